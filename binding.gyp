@@ -28,7 +28,19 @@
       'sources': [
         'src/nodem.cc',
         'src/gtm.cc',
-        'src/ydb.cc'
+        'src/ydb.cc',
+        'src/lockstats.cc',
+        'src/shard.cc',
+        'src/adaptive.cc',
+        'src/token.cc',
+        'src/packed.cc',
+        'src/json.cc',
+        'src/filter.cc',
+        'src/distinct.cc',
+        'src/readahead.cc',
+        'src/bloom.cc',
+        'src/aggregate.cc',
+        'src/movewatch.cc'
       ],
       'cflags': [
         '-error',
@@ -0,0 +1,120 @@
+/*
+ * Package:    NodeM
+ * File:       adaptive.js
+ * Summary:    Test adaptive execution
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Turn on adaptive mode, and check that calls on ^v4wTest("adaptive") made
+ * without a callback return Promises that resolve with the usual results, both
+ * for calls run right away and for a lock with a timeout, which is sent to the
+ * thread pool; that calls inside a transaction are not affected; that invalid
+ * thresholds are rejected; and that a threshold of 0 turns adaptive mode off.
+ *
+ * Requires Node.js version 8.0.0 or newer.
+ */
+
+'use strict';
+
+process.on('uncaughtException', (error) => {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+process.on('unhandledRejection', (error) => {
+    console.trace('Unhandled Rejection:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+const assert = require('assert');
+const nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.data('^v4wTest', 'adaptive') !== 0) {
+    console.error('^v4wTest("adaptive") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+async function main() {
+    [Infinity, NaN, -1, 60001].forEach((threshold) => {
+        assert.throws(() => nodem.configure({adaptive: threshold}), RangeError);
+    });
+
+    nodem.configure({adaptive: true});
+
+    let promise = nodem.set({global: 'v4wTest', subscripts: ['adaptive', 1], data: 'one'});
+
+    assert.ok(promise instanceof Promise);
+    assert.strictEqual((await promise).ok, true);
+
+    for (let i = 0; i < 100; i++) {
+        const result = await nodem.get({global: 'v4wTest', subscripts: ['adaptive', 1]});
+
+        assert.strictEqual(result.data, 'one');
+        assert.strictEqual(result.defined, true);
+    }
+
+    assert.strictEqual((await nodem.increment({global: 'v4wTest', subscripts: ['adaptive', 2]})).data, 1);
+    assert.strictEqual((await nodem.data({global: 'v4wTest', subscripts: ['adaptive']})).defined, 10);
+
+    promise = nodem.lock({global: 'v4wTest', subscripts: ['adaptive'], timeout: 1});
+
+    assert.ok(promise instanceof Promise);
+    assert.strictEqual((await promise).result, true);
+    assert.strictEqual((await nodem.unlock({global: 'v4wTest', subscripts: ['adaptive']})).ok, true);
+
+    if (nodem.version().split(' ')[3].slice(0, -1) === 'YottaDB') {
+        const tpResult = nodem.transaction(() => {
+            const result = nodem.get({global: 'v4wTest', subscripts: ['adaptive', 1]});
+
+            assert.ok(!(result instanceof Promise));
+            assert.strictEqual(result.data, 'one');
+
+            return 'Commit';
+        });
+
+        assert.strictEqual(tpResult.ok, true);
+    }
+
+    nodem.configure({adaptive: 0.25});
+
+    promise = nodem.get({global: 'v4wTest', subscripts: ['adaptive', 1]});
+
+    assert.ok(promise instanceof Promise);
+    assert.strictEqual((await promise).data, 'one');
+
+    nodem.configure({adaptive: 0});
+
+    const result = nodem.get({global: 'v4wTest', subscripts: ['adaptive', 1]});
+
+    assert.ok(!(result instanceof Promise));
+    assert.strictEqual(result.data, 'one');
+
+    nodem.kill('^v4wTest', 'adaptive');
+}
+
+main().then(() => {
+    console.log('adaptive: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,185 @@
+/*
+ * Package:    NodeM
+ * File:       aggregate.js
+ * Summary:    Test the defineAggregate API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Keep the count and sum of the orders in ^v4wAggregate by region in
+ * ^v4wTotal, checking that set, increment, kill, and killTree calls keep the
+ * totals equal to ones computed from the orders, with exact decimal sums, that
+ * a group is killed with its last order, and that a merge marks them stale.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The defineAggregate API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wAggregate') !== 0 || nodem.data('^v4wTotal') !== 0) {
+    console.error('^v4wAggregate or ^v4wTotal already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i;
+
+for (i = 1; i <= 10; i++) {
+    nodem.set('^v4wAggregate', 'east', i, i * 10);
+    nodem.set('^v4wAggregate', 'west', i, i);
+}
+
+// Nodes above and below the value level are not totaled
+nodem.set('^v4wAggregate', 'east', 'note');
+nodem.set('^v4wAggregate', 'east', 1, 'line', 1000);
+
+var result = nodem.defineAggregate({source: 'v4wAggregate', target: 'v4wTotal', groupLevel: 1, valueLevel: 2});
+
+assert.strictEqual(result.ok, true);
+assert.deepStrictEqual(result.ops, ['count', 'sum']);
+assert.strictEqual(result.stale, false);
+assert.strictEqual(result.count, 20);
+
+function check(region) {
+    var count = 0;
+    var sum = 0;
+    var order = '';
+
+    while ((order = nodem.order('^v4wAggregate', region, order)) !== '') {
+        if (nodem.data('^v4wAggregate', region, order) % 10 === 1) {
+            count++;
+            sum += nodem.get('^v4wAggregate', region, order) * 100;
+        }
+    }
+
+    if (count === 0) {
+        assert.strictEqual(nodem.data('^v4wTotal', region), 0);
+    } else {
+        assert.strictEqual(nodem.get('^v4wTotal', region, 'count'), count);
+        assert.strictEqual(Math.round(nodem.get('^v4wTotal', region, 'sum') * 100), Math.round(sum));
+    }
+}
+
+check('east');
+check('west');
+
+nodem.set('^v4wAggregate', 'east', 11, 0.1);
+nodem.set('^v4wAggregate', 'east', 12, 0.2);
+nodem.set('^v4wAggregate', 'east', 2, 25);
+nodem.increment({global: 'v4wAggregate', subscripts: ['east', 3], increment: 5});
+nodem.kill('^v4wAggregate', 'east', 4);
+
+check('east');
+
+// M arithmetic keeps decimal sums exact
+assert.strictEqual(nodem.get('^v4wTotal', 'east', 'sum'), 520.3);
+
+nodem.set('^v4wAggregate', 'north', 1, 7);
+
+assert.strictEqual(nodem.get('^v4wTotal', 'north', 'count'), 1);
+
+nodem.kill('^v4wAggregate', 'north', 1);
+
+assert.strictEqual(nodem.data('^v4wTotal', 'north'), 0);
+
+nodem.killTree({global: 'v4wAggregate', subscripts: ['west'], chunkSize: 3});
+
+check('west');
+
+result = nodem.defineAggregate({target: 'v4wTotal'});
+
+assert.strictEqual(result.source, 'v4wAggregate');
+assert.strictEqual(result.stale, false);
+assert.strictEqual(result.count, undefined);
+
+// A merge in to the source can write any node, so the totals are stale until they are computed again
+nodem.set({local: 'aggregateSource', subscripts: [1], data: 1000});
+nodem.merge({from: {local: 'aggregateSource'}, to: {global: 'v4wAggregate', subscripts: ['south']}});
+
+assert.strictEqual(nodem.defineAggregate({target: 'v4wTotal'}).stale, true);
+assert.strictEqual(nodem.data('^v4wTotal', 'south'), 0);
+
+result = nodem.defineAggregate({source: 'v4wAggregate', target: 'v4wTotal', groupLevel: 1, valueLevel: 2, ops: ['sum']});
+
+assert.strictEqual(result.stale, false);
+assert.deepStrictEqual(result.ops, ['sum']);
+assert.strictEqual(nodem.get('^v4wTotal', 'south', 'sum'), 1000);
+assert.strictEqual(nodem.data('^v4wTotal', 'south', 'count'), 0);
+
+assert.throws(function() {
+    nodem.defineAggregate({source: 'v4wTotal', target: 'v4wTotal'});
+}, Error);
+
+assert.throws(function() {
+    nodem.defineAggregate({source: 'v4wAggregate'});
+}, SyntaxError);
+
+[{valueLevel: 0}, {valueLevel: 2, groupLevel: 3}, {valueLevel: 1.5}].forEach(function(levels) {
+    assert.throws(function() {
+        nodem.defineAggregate({source: 'v4wAggregate', target: 'v4wTotal', groupLevel: levels.groupLevel,
+          valueLevel: levels.valueLevel});
+    }, RangeError);
+});
+
+[['avg'], [], 'sum'].forEach(function(ops) {
+    assert.throws(function() {
+        nodem.defineAggregate({source: 'v4wAggregate', target: 'v4wTotal', valueLevel: 2, ops: ops});
+    }, TypeError);
+});
+
+result = nodem.defineAggregate({target: 'v4wTotal', drop: true});
+
+assert.strictEqual(result.dropped, true);
+assert.strictEqual(nodem.get('^v4wTotal', 'south', 'sum'), 1000);
+
+nodem.set('^v4wAggregate', 'south', 2, 1);
+
+assert.strictEqual(nodem.get('^v4wTotal', 'south', 'sum'), 1000);
+
+// A grand total, with the default groupLevel of 0
+nodem.defineAggregate({source: 'v4wAggregate', target: 'v4wTotal', valueLevel: 2}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.groupLevel, 0);
+    assert.strictEqual(result.count, 13);
+    assert.strictEqual(nodem.get('^v4wTotal', 'count'), 13);
+    assert.strictEqual(nodem.get('^v4wTotal', 'sum'), 1521.3);
+    assert.strictEqual(nodem.data('^v4wTotal', 'south'), 0);
+
+    nodem.defineAggregate({target: 'v4wTotal', drop: true});
+    nodem.kill('^v4wAggregate');
+    nodem.kill('^v4wTotal');
+
+    console.log('defineAggregate: ok');
+
+    nodem.close();
+    process.exit(0);
+});
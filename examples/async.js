@@ -0,0 +1,104 @@
+/*
+ * Package:    NodeM
+ * File:       async.js
+ * Summary:    Test asynchronous calls reusing pooled batons
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Make several rounds of many concurrent asynchronous calls of different kinds
+ * on ^v4wTest("async"), with small and large values, and synchronous calls in
+ * between, checking that each callback gets the result of its own call, so that
+ * a baton reused from the pool never carries over anything from its last call.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.data('^v4wTest', 'async') !== 0) {
+    console.error('^v4wTest("async") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var nodes = 200;
+var rounds = 5;
+var large = new Array(100001).join('L');
+
+function value(i) {
+    return (i % 10 === 0) ? large + i : 'value ' + i;
+}
+
+for (var i = 0; i < nodes; i++) nodem.set('^v4wTest', 'async', i, value(i));
+
+function round(number) {
+    if (number === rounds) {
+        nodem.kill('^v4wTest', 'async');
+
+        console.log('asynchronous batons: ok');
+
+        nodem.close();
+        process.exit(0);
+    }
+
+    var pending = nodes * 3;
+
+    function done() {
+        if (--pending > 0) return;
+
+        // Synchronous calls between rounds do not disturb the pooled batons
+        for (var j = 0; j < nodes; j++) assert.strictEqual(nodem.get('^v4wTest', 'async', j), value(j));
+
+        round(number + 1);
+    }
+
+    for (var j = 0; j < nodes; j++) {
+        (function(j) {
+            nodem.get({global: 'v4wTest', subscripts: ['async', j]}, function(error, result) {
+                assert.ifError(error);
+                assert.deepStrictEqual(result.subscripts, ['async', j]);
+                assert.strictEqual(result.data, value(j));
+                done();
+            });
+
+            nodem.data({global: 'v4wTest', subscripts: ['async', j, 'none']}, function(error, result) {
+                assert.ifError(error);
+                assert.deepStrictEqual(result.subscripts, ['async', j, 'none']);
+                assert.strictEqual(result.defined, 0);
+                done();
+            });
+
+            nodem.order({global: 'v4wTest', subscripts: ['async', j]}, function(error, result) {
+                assert.ifError(error);
+                assert.strictEqual(result.result, (j + 1 < nodes) ? j + 1 : '');
+                done();
+            });
+        })(j);
+    }
+}
+
+round(0);
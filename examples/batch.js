@@ -0,0 +1,122 @@
+/*
+ * Package:    NodeM
+ * File:       batch.js
+ * Summary:    Test the batch API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Run every kind of operation on ^v4wTest("batch") and a local variable in one
+ * batch, synchronously and asynchronously, checking that they run in order and
+ * each returns what the single API would, that a failing operation returns its
+ * error after the ones before it have taken effect, and that an unknown
+ * operation is rejected.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.data('^v4wTest', 'batch') !== 0) {
+    console.error('^v4wTest("batch") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var operations = [
+    {op: 'set', global: 'v4wTest', subscripts: ['batch', 42, 'status'], data: 'OPEN'},
+    {op: 'increment', global: 'v4wTest', subscripts: ['batch', 42, 'lines']},
+    {op: 'increment', global: 'v4wTest', subscripts: ['batch', 42, 'lines'], increment: 2.5},
+    {op: 'get', global: 'v4wTest', subscripts: ['batch', 42, 'status']},
+    {op: 'get', global: 'v4wTest', subscripts: ['batch', 42, 'missing']},
+    {op: 'data', global: 'v4wTest', subscripts: ['batch', 42]},
+    {op: 'order', global: 'v4wTest', subscripts: ['batch', 42, '']},
+    {op: 'previous', global: 'v4wTest', subscripts: ['batch', 42, '']},
+    {op: 'set', local: 'batch', subscripts: ['a, "b"'], data: 'x,y"z'},
+    {op: 'get', local: 'batch', subscripts: ['a, "b"']},
+    {op: 'kill', global: 'v4wTest', subscripts: ['batch', 42, 'status']},
+    {op: 'data', global: 'v4wTest', subscripts: ['batch', 42, 'status']}
+];
+
+function check(result) {
+    assert.strictEqual(result.ok, true);
+    assert.strictEqual(result.results.length, operations.length);
+
+    result.results.forEach(function(entry, index) {
+        assert.strictEqual(entry.ok, true);
+        assert.strictEqual(entry.op, operations[index].op);
+    });
+
+    assert.strictEqual(result.results[1].data, 1);
+    assert.strictEqual(result.results[2].data, 3.5);
+    assert.strictEqual(result.results[3].data, 'OPEN');
+    assert.strictEqual(result.results[3].defined, true);
+    assert.strictEqual(result.results[4].defined, false);
+    assert.strictEqual(result.results[5].defined, 10);
+    assert.strictEqual(result.results[6].result, 'lines');
+    assert.strictEqual(result.results[7].result, 'status');
+    assert.strictEqual(result.results[9].data, 'x,y"z');
+    assert.strictEqual(result.results[11].defined, 0);
+
+    assert.strictEqual(nodem.get('^v4wTest', 'batch', 42, 'lines'), 3.5);
+}
+
+check(nodem.batch(operations));
+
+nodem.kill('^v4wTest', 'batch');
+
+var result = nodem.batch([
+    {op: 'set', global: 'v4wTest', subscripts: ['batch', 'before'], data: 'kept'},
+    {op: 'set', global: 'v4wTest', subscripts: ['batch', new Array(1100).join('x')], data: 'too long'},
+    {op: 'set', global: 'v4wTest', subscripts: ['batch', 'after'], data: 'never'}
+]);
+
+assert.strictEqual(result.ok, false);
+assert.strictEqual(nodem.get('^v4wTest', 'batch', 'before'), 'kept');
+assert.strictEqual(nodem.data('^v4wTest', 'batch', 'after'), 0);
+
+assert.throws(function() {
+    nodem.batch([{op: 'merge', global: 'v4wTest', subscripts: ['batch']}]);
+}, SyntaxError);
+
+assert.throws(function() {
+    nodem.batch([{op: 'set', global: 'v4wTest', subscripts: ['batch']}]);
+}, SyntaxError);
+
+nodem.kill('^v4wTest', 'batch');
+
+nodem.batch(operations, function(error, result) {
+    assert.ifError(error);
+    check(result);
+
+    nodem.kill('^v4wTest', 'batch');
+    nodem.kill({local: 'batch'});
+
+    console.log('batch: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,141 @@
+/*
+ * Package:    NodeM
+ * File:       bloom.js
+ * Summary:    Test the bloom API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Build a Bloom filter over the keys of ^v4wTest("bloom"), checking that data
+ * and get answer correctly for keys that are and are not there, that keys set
+ * afterward are found, that a merge over the node marks the filter stale until
+ * it is rebuilt, and that the filter is not used inside a transaction.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The bloom API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'bloom') !== 0) {
+    console.error('^v4wTest("bloom") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i;
+
+for (i = 1; i <= 100; i++) nodem.set('^v4wTest', 'bloom', i, 'name', 'patient ' + i);
+
+var result = nodem.bloom({global: 'v4wTest', subscripts: ['bloom']});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.level, 2);
+assert.strictEqual(result.count, 100);
+assert.ok(result.bits >= 1000);
+assert.strictEqual(result.stale, false);
+assert.strictEqual(result.probes, 0);
+
+// Every covered data or get call is probed, and the keys that are there are always looked up
+for (i = 1; i <= 10; i++) {
+    assert.strictEqual(nodem.data('^v4wTest', 'bloom', i), 10);
+    assert.strictEqual(nodem.get('^v4wTest', 'bloom', i, 'name'), 'patient ' + i);
+}
+
+for (i = 1001; i <= 1040; i++) {
+    assert.strictEqual(nodem.data('^v4wTest', 'bloom', i), 0);
+    assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: ['bloom', i, 'name']}).defined, false);
+}
+
+assert.strictEqual(nodem.data('^v4wTest', 'bloom'), 10);
+
+nodem.set('^v4wTest', 'bloom', 1001, 'name', 'added');
+
+assert.strictEqual(nodem.data('^v4wTest', 'bloom', 1001), 10);
+assert.strictEqual(nodem.get('^v4wTest', 'bloom', 1001, 'name'), 'added');
+
+// Inside a transaction the filter is not used
+nodem.transaction(function() {
+    assert.strictEqual(nodem.data('^v4wTest', 'bloom', 2000), 0);
+
+    return 'OK';
+});
+
+result = nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], level: 2});
+
+assert.strictEqual(result.count, 101);
+assert.strictEqual(result.probes, 102);
+assert.ok(result.negatives > 60 && result.negatives <= 80);
+
+// A merge over the node can add keys the filter does not know, so it is stale until it is rebuilt
+nodem.set({local: 'bloomSource', subscripts: [3000, 'name'], data: 'merged'});
+nodem.merge({from: {local: 'bloomSource'}, to: {global: 'v4wTest', subscripts: ['bloom']}});
+
+assert.strictEqual(nodem.data('^v4wTest', 'bloom', 3000), 10);
+assert.strictEqual(nodem.get('^v4wTest', 'bloom', 3000, 'name'), 'merged');
+
+result = nodem.bloom({global: 'v4wTest', subscripts: ['bloom']});
+
+assert.strictEqual(result.stale, false);
+assert.strictEqual(result.count, 102);
+assert.strictEqual(nodem.data('^v4wTest', 'bloom', 3000), 10);
+
+assert.throws(function() {
+    nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], level: 1});
+}, TypeError);
+
+[0, 100000, 'ten'].forEach(function(bitsPerKey) {
+    assert.throws(function() {
+        nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], bitsPerKey: bitsPerKey});
+    }, RangeError);
+});
+
+assert.throws(function() {
+    nodem.bloom({global: '|"other.gld"|v4wTest', subscripts: ['bloom']});
+}, Error);
+
+assert.strictEqual(nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], drop: true}).dropped, true);
+assert.strictEqual(nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], drop: true}).dropped, false);
+
+nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], bitsPerKey: 16}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.count, 102);
+    assert.strictEqual(result.probes, 0);
+    assert.strictEqual(nodem.data('^v4wTest', 'bloom', 4000), 0);
+
+    nodem.bloom({global: 'v4wTest', subscripts: ['bloom'], drop: true});
+    nodem.kill('^v4wTest', 'bloom');
+
+    console.log('bloom: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,138 @@
+/*
+ * Package:    NodeM
+ * File:       counter.js
+ * Summary:    Test the stripedCounter API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Increment a counter in ^v4wTest("counter"), spread across four stripes, from
+ * the main thread, the thread pool, and a worker thread, and check that each
+ * increment goes to one stripe, and that a read sums every stripe. Then check
+ * that an invalid number of stripes is rejected.
+ *
+ * Requires Node.js version 11.7.0 or newer.
+ */
+
+'use strict';
+
+process.on('uncaughtException', (error) => {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+const assert = require('assert');
+const {Worker, isMainThread, parentPort} = require('worker_threads');
+const nodem = require('../lib/nodem.js').Gtm();
+
+const counter = {global: 'v4wTest', subscripts: ['counter'], stripes: 4};
+
+if (!isMainThread) {
+    const stripes = new Set();
+
+    for (let i = 0; i < 10; i++) {
+        const result = nodem.stripedCounter(Object.assign({increment: 3}, counter));
+
+        assert.strictEqual(result.ok, true);
+        stripes.add(result.stripe);
+    }
+
+    parentPort.postMessage([...stripes]);
+    return;
+}
+
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The stripedCounter API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'counter') !== 0) {
+    console.error('^v4wTest("counter") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+[0, 1025, 2.5, -1].forEach((stripes) => {
+    assert.throws(() => nodem.stripedCounter({global: 'v4wTest', subscripts: ['counter'], stripes}), RangeError);
+});
+
+const stripes = new Set();
+
+for (let i = 0; i < 10; i++) {
+    const result = nodem.stripedCounter(Object.assign({increment: 1}, counter));
+
+    assert.strictEqual(result.ok, true);
+    assert.strictEqual(result.stripes, 4);
+    assert.strictEqual(result.increment, 1);
+    assert.ok(result.stripe >= 0 && result.stripe < 4);
+
+    stripes.add(result.stripe);
+}
+
+// Every increment from one thread goes to the same stripe
+assert.strictEqual(stripes.size, 1);
+
+function sum() {
+    let total = 0;
+
+    for (let stripe = 0; stripe < 4; stripe++) {
+        const result = nodem.get({global: 'v4wTest', subscripts: ['counter', stripe]});
+
+        if (result.defined) total += result.data;
+    }
+
+    return total;
+}
+
+let pending = 5;
+
+for (let i = 0; i < 5; i++) {
+    nodem.stripedCounter(Object.assign({increment: 2}, counter), (error, result) => {
+        assert.ifError(error);
+        assert.ok(result.stripe >= 0 && result.stripe < 4);
+
+        if (--pending > 0) return;
+
+        const worker = new Worker(__filename);
+
+        worker.on('message', (workerStripes) => {
+            assert.strictEqual(workerStripes.length, 1);
+
+            const result = nodem.stripedCounter(counter);
+
+            assert.strictEqual(result.data, 50);
+            assert.strictEqual(result.data, sum());
+            assert.strictEqual(nodem.stripedCounter(Object.assign({increment: 0}, counter)).data, 50);
+
+            nodem.kill('^v4wTest', 'counter');
+
+            console.log('stripedCounter: ok');
+
+            nodem.close();
+            process.exit(0);
+        });
+
+        worker.on('error', (error) => {
+            throw error;
+        });
+    });
+}
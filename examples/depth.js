@@ -0,0 +1,98 @@
+/*
+ * Package:    NodeM
+ * File:       depth.js
+ * Summary:    Test the data, get, set, order, and previous APIs at each subscript depth
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Set, read, and walk nodes of ^v4wTest("depth"), and of a local variable, with
+ * from one to ten subscripts, which covers each fixed-arity Call-in entry point
+ * and the generic ones past them, using subscripts and values with quotes,
+ * commas, parentheses, empty strings, and numbers, checking that every depth
+ * returns the same results.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.data('^v4wTest', 'depth') !== 0) {
+    console.error('^v4wTest("depth") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var parts = ['a"b', 'c,d', 'e(f)', -1.5, 'g h', 0, '"', 'i,"j")', 12, 'k'];
+var values = ['plain', 'quote "in" it', 'comma, paren (', '', -42.25, 7, 'x"y', '$C(0)', 'end', 'last'];
+
+function check(type, name) {
+    for (var depth = 1; depth <= 10; depth++) {
+        var subscripts = [name === 'v4wTest' ? 'depth' : 'root'].concat(parts.slice(0, depth - 1));
+        var node = {subscripts: subscripts};
+        var value = values[depth - 1];
+
+        node[type] = name;
+
+        assert.strictEqual(nodem.set(Object.assign({data: value}, node)).ok, true);
+        assert.strictEqual(nodem.get(node).data, value);
+        assert.strictEqual(nodem.get(node).defined, true);
+        assert.strictEqual(nodem.data(node).defined, 1);
+
+        if (depth > 1) {
+            var sibling = subscripts.slice(0, -1).concat(['zz']);
+            var first = subscripts.slice(0, -1).concat(['']);
+
+            nodem.set(Object.assign({data: 'sibling'}, node, {subscripts: sibling}));
+
+            assert.strictEqual(nodem.order(Object.assign({}, node, {subscripts: first})).result, subscripts[depth - 1]);
+            assert.strictEqual(nodem.order(node).result, 'zz');
+            assert.strictEqual(nodem.previous(Object.assign({}, node, {subscripts: sibling})).result, subscripts[depth - 1]);
+            assert.strictEqual(nodem.previous(Object.assign({}, node, {subscripts: first})).result, 'zz');
+        }
+
+        var missing = Object.assign({}, node, {subscripts: subscripts.concat(['missing'])});
+
+        assert.strictEqual(nodem.get(missing).defined, false);
+        assert.strictEqual(nodem.data(missing).defined, 0);
+    }
+}
+
+check('global', 'v4wTest');
+check('local', 'depth');
+
+assert.strictEqual(nodem.get('^v4wTest', 'depth', 'a"b', 'c,d', 'e(f)'), values[3]);
+assert.strictEqual(nodem.data('^v4wTest', 'depth', 'a"b'), 11);
+assert.strictEqual(nodem.order('^v4wTest', 'depth', 'a"b', 'c,d', 'e(f)', -1.5, ''), 'g h');
+assert.strictEqual(nodem.previous('^v4wTest', 'depth', 'a"b', 'c,d', 'e(f)', -1.5, ''), 'zz');
+
+nodem.kill('^v4wTest', 'depth');
+nodem.kill({local: 'depth'});
+
+console.log('subscript depths: ok');
+
+nodem.close();
+process.exit(0);
@@ -0,0 +1,108 @@
+/*
+ * Package:    NodeM
+ * File:       distinct.js
+ * Summary:    Test the countDistinct API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Count the distinct values, and the distinct subscripts at a level, of
+ * ^v4wTest("distinct"), checking that a handful of entries is counted exactly,
+ * that a larger count is estimated closely, and that merging the sketch of one
+ * subtree in to the count of another estimates their union.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The countDistinct API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'distinct') !== 0) {
+    console.error('^v4wTest("distinct") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+function near(estimate, count) {
+    assert.ok(Math.abs(estimate - count) <= count * 0.05, 'estimate ' + estimate + ' is not near ' + count);
+}
+
+var i;
+
+for (i = 0; i < 20; i++) nodem.set('^v4wTest', 'distinct', 'small', i, 'value ' + (i % 5));
+
+var result = nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'small']});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.of, 'value');
+assert.strictEqual(result.estimate, 5);
+
+// Day 1 sees patients 0 to 2999, and day 2 sees patients 2000 to 5999, several times each
+for (i = 0; i < 9000; i++) {
+    nodem.set('^v4wTest', 'distinct', 'day1', i % 3000, i, 'visit');
+    nodem.set('^v4wTest', 'distinct', 'day2', 2000 + (i % 4000), i, 'visit');
+}
+
+var day1 = nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day1'], of: 3, sketch: true});
+
+assert.strictEqual(day1.of, 3);
+assert.ok(Buffer.isBuffer(day1.sketch));
+near(day1.estimate, 3000);
+
+near(nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day2'], of: 3}).estimate, 4000);
+near(nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day2'], of: 4}).estimate, 9000);
+assert.strictEqual(nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day2']}).estimate, 1);
+
+result = nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day2'], of: 3, merge: [day1.sketch]});
+
+near(result.estimate, 6000);
+
+[1, 2, 'subscript', -1].forEach(function(of) {
+    assert.throws(function() {
+        nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day1'], of: of});
+    }, TypeError);
+});
+
+assert.throws(function() {
+    nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'day1'], merge: [Buffer.from('not a sketch')]});
+}, TypeError);
+
+nodem.countDistinct({global: 'v4wTest', subscripts: ['distinct', 'small'], of: 3}, function(error, result) {
+    assert.ifError(error);
+    assert.ok(Math.abs(result.estimate - 20) <= 1);
+
+    nodem.kill('^v4wTest', 'distinct');
+
+    console.log('countDistinct: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,124 @@
+/*
+ * Package:    NodeM
+ * File:       filter.js
+ * Summary:    Test the filter option of the scan API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Scan ^v4wTest("filter") with filter expressions using each kind of operand,
+ * comparison, and logical operator, checking that exactly the matching nodes
+ * are returned, that a filter matching few nodes pages through the whole level
+ * in bounded pages, and that invalid expressions throw a SyntaxError.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The scan API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'filter') !== 0) {
+    console.error('^v4wTest("filter") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var users = [];
+var i;
+
+for (i = 1; i <= 200; i++) {
+    users.push({id: i, name: (i % 2 ? 'Alice' : 'Bob') + i, age: 10 + (i % 60)});
+    nodem.set('^v4wTest', 'filter', i, users[i - 1].name + '^' + users[i - 1].age);
+}
+
+nodem.set('^v4wTest', 'filter', 7, 'child', 'below');
+nodem.set('^v4wTest', 'filter', 'zz', 'child', 'only');
+
+function scan(filter, limit) {
+    var results = [];
+    var page = {token: null};
+
+    do {
+        page = nodem.scan({global: 'v4wTest', subscripts: ['filter'], filter: filter, limit: limit || 100,
+          token: page.token});
+
+        assert.ok(page.results.length <= (limit || 100));
+
+        results = results.concat(page.results);
+    } while (page.token !== null);
+
+    return results.map(function(result) {
+        return result.subscript;
+    });
+}
+
+function expect(test) {
+    return users.filter(test).map(function(user) {
+        return user.id;
+    });
+}
+
+assert.deepStrictEqual(scan("piece(value, '^', 2) between 18 and 65"), expect(function(user) {
+    return user.age >= 18 && user.age <= 65;
+}));
+
+assert.deepStrictEqual(scan("value startsWith 'Bob' and not (subscript < 100 or subscript >= 150)"), expect(function(user) {
+    return user.name.slice(0, 3) === 'Bob' && user.id >= 100 && user.id < 150;
+}));
+
+assert.deepStrictEqual(scan("piece(value, '^', 1) = 'Alice7' or value contains '^69'"), expect(function(user) {
+    return user.name === 'Alice7' || user.age === 69;
+}));
+
+assert.deepStrictEqual(scan("data = 11"), [7]);
+assert.deepStrictEqual(scan("data = 10"), ['zz']);
+assert.strictEqual(scan("value != ''", 1000).length, 200);
+assert.deepStrictEqual(scan("subscript > 195 and subscript <= 198"), [196, 197, 198]);
+
+// A filter that matches one node in 200 is paged in pages that visit at most ten times the limit
+var page = nodem.scan({global: 'v4wTest', subscripts: ['filter'], filter: 'subscript = 190', limit: 2});
+
+assert.strictEqual(page.results.length, 0);
+assert.notStrictEqual(page.token, null);
+assert.deepStrictEqual(scan('subscript = 190', 2), [190]);
+
+['value =', "piece(value, '^') = 1", 'subscript between 1', "value = 'open", 'unknown = 1', '(data = 1'].forEach(function(filter) {
+    assert.throws(function() {
+        nodem.scan({global: 'v4wTest', subscripts: ['filter'], filter: filter});
+    }, SyntaxError);
+});
+
+nodem.kill('^v4wTest', 'filter');
+
+console.log('scan filter: ok');
+
+nodem.close();
+process.exit(0);
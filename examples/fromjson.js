@@ -0,0 +1,110 @@
+/*
+ * Package:    NodeM
+ * File:       fromjson.js
+ * Summary:    Test the fromJSON API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Parse JSON text in to ^v4wTest("fromJSON"), from a Buffer and a string, in
+ * the nested and flat shapes, synchronously and asynchronously, checking the
+ * nodes set, that what toJSON writes is read back in to the same nodes, and
+ * that invalid JSON keeps the nodes set before it, or, in a transaction, none.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The fromJSON API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'fromJSON') !== 0) {
+    console.error('^v4wTest("fromJSON") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var text = '{"1": "Alice", "2": {"": "Bob", "email": "bob@example.com"}, "list": [10, true, null, "x"], ' +
+  '"n": 0.50, "escaped": "tab\\there \\u00e9\\ud83d\\ude00"}';
+
+var result = nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON', 'nested']}, Buffer.from(text));
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.count, 8);
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 1), 'Alice');
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 2), 'Bob');
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 2, 'email'), 'bob@example.com');
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 'list', 0), 10);
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 'list', 1), 1);
+assert.strictEqual(nodem.data('^v4wTest', 'fromJSON', 'nested', 'list', 2), 0);
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 'list', 3), 'x');
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 'n'), 0.5);
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'nested', 'escaped'), 'tab\there é😀');
+
+// What toJSON writes, in either shape, is read back in to the same nodes
+['nested', 'flat'].forEach(function(shape) {
+    var json = nodem.toJSON({global: 'v4wTest', subscripts: ['fromJSON', 'nested'], shape: shape}).json;
+
+    result = nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON', shape + 'Copy']}, json.toString(), {shape: shape});
+
+    assert.strictEqual(result.count, 8);
+    assert.strictEqual(nodem.toJSON({global: 'v4wTest', subscripts: ['fromJSON', shape + 'Copy'], shape: shape}).json.toString(),
+      json.toString());
+});
+
+result = nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON', 'partial']}, '{"a": 1, "b": 2, "c": }');
+
+assert.strictEqual(result.ok, false);
+assert.ok(/PARAMINVALID/.test(result.errorMessage));
+assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'partial', 'b'), 2);
+
+result = nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON', 'atomic']}, '{"a": 1, "b": 2, "c": }',
+  {transaction: true});
+
+assert.strictEqual(result.ok, false);
+assert.strictEqual(nodem.data('^v4wTest', 'fromJSON', 'atomic'), 0);
+
+assert.throws(function() {
+    nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON']}, '{}', {shape: 'tree'});
+}, TypeError);
+
+nodem.fromJSON({global: 'v4wTest', subscripts: ['fromJSON', 'async']}, '[{"id": 1}, {"id": 2}]', {transaction: true},
+  function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.count, 2);
+    assert.strictEqual(nodem.get('^v4wTest', 'fromJSON', 'async', 1, 'id'), 2);
+
+    nodem.kill('^v4wTest', 'fromJSON');
+
+    console.log('fromJSON: ok');
+
+    nodem.close();
+    process.exit(0);
+});
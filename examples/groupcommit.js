@@ -0,0 +1,132 @@
+/*
+ * Package:    NodeM
+ * File:       groupcommit.js
+ * Summary:    Test group commit of asynchronous updates
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Turn on group commit, and make asynchronous set, increment, and kill calls on
+ * ^v4wTest("groupCommit"), including one that fails, checking that each call
+ * gets its own result, and that the rest of its batch is committed. Then check
+ * that invalid options are rejected, and that a child process that closes the
+ * database while a batch is still open commits it first.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('Group commit is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (process.argv[2] === 'child') {
+    nodem.configure({groupCommit: {window: 1000, maxOps: 100}});
+    nodem.set({global: 'v4wTest', subscripts: ['groupCommit', 'closed'], data: 'committed'}, function() {});
+    nodem.close();
+    process.exit(0);
+}
+
+if (nodem.data('^v4wTest', 'groupCommit') !== 0) {
+    console.error('^v4wTest("groupCommit") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+[{window: Infinity}, {window: NaN}, {window: -1}, {window: 1001}, {window: 0.5},
+  {maxOps: 0}, {maxOps: 65537}, {maxOps: 2.5}].forEach(function(options) {
+    assert.throws(function() {
+        nodem.configure({groupCommit: options});
+    }, RangeError);
+});
+
+nodem.set('^v4wTest', 'groupCommit', 'gone', 'killed');
+nodem.configure({groupCommit: {window: 5, maxOps: 8}});
+
+var calls = 20;
+var pending = calls + 3;
+var errors = 0;
+
+function done() {
+    if (--pending > 0) return;
+
+    assert.strictEqual(errors, 1);
+
+    for (var i = 0; i < calls; i++) assert.strictEqual(nodem.get('^v4wTest', 'groupCommit', i), 'value ' + i);
+
+    assert.strictEqual(nodem.get('^v4wTest', 'groupCommit', 'count'), 2);
+    assert.strictEqual(nodem.data('^v4wTest', 'groupCommit', 'gone'), 0);
+
+    nodem.configure({groupCommit: false});
+
+    var spawnSync = require('child_process').spawnSync;
+    var child = spawnSync(process.execPath, [__filename, 'child'], {stdio: 'inherit'});
+
+    assert.strictEqual(child.status, 0, 'child process failed');
+    assert.strictEqual(nodem.get('^v4wTest', 'groupCommit', 'closed'), 'committed');
+
+    nodem.kill('^v4wTest', 'groupCommit');
+
+    console.log('groupCommit: ok');
+
+    nodem.close();
+    process.exit(0);
+}
+
+for (var i = 0; i < calls; i++) {
+    nodem.set({global: 'v4wTest', subscripts: ['groupCommit', i], data: 'value ' + i}, function(error, result) {
+        assert.ifError(error);
+        assert.strictEqual(result.ok, true);
+        done();
+    });
+}
+
+nodem.increment({global: 'v4wTest', subscripts: ['groupCommit', 'count']}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.data, 1);
+
+    nodem.increment({global: 'v4wTest', subscripts: ['groupCommit', 'count']}, function(error, result) {
+        assert.ifError(error);
+        assert.strictEqual(result.data, 2);
+        done();
+    });
+});
+
+nodem.kill({global: 'v4wTest', subscripts: ['groupCommit', 'gone']}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.ok, true);
+    done();
+});
+
+// A key too long for any database fails on its own, and the rest of its batch is still committed
+nodem.set({global: 'v4wTest', subscripts: ['groupCommit', new Array(1100).join('x')], data: 'too long'}, function(error) {
+    assert.ok(error);
+    errors++;
+    done();
+});
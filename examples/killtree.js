@@ -0,0 +1,121 @@
+/*
+ * Package:    NodeM
+ * File:       killtree.js
+ * Summary:    Test the killTree API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Kill a tree in ^v4wTest("killTree") in chunks, synchronously, asynchronously,
+ * and inside a transaction, checking the number of nodes killed, that nothing
+ * is left behind, that the nodes next to the tree are kept, and that an invalid
+ * chunkSize is rejected.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The killTree API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'killTree') !== 0) {
+    console.error('^v4wTest("killTree") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+function fill(tree) {
+    var i;
+
+    nodem.set('^v4wTest', 'killTree', tree, 'root');
+
+    for (i = 1; i <= 250; i++) {
+        nodem.set('^v4wTest', 'killTree', tree, i, 'record ' + i);
+        nodem.set('^v4wTest', 'killTree', tree, i, 'line', 'line ' + i);
+    }
+
+    return 501;
+}
+
+nodem.set('^v4wTest', 'killTree', 'keep', 'kept');
+
+var count = fill('sync');
+var result = nodem.killTree({global: 'v4wTest', subscripts: ['killTree', 'sync'], chunkSize: 100});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.chunkSize, 100);
+assert.strictEqual(result.killed, count);
+assert.strictEqual(nodem.data('^v4wTest', 'killTree', 'sync'), 0);
+
+count = fill('tp');
+
+var killed = 0;
+
+nodem.transaction(function() {
+    killed = nodem.killTree({global: 'v4wTest', subscripts: ['killTree', 'tp'], chunkSize: 10}).killed;
+
+    return 'Rollback';
+});
+
+assert.strictEqual(killed, count);
+assert.strictEqual(nodem.data('^v4wTest', 'killTree', 'tp'), 11);
+assert.strictEqual(nodem.get('^v4wTest', 'killTree', 'tp', 250, 'line'), 'line 250');
+
+result = nodem.killTree({global: 'v4wTest', subscripts: ['killTree', 'tp']});
+
+assert.strictEqual(result.chunkSize, 1000);
+assert.strictEqual(result.killed, count);
+
+[0, -1, 1.5, 'ten'].forEach(function(chunkSize) {
+    assert.throws(function() {
+        nodem.killTree({global: 'v4wTest', subscripts: ['killTree', 'keep'], chunkSize: chunkSize});
+    });
+});
+
+assert.strictEqual(nodem.get('^v4wTest', 'killTree', 'keep'), 'kept');
+
+count = fill('async');
+
+nodem.killTree({global: 'v4wTest', subscripts: ['killTree', 'async'], chunkSize: 50}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.killed, count);
+    assert.strictEqual(nodem.data('^v4wTest', 'killTree', 'async'), 0);
+    assert.strictEqual(nodem.get('^v4wTest', 'killTree', 'keep'), 'kept');
+
+    nodem.kill('^v4wTest', 'killTree');
+
+    console.log('killTree: ok');
+
+    nodem.close();
+    process.exit(0);
+});
+
+// Other calls keep running between the chunks of the asynchronous kill
+assert.strictEqual(nodem.get('^v4wTest', 'killTree', 'keep'), 'kept');
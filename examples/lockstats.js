@@ -0,0 +1,98 @@
+/*
+ * Package:    NodeM
+ * File:       lockstats.js
+ * Summary:    Test the lockStats API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Lock ^v4wTest("lock",1) and ^v4wTest("lock",2), first in one order and then
+ * in the other, and check the acquisitions, holders, and lock-order inversion
+ * that lockStats reports, and that a reset keeps the current holders.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+var first = '^v4wTest("lock",1)';
+var second = '^v4wTest("lock",2)';
+
+function resource(stats, name) {
+    return stats.resources.filter(function(entry) {
+        return entry.resource === name;
+    })[0];
+}
+
+nodem.lockStats({reset: true});
+
+assert.strictEqual(nodem.lock({global: 'v4wTest', subscripts: ['lock', 1], timeout: 0}).result, true);
+assert.strictEqual(nodem.lock({global: 'v4wTest', subscripts: ['lock', 2], timeout: 0}).result, true);
+
+var stats = nodem.lockStats();
+
+assert.strictEqual(stats.ok, true);
+assert.strictEqual(resource(stats, first).acquisitions, 1);
+assert.strictEqual(resource(stats, first).timeouts, 0);
+assert.strictEqual(resource(stats, first).holders.length, 1);
+assert.strictEqual(resource(stats, first).holders[0].count, 1);
+assert.strictEqual(stats.inversions.length, 0);
+
+nodem.unlock({global: 'v4wTest', subscripts: ['lock', 2]});
+nodem.unlock({global: 'v4wTest', subscripts: ['lock', 1]});
+
+stats = nodem.lockStats();
+
+assert.strictEqual(resource(stats, first).holders.length, 0);
+assert.strictEqual(resource(stats, second).holders.length, 0);
+
+assert.strictEqual(nodem.lock({global: 'v4wTest', subscripts: ['lock', 2], timeout: 0}).result, true);
+assert.strictEqual(nodem.lock({global: 'v4wTest', subscripts: ['lock', 1], timeout: 0}).result, true);
+
+stats = nodem.lockStats({reset: true});
+
+assert.strictEqual(resource(stats, first).acquisitions, 2);
+assert.strictEqual(stats.inversions.length, 1);
+assert.strictEqual(stats.inversions[0].count, 1);
+assert.deepStrictEqual([stats.inversions[0].first, stats.inversions[0].second].sort(), [first, second]);
+
+stats = nodem.lockStats();
+
+assert.strictEqual(resource(stats, first).acquisitions, 0);
+assert.strictEqual(resource(stats, first).holders.length, 1);
+assert.strictEqual(stats.inversions.length, 0);
+
+nodem.unlock();
+
+assert.strictEqual(resource(nodem.lockStats(), first).holders.length, 0);
+assert.throws(function() {
+    nodem.lockStats('reset');
+}, TypeError);
+
+console.log('lockStats: ok');
+
+nodem.close();
+process.exit(0);
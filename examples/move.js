@@ -0,0 +1,180 @@
+/*
+ * Package:    NodeM
+ * File:       move.js
+ * Summary:    Test the move API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Move trees within ^v4wTest("move"), atomically and in chunks, and from a
+ * local, checking that every node arrives in the target with its value, that
+ * the source is killed, that a move to a tree with data or in to a descendant
+ * is refused without changing either tree, and that a rollback undoes a move.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The move API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'move') !== 0) {
+    console.error('^v4wTest("move") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+// Fill a tree with one node for the root, and three for each order line, returning how many nodes have values
+function fill(subscripts, lines) {
+    nodem.set({global: 'v4wTest', subscripts: subscripts, data: 'order'});
+
+    for (var i = 1; i <= lines; i++) {
+        nodem.set({global: 'v4wTest', subscripts: subscripts.concat(['line', i]), data: 'item ' + i});
+        nodem.set({global: 'v4wTest', subscripts: subscripts.concat(['line', i, 'qty']), data: i});
+        nodem.set({global: 'v4wTest', subscripts: subscripts.concat(['line', i, 'price']), data: i + 0.25});
+    }
+
+    return 1 + lines * 3;
+}
+
+function check(subscripts, lines) {
+    assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: subscripts}).data, 'order');
+
+    for (var i = 1; i <= lines; i++) {
+        assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: subscripts.concat(['line', i])}).data, 'item ' + i);
+        assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: subscripts.concat(['line', i, 'qty'])}).data, i);
+        assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: subscripts.concat(['line', i, 'price'])}).data, i + 0.25);
+    }
+
+    assert.strictEqual(nodem.order({global: 'v4wTest', subscripts: subscripts.concat(['line', ''])}).result, 1);
+    assert.strictEqual(nodem.previous({global: 'v4wTest', subscripts: subscripts.concat(['line', ''])}).result, lines);
+}
+
+var count = fill(['move', 'order', 42], 5);
+var result = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 42]},
+  to: {global: 'v4wTest', subscripts: ['move', 'archive', 42]}});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.chunked, false);
+assert.strictEqual(result.chunkSize, 1000);
+assert.strictEqual(result.moved, count);
+assert.strictEqual(result.chunks, 1);
+assert.strictEqual(nodem.data('^v4wTest', 'move', 'order', 42), 0);
+check(['move', 'archive', 42], 5);
+
+// A move to a tree that has data, or in to its own descendant, is refused
+fill(['move', 'order', 42], 2);
+
+result = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 42]},
+  to: {global: 'v4wTest', subscripts: ['move', 'archive', 42]}});
+
+assert.strictEqual(result.ok, false);
+assert.ok(/already has data/.test(result.errorMessage));
+check(['move', 'order', 42], 2);
+check(['move', 'archive', 42], 5);
+
+result = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 42]},
+  to: {global: 'v4wTest', subscripts: ['move', 'order', 42, 'copy']}});
+
+assert.strictEqual(result.ok, false);
+assert.ok(/MERGEDESC/.test(result.errorMessage));
+check(['move', 'order', 42], 2);
+
+// A move inside a transaction is rolled back with it
+var moved = 0;
+
+nodem.transaction(function() {
+    moved = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 42]},
+      to: {global: 'v4wTest', subscripts: ['move', 'archive', 43]}}).moved;
+
+    return 'Rollback';
+});
+
+assert.strictEqual(moved, 7);
+check(['move', 'order', 42], 2);
+assert.strictEqual(nodem.data('^v4wTest', 'move', 'archive', 43), 0);
+
+// A tree larger than the chunk size is copied in chunks, and then cut over
+count = fill(['move', 'log', 2023], 1000);
+
+result = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'log', 2023]},
+  to: {global: 'v4wTest', subscripts: ['move', 'archive', 'log', 2023]}, chunked: true, chunkSize: 500});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.chunked, true);
+assert.strictEqual(result.moved, count);
+assert.ok(result.chunks > 1);
+assert.strictEqual(nodem.data('^v4wTest', 'move', 'log', 2023), 0);
+check(['move', 'archive', 'log', 2023], 1000);
+
+result = nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 42]},
+  to: {global: 'v4wTest', subscripts: ['move', 'archive', 44]}, chunked: true, chunkSize: 500});
+
+assert.strictEqual(result.moved, 7);
+assert.strictEqual(result.chunks, 1);
+check(['move', 'archive', 44], 2);
+
+nodem.set({local: 'moveSource', subscripts: [1], data: 'one'});
+nodem.set({local: 'moveSource', subscripts: [2, 'a'], data: 'two'});
+
+result = nodem.move({from: {local: 'moveSource'}, to: {global: 'v4wTest', subscripts: ['move', 'local']}});
+
+assert.strictEqual(result.moved, 2);
+assert.strictEqual(nodem.get('^v4wTest', 'move', 'local', 2, 'a'), 'two');
+assert.deepStrictEqual(nodem.localDirectory(), []);
+
+[0, -1, 1.5, 'ten'].forEach(function(chunkSize) {
+    assert.throws(function() {
+        nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'local']},
+          to: {global: 'v4wTest', subscripts: ['move', 'other']}, chunked: true, chunkSize: chunkSize});
+    }, TypeError);
+});
+
+assert.throws(function() {
+    nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'local']}});
+}, SyntaxError);
+
+count = fill(['move', 'order', 45], 400);
+
+nodem.move({from: {global: 'v4wTest', subscripts: ['move', 'order', 45]},
+  to: {global: 'v4wTest', subscripts: ['move', 'archive', 45]}, chunked: true, chunkSize: 100}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.moved, count);
+    assert.ok(result.chunks > 1);
+    assert.strictEqual(nodem.data('^v4wTest', 'move', 'order', 45), 0);
+    check(['move', 'archive', 45], 400);
+
+    nodem.kill('^v4wTest', 'move');
+
+    console.log('move: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,125 @@
+/*
+ * Package:    NodeM
+ * File:       packed.js
+ * Summary:    Test packed results
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Read ^v4wTest("packed") with scan and readConsistent, with and without
+ * packed: true, and check that the Packed class decodes every result to the
+ * same value as the unpacked call returns, in order and out of order, and that
+ * it rejects a Buffer that does not hold packed results.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var Packed = require('../lib/nodem.js').Packed;
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('Packed results are only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'packed') !== 0) {
+    console.error('^v4wTest("packed") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i;
+
+for (i = 1; i <= 50; i++) nodem.set('^v4wTest', 'packed', 'user' + (1000 + i), 'name ' + i);
+
+nodem.set('^v4wTest', 'packed', 'user1007', 'email', 'user7@example.com');
+nodem.set('^v4wTest', 'packed', 'number', -12.5);
+nodem.set('^v4wTest', 'packed', 'unicode', 'café 中文');
+nodem.set('^v4wTest', 'packed', 'parent', 'child', 1);
+
+var options = {global: 'v4wTest', subscripts: ['packed'], limit: 30};
+var plain = nodem.scan(options);
+var page = nodem.scan(Object.assign({packed: true}, options));
+
+assert.ok(Buffer.isBuffer(page.results));
+assert.strictEqual(page.token, plain.token);
+
+var results = new Packed(page.results);
+
+assert.strictEqual(results.length, plain.results.length);
+assert.deepStrictEqual(results.toArray(), plain.results);
+assert.deepStrictEqual(results.get(17), plain.results[17]);
+assert.deepStrictEqual(results.get(3), plain.results[3]);
+assert.strictEqual(results.get(results.length), undefined);
+
+var seen = 0;
+
+results.forEach(function(result, index) {
+    assert.deepStrictEqual(result, plain.results[index]);
+    seen++;
+});
+
+assert.strictEqual(seen, plain.results.length);
+
+if (typeof Symbol === 'function' && Symbol.iterator) {
+    seen = 0;
+
+    for (var result of results) assert.deepStrictEqual(result, plain.results[seen++]);
+
+    assert.strictEqual(seen, plain.results.length);
+}
+
+plain = nodem.scan({global: 'v4wTest', subscripts: ['packed'], limit: 30, token: plain.token});
+page = nodem.scan({global: 'v4wTest', subscripts: ['packed'], limit: 30, token: page.token, packed: true});
+
+assert.deepStrictEqual(new Packed(page.results).toArray(), plain.results);
+
+var nodes = [
+    {global: 'v4wTest', subscripts: ['packed', 'user1001']},
+    {global: 'v4wTest', subscripts: ['packed', 'user1007', 'email']},
+    {global: 'v4wTest', subscripts: ['packed', 'missing']},
+    {global: 'v4wTest', subscripts: ['packed', 'number']},
+    {global: 'v4wTest', subscripts: ['packed', 'unicode']}
+];
+
+var consistent = nodem.readConsistent(nodes);
+var packed = nodem.readConsistent(nodes, {packed: true});
+
+assert.ok(Buffer.isBuffer(packed.results));
+assert.deepStrictEqual(new Packed(packed.results).toArray(), consistent.results);
+assert.strictEqual(new Packed(packed.results).get(4).data, 'café 中文');
+
+assert.throws(function() {
+    return new Packed(Buffer.from('not packed results'));
+}, TypeError);
+
+nodem.kill('^v4wTest', 'packed');
+
+console.log('packed: ok');
+
+nodem.close();
+process.exit(0);
@@ -0,0 +1,161 @@
+/*
+ * Package:    NodeM
+ * File:       prune.js
+ * Summary:    Test the prune API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Prune log days and expired sessions from ^v4wTest("prune"), in chunks and in
+ * limited passes resumed with a token, checking that exactly the matching nodes
+ * are killed along with their subtrees, that the counts are right, and that a
+ * prune inside a transaction is rolled back with it.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The prune API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'prune') !== 0) {
+    console.error('^v4wTest("prune") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i, j;
+
+for (i = 1; i <= 30; i++) {
+    for (j = 1; j <= 3; j++) nodem.set('^v4wTest', 'prune', 'log', i, j, 'entry ' + j);
+}
+
+var result = nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'subscript < 11', chunkSize: 7});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.level, 3);
+assert.strictEqual(result.chunkSize, 7);
+assert.strictEqual(result.scanned, 30);
+assert.strictEqual(result.pruned, 10);
+assert.ok(result.chunks >= 5);
+assert.strictEqual(result.token, null);
+assert.strictEqual(nodem.order('^v4wTest', 'prune', 'log', ''), 11);
+assert.strictEqual(nodem.data('^v4wTest', 'prune', 'log', 10, 1), 0);
+assert.strictEqual(nodem.get('^v4wTest', 'prune', 'log', 11, 1), 'entry 1');
+
+// A prune inside a transaction is rolled back with it
+var pruned = 0;
+
+nodem.transaction(function() {
+    pruned = nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'subscript <= 30'}).pruned;
+
+    return 'Rollback';
+});
+
+assert.strictEqual(pruned, 20);
+assert.strictEqual(nodem.data('^v4wTest', 'prune', 'log', 30), 10);
+
+for (i = 1; i <= 20; i++) {
+    for (j = 1; j <= 5; j++) nodem.set('^v4wTest', 'prune', 'session', i, j, j % 2 ? 20240301 : 20240901);
+}
+
+nodem.set('^v4wTest', 'prune', 'session', 21, 1, 20240101);
+nodem.set('^v4wTest', 'prune', 'session', 21, 3, 20240102);
+
+var token = null;
+var scanned = 0;
+var passes = 0;
+
+pruned = 0;
+
+do {
+    result = nodem.prune({global: 'v4wTest', subscripts: ['prune', 'session'], level: 4, where: 'value < 20240601',
+      limit: 10, token: token});
+
+    assert.strictEqual(result.level, 4);
+
+    scanned += result.scanned;
+    pruned += result.pruned;
+    token = result.token;
+    passes++;
+} while (token);
+
+assert.strictEqual(scanned, 102);
+assert.strictEqual(pruned, 62);
+assert.ok(passes > 10);
+assert.strictEqual(nodem.data('^v4wTest', 'prune', 'session', 21), 0);
+assert.strictEqual(nodem.order('^v4wTest', 'prune', 'session', 7, ''), 2);
+assert.strictEqual(nodem.order('^v4wTest', 'prune', 'session', 7, 2), 4);
+assert.strictEqual(nodem.order('^v4wTest', 'prune', 'session', 7, 4), '');
+
+result = nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'subscript > 0', limit: 5});
+
+assert.notStrictEqual(result.token, null);
+
+assert.throws(function() {
+    nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'subscript > 1', token: result.token});
+}, TypeError);
+
+assert.throws(function() {
+    nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], level: 2, where: 'subscript > 0'});
+}, TypeError);
+
+[0, -1, 1.5, 'ten'].forEach(function(chunkSize) {
+    assert.throws(function() {
+        nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'subscript > 0', chunkSize: chunkSize});
+    }, TypeError);
+});
+
+assert.throws(function() {
+    nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log'], where: 'value ='});
+}, SyntaxError);
+
+assert.throws(function() {
+    nodem.prune({global: 'v4wTest', subscripts: ['prune', 'log']});
+}, SyntaxError);
+
+for (i = 1; i <= 10; i++) nodem.set({local: 'prune', subscripts: [i], data: i % 3});
+
+result = nodem.prune({local: 'prune', where: 'value = 0'});
+
+assert.strictEqual(result.pruned, 3);
+assert.deepStrictEqual(nodem.localDirectory(), ['prune']);
+assert.strictEqual(nodem.data({local: 'prune', subscripts: [3]}).defined, 0);
+
+nodem.prune({global: 'v4wTest', subscripts: ['prune'], level: 3, where: 'subscript >= 1'}, function(error, result) {
+    assert.ifError(error);
+    assert.strictEqual(result.pruned, 20 + 20);
+    assert.strictEqual(nodem.data('^v4wTest', 'prune'), 0);
+
+    console.log('prune: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,135 @@
+/*
+ * Package:    NodeM
+ * File:       readahead.js
+ * Summary:    Test read-ahead for order and previous loops
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Walk ^v4wTest("readAhead") with order and previous loops, nested loops, and
+ * get calls, with read-ahead windows smaller than the level, checking that
+ * each loop returns what it does without read-ahead, that writes made during a
+ * loop are seen, and that invalid options are rejected.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('Read-ahead is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'readAhead') !== 0) {
+    console.error('^v4wTest("readAhead") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i, j;
+
+for (i = 1; i <= 100; i++) {
+    nodem.set('^v4wTest', 'readAhead', i, 'value ' + i);
+
+    for (j = 1; j <= 5; j++) nodem.set('^v4wTest', 'readAhead', i, 'line', j, i * j);
+}
+
+function walk(reverse, values) {
+    var api = reverse ? nodem.previous : nodem.order;
+    var subscript = '';
+    var seen = [];
+
+    while ((subscript = api.call(nodem, {global: 'v4wTest', subscripts: ['readAhead', subscript]}).result) !== '') {
+        var node = {subscript: subscript};
+
+        if (values) node.data = nodem.get({global: 'v4wTest', subscripts: ['readAhead', subscript]}).data;
+
+        var line = '';
+        var total = 0;
+
+        while ((line = nodem.order({global: 'v4wTest', subscripts: ['readAhead', subscript, 'line', line]}).result) !== '') {
+            total += nodem.get({global: 'v4wTest', subscripts: ['readAhead', subscript, 'line', line]}).data;
+        }
+
+        node.total = total;
+        seen.push(node);
+    }
+
+    return seen;
+}
+
+var forward = walk(false, true);
+var backward = walk(true, true);
+
+assert.strictEqual(forward.length, 100);
+assert.deepStrictEqual(forward[41], {subscript: 42, data: 'value 42', total: 42 * 15});
+
+[true, 8, {window: 7, values: true}, {window: 1}].forEach(function(readAhead) {
+    nodem.configure({readAhead: readAhead});
+
+    assert.deepStrictEqual(walk(false, true), forward);
+    assert.deepStrictEqual(walk(true, true), backward);
+    assert.deepStrictEqual(walk(false, false), forward.map(function(node) {
+        return {subscript: node.subscript, total: node.total};
+    }));
+});
+
+// Writes made during a loop are seen by the calls that follow them
+nodem.configure({readAhead: {window: 16, values: true}});
+
+var seen = [];
+var subscript = '';
+
+while ((subscript = nodem.order({global: 'v4wTest', subscripts: ['readAhead', subscript]}).result) !== '') {
+    seen.push(subscript);
+
+    if (subscript === 10) {
+        nodem.set('^v4wTest', 'readAhead', 10.5, 'added');
+        nodem.kill('^v4wTest', 'readAhead', 12);
+        nodem.set('^v4wTest', 'readAhead', 11, 'changed');
+    }
+
+    if (subscript === 11) assert.strictEqual(nodem.get('^v4wTest', 'readAhead', 11), 'changed');
+}
+
+assert.deepStrictEqual(seen.slice(9, 13), [10, 10.5, 11, 13]);
+assert.strictEqual(seen.length, 100);
+
+[0, -1, 2.5, {window: 0}, {window: 'big'}].forEach(function(readAhead) {
+    assert.throws(function() {
+        nodem.configure({readAhead: readAhead});
+    }, TypeError);
+});
+
+nodem.configure({readAhead: false});
+nodem.kill('^v4wTest', 'readAhead');
+
+console.log('readAhead: ok');
+
+nodem.close();
+process.exit(0);
@@ -0,0 +1,110 @@
+/*
+ * Package:    NodeM
+ * File:       readconsistent.js
+ * Summary:    Test the readConsistent API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Read several nodes of ^v4wTest("readConsistent"), a local variable, and a
+ * node named with an extended reference, in one call, synchronously, inside a
+ * transaction, and asynchronously, checking that each value is returned in the
+ * order asked for, and that a node without a value is not an error.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The readConsistent API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'readConsistent') !== 0) {
+    console.error('^v4wTest("readConsistent") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var gld = nodem.get({local: '$zgbldir'}).data;
+
+nodem.set('^v4wTest', 'readConsistent', 'account', 42, 'balance', 1250);
+nodem.set('^v4wTest', 'readConsistent', 'ledger', 42, 'entries', 3);
+nodem.set({local: 'readConsistent', subscripts: ['session'], data: 'open'});
+
+var nodes = [
+    {global: 'v4wTest', subscripts: ['readConsistent', 'account', 42, 'balance']},
+    {global: 'v4wTest', subscripts: ['readConsistent', 'ledger', 42]},
+    {local: 'readConsistent', subscripts: ['session']},
+    {global: '^|"' + gld + '"|v4wTest', subscripts: ['readConsistent', 'ledger', 42, 'entries']}
+];
+
+function check(results, balance) {
+    assert.strictEqual(results.length, 4);
+    assert.deepStrictEqual(results[0].subscripts, ['readConsistent', 'account', 42, 'balance']);
+    assert.strictEqual(results[0].data, balance);
+    assert.strictEqual(results[0].defined, true);
+    assert.strictEqual(results[1].data, '');
+    assert.strictEqual(results[1].defined, false);
+    assert.strictEqual(results[2].local, 'readConsistent');
+    assert.strictEqual(results[2].data, 'open');
+    assert.strictEqual(results[3].data, 3);
+}
+
+var result = nodem.readConsistent(nodes);
+
+assert.strictEqual(result.ok, true);
+check(result.results, 1250);
+
+nodem.transaction(function() {
+    nodem.set('^v4wTest', 'readConsistent', 'account', 42, 'balance', 1000);
+    result = nodem.readConsistent(nodes);
+
+    return 'Rollback';
+});
+
+assert.strictEqual(result.ok, true);
+check(result.results, 1000);
+check(nodem.readConsistent(nodes).results, 1250);
+
+assert.throws(function() {
+    nodem.readConsistent([{global: 'v4wTest', subscripts: ['readConsistent']}, 'account']);
+}, TypeError);
+
+nodem.readConsistent(nodes, function(error, result) {
+    assert.ifError(error);
+    check(result.results, 1250);
+
+    nodem.kill('^v4wTest', 'readConsistent');
+    nodem.kill({local: 'readConsistent'});
+
+    console.log('readConsistent: ok');
+
+    nodem.close();
+    process.exit(0);
+});
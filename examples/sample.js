@@ -0,0 +1,135 @@
+/*
+ * Package:    NodeM
+ * File:       sample.js
+ * Summary:    Test the sample API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Sample ^v4wTest("sample") by reservoir and by random descent, checking that
+ * each sample holds distinct nodes with values from the subtree, with their
+ * full subscripts and data, that the reservoir counts the nodes and can choose
+ * any of them, and that a sample larger than the subtree returns every node.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The sample API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'sample') !== 0) {
+    console.error('^v4wTest("sample") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i;
+
+for (i = 1; i <= 80; i++) nodem.set('^v4wTest', 'sample', 'order', i, 'total', i * 10);
+for (i = 1; i <= 19; i++) nodem.set('^v4wTest', 'sample', 'order', i, 'line', 1, 'item ' + i);
+
+nodem.set('^v4wTest', 'sample', 'order', 'header');
+nodem.set('^v4wTest', 'sample', 'small', 'a', 1);
+nodem.set('^v4wTest', 'sample', 'small', 'b', 2);
+nodem.set('^v4wTest', 'sample', 'small', 'c', 3);
+
+function check(result, root, n) {
+    var keys = {};
+
+    assert.strictEqual(result.ok, true);
+    assert.ok(result.results.length <= n);
+
+    result.results.forEach(function(node) {
+        var key = JSON.stringify(node.subscripts);
+
+        assert.deepStrictEqual(node.subscripts.slice(0, root.length), root);
+        assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: node.subscripts}).data, node.data);
+        assert.strictEqual(keys[key], undefined);
+
+        keys[key] = true;
+    });
+}
+
+var result = nodem.sample({global: 'v4wTest', subscripts: ['sample', 'order'], n: 10});
+
+check(result, ['sample', 'order'], 10);
+assert.strictEqual(result.method, 'reservoir');
+assert.strictEqual(result.count, 100);
+assert.strictEqual(result.results.length, 10);
+
+result = nodem.sample({global: 'v4wTest', subscripts: ['sample', 'small'], n: 50});
+
+check(result, ['sample', 'small'], 50);
+assert.strictEqual(result.count, 3);
+assert.strictEqual(result.results.length, 3);
+
+// Every node has the same chance of being chosen
+var chosen = {};
+
+for (i = 0; i < 200; i++) {
+    chosen[nodem.sample({global: 'v4wTest', subscripts: ['sample', 'small'], n: 1}).results[0].subscripts[2]] = true;
+}
+
+assert.deepStrictEqual(Object.keys(chosen).sort(), ['a', 'b', 'c']);
+
+result = nodem.sample({global: 'v4wTest', subscripts: ['sample', 'order'], n: 10, method: 'descent'});
+
+check(result, ['sample', 'order'], 10);
+assert.strictEqual(result.method, 'descent');
+assert.ok(result.results.length > 0);
+
+check(nodem.sample({global: 'v4wTest', subscripts: ['sample', 'small'], n: 5, method: 'descent'}), ['sample', 'small'], 5);
+
+assert.strictEqual(nodem.sample({global: 'v4wTest', subscripts: ['sample', 'none']}).results.length, 0);
+
+[0, -1, 1.5, 'ten'].forEach(function(n) {
+    assert.throws(function() {
+        nodem.sample({global: 'v4wTest', subscripts: ['sample'], n: n});
+    }, TypeError);
+});
+
+assert.throws(function() {
+    nodem.sample({global: 'v4wTest', subscripts: ['sample'], method: 'random'});
+}, TypeError);
+
+nodem.sample({global: 'v4wTest', subscripts: ['sample']}, function(error, result) {
+    assert.ifError(error);
+    check(result, ['sample'], 10);
+    assert.strictEqual(result.results.length, 10);
+    assert.strictEqual(result.count, 103);
+
+    nodem.kill('^v4wTest', 'sample');
+
+    console.log('sample: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,141 @@
+/*
+ * Package:    NodeM
+ * File:       scan.js
+ * Summary:    Test the scan API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Page through ^v4wTest("scan") forwards and in reverse, synchronously and
+ * asynchronously, checking that every subscript is returned once, in order,
+ * with its defined status and data, that a node set between pages is seen, and
+ * that a token from a different scan is rejected.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The scan API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'scan') !== 0) {
+    console.error('^v4wTest("scan") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var i;
+
+for (i = 1; i <= 25; i++) nodem.set('^v4wTest', 'scan', i, 'record ' + i);
+
+nodem.set('^v4wTest', 'scan', 7, 'child', 'below');
+nodem.set('^v4wTest', 'scan', 'name', 'child', 'only');
+
+function scanAll(reverse) {
+    var results = [];
+    var pages = 0;
+    var page = {token: null};
+
+    do {
+        page = nodem.scan({global: 'v4wTest', subscripts: ['scan'], limit: 10, reverse: reverse, token: page.token});
+
+        assert.strictEqual(page.ok, true);
+        assert.ok(page.results.length <= 10);
+
+        results = results.concat(page.results);
+        pages++;
+    } while (page.token !== null);
+
+    return {results: results, pages: pages};
+}
+
+var forward = scanAll(false);
+
+assert.strictEqual(forward.results.length, 26);
+assert.ok(forward.pages >= 3);
+
+for (i = 0; i < 25; i++) assert.strictEqual(forward.results[i].subscript, i + 1);
+
+assert.deepStrictEqual(forward.results[0], {subscript: 1, defined: 1, data: 'record 1'});
+assert.deepStrictEqual(forward.results[6], {subscript: 7, defined: 11, data: 'record 7'});
+assert.deepStrictEqual(forward.results[25], {subscript: 'name', defined: 10});
+
+var backward = scanAll(true);
+
+assert.deepStrictEqual(backward.results.map(function(result) {
+    return result.subscript;
+}), forward.results.map(function(result) {
+    return result.subscript;
+}).reverse());
+
+var page = nodem.scan({global: 'v4wTest', subscripts: ['scan'], limit: 5});
+
+assert.strictEqual(page.results[4].subscript, 5);
+assert.strictEqual(typeof page.token, 'string');
+
+nodem.set('^v4wTest', 'scan', 5.5, 'between');
+nodem.kill('^v4wTest', 'scan', 6);
+
+page = nodem.scan({global: 'v4wTest', subscripts: ['scan'], limit: 2, token: page.token});
+
+assert.deepStrictEqual(page.results.map(function(result) {
+    return result.subscript;
+}), [5.5, 7]);
+
+assert.throws(function() {
+    nodem.scan({global: 'v4wTest', subscripts: ['other'], token: page.token});
+}, TypeError);
+
+assert.throws(function() {
+    nodem.scan({global: 'v4wTest', subscripts: ['scan'], reverse: true, token: page.token});
+}, TypeError);
+
+nodem.set({local: 'scan', subscripts: ['a'], data: 1});
+nodem.set({local: 'scan', subscripts: ['b'], data: 2});
+
+page = nodem.scan({local: 'scan'});
+
+assert.strictEqual(page.local, 'scan');
+assert.deepStrictEqual(page.results, [{subscript: 'a', defined: 1, data: 1}, {subscript: 'b', defined: 1, data: 2}]);
+assert.strictEqual(page.token, null);
+
+nodem.scan({global: 'v4wTest', subscripts: ['scan'], limit: 3}, function(error, result) {
+    assert.ifError(error);
+    assert.deepStrictEqual(result.results.map(function(result) {
+        return result.subscript;
+    }), [1, 2, 3]);
+
+    nodem.kill('^v4wTest', 'scan');
+
+    console.log('scan: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,121 @@
+/*
+ * Package:    NodeM
+ * File:       shard.js
+ * Summary:    Test the shardedGlobal API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Shard ^v4wTest on its second subscript, across two shards that both use the
+ * current global directory, and check that the routed APIs, and the order and
+ * node APIs that merge every shard's answers, see ^v4wTest("shard") as one
+ * global, that $zgbldir is left as it was, and that the definition is shown and
+ * removed.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The shardedGlobal API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'shard') !== 0) {
+    console.error('^v4wTest("shard") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+var gld = nodem.get({local: '$zgbldir'}).data;
+
+var result = nodem.shardedGlobal({name: 'v4wTest', shards: [{gld: gld, region: 'A'}, {gld: gld, region: 'B'}],
+  keyLevel: 2, hash: 'modulo'});
+
+assert.strictEqual(result.ok, true);
+assert.strictEqual(result.name, 'v4wTest');
+assert.strictEqual(result.shards.length, 2);
+assert.strictEqual(result.shards[1].region, 'B');
+assert.strictEqual(result.keyLevel, 2);
+assert.strictEqual(result.hash, 'modulo');
+
+var i;
+
+for (i = 1; i <= 10; i++) nodem.set({global: 'v4wTest', subscripts: ['shard', i, 'x'], data: 'node ' + i});
+
+for (i = 1; i <= 10; i++) {
+    assert.strictEqual(nodem.get({global: 'v4wTest', subscripts: ['shard', i, 'x']}).data, 'node ' + i);
+}
+
+assert.strictEqual(nodem.increment({global: 'v4wTest', subscripts: ['shard', 4, 'count'], increment: 2}).data, 2);
+assert.strictEqual(nodem.data({global: 'v4wTest', subscripts: ['shard']}).defined, 10);
+
+var subscript = '';
+var seen = [];
+
+while ((subscript = nodem.order({global: 'v4wTest', subscripts: ['shard', subscript]}).result) !== '') {
+    seen.push(subscript);
+}
+
+assert.deepStrictEqual(seen, [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]);
+assert.strictEqual(nodem.previous({global: 'v4wTest', subscripts: ['shard', '']}).result, 10);
+assert.deepStrictEqual(nodem.nextNode({global: 'v4wTest', subscripts: ['shard']}).subscripts, ['shard', 1, 'x']);
+assert.deepStrictEqual(nodem.previousNode({global: 'v4wTest', subscripts: ['shard', 5, 'x']}).subscripts,
+  ['shard', 4, 'x']);
+
+assert.strictEqual(nodem.lock({global: 'v4wTest', subscripts: ['shard', 7], timeout: 0}).result, true);
+assert.strictEqual(nodem.unlock({global: 'v4wTest', subscripts: ['shard', 7]}).ok, true);
+
+nodem.kill({global: 'v4wTest', subscripts: ['shard', 3]});
+
+assert.strictEqual(nodem.data({global: 'v4wTest', subscripts: ['shard', 3]}).defined, 0);
+assert.strictEqual(nodem.order({global: 'v4wTest', subscripts: ['shard', 2]}).result, 4);
+assert.strictEqual(nodem.get({local: '$zgbldir'}).data, gld);
+
+result = nodem.shardedGlobal({name: 'v4wTest'});
+
+assert.strictEqual(result.shards.length, 2);
+assert.strictEqual(result.keyLevel, 2);
+
+assert.throws(function() {
+    nodem.shardedGlobal({name: 'v4wTest', shards: [{gld: gld}], keyLevel: 0});
+}, RangeError);
+
+assert.throws(function() {
+    nodem.shardedGlobal({name: 'v4wTest', shards: [{gld: gld}], hash: 'md5'});
+}, TypeError);
+
+nodem.kill('^v4wTest', 'shard');
+
+assert.strictEqual(nodem.data('^v4wTest', 'shard'), 0);
+assert.strictEqual(nodem.shardedGlobal({name: 'v4wTest', shards: []}).shards.length, 0);
+
+console.log('shardedGlobal: ok');
+
+nodem.close();
+process.exit(0);
@@ -0,0 +1,97 @@
+/*
+ * Package:    NodeM
+ * File:       simpleapi.js
+ * Summary:    Test running the SimpleAPI without the Call-in interface
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Run the open, set, merge, version, globalDirectory, localDirectory, and kill
+ * APIs on ^v4wTest("simple") in a child process whose Call-in table does not
+ * exist, so that any use of the Call-in interface would fail, and check that a
+ * merge of a tree in to its own descendant is refused.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    if (nodem) nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem;
+
+if (process.argv[2] === 'child') {
+    nodem = require('../lib/nodem.js').Gtm();
+    nodem.open();
+
+    if (nodem.data('^v4wTest', 'simple') !== 0) {
+        console.error('^v4wTest("simple") already contains data, aborting...');
+        nodem.close();
+        process.exit(1);
+    }
+
+    assert.ok(/YottaDB/.test(nodem.version()));
+
+    nodem.set('^v4wTest', 'simple', 'from', 1, 'one');
+    nodem.set('^v4wTest', 'simple', 'from', 2, 'a', 'two');
+    nodem.set({local: 'simple', subscripts: [1], data: 'local'});
+
+    var result = nodem.merge({from: {global: 'v4wTest', subscripts: ['simple', 'from']},
+      to: {global: 'v4wTest', subscripts: ['simple', 'to']}});
+
+    assert.strictEqual(result.ok, true);
+    assert.strictEqual(nodem.get('^v4wTest', 'simple', 'to', 1), 'one');
+    assert.strictEqual(nodem.get('^v4wTest', 'simple', 'to', 2, 'a'), 'two');
+    assert.strictEqual(nodem.data('^v4wTest', 'simple', 'from'), 10);
+
+    result = nodem.merge({from: {global: 'v4wTest', subscripts: ['simple', 'from']},
+      to: {global: 'v4wTest', subscripts: ['simple', 'from', 3]}});
+
+    assert.strictEqual(result.ok, false);
+    assert.ok(/MERGEDESC/.test(result.errorMessage));
+    assert.strictEqual(nodem.data('^v4wTest', 'simple', 'from', 3), 0);
+
+    result = nodem.merge({from: {local: 'simple'}, to: {global: 'v4wTest', subscripts: ['simple', 'local']}});
+
+    assert.strictEqual(result.ok, true);
+    assert.strictEqual(nodem.get('^v4wTest', 'simple', 'local', 1), 'local');
+
+    assert.notStrictEqual(nodem.globalDirectory().indexOf('v4wTest'), -1);
+    assert.deepStrictEqual(nodem.localDirectory(), ['simple']);
+
+    nodem.kill('^v4wTest', 'simple');
+    nodem.kill();
+
+    assert.deepStrictEqual(nodem.localDirectory(), []);
+
+    nodem.close();
+    process.exit(0);
+} else {
+    var spawnSync = require('child_process').spawnSync;
+
+    var env = Object.assign({}, process.env, {ydb_ci: '/nonexistent/nodem.ci', GTMCI: '/nonexistent/nodem.ci'});
+    var child = spawnSync(process.execPath, [__filename, 'child'], {env: env, stdio: 'inherit'});
+
+    assert.strictEqual(child.status, 0, 'child process failed');
+
+    console.log('SimpleAPI without Call-ins: ok');
+    process.exit(0);
+}
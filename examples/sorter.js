@@ -0,0 +1,117 @@
+/*
+ * Package:    NodeM
+ * File:       sorter.js
+ * Summary:    Test the Sorter class
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Sort pairs with number and string keys, many of them equal, through a loop
+ * and through streams, in batches and pages smaller than the sort, checking
+ * that they come back in M collation order, that equal keys keep the order
+ * they were added in, and that the pairs are killed once they have been read.
+ *
+ * Requires Node.js version 10.0.0 or newer.
+ */
+
+'use strict';
+
+process.on('uncaughtException', (error) => {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+const assert = require('assert');
+const nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The Sorter class is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+const keys = [42, -7.5, 0, 'apple', 'Zebra', 1000, 'apple pie', '10', 3.25, 'b'];
+const pairs = [];
+
+for (let i = 0; i < 5000; i++) pairs.push({key: keys[(i * 7) % keys.length], record: 'record ' + i});
+
+// M collation: canonical numbers first, in numeric order, then strings, in byte order; equal keys keep their order
+function collate(first, second) {
+    const a = (typeof first === 'number') ? first : (String(Number(first)) === first ? Number(first) : first);
+    const b = (typeof second === 'number') ? second : (String(Number(second)) === second ? Number(second) : second);
+
+    if (typeof a === 'number' && typeof b === 'number') return a - b;
+    if (typeof a === 'number') return -1;
+    if (typeof b === 'number') return 1;
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+const expected = pairs.map((pair, index) => ({pair, index})).sort((first, second) => {
+    return collate(first.pair.key, second.pair.key) || first.index - second.index;
+}).map((entry) => entry.pair.record);
+
+const sorter = nodem.sorter({batch: 700, limit: 300});
+
+for (const pair of pairs) sorter.add(pair.key, pair.record);
+
+const records = [];
+let last = null;
+
+for (const {key, record} of sorter) {
+    if (last !== null) assert.ok(collate(last, key) <= 0);
+
+    last = key;
+    records.push(record);
+}
+
+assert.deepStrictEqual(records, expected);
+assert.strictEqual(nodem.data('^v4wSort', process.pid), 0);
+
+assert.throws(() => sorter.add(1, 'closed'), Error);
+
+const streamed = nodem.sorter({batch: 1000, limit: 450});
+const writable = streamed.writable();
+
+writable.on('error', (error) => {
+    throw error;
+});
+
+writable.on('finish', () => {
+    const results = [];
+
+    streamed.readable().on('data', (pair) => {
+        results.push(pair.record);
+    }).on('error', (error) => {
+        throw error;
+    }).on('end', () => {
+        assert.deepStrictEqual(results, expected);
+        assert.strictEqual(nodem.data('^v4wSort', process.pid), 0);
+
+        console.log('Sorter: ok');
+
+        nodem.close();
+        process.exit(0);
+    });
+});
+
+for (const pair of pairs) writable.write(pair);
+
+writable.end();
@@ -0,0 +1,114 @@
+/*
+ * Package:    NodeM
+ * File:       tojson.js
+ * Summary:    Test the toJSON API
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Serialize ^v4wTest("toJSON") in the nested and flat shapes, synchronously and
+ * asynchronously, and check that the text parses to the expected values, with
+ * canonical numbers as numbers and strings escaped, and that an empty subtree
+ * is written as null, or as an empty array.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem = require('../lib/nodem.js').Gtm();
+nodem.open();
+
+if (nodem.version().split(' ')[3].slice(0, -1) !== 'YottaDB') {
+    console.error('The toJSON API is only supported on YottaDB');
+    nodem.close();
+    process.exit(1);
+}
+
+if (nodem.data('^v4wTest', 'toJSON') !== 0) {
+    console.error('^v4wTest("toJSON") already contains data, aborting...');
+    nodem.close();
+    process.exit(1);
+}
+
+nodem.set('^v4wTest', 'toJSON', 'users', 'all users');
+nodem.set('^v4wTest', 'toJSON', 'users', 1, 'Alice');
+nodem.set('^v4wTest', 'toJSON', 'users', 2, 'Bob');
+nodem.set('^v4wTest', 'toJSON', 'users', 2, 'email', 'bob@example.com');
+nodem.set('^v4wTest', 'toJSON', 'users', 3, 'age', 42);
+nodem.set('^v4wTest', 'toJSON', 'users', 'quote', 'say "hi"\\\t/ café');
+
+var nested = {
+    '': 'all users',
+    1: 'Alice',
+    2: {'': 'Bob', email: 'bob@example.com'},
+    3: {age: 42},
+    quote: 'say "hi"\\\t/ café'
+};
+
+var flat = [
+    {subscripts: [], data: 'all users'},
+    {subscripts: [1], data: 'Alice'},
+    {subscripts: [2], data: 'Bob'},
+    {subscripts: [2, 'email'], data: 'bob@example.com'},
+    {subscripts: [3, 'age'], data: 42},
+    {subscripts: ['quote'], data: 'say "hi"\\\t/ café'}
+];
+
+var result = nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'users']});
+
+assert.strictEqual(result.ok, true);
+assert.ok(Buffer.isBuffer(result.json));
+assert.deepStrictEqual(JSON.parse(result.json.toString()), nested);
+
+result = nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'users'], shape: 'flat'});
+
+assert.deepStrictEqual(JSON.parse(result.json.toString()), flat);
+
+result = nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'users', 3]});
+
+assert.strictEqual(result.json.toString(), '{"age":42}');
+assert.strictEqual(nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'none']}).json.toString(), 'null');
+assert.strictEqual(nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'none'], shape: 'flat'}).json.toString(), '[]');
+
+nodem.set({local: 'toJSON', subscripts: ['a'], data: 1});
+nodem.set({local: 'toJSON', subscripts: ['b', 'c'], data: 'd'});
+
+assert.deepStrictEqual(JSON.parse(nodem.toJSON({local: 'toJSON'}).json.toString()), {a: 1, b: {c: 'd'}});
+
+assert.throws(function() {
+    nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON'], shape: 'tree'});
+});
+
+nodem.toJSON({global: 'v4wTest', subscripts: ['toJSON', 'users']}, function(error, result) {
+    assert.ifError(error);
+    assert.deepStrictEqual(JSON.parse(result.json.toString()), nested);
+
+    nodem.kill('^v4wTest', 'toJSON');
+    nodem.kill({local: 'toJSON'});
+
+    console.log('toJSON: ok');
+
+    nodem.close();
+    process.exit(0);
+});
@@ -0,0 +1,97 @@
+/*
+ * Package:    NodeM
+ * File:       trace.js
+ * Summary:    Test the trace events emitted for each phase of an API call
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ *
+ * Run a synchronous and an asynchronous call on ^v4wTest("trace") in a child
+ * process with the nodem trace category enabled, then check that its trace
+ * file has the queue, db, and marshal phases, each naming the global.
+ *
+ * Requires Node.js version 12.0.0 or newer.
+ */
+
+'use strict';
+
+process.on('uncaughtException', function(error) {
+    console.trace('Uncaught Exception:\n', error);
+    if (nodem) nodem.close();
+    process.exit(1);
+});
+
+var assert = require('assert');
+var nodem;
+
+if (process.argv[2] === 'child') {
+    nodem = require('../lib/nodem.js').Gtm();
+    nodem.open();
+
+    if (nodem.data('^v4wTest', 'trace') !== 0) {
+        console.error('^v4wTest("trace") already contains data, aborting...');
+        nodem.close();
+        process.exit(1);
+    }
+
+    nodem.set('^v4wTest', 'trace', 'traced');
+
+    nodem.get({global: 'v4wTest', subscripts: ['trace']}, function(error, result) {
+        assert.ifError(error);
+        assert.strictEqual(result.data, 'traced');
+
+        nodem.kill('^v4wTest', 'trace');
+        nodem.close();
+        process.exit(0);
+    });
+} else {
+    var fs = require('fs');
+    var os = require('os');
+    var path = require('path');
+    var spawnSync = require('child_process').spawnSync;
+
+    var dir = fs.mkdtempSync(path.join(os.tmpdir(), 'nodem-trace-'));
+    var file = path.join(dir, 'trace.json');
+
+    var child = spawnSync(process.execPath, ['--trace-event-categories', 'nodem', '--trace-event-file-pattern', file,
+      __filename, 'child'], {stdio: 'inherit'});
+
+    assert.strictEqual(child.status, 0, 'child process failed');
+
+    var events = JSON.parse(fs.readFileSync(file, 'utf8')).traceEvents.filter(function(event) {
+        return event.cat === 'nodem';
+    });
+
+    fs.unlinkSync(file);
+    fs.rmdirSync(dir);
+
+    ['queue', 'db', 'marshal'].forEach(function(phase) {
+        var phases = events.filter(function(event) {
+            return event.name === phase;
+        });
+
+        assert.ok(phases.length > 0, 'no ' + phase + ' events');
+
+        phases.forEach(function(event) {
+            assert.strictEqual(event.args.global, '^v4wTest');
+        });
+    });
+
+    console.log('trace: ok');
+    process.exit(0);
+}
@@ -48,3 +48,12 @@ try {
         console.info("Try rebuilding Nodem with 'npm run install' in the", dir, 'directory\n');
     }
 }
+
+module.exports.Packed = require('./packed.js');
+module.exports.Sorter = require('./sorter.js');
+
+if (module.exports.Gtm) {
+    module.exports.Gtm.prototype.sorter = function (options) {
+        return new module.exports.Sorter(this, options);
+    };
+}
@@ -0,0 +1,212 @@
+/*
+ * Package:    NodeM
+ * File:       packed.js
+ * Summary:    Lazy decoder for packed scan and readConsistent results
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+'use strict';
+
+var VERSION = 1;
+var HEADER = 12;
+var SCAN = 1;
+var CONSISTENT = 2;
+
+/*
+ * @class Packed
+ * @summary A read-only view of the results packed by scan or readConsistent, which decodes each result only when it is read
+ * @param {Buffer} buffer - The results property returned by scan or readConsistent, when called with packed: true
+ */
+function Packed(buffer) {
+    if (!(this instanceof Packed)) return new Packed(buffer);
+
+    if (!Buffer.isBuffer(buffer) || buffer.length < HEADER || buffer[0] !== 0x4E || buffer[1] !== 0x50) {
+        throw new TypeError('Not a packed Nodem result');
+    }
+
+    if (buffer[2] !== VERSION) throw new TypeError('Unsupported packed result version: ' + buffer[2]);
+
+    this.buffer = buffer;
+    this.kind = buffer[3];
+    this.encoding = (buffer[4] & 1) ? 'utf8' : 'binary';
+    this.length = buffer.readUInt32LE(8);
+
+    this._index = 0;
+    this._offset = HEADER;
+    this._key = [];
+}
+
+/*
+ * @method {private} Packed#_varint
+ * @summary Read an unsigned integer, seven bits per byte, at the cursor
+ * @returns {number} - The integer
+ */
+Packed.prototype._varint = function () {
+    var value = 0;
+    var scale = 1;
+    var byte;
+
+    do {
+        if (this._offset >= this.buffer.length) throw new RangeError('Packed Nodem result is truncated');
+
+        byte = this.buffer[this._offset++];
+        value += (byte & 0x7F) * scale;
+        scale *= 128;
+    } while (byte & 0x80);
+
+    return value;
+};
+
+/*
+ * @method {private} Packed#_part
+ * @summary Read a key part or value at the cursor, as its bytes and whether it is a canonical number
+ * @returns {object} - {bytes, number}
+ */
+Packed.prototype._part = function () {
+    var header = this._varint();
+    var start = this._offset;
+
+    this._offset += Math.floor(header / 2);
+
+    if (this._offset > this.buffer.length) throw new RangeError('Packed Nodem result is truncated');
+
+    return {bytes: this.buffer.slice(start, this._offset), number: (header & 1) === 1};
+};
+
+/*
+ * @method {private} Packed#_decode
+ * @summary Convert a key part or value to a string, or a number in canonical mode
+ * @param {object} part - {bytes, number}
+ * @returns {string|number} - The decoded part or value
+ */
+Packed.prototype._decode = function (part) {
+    var data = part.bytes.toString(this.encoding);
+
+    return part.number ? Number(data) : data;
+};
+
+/*
+ * @method {private} Packed#_next
+ * @summary Decode the result at the cursor, rebuilding its key from the parts it shares with the previous key
+ * @returns {object} - The result, shaped like the unpacked results of the API that packed it
+ */
+Packed.prototype._next = function () {
+    var data = this.buffer[this._offset++];
+    var keepParts = this._varint();
+    var keepBytes = this._varint();
+    var newParts = this._varint();
+    var key = this._key.slice(0, keepParts);
+    var i;
+
+    for (i = 0; i < newParts; i++) {
+        var part = this._part();
+
+        if (i === 0 && keepBytes > 0) {
+            part.bytes = Buffer.concat([this._key[keepParts].bytes.slice(0, keepBytes), part.bytes]);
+        }
+
+        key.push(part);
+    }
+
+    var value = this._part();
+
+    this._key = key;
+    this._index++;
+
+    if (this.kind === SCAN) {
+        var result = {subscript: this._decode(key[0]), defined: data};
+
+        if (data % 10 === 1) result.data = this._decode(value);
+
+        return result;
+    } else if (this.kind === CONSISTENT) {
+        var name = this._decode(key[0]);
+        var node = (name.charAt(0) === '^') ? {global: name.slice(1)} : {local: name};
+
+        if (key.length > 1) node.subscripts = key.slice(1).map(this._decode, this);
+
+        node.data = this._decode(value);
+        node.defined = data !== 0;
+
+        return node;
+    }
+
+    throw new TypeError('Unsupported packed result kind: ' + this.kind);
+};
+
+/*
+ * @method Packed#get
+ * @summary Return one result; reading the results in order is fastest, as each key is rebuilt from the one before it
+ * @param {number} index - Position of the result
+ * @returns {object|undefined} - The result, or undefined if there is no result at that position
+ */
+Packed.prototype.get = function (index) {
+    if (index < 0 || index >= this.length || index !== Math.floor(index)) return undefined;
+
+    if (index < this._index) {
+        this._index = 0;
+        this._offset = HEADER;
+        this._key = [];
+    }
+
+    var result;
+
+    while (this._index <= index) result = this._next();
+
+    return result;
+};
+
+/*
+ * @method Packed#forEach
+ * @summary Call a function with each result, in order
+ * @param {function} callback - Called with the result, its position, and this view
+ * @param {*} [thisArg] - Value to use as this when calling the function
+ * @returns {undefined}
+ */
+Packed.prototype.forEach = function (callback, thisArg) {
+    for (var i = 0; i < this.length; i++) callback.call(thisArg, this.get(i), i, this);
+};
+
+/*
+ * @method Packed#toArray
+ * @summary Decode every result, returning the same array the API returns when it is not packed
+ * @returns {object[]} - The results
+ */
+Packed.prototype.toArray = function () {
+    var results = new Array(this.length);
+
+    for (var i = 0; i < this.length; i++) results[i] = this.get(i);
+
+    return results;
+};
+
+if (typeof Symbol === 'function' && Symbol.iterator) {
+    Packed.prototype[Symbol.iterator] = function () {
+        var self = this;
+        var i = 0;
+
+        return {
+            next: function () {
+                return (i < self.length) ? {value: self.get(i++), done: false} : {value: undefined, done: true};
+            }
+        };
+    };
+}
+
+module.exports = Packed;
@@ -0,0 +1,316 @@
+/*
+ * Package:    NodeM
+ * File:       sorter.js
+ * Summary:    External sort of (key, record) pairs, through a database global
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+'use strict';
+
+var stream = require('stream');
+
+var GLOBAL = 'v4wSort';
+var BATCH = 1000;
+var PAGE = 1000;
+
+var threadId = 0;
+var sorters = 0;
+
+try {
+    threadId = require('worker_threads').threadId;
+} catch {
+    threadId = 0;
+}
+
+/*
+ * @function {private} failure
+ * @summary Turn a failed result, or the error passed to an asynchronous callback, in to an Error
+ * @param {object|Error} error - The failure
+ * @returns {Error} - The error to throw or emit
+ */
+function failure(error) {
+    if (error instanceof Error) return error;
+
+    return new Error((error && error.errorMessage) ? error.errorMessage : String(error));
+}
+
+/*
+ * @function {private} check
+ * @summary Throw when a synchronous API call returns a failure
+ * @param {object} result - The result of the API call
+ * @returns {object} - The same result, when it succeeded
+ */
+function check(result) {
+    if (result && result.ok === false) throw failure(result);
+
+    return result;
+}
+
+/*
+ * @class Sorter
+ * @summary Sort (key, record) pairs that may not fit in memory, by writing them in batches to a global and reading them back in key order
+ * @param {Gtm|Ydb} db - An open Nodem connection
+ * @param {object} [options] - {global <'v4wSort'>, batch <1000>, limit <1000>}
+ */
+function Sorter(db, options) {
+    if (!(this instanceof Sorter)) return new Sorter(db, options);
+
+    options = options || {};
+
+    this.db = db;
+    this.global = options.global || GLOBAL;
+    this.batch = options.batch || BATCH;
+    this.limit = options.limit || PAGE;
+    this.subscripts = [process.pid, threadId, ++sorters];
+    this.count = 0;
+    this.closed = false;
+
+    this._keys = [];
+    this._records = [];
+
+    // The first sorter in a process also removes anything left behind by an earlier process with the same pid
+    check(db.kill({global: this.global, subscripts: (sorters === 1) ? [process.pid, threadId] : this.subscripts}));
+}
+
+/*
+ * @method {private} Sorter#_add
+ * @summary Queue one pair for the next batch
+ * @param {string|number} key - The sort key
+ * @param {string|number} record - The record to return with it
+ * @returns {boolean} - Whether the batch is full
+ */
+Sorter.prototype._add = function (key, record) {
+    if (this.closed) throw new Error('Sorter is closed');
+
+    this._keys.push(key);
+    this._records.push(record);
+
+    return this._keys.length >= this.batch;
+};
+
+/*
+ * @method Sorter#add
+ * @summary Add one pair to the sort, writing the batch when it is full; records with equal keys keep the order they were added in
+ * @param {string|number} key - The sort key
+ * @param {string|number} record - The record to return with it
+ * @returns {Sorter} - This sorter
+ */
+Sorter.prototype.add = function (key, record) {
+    if (this._add(key, record)) this.flush();
+
+    return this;
+};
+
+/*
+ * @method Sorter#flush
+ * @summary Write the queued pairs to the global, with one native call
+ * @param {function} [callback] - Makes the write asynchronous; called with an error or null
+ * @returns {Sorter} - This sorter
+ */
+Sorter.prototype.flush = function (callback) {
+    if (this._keys.length === 0) {
+        if (typeof callback === 'function') process.nextTick(callback, null);
+
+        return this;
+    }
+
+    var args = {
+        global: this.global,
+        subscripts: this.subscripts,
+        keys: this._keys,
+        records: this._records,
+        sequence: this.count
+    };
+
+    this.count += this._keys.length;
+    this._keys = [];
+    this._records = [];
+
+    if (typeof callback === 'function') {
+        this.db.sorterWrite(args, function (error) {
+            callback(error ? failure(error) : null);
+        });
+    } else {
+        check(this.db.sorterWrite(args));
+    }
+
+    return this;
+};
+
+/*
+ * @method Sorter#close
+ * @summary Remove the sorted pairs from the global; called for you once they have all been read
+ * @param {function} [callback] - Makes the kill asynchronous; called with an error or null
+ * @returns {undefined}
+ */
+Sorter.prototype.close = function (callback) {
+    if (this.closed) {
+        if (typeof callback === 'function') process.nextTick(callback, null);
+
+        return;
+    }
+
+    var args = {global: this.global, subscripts: this.subscripts};
+
+    this.closed = true;
+    this._keys = [];
+    this._records = [];
+
+    if (typeof callback === 'function') {
+        this.db.kill(args, function (error) {
+            callback(error ? failure(error) : null);
+        });
+    } else {
+        check(this.db.kill(args));
+    }
+};
+
+/*
+ * @method {private} Sorter#_page
+ * @summary Build the arguments to read the page of pairs that starts at a position
+ * @param {array|null} next - The position returned with the previous page, or null for the first page
+ * @returns {object} - Arguments for sorterRead
+ */
+Sorter.prototype._page = function (next) {
+    return {global: this.global, subscripts: this.subscripts, limit: this.limit, next: next};
+};
+
+if (typeof Symbol === 'function' && Symbol.iterator) {
+    Sorter.prototype[Symbol.iterator] = function () {
+        var self = this;
+        var results = [];
+        var next = null;
+        var started = false;
+        var done = false;
+        var i = 0;
+
+        var finish = function (value) {
+            if (!done) {
+                done = true;
+                self.close();
+            }
+
+            return {value: value, done: true};
+        };
+
+        this.flush();
+
+        return {
+            next: function () {
+                while (i >= results.length) {
+                    if (done || (started && next === null)) return finish(undefined);
+
+                    var page = check(self.db.sorterRead(self._page(next)));
+
+                    started = true;
+                    results = page.results;
+                    next = page.next;
+                    i = 0;
+                }
+
+                return {value: results[i++], done: false};
+            },
+            return: finish
+        };
+    };
+}
+
+/*
+ * @method Sorter#readable
+ * @summary Stream the sorted pairs, as {key, record} objects, reading each page asynchronously
+ * @returns {stream.Readable} - An object mode stream, which closes the sorter when it ends or is destroyed
+ */
+Sorter.prototype.readable = function () {
+    var self = this;
+    var next = null;
+    var started = false;
+    var reading = false;
+
+    return new stream.Readable({
+        objectMode: true,
+        read: function () {
+            var readable = this;
+
+            if (reading || (started && next === null)) return;
+
+            reading = true;
+
+            var read = function () {
+                self.db.sorterRead(self._page(next), function (error, page) {
+                    if (error) return readable.destroy(failure(error));
+
+                    started = true;
+                    next = page.next;
+
+                    for (var j = 0; j < page.results.length; j++) readable.push(page.results[j]);
+
+                    reading = false;
+
+                    if (next !== null) return;
+
+                    self.close(function (error) {
+                        if (error) return readable.destroy(error);
+
+                        readable.push(null);
+                    });
+                });
+            };
+
+            if (started) return read();
+
+            self.flush(function (error) {
+                if (error) return readable.destroy(error);
+
+                read();
+            });
+        },
+        destroy: function (error, callback) {
+            self.close(function (closeError) {
+                callback(error || closeError);
+            });
+        }
+    });
+};
+
+/*
+ * @method Sorter#writable
+ * @summary Accept {key, record} objects as a stream, writing each full batch asynchronously
+ * @returns {stream.Writable} - An object mode stream, which writes the last partial batch when it finishes
+ */
+Sorter.prototype.writable = function () {
+    var self = this;
+
+    return new stream.Writable({
+        objectMode: true,
+        write: function (pair, encoding, callback) {
+            try {
+                if (!self._add(pair.key, pair.record)) return callback();
+            } catch (error) {
+                return callback(error);
+            }
+
+            self.flush(callback);
+        },
+        final: function (callback) {
+            self.flush(callback);
+        }
+    });
+};
+
+module.exports = Sorter;
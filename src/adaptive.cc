@@ -0,0 +1,108 @@
+/*
+ * Package:    NodeM
+ * File:       adaptive.cc
+ * Summary:    Latency estimates for adaptive synchronous/asynchronous execution
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "adaptive.hh"
+#include <uv.h>
+#include <map>
+
+using std::map;
+
+namespace nodem {
+
+/*
+ * @struct {private} nodem::AdaptiveEntry
+ * @summary Running latency estimate for one kind of call
+ */
+struct AdaptiveEntry {
+    uint64_t    average = 0;
+    uint64_t    last = 0;
+}; // @end nodem::AdaptiveEntry struct
+
+static uv_once_t                        adaptive_once_g = UV_ONCE_INIT;
+static uv_mutex_t                       adaptive_mutex_g;
+static map<AdaptiveKey, AdaptiveEntry>  adaptive_entries_g;
+
+/*
+ * @function {private} nodem::adaptive_init
+ * @summary Initialize the mutex that protects the latency estimates, once per process
+ * @returns {void}
+ */
+static void adaptive_init(void)
+{
+    uv_mutex_init(&adaptive_mutex_g);
+    return;
+} // @end nodem::adaptive_init function
+
+/*
+ * @function nodem::adaptive_record
+ * @summary Add the latency of a finished call to the running estimate for its kind of call
+ * @param {AdaptiveKey} key - The kind of call
+ * @param {uint64_t} latency - Time spent in the database call, in nanoseconds
+ * @returns {void}
+ */
+void adaptive_record(const AdaptiveKey& key, const uint64_t latency)
+{
+    uv_once(&adaptive_once_g, adaptive_init);
+    uv_mutex_lock(&adaptive_mutex_g);
+
+    map<AdaptiveKey, AdaptiveEntry>::iterator entry = adaptive_entries_g.find(key);
+
+    if (entry == adaptive_entries_g.end()) {
+        if (adaptive_entries_g.size() < ADAPTIVE_MAX) {
+            AdaptiveEntry first;
+
+            first.average = first.last = latency;
+            adaptive_entries_g.insert(std::make_pair(key, first));
+        }
+    } else {
+        // Exponentially weighted moving average, with a weight of 1/8 for the newest call
+        entry->second.average = entry->second.average - (entry->second.average >> 3) + (latency >> 3);
+        entry->second.last = latency;
+    }
+
+    uv_mutex_unlock(&adaptive_mutex_g);
+    return;
+} // @end nodem::adaptive_record function
+
+/*
+ * @function nodem::adaptive_predict
+ * @summary Predict the latency of a call, from the running average and the most recent call of its kind
+ * @param {AdaptiveKey} key - The kind of call
+ * @param {uint64_t} latency - The predicted latency, in nanoseconds, on output; the larger of the average and the last call
+ * @returns {bool} - Whether there is an estimate for this kind of call yet
+ */
+bool adaptive_predict(const AdaptiveKey& key, uint64_t& latency)
+{
+    uv_once(&adaptive_once_g, adaptive_init);
+    uv_mutex_lock(&adaptive_mutex_g);
+
+    map<AdaptiveKey, AdaptiveEntry>::const_iterator entry = adaptive_entries_g.find(key);
+    bool found = entry != adaptive_entries_g.end();
+
+    if (found) latency = (entry->second.last > entry->second.average) ? entry->second.last : entry->second.average;
+
+    uv_mutex_unlock(&adaptive_mutex_g);
+    return found;
+} // @end nodem::adaptive_predict function
+
+} // @end namespace nodem
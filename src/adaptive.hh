@@ -0,0 +1,62 @@
+/*
+ * Package:    NodeM
+ * File:       adaptive.hh
+ * Summary:    Latency estimates for adaptive synchronous/asynchronous execution
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef ADAPTIVE_HH
+#   define ADAPTIVE_HH
+
+#include <cstdint>
+#include <string>
+
+#define ADAPTIVE_MAX           4096
+#define ADAPTIVE_THRESHOLD     1000000
+#define ADAPTIVE_MAX_THRESHOLD 60000
+
+namespace nodem {
+
+/*
+ * @struct nodem::AdaptiveKey
+ * @summary Identifies a kind of call, for latency estimates: the API, the global or local name, and the subscript depth
+ * @member {uintptr_t} api
+ * @member {string} name
+ * @member {unsigned int} depth
+ */
+struct AdaptiveKey {
+    uintptr_t       api;
+    std::string     name;
+    unsigned int    depth;
+
+    bool operator<(const AdaptiveKey& key) const
+    {
+        if (api != key.api) return api < key.api;
+        if (depth != key.depth) return depth < key.depth;
+
+        return name < key.name;
+    }
+}; // @end nodem::AdaptiveKey struct
+
+void adaptive_record(const AdaptiveKey&, const uint64_t);
+bool adaptive_predict(const AdaptiveKey&, uint64_t&);
+
+} // @end namespace nodem
+
+#endif // @end ADAPTIVE_HH
@@ -0,0 +1,140 @@
+/*
+ * Package:    NodeM
+ * File:       aggregate.cc
+ * Summary:    Materialized count and sum aggregates of a global, kept current by the writes made through Nodem
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "aggregate.hh"
+#include "registry.hh"
+#include "utility.hh"
+#include <map>
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+static Registry<map<string, aggregate_ptr_t>> aggregates_g;
+
+/*
+ * @function nodem::aggregate_define
+ * @summary Add an aggregate definition, or replace the existing definition with the same target
+ * @param {aggregate_ptr_t} aggregate - The definition, with the global names including their leading ^
+ * @returns {void}
+ */
+void aggregate_define(const aggregate_ptr_t& aggregate)
+{
+    aggregates_g.write()[aggregate->target] = aggregate;
+    aggregates_g.write_done();
+    return;
+} // @end nodem::aggregate_define function
+
+/*
+ * @function nodem::aggregate_remove
+ * @summary Remove an aggregate definition, leaving its target global as it is
+ * @param {string} target - Target global name, including its leading ^
+ * @returns {bool} - Whether there was a definition to remove
+ */
+bool aggregate_remove(const string& target)
+{
+    bool removed = aggregates_g.write().erase(target) > 0;
+    aggregates_g.write_done();
+    return removed;
+} // @end nodem::aggregate_remove function
+
+/*
+ * @function nodem::aggregate_find
+ * @summary Look up the aggregate definition kept in a target global
+ * @param {string} target - Target global name, including its leading ^
+ * @returns {aggregate_ptr_t} - The definition, or an empty pointer if there is none
+ */
+aggregate_ptr_t aggregate_find(const string& target)
+{
+    if (aggregates_g.empty()) return aggregate_ptr_t {};
+
+    const map<string, aggregate_ptr_t>& aggregates = aggregates_g.read();
+
+    map<string, aggregate_ptr_t>::const_iterator aggregate = aggregates.find(target);
+    aggregate_ptr_t found = (aggregate == aggregates.end()) ? aggregate_ptr_t {} : aggregate->second;
+
+    aggregates_g.read_done();
+    return found;
+} // @end nodem::aggregate_find function
+
+/*
+ * @function nodem::aggregate_sources
+ * @summary Find the aggregates that a write to a node of a global can change, without taking a lock when there are none
+ * @param {string} source - Global name, including its leading ^; an extended reference finds the aggregates of the plain name
+ * @param {unsigned int} depth - Number of subscripts of the node written
+ * @param {bool} subtree - Whether the write changes the nodes below the node too, as a kill does
+ * @returns {vector<aggregate_ptr_t>} - The definitions, which is empty for most writes
+ */
+vector<aggregate_ptr_t> aggregate_sources(const string& source, const unsigned int depth, const bool subtree)
+{
+    vector<aggregate_ptr_t> found;
+
+    if (aggregates_g.empty() || source[0] != '^') return found;
+
+    const string plain = plain_name(source);
+
+    for (const std::pair<const string, aggregate_ptr_t>& aggregate : aggregates_g.read()) {
+        if (aggregate.second->source != plain) continue;
+
+        if (aggregate.second->value_level == depth || (subtree && aggregate.second->value_level > depth)) {
+            found.push_back(aggregate.second);
+        }
+    }
+
+    aggregates_g.read_done();
+    return found;
+} // @end nodem::aggregate_sources function
+
+/*
+ * @function nodem::aggregate_stale
+ * @summary Mark the aggregates of a global stale, after a write that could not keep them current
+ * @param {string} source - Global name, including its leading ^, or an extended reference to it; an empty string marks every aggregate stale
+ * @returns {void}
+ */
+void aggregate_stale(const string& source)
+{
+    if (aggregates_g.empty()) return;
+
+    const string plain = plain_name(source);
+
+    for (const std::pair<const string, aggregate_ptr_t>& aggregate : aggregates_g.read()) {
+        if (plain.empty() || aggregate.second->source == plain) aggregate.second->stale = true;
+    }
+
+    aggregates_g.read_done();
+    return;
+} // @end nodem::aggregate_stale function
+
+/*
+ * @function nodem::aggregate_active
+ * @summary Check whether any aggregates are defined, so that writes can skip looking for them
+ * @returns {bool} - Whether there is at least one aggregate
+ */
+bool aggregate_active(void)
+{
+    return !aggregates_g.empty();
+} // @end nodem::aggregate_active function
+
+} // @end namespace nodem
@@ -0,0 +1,72 @@
+/*
+ * Package:    NodeM
+ * File:       aggregate.hh
+ * Summary:    Materialized count and sum aggregates of a global, kept current by the writes made through Nodem
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef AGGREGATE_HH
+#   define AGGREGATE_HH
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define AGGREGATE_MAX    64
+#define AGGREGATE_NUMBER 128
+
+namespace nodem {
+
+enum aggregate_op_t {
+    AGGREGATE_COUNT = 1,
+    AGGREGATE_SUM   = 2
+};
+
+/*
+ * @struct nodem::Aggregate
+ * @summary Totals of the values at value_level in a source global, grouped by its first group_level subscripts, in a target global
+ * @member {string} source
+ * @member {string} target
+ * @member {unsigned int} group_level
+ * @member {unsigned int} value_level
+ * @member {unsigned int} ops
+ * @member {atomic<bool>} stale
+ */
+struct Aggregate {
+    std::string                 source;
+    std::string                 target;
+    unsigned int                group_level;
+    unsigned int                value_level;
+    unsigned int                ops;
+    mutable std::atomic<bool>   stale {false};
+}; // @end nodem::Aggregate struct
+
+typedef std::shared_ptr<const Aggregate> aggregate_ptr_t;
+
+void aggregate_define(const aggregate_ptr_t&);
+bool aggregate_remove(const std::string&);
+aggregate_ptr_t aggregate_find(const std::string&);
+std::vector<aggregate_ptr_t> aggregate_sources(const std::string&, const unsigned int, const bool);
+void aggregate_stale(const std::string&);
+bool aggregate_active(void);
+
+} // @end namespace nodem
+
+#endif // @end AGGREGATE_HH
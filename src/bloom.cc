@@ -0,0 +1,405 @@
+/*
+ * Package:    NodeM
+ * File:       bloom.cc
+ * Summary:    Bloom filters over the keys at one level of a global or local, and the process-wide list of them kept current on writes
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "bloom.hh"
+#include "registry.hh"
+#include "utility.hh"
+#include <algorithm>
+#include <cmath>
+
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+static Registry<vector<bloom_ptr_t>> blooms_g;
+
+/*
+ * @function {private} nodem::bloom_mix
+ * @summary Finish a 64-bit hash, so that every bit of it depends on every bit of the input (MurmurHash3 fmix64)
+ * @param {uint64_t} hash - The hash to mix
+ * @returns {uint64_t} - The mixed hash
+ */
+inline static uint64_t bloom_mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+} // @end nodem::bloom_mix function
+
+/*
+ * @method nodem::BloomFilter::BloomFilter
+ * @summary Create an empty filter, in the building state, which queues the keys written until its bits are sized
+ * @param {string} nam - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node whose descendants are keyed
+ * @param {unsigned int} lev - Subscript level of the last subscript in each key
+ */
+BloomFilter::BloomFilter(const string& nam, const vector<string>& subs, const unsigned int lev) :
+    name {nam},
+    root {subs},
+    level {lev},
+    state {BUILDING},
+    count {0},
+    probes {0},
+    negatives {0},
+    bits {0},
+    hashes {0}
+{
+    uv_mutex_init(&pending_mutex);
+    return;
+} // @end nodem::BloomFilter::BloomFilter method
+
+/*
+ * @method nodem::BloomFilter::~BloomFilter
+ * @summary Free the mutex that protects the queue of keys written while building
+ */
+BloomFilter::~BloomFilter()
+{
+    uv_mutex_destroy(&pending_mutex);
+    return;
+} // @end nodem::BloomFilter::~BloomFilter method
+
+/*
+ * @method nodem::BloomFilter::hash
+ * @summary Hash the key of a node: its subscripts from below the filter's node down to the filter's level
+ * @param {vector<string>} subs - Subscripts of the node
+ * @param {size_t} start - Number of subscripts in the filter's node
+ * @param {size_t} end - The filter's level
+ * @returns {uint64_t} - The hash of the key
+ */
+uint64_t BloomFilter::hash(const vector<string>& subs, const size_t start, const size_t end)
+{
+    // 64-bit FNV-1a, with each subscript's length mixed in, so ("ab", "c") and ("a", "bc") differ
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = start; i < end; i++) {
+        uint64_t length = subs[i].length();
+
+        for (unsigned int j = 0; j < 4; j++) {
+            hash = (hash ^ ((length >> (j * 8)) & 0xFF)) * 1099511628211ULL;
+        }
+
+        for (unsigned char c : subs[i]) hash = (hash ^ c) * 1099511628211ULL;
+    }
+
+    return bloom_mix(hash);
+} // @end nodem::BloomFilter::hash method
+
+/*
+ * @method nodem::BloomFilter::covers
+ * @summary Check whether a node is at or below the filter's level under its node, so the filter knows whether its key exists
+ * @param {string} nam - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node
+ * @returns {bool} - Whether the filter covers the node
+ */
+bool BloomFilter::covers(const string& nam, const vector<string>& subs) const
+{
+    return subs.size() >= level && nam == name && std::equal(root.begin(), root.end(), subs.begin());
+} // @end nodem::BloomFilter::covers method
+
+/*
+ * @method {private} nodem::BloomFilter::insert
+ * @summary Set the bits for a key hash, by double hashing
+ * @param {uint64_t} key_hash - The hash of the key
+ * @returns {void}
+ */
+void BloomFilter::insert(const uint64_t key_hash)
+{
+    uint64_t step = bloom_mix(key_hash ^ 0x9E3779B97F4A7C15ULL) | 1;
+
+    for (unsigned int i = 0; i < hashes; i++) {
+        uint64_t bit = (key_hash + i * step) % bits;
+
+        words[bit / 64].fetch_or(1ULL << (bit % 64), std::memory_order_release);
+    }
+
+    return;
+} // @end nodem::BloomFilter::insert method
+
+/*
+ * @method nodem::BloomFilter::add
+ * @summary Add the key of a node written through Nodem, or queue it while the filter is still being built
+ * @param {vector<string>} subs - Subscripts of the node; the filter must cover it
+ * @returns {void}
+ */
+void BloomFilter::add(const vector<string>& subs)
+{
+    uint64_t key_hash = hash(subs, root.size(), level);
+
+    if (state.load(std::memory_order_acquire) != READY) {
+        uv_mutex_lock(&pending_mutex);
+
+        bloom_state_t current = state.load(std::memory_order_acquire);
+
+        if (current == BUILDING) pending.push_back(key_hash);
+
+        uv_mutex_unlock(&pending_mutex);
+
+        // A stale filter no longer answers probes, so its keys are not kept
+        if (current != READY) return;
+    }
+
+    insert(key_hash);
+    count++;
+
+    return;
+} // @end nodem::BloomFilter::add method
+
+/*
+ * @method nodem::BloomFilter::contains
+ * @summary Check whether the key of a node may exist; false means it certainly does not
+ * @param {vector<string>} subs - Subscripts of the node; the filter must cover it
+ * @returns {bool} - Whether the key may exist
+ */
+bool BloomFilter::contains(const vector<string>& subs) const
+{
+    uint64_t key_hash = hash(subs, root.size(), level);
+    uint64_t step = bloom_mix(key_hash ^ 0x9E3779B97F4A7C15ULL) | 1;
+
+    probes++;
+
+    for (unsigned int i = 0; i < hashes; i++) {
+        uint64_t bit = (key_hash + i * step) % bits;
+
+        if ((words[bit / 64].load(std::memory_order_acquire) & (1ULL << (bit % 64))) == 0) {
+            negatives++;
+            return false;
+        }
+    }
+
+    return true;
+} // @end nodem::BloomFilter::contains method
+
+/*
+ * @method nodem::BloomFilter::finish
+ * @summary Size the filter for the keys found by its scan, add them and any keys written meanwhile, and start answering probes
+ * @param {vector<uint64_t>} key_hashes - The hash of each key found
+ * @param {unsigned int} bits_per_key - Bits to allocate for each key
+ * @returns {void}
+ */
+void BloomFilter::finish(const vector<uint64_t>& key_hashes, const unsigned int bits_per_key)
+{
+    uv_mutex_lock(&pending_mutex);
+
+    uint64_t keys = std::max<uint64_t>(key_hashes.size() + pending.size(), BLOOM_MIN_KEYS);
+
+    bits = ((keys * bits_per_key + 63) / 64) * 64;
+    hashes = std::min(std::max(static_cast<unsigned int>(std::lround(bits_per_key * std::log(2.0))), 1U), 16U);
+    words.reset(new std::atomic<uint64_t>[bits / 64]);
+
+    for (uint64_t i = 0; i < bits / 64; i++) words[i].store(0, std::memory_order_relaxed);
+    for (uint64_t key_hash : key_hashes) insert(key_hash);
+    for (uint64_t key_hash : pending) insert(key_hash);
+
+    count = key_hashes.size() + pending.size();
+    pending.clear();
+    pending.shrink_to_fit();
+
+    // A filter marked stale while its scan ran stays stale
+    bloom_state_t building = BUILDING;
+
+    state.compare_exchange_strong(building, READY, std::memory_order_acq_rel);
+    uv_mutex_unlock(&pending_mutex);
+
+    return;
+} // @end nodem::BloomFilter::finish method
+
+/*
+ * @function nodem::bloom_begin
+ * @summary Start building a filter, replacing any filter on the same node and level; writes are queued for it from now on
+ * @param {string} name - Global or local name
+ * @param {vector<string>} root - Subscripts of the node whose descendants are keyed
+ * @param {unsigned int} level - Subscript level of the last subscript in each key
+ * @returns {bloom_ptr_t} - The new filter, to fill and finish
+ */
+bloom_ptr_t bloom_begin(const string& name, const vector<string>& root, const unsigned int level)
+{
+    bloom_ptr_t filter = std::make_shared<BloomFilter>(name, root, level);
+
+    vector<bloom_ptr_t>& blooms = blooms_g.write();
+
+    blooms.erase(std::remove_if(blooms.begin(), blooms.end(), [&](const bloom_ptr_t& bloom) {
+        if (bloom->name != name || bloom->root != root || bloom->level != level) return false;
+
+        // A rebuild keeps counting the probes of the filter it replaces
+        filter->probes = bloom->probes.load();
+        filter->negatives = bloom->negatives.load();
+
+        return true;
+    }), blooms.end());
+
+    blooms.push_back(filter);
+
+    blooms_g.write_done();
+    return filter;
+} // @end nodem::bloom_begin function
+
+/*
+ * @function nodem::bloom_find
+ * @summary Look up the filter on a node and level
+ * @param {string} name - Global or local name
+ * @param {vector<string>} root - Subscripts of the node whose descendants are keyed
+ * @param {unsigned int} level - Subscript level of the last subscript in each key
+ * @returns {bloom_ptr_t} - The filter, or an empty pointer if there is none
+ */
+bloom_ptr_t bloom_find(const string& name, const vector<string>& root, const unsigned int level)
+{
+    if (blooms_g.empty()) return bloom_ptr_t {};
+
+    bloom_ptr_t found;
+
+    for (const bloom_ptr_t& bloom : blooms_g.read()) {
+        if (bloom->name == name && bloom->root == root && bloom->level == level) {
+            found = bloom;
+            break;
+        }
+    }
+
+    blooms_g.read_done();
+    return found;
+} // @end nodem::bloom_find function
+
+/*
+ * @function nodem::bloom_remove
+ * @summary Remove the filter on a node and level
+ * @param {string} name - Global or local name
+ * @param {vector<string>} root - Subscripts of the node whose descendants are keyed
+ * @param {unsigned int} level - Subscript level of the last subscript in each key
+ * @returns {bool} - Whether there was a filter to remove
+ */
+bool bloom_remove(const string& name, const vector<string>& root, const unsigned int level)
+{
+    vector<bloom_ptr_t>& blooms = blooms_g.write();
+    size_t size = blooms.size();
+
+    blooms.erase(std::remove_if(blooms.begin(), blooms.end(), [&](const bloom_ptr_t& bloom) {
+        return bloom->name == name && bloom->root == root && bloom->level == level;
+    }), blooms.end());
+
+    bool removed = blooms.size() < size;
+
+    blooms_g.write_done();
+    return removed;
+} // @end nodem::bloom_remove function
+
+/*
+ * @function nodem::bloom_abandon
+ * @summary Remove a filter whose scan failed, unless another build has already replaced it
+ * @param {bloom_ptr_t} filter - The filter to remove
+ * @returns {void}
+ */
+void bloom_abandon(const bloom_ptr_t& filter)
+{
+    vector<bloom_ptr_t>& blooms = blooms_g.write();
+
+    blooms.erase(std::remove(blooms.begin(), blooms.end(), filter), blooms.end());
+
+    blooms_g.write_done();
+    return;
+} // @end nodem::bloom_abandon function
+
+/*
+ * @function nodem::bloom_absent
+ * @summary Check whether a ready filter proves that a node does not exist, without taking a lock when there are no filters
+ * @param {string} name - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node
+ * @returns {bool} - Whether the node certainly does not exist
+ */
+bool bloom_absent(const string& name, const vector<string>& subs)
+{
+    if (blooms_g.empty()) return false;
+
+    bool absent = false;
+
+    for (const bloom_ptr_t& bloom : blooms_g.read()) {
+        if (bloom->state.load(std::memory_order_acquire) != READY || !bloom->covers(name, subs)) continue;
+
+        if (!bloom->contains(subs)) {
+            absent = true;
+            break;
+        }
+    }
+
+    blooms_g.read_done();
+    return absent;
+} // @end nodem::bloom_absent function
+
+/*
+ * @function nodem::bloom_written
+ * @summary Keep the filters current before a write through Nodem: add the key of a node it covers, or mark a filter stale
+ * @param {string} name - Global or local name written to, which can be an extended reference
+ * @param {vector<string>} subs - Subscripts of the node written, or of the root of the subtree written
+ * @param {bool} subtree - Whether the write can create nodes below the one given, e.g. a merge, so its keys are not known
+ * @returns {void}
+ */
+void bloom_written(const string& name, const vector<string>& subs, const bool subtree)
+{
+    if (blooms_g.empty()) return;
+
+    const string plain = plain_name(name);
+
+    for (const bloom_ptr_t& bloom : blooms_g.read()) {
+        if (bloom->covers(plain, subs)) {
+            bloom->add(subs);
+        } else if (subtree && bloom->name == plain) {
+            size_t shared = std::min(subs.size(), bloom->root.size());
+
+            // A subtree written above the level, over the filter's node, can add keys the filter has no way to know
+            if (std::equal(subs.begin(), subs.begin() + shared, bloom->root.begin())) bloom->state = STALE;
+        }
+    }
+
+    blooms_g.read_done();
+    return;
+} // @end nodem::bloom_written function
+
+/*
+ * @function nodem::bloom_stale_all
+ * @summary Mark every filter stale, before a call that can write to any name, e.g. M code run by function or procedure
+ * @returns {void}
+ */
+void bloom_stale_all(void)
+{
+    if (blooms_g.empty()) return;
+
+    for (const bloom_ptr_t& bloom : blooms_g.read()) bloom->state = STALE;
+
+    blooms_g.read_done();
+    return;
+} // @end nodem::bloom_stale_all function
+
+/*
+ * @function nodem::bloom_active
+ * @summary Check whether there are any filters to keep current
+ * @returns {bool} - Whether there is at least one filter
+ */
+bool bloom_active(void)
+{
+    return !blooms_g.empty();
+} // @end nodem::bloom_active function
+
+} // @end namespace nodem
@@ -0,0 +1,108 @@
+/*
+ * Package:    NodeM
+ * File:       bloom.hh
+ * Summary:    Bloom filters over the keys at one level of a global or local, that answer negative existence checks without the database
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef BLOOM_HH
+#   define BLOOM_HH
+
+#include <uv.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define BLOOM_BITS_PER_KEY 10
+#define BLOOM_MAX_BITS     64
+#define BLOOM_MIN_KEYS     1024
+#define BLOOM_CHUNK        1000
+
+namespace nodem {
+
+typedef enum {BUILDING, READY, STALE} bloom_state_t;
+
+/*
+ * @class nodem::BloomFilter
+ * @summary A Bloom filter over the keys at one level under a node, where a key is the subscripts from below the node down to the level
+ * @constructor BloomFilter
+ * @destructor ~BloomFilter
+ * @method {instance} covers
+ * @method {instance} add
+ * @method {instance} contains
+ * @method {instance} finish
+ * @member {string} name
+ * @member {vector<string>} root
+ * @member {unsigned int} level
+ * @member {atomic<bloom_state_t>} state
+ * @member {atomic<uint64_t>} count
+ * @member {atomic<uint64_t>} probes
+ * @member {atomic<uint64_t>} negatives
+ * @member {uint64_t} bits
+ * @member {unsigned int} hashes
+ * @member {unique_ptr<atomic<uint64_t>[]>} {private} words
+ * @member {vector<uint64_t>} {private} pending
+ * @member {uv_mutex_t} {private} pending_mutex
+ */
+class BloomFilter {
+public:
+    BloomFilter(const std::string&, const std::vector<std::string>&, const unsigned int);
+    ~BloomFilter();
+
+    bool covers(const std::string&, const std::vector<std::string>&) const;
+    void add(const std::vector<std::string>&);
+    bool contains(const std::vector<std::string>&) const;
+    void finish(const std::vector<uint64_t>&, const unsigned int);
+
+    static uint64_t hash(const std::vector<std::string>&, const size_t, const size_t);
+
+    const std::string               name;
+    const std::vector<std::string>  root;
+    const unsigned int              level;
+    std::atomic<bloom_state_t>      state;
+    std::atomic<uint64_t>           count;
+    mutable std::atomic<uint64_t>   probes;
+    mutable std::atomic<uint64_t>   negatives;
+    uint64_t                        bits;
+    unsigned int                    hashes;
+
+private:
+    void insert(const uint64_t);
+
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    std::vector<uint64_t>                   pending;
+    uv_mutex_t                              pending_mutex;
+}; // @end nodem::BloomFilter class
+
+typedef std::shared_ptr<BloomFilter> bloom_ptr_t;
+
+bloom_ptr_t bloom_begin(const std::string&, const std::vector<std::string>&, const unsigned int);
+bloom_ptr_t bloom_find(const std::string&, const std::vector<std::string>&, const unsigned int);
+bool bloom_remove(const std::string&, const std::vector<std::string>&, const unsigned int);
+void bloom_abandon(const bloom_ptr_t&);
+bool bloom_absent(const std::string&, const std::vector<std::string>&);
+void bloom_written(const std::string&, const std::vector<std::string>&, const bool);
+void bloom_stale_all(void);
+bool bloom_active(void);
+
+} // @end namespace nodem
+
+#endif // @end BLOOM_HH
@@ -346,6 +346,27 @@ inline static v8::Local<v8::Value> call_n(v8::Isolate* isolate, const v8::Local<
 #endif
 } // @end nodem::call_n function
 
+/*
+ * @function {private} nodem::new_buffer_n
+ * @summary Create a new Node.js Buffer, holding a copy of some bytes
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {const char*} data - The bytes to copy into the buffer
+ * @param {size_t} length - The number of bytes to copy
+ * @returns {Local<Object>} - The new Node.js Buffer, or a V8 Null if it could not be allocated
+ */
+inline static v8::Local<v8::Value> new_buffer_n(v8::Isolate* isolate, const char* data, const size_t length)
+{
+#if NODE_MAJOR_VERSION >= 3
+    v8::MaybeLocal<v8::Object> maybe_buffer = node::Buffer::Copy(isolate, data, length);
+
+    if (maybe_buffer.IsEmpty()) return v8::Null(isolate);
+
+    return maybe_buffer.ToLocalChecked();
+#else
+    return node::Buffer::New(isolate, data, length);
+#endif
+} // @end nodem::new_buffer_n function
+
 /*
  * @function {private} nodem::set_prototype_method_n
  * @summary Add Nodem class methods and external per-thread data to the Gtm/Ydb JavaScript function prototypes
@@ -0,0 +1,161 @@
+/*
+ * Package:    NodeM
+ * File:       distinct.cc
+ * Summary:    HyperLogLog sketches, for estimating the number of distinct values or subscripts in a subtree
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "distinct.hh"
+#include <cmath>
+#include <cstring>
+
+using std::string;
+
+namespace nodem {
+
+/*
+ * Layout: "NH", version, precision, and then one byte per register, holding the longest run of leading zero bits,
+ * plus one, seen in the hashes routed to it; merging two sketches keeps the larger byte in each register
+ */
+
+/*
+ * @function {private} nodem::distinct_hash
+ * @summary Hash a value to 64 bits, with 64-bit FNV-1a, finished with MurmurHash3's mixer so every bit depends on every byte
+ * @param {char*} data - The value
+ * @param {size_t} length - Number of bytes in the value
+ * @returns {uint64_t} - The hash
+ */
+static uint64_t distinct_hash(const char* data, const size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+} // @end nodem::distinct_hash function
+
+/*
+ * @class nodem::DistinctSketch
+ * @constructor DistinctSketch
+ * @summary Start an empty sketch, with its header and every register zero
+ */
+DistinctSketch::DistinctSketch()
+{
+    sketch.reserve(DISTINCT_HEADER + DISTINCT_REGISTERS);
+    sketch.append("NH");
+    sketch.push_back(static_cast<char>(DISTINCT_VERSION));
+    sketch.push_back(static_cast<char>(DISTINCT_PRECISION));
+    sketch.append(DISTINCT_REGISTERS, '\0');
+
+    return;
+}
+
+/*
+ * @class nodem::DistinctSketch
+ * @method {instance} add
+ * @summary Add a value to the sketch; adding the same value again does not change it
+ * @param {char*} data - The value
+ * @param {size_t} length - Number of bytes in the value
+ * @returns {void}
+ */
+void DistinctSketch::add(const char* data, const size_t length)
+{
+    uint64_t hash = distinct_hash(data, length);
+    size_t index = hash >> (64 - DISTINCT_PRECISION);
+    uint64_t rest = hash << DISTINCT_PRECISION;
+    unsigned char rank = 1;
+
+    while (rank <= 64 - DISTINCT_PRECISION && (rest & 0x8000000000000000ULL) == 0) {
+        rest <<= 1;
+        rank++;
+    }
+
+    char& reg = sketch[DISTINCT_HEADER + index];
+
+    if (rank > static_cast<unsigned char>(reg)) reg = static_cast<char>(rank);
+
+    return;
+} // @end DistinctSketch::add method
+
+/*
+ * @class nodem::DistinctSketch
+ * @method {instance} merge
+ * @summary Merge a serialized sketch in to this one, so it estimates the union of both
+ * @param {char*} data - The serialized sketch, from serialized
+ * @param {size_t} length - Number of bytes in the serialized sketch
+ * @returns {bool} - Whether it was a sketch this version of Nodem can merge
+ */
+bool DistinctSketch::merge(const char* data, const size_t length)
+{
+    if (length != sketch.length() || memcmp(data, sketch.data(), DISTINCT_HEADER) != 0) return false;
+
+    for (size_t i = DISTINCT_HEADER; i < length; i++) {
+        if (static_cast<unsigned char>(data[i]) > static_cast<unsigned char>(sketch[i])) sketch[i] = data[i];
+    }
+
+    return true;
+} // @end DistinctSketch::merge method
+
+/*
+ * @class nodem::DistinctSketch
+ * @method {instance} estimate
+ * @summary Estimate the number of distinct values added, with linear counting while many registers are still empty
+ * @returns {double} - The estimate, rounded to a whole number
+ */
+double DistinctSketch::estimate(void) const
+{
+    const double registers = DISTINCT_REGISTERS;
+    double sum = 0;
+    unsigned int zeros = 0;
+
+    for (size_t i = DISTINCT_HEADER; i < sketch.length(); i++) {
+        unsigned char rank = static_cast<unsigned char>(sketch[i]);
+
+        sum += std::ldexp(1.0, -rank);
+        if (rank == 0) zeros++;
+    }
+
+    double estimate = (0.7213 / (1 + 1.079 / registers)) * registers * registers / sum;
+
+    if (estimate <= 2.5 * registers && zeros > 0) estimate = registers * std::log(registers / zeros);
+
+    return std::round(estimate);
+} // @end DistinctSketch::estimate method
+
+/*
+ * @class nodem::DistinctSketch
+ * @method {instance} serialized
+ * @summary Return the sketch in its serialized form, to hand to JavaScript, or to merge in to another sketch
+ * @returns {string} - The serialized sketch
+ */
+const string& DistinctSketch::serialized(void) const
+{
+    return sketch;
+} // @end DistinctSketch::serialized method
+
+} // @end namespace nodem
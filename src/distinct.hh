@@ -0,0 +1,63 @@
+/*
+ * Package:    NodeM
+ * File:       distinct.hh
+ * Summary:    HyperLogLog sketches, for estimating the number of distinct values or subscripts in a subtree
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef DISTINCT_HH
+#   define DISTINCT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define DISTINCT_VERSION   1
+#define DISTINCT_PRECISION 14
+#define DISTINCT_HEADER    4
+#define DISTINCT_REGISTERS (1 << DISTINCT_PRECISION)
+
+namespace nodem {
+
+/*
+ * @class nodem::DistinctSketch
+ * @summary A HyperLogLog sketch, kept in its serialized form, so it can be handed to JavaScript and merged back in as is
+ * @constructor DistinctSketch
+ * @method {instance} add
+ * @method {instance} merge
+ * @method {instance} estimate
+ * @method {instance} serialized
+ * @member {string} {private} sketch
+ */
+class DistinctSketch {
+public:
+    DistinctSketch();
+
+    void add(const char*, const size_t);
+    bool merge(const char*, const size_t);
+    double estimate(void) const;
+    const std::string& serialized(void) const;
+
+private:
+    std::string sketch;
+}; // @end nodem::DistinctSketch class
+
+} // @end namespace nodem
+
+#endif // @end DISTINCT_HH
@@ -0,0 +1,677 @@
+/*
+ * Package:    NodeM
+ * File:       filter.cc
+ * Summary:    Compile scan filter expressions in to bytecode, and run them against each node a scan visits
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "filter.hh"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+using std::map;
+using std::string;
+
+namespace nodem {
+
+/*
+ * Grammar, with keywords in lower case:
+ *   or         - and { "or" and }
+ *   and        - not { "and" not }
+ *   not        - "not" not | "(" or ")" | comparison
+ *   comparison - operand ( ("=" | "!=" | "<" | "<=" | ">" | ">=") operand | "startsWith" operand | "contains" operand |
+ *                "between" operand "and" operand )
+ *   operand    - "subscript" | "value" | "data" | string | number | "piece" "(" operand "," string "," integer ")"
+ * Equality, startsWith, and contains compare bytes; the ordering operators and between compare numerically, as M does
+ */
+
+/*
+ * @struct {private} nodem::FilterSlot
+ * @summary One entry on the evaluation stack: a slice of the subscript, value, or a constant, and a comparison result
+ * @member {char*} data
+ * @member {size_t} length
+ * @member {bool} truth
+ */
+struct FilterSlot {
+    const char* data;
+    size_t      length;
+    bool        truth;
+}; // @end nodem::FilterSlot struct
+
+/*
+ * @function {private} nodem::slot_number
+ * @summary Interpret a slice as a number the way M does, from its longest leading numeric prefix, or 0 if it has none
+ * @param {FilterSlot} slot - The slice
+ * @returns {double} - Its numeric value
+ */
+static double slot_number(const FilterSlot& slot)
+{
+    char buffer[64];
+    size_t length = std::min(slot.length, sizeof(buffer) - 1);
+    size_t end = 0;
+
+    memcpy(buffer, slot.data, length);
+
+    if (end < length && (buffer[end] == '-' || buffer[end] == '+')) end++;
+    while (end < length && isdigit(static_cast<unsigned char>(buffer[end]))) end++;
+
+    if (end < length && buffer[end] == '.') {
+        end++;
+        while (end < length && isdigit(static_cast<unsigned char>(buffer[end]))) end++;
+    }
+
+    if (end < length && buffer[end] == 'E') {
+        size_t exponent = end + 1;
+
+        if (exponent < length && (buffer[exponent] == '-' || buffer[exponent] == '+')) exponent++;
+
+        if (exponent < length && isdigit(static_cast<unsigned char>(buffer[exponent]))) {
+            while (exponent < length && isdigit(static_cast<unsigned char>(buffer[exponent]))) exponent++;
+            end = exponent;
+        }
+    }
+
+    buffer[end] = '\0';
+
+    return strtod(buffer, NULL);
+} // @end nodem::slot_number function
+
+/*
+ * @function {private} nodem::slot_piece
+ * @summary Narrow a slice to one of its pieces, as $PIECE does
+ * @param {FilterSlot} slot - The slice, narrowed in place
+ * @param {string} delimiter - The piece delimiter
+ * @param {uint32_t} number - Which piece, starting at 1
+ * @returns {void}
+ */
+static void slot_piece(FilterSlot& slot, const string& delimiter, const uint32_t number)
+{
+    const char* start = slot.data;
+    const char* end = slot.data + slot.length;
+
+    if (delimiter.empty() || number == 0) {
+        slot.length = 0;
+        return;
+    }
+
+    for (uint32_t i = 1; i < number; i++) {
+        const char* found = std::search(start, end, delimiter.begin(), delimiter.end());
+
+        if (found == end) {
+            slot.length = 0;
+            return;
+        }
+
+        start = found + delimiter.length();
+    }
+
+    slot.data = start;
+    slot.length = std::search(start, end, delimiter.begin(), delimiter.end()) - start;
+
+    return;
+} // @end nodem::slot_piece function
+
+/*
+ * @function {private} nodem::canonical_literal
+ * @summary Write a numeric literal the way M stores the number, so that equality against stored numbers works
+ * @param {string} number - The literal, e.g. 007, 0.50, or -0
+ * @returns {string} - The canonical form, e.g. 7, .5, or 0
+ */
+static string canonical_literal(const string& number)
+{
+    string sign = (number[0] == '-') ? "-" : "";
+    string digits = number.substr(sign.length());
+    size_t point = digits.find('.');
+
+    if (point != string::npos) {
+        while (digits.back() == '0') digits.pop_back();
+        if (digits.back() == '.') digits.pop_back();
+    }
+
+    size_t first = digits.find_first_not_of('0');
+
+    if (first == string::npos) return "0";
+
+    digits = digits.substr(first);
+
+    return digits.empty() ? "0" : sign + digits;
+} // @end nodem::canonical_literal function
+
+/*
+ * @class nodem::FilterProgram
+ * @constructor FilterProgram
+ * @summary Start an empty program, which compile fills in
+ */
+FilterProgram::FilterProgram() :
+    position {0},
+    depth {0},
+    max_depth {0},
+    nesting {0}
+{
+    return;
+}
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} compile
+ * @summary Compile a filter expression in to bytecode
+ * @param {string} expression - The filter expression
+ * @returns {bool} - Whether it compiled; error returns the reason when it did not
+ */
+bool FilterProgram::compile(const string& expression)
+{
+    text = expression;
+    position = 0;
+    code.clear();
+    constants.clear();
+
+    if (!parse_or()) return false;
+
+    skip_space();
+
+    if (position < text.length()) return fail("has unexpected text");
+    if (max_depth > FILTER_STACK) return fail("is too complex");
+
+    return true;
+} // @end FilterProgram::compile method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} match
+ * @summary Run the bytecode against one node
+ * @param {string} subscript - The node's last subscript
+ * @param {string} value - The node's value, or an empty string if it has none
+ * @param {unsigned int} data - The node's $DATA
+ * @returns {bool} - Whether the node matches the filter
+ */
+bool FilterProgram::match(const string& subscript, const string& value, const unsigned int data) const
+{
+    FilterSlot stack[FILTER_STACK];
+    unsigned int top = 0;
+    char data_text[16];
+    size_t data_length = snprintf(data_text, sizeof(data_text), "%u", data);
+    size_t counter = 0;
+
+    while (counter < code.size()) {
+        const FilterInstruction& instruction = code[counter++];
+
+        switch (instruction.op) {
+            case FILTER_SUBSCRIPT:
+                stack[top++] = FilterSlot {subscript.data(), subscript.length(), false};
+                break;
+            case FILTER_VALUE:
+                stack[top++] = FilterSlot {value.data(), value.length(), false};
+                break;
+            case FILTER_DATA:
+                stack[top++] = FilterSlot {data_text, data_length, false};
+                break;
+            case FILTER_CONST:
+                stack[top++] = FilterSlot {constants[instruction.arg].data(), constants[instruction.arg].length(), false};
+                break;
+            case FILTER_PIECE:
+                slot_piece(stack[top - 1], constants[instruction.arg], instruction.arg2);
+                break;
+            case FILTER_EQ:
+            case FILTER_NE: {
+                const FilterSlot& left = stack[top - 2];
+                const FilterSlot& right = stack[top - 1];
+                bool equal = left.length == right.length && memcmp(left.data, right.data, left.length) == 0;
+
+                top--;
+                stack[top - 1].truth = (instruction.op == FILTER_EQ) ? equal : !equal;
+                break;
+            }
+            case FILTER_LT:
+            case FILTER_LE:
+            case FILTER_GT:
+            case FILTER_GE: {
+                double left = slot_number(stack[top - 2]);
+                double right = slot_number(stack[top - 1]);
+                bool truth;
+
+                if (instruction.op == FILTER_LT) {
+                    truth = left < right;
+                } else if (instruction.op == FILTER_LE) {
+                    truth = left <= right;
+                } else if (instruction.op == FILTER_GT) {
+                    truth = left > right;
+                } else {
+                    truth = left >= right;
+                }
+
+                top--;
+                stack[top - 1].truth = truth;
+                break;
+            }
+            case FILTER_STARTS: {
+                const FilterSlot& left = stack[top - 2];
+                const FilterSlot& right = stack[top - 1];
+                bool truth = left.length >= right.length && memcmp(left.data, right.data, right.length) == 0;
+
+                top--;
+                stack[top - 1].truth = truth;
+                break;
+            }
+            case FILTER_CONTAINS: {
+                const FilterSlot& left = stack[top - 2];
+                const FilterSlot& right = stack[top - 1];
+                bool truth = std::search(left.data, left.data + left.length, right.data, right.data + right.length) !=
+                  left.data + left.length || right.length == 0;
+
+                top--;
+                stack[top - 1].truth = truth;
+                break;
+            }
+            case FILTER_BETWEEN: {
+                double number = slot_number(stack[top - 3]);
+                bool truth = number >= slot_number(stack[top - 2]) && number <= slot_number(stack[top - 1]);
+
+                top -= 2;
+                stack[top - 1].truth = truth;
+                break;
+            }
+            case FILTER_NOT:
+                stack[top - 1].truth = !stack[top - 1].truth;
+                break;
+            case FILTER_JUMP_FALSE:
+            case FILTER_JUMP_TRUE:
+                // Short-circuit: leave the deciding result for the jump target, or drop it and evaluate the other side
+                if (stack[top - 1].truth == (instruction.op == FILTER_JUMP_TRUE)) {
+                    counter = instruction.arg;
+                } else {
+                    top--;
+                }
+
+                break;
+        }
+    }
+
+    return top > 0 && stack[top - 1].truth;
+} // @end FilterProgram::match method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} error
+ * @summary Return why the last compile failed
+ * @returns {string} - The reason, worded to follow "Property 'filter' "
+ */
+const string& FilterProgram::error(void) const
+{
+    return message;
+} // @end FilterProgram::error method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_or
+ * @summary Parse and compile one or more and-expressions, joined by "or"
+ * @returns {bool} - Whether it parsed
+ */
+bool FilterProgram::parse_or(void)
+{
+    if (!parse_and()) return false;
+
+    while (next_word("or")) {
+        size_t jump = code.size();
+
+        emit(FILTER_JUMP_TRUE);
+
+        if (!parse_and()) return false;
+
+        code[jump].arg = code.size();
+    }
+
+    return true;
+} // @end FilterProgram::parse_or method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_and
+ * @summary Parse and compile one or more not-expressions, joined by "and"
+ * @returns {bool} - Whether it parsed
+ */
+bool FilterProgram::parse_and(void)
+{
+    if (!parse_not()) return false;
+
+    while (next_word("and")) {
+        size_t jump = code.size();
+
+        emit(FILTER_JUMP_FALSE);
+
+        if (!parse_not()) return false;
+
+        code[jump].arg = code.size();
+    }
+
+    return true;
+} // @end FilterProgram::parse_and method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_not
+ * @summary Parse and compile a negation, a parenthesized expression, or a comparison
+ * @returns {bool} - Whether it parsed
+ */
+bool FilterProgram::parse_not(void)
+{
+    if (++nesting > FILTER_NESTING) return fail("is nested too deeply");
+
+    bool parsed;
+
+    if (next_word("not")) {
+        parsed = parse_not();
+
+        if (parsed) emit(FILTER_NOT);
+    } else if (next_symbol("(")) {
+        parsed = parse_or();
+
+        if (parsed && !next_symbol(")")) parsed = fail("is missing a closing parenthesis");
+    } else {
+        parsed = parse_comparison();
+    }
+
+    nesting--;
+
+    return parsed;
+} // @end FilterProgram::parse_not method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_comparison
+ * @summary Parse and compile two operands and the comparison between them, or an operand and a between range
+ * @returns {bool} - Whether it parsed
+ */
+bool FilterProgram::parse_comparison(void)
+{
+    if (!parse_operand()) return false;
+
+    filter_op_t op;
+
+    if (next_symbol("!=")) {
+        op = FILTER_NE;
+    } else if (next_symbol("<=")) {
+        op = FILTER_LE;
+    } else if (next_symbol(">=")) {
+        op = FILTER_GE;
+    } else if (next_symbol("=")) {
+        op = FILTER_EQ;
+    } else if (next_symbol("<")) {
+        op = FILTER_LT;
+    } else if (next_symbol(">")) {
+        op = FILTER_GT;
+    } else if (next_word("startsWith")) {
+        op = FILTER_STARTS;
+    } else if (next_word("contains")) {
+        op = FILTER_CONTAINS;
+    } else if (next_word("between")) {
+        if (!parse_operand()) return false;
+        if (!next_word("and")) return fail("is missing 'and' in a between range");
+        if (!parse_operand()) return false;
+
+        emit(FILTER_BETWEEN);
+        return true;
+    } else {
+        return fail("is missing a comparison");
+    }
+
+    if (!parse_operand()) return false;
+
+    emit(op);
+    return true;
+} // @end FilterProgram::parse_comparison method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_operand
+ * @summary Parse and compile subscript, value, data, a literal, or a piece of another operand
+ * @returns {bool} - Whether it parsed
+ */
+bool FilterProgram::parse_operand(void)
+{
+    string literal;
+
+    if (next_word("subscript")) {
+        emit(FILTER_SUBSCRIPT);
+    } else if (next_word("value")) {
+        emit(FILTER_VALUE);
+    } else if (next_word("data")) {
+        emit(FILTER_DATA);
+    } else if (next_word("piece")) {
+        if (!next_symbol("(")) return fail("is missing an opening parenthesis after piece");
+        if (++nesting > FILTER_NESTING) return fail("is nested too deeply");
+        if (!parse_operand()) return false;
+
+        nesting--;
+
+        string delimiter, number;
+
+        if (!next_symbol(",") || !parse_string(delimiter)) return fail("is missing a piece delimiter string");
+        if (!next_symbol(",") || !parse_number(number) || number.find_first_not_of("0123456789") != string::npos) {
+            return fail("is missing a piece number");
+        }
+
+        if (!next_symbol(")")) return fail("is missing a closing parenthesis after piece");
+
+        constants.push_back(delimiter);
+        emit(FILTER_PIECE, constants.size() - 1, strtoul(number.c_str(), NULL, 10));
+    } else if (parse_string(literal) || parse_number(literal)) {
+        constants.push_back(literal);
+        emit(FILTER_CONST, constants.size() - 1);
+    } else {
+        return fail("is missing an operand");
+    }
+
+    return true;
+} // @end FilterProgram::parse_operand method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_string
+ * @summary Parse a string literal in single or double quotes, with backslash escaping a quote or a backslash
+ * @param {string} literal - The string, without its quotes, on output
+ * @returns {bool} - Whether a string literal was next
+ */
+bool FilterProgram::parse_string(string& literal)
+{
+    skip_space();
+
+    if (position >= text.length() || (text[position] != '\'' && text[position] != '"')) return false;
+
+    char quote = text[position++];
+
+    literal.clear();
+
+    while (position < text.length() && text[position] != quote) {
+        if (text[position] == '\\' && position + 1 < text.length()) position++;
+
+        literal += text[position++];
+    }
+
+    if (position >= text.length()) return fail("has an unterminated string");
+
+    position++;
+
+    return true;
+} // @end FilterProgram::parse_string method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} parse_number
+ * @summary Parse a numeric literal, and write it in canonical form
+ * @param {string} literal - The number, on output
+ * @returns {bool} - Whether a numeric literal was next
+ */
+bool FilterProgram::parse_number(string& literal)
+{
+    skip_space();
+
+    size_t start = position;
+    size_t end = position;
+
+    if (end < text.length() && text[end] == '-') end++;
+
+    size_t digits = end;
+
+    while (end < text.length() && isdigit(static_cast<unsigned char>(text[end]))) end++;
+
+    if (end < text.length() && text[end] == '.') {
+        end++;
+        while (end < text.length() && isdigit(static_cast<unsigned char>(text[end]))) end++;
+    }
+
+    if (end == digits || (end == digits + 1 && text[digits] == '.')) return false;
+
+    position = end;
+    literal = canonical_literal(text.substr(start, end - start));
+
+    return true;
+} // @end FilterProgram::parse_number method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} next_word
+ * @summary Consume a keyword, if it is next, as a whole word
+ * @param {char*} word - The keyword
+ * @returns {bool} - Whether it was next
+ */
+bool FilterProgram::next_word(const char* word)
+{
+    skip_space();
+
+    size_t length = strlen(word);
+
+    if (text.compare(position, length, word) != 0) return false;
+
+    size_t end = position + length;
+
+    if (end < text.length() && (isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) return false;
+
+    position = end;
+
+    return true;
+} // @end FilterProgram::next_word method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} next_symbol
+ * @summary Consume an operator or punctuation symbol, if it is next
+ * @param {char*} symbol - The symbol
+ * @returns {bool} - Whether it was next
+ */
+bool FilterProgram::next_symbol(const char* symbol)
+{
+    skip_space();
+
+    size_t length = strlen(symbol);
+
+    if (text.compare(position, length, symbol) != 0) return false;
+
+    position += length;
+
+    return true;
+} // @end FilterProgram::next_symbol method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} fail
+ * @summary Record why compiling failed, and where
+ * @param {char*} reason - What is wrong with the expression
+ * @returns {bool} - Always false, so parse methods can return it
+ */
+bool FilterProgram::fail(const char* reason)
+{
+    if (message.empty()) message = string(reason) + " at position " + std::to_string(position + 1);
+
+    return false;
+} // @end FilterProgram::fail method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} emit
+ * @summary Append an instruction, tracking how deep the evaluation stack gets
+ * @param {filter_op_t} op - The instruction
+ * @param {uint32_t} arg - Constant index, jump target, or piece delimiter index
+ * @param {uint32_t} arg2 - Piece number
+ * @returns {void}
+ */
+void FilterProgram::emit(const filter_op_t op, const uint32_t arg, const uint32_t arg2)
+{
+    code.push_back(FilterInstruction {op, arg, arg2});
+
+    if (op <= FILTER_CONST) {
+        depth++;
+    } else if (op == FILTER_BETWEEN) {
+        depth -= 2;
+    } else if (op != FILTER_PIECE && op != FILTER_NOT) {
+        depth--;
+    }
+
+    if (depth > max_depth) max_depth = depth;
+
+    return;
+} // @end FilterProgram::emit method
+
+/*
+ * @class nodem::FilterProgram
+ * @method {instance} {private} skip_space
+ * @summary Move past any white space
+ * @returns {void}
+ */
+void FilterProgram::skip_space(void)
+{
+    while (position < text.length() && isspace(static_cast<unsigned char>(text[position]))) position++;
+
+    return;
+} // @end FilterProgram::skip_space method
+
+/*
+ * @function nodem::filter_compile
+ * @summary Compile a filter expression, reusing the program from an earlier page of the same scan when there is one
+ * @param {string} expression - The filter expression
+ * @param {string} error - Why it did not compile, on output
+ * @returns {filter_ptr_t} - The compiled program, or empty if it did not compile
+ */
+filter_ptr_t filter_compile(const string& expression, string& error)
+{
+    // Each thread only compiles its own calls, so its cache needs no lock
+    static thread_local map<string, filter_ptr_t> cache;
+
+    map<string, filter_ptr_t>::const_iterator cached = cache.find(expression);
+
+    if (cached != cache.end()) return cached->second;
+
+    std::shared_ptr<FilterProgram> program = std::make_shared<FilterProgram>();
+
+    if (!program->compile(expression)) {
+        error = program->error();
+        return filter_ptr_t {};
+    }
+
+    if (cache.size() >= FILTER_CACHE) cache.clear();
+
+    cache[expression] = program;
+
+    return program;
+} // @end nodem::filter_compile function
+
+} // @end namespace nodem
@@ -0,0 +1,125 @@
+/*
+ * Package:    NodeM
+ * File:       filter.hh
+ * Summary:    Compile scan filter expressions in to bytecode, and run them against each node a scan visits
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef FILTER_HH
+#   define FILTER_HH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILTER_STACK   64
+#define FILTER_NESTING 32
+#define FILTER_CACHE   64
+
+namespace nodem {
+
+enum filter_op_t : uint8_t {
+    FILTER_SUBSCRIPT,
+    FILTER_VALUE,
+    FILTER_DATA,
+    FILTER_CONST,
+    FILTER_PIECE,
+    FILTER_EQ,
+    FILTER_NE,
+    FILTER_LT,
+    FILTER_LE,
+    FILTER_GT,
+    FILTER_GE,
+    FILTER_STARTS,
+    FILTER_CONTAINS,
+    FILTER_BETWEEN,
+    FILTER_NOT,
+    FILTER_JUMP_FALSE,
+    FILTER_JUMP_TRUE
+};
+
+/*
+ * @struct nodem::FilterInstruction
+ * @summary One bytecode instruction; arg is a constant index, jump target, or piece delimiter, and arg2 a piece number
+ * @member {filter_op_t} op
+ * @member {uint32_t} arg
+ * @member {uint32_t} arg2
+ */
+struct FilterInstruction {
+    filter_op_t op;
+    uint32_t    arg;
+    uint32_t    arg2;
+}; // @end nodem::FilterInstruction struct
+
+/*
+ * @class nodem::FilterProgram
+ * @summary A filter expression, compiled once in to stack-machine bytecode, and run against each node a scan visits
+ * @constructor FilterProgram
+ * @method {instance} compile
+ * @method {instance} match
+ * @method {instance} error
+ * @member {vector<FilterInstruction>} {private} code
+ * @member {vector<string>} {private} constants
+ * @member {string} {private} text
+ * @member {string} {private} message
+ * @member {size_t} {private} position
+ * @member {unsigned int} {private} depth
+ * @member {unsigned int} {private} max_depth
+ * @member {unsigned int} {private} nesting
+ */
+class FilterProgram {
+public:
+    FilterProgram();
+
+    bool compile(const std::string&);
+    bool match(const std::string&, const std::string&, const unsigned int) const;
+    const std::string& error(void) const;
+
+private:
+    bool parse_or(void);
+    bool parse_and(void);
+    bool parse_not(void);
+    bool parse_comparison(void);
+    bool parse_operand(void);
+    bool parse_string(std::string&);
+    bool parse_number(std::string&);
+    bool next_word(const char*);
+    bool next_symbol(const char*);
+    bool fail(const char*);
+    void emit(const filter_op_t, const uint32_t = 0, const uint32_t = 0);
+    void skip_space(void);
+
+    std::vector<FilterInstruction> code;
+    std::vector<std::string>        constants;
+    std::string                     text;
+    std::string                     message;
+    size_t                          position;
+    unsigned int                    depth;
+    unsigned int                    max_depth;
+    unsigned int                    nesting;
+}; // @end nodem::FilterProgram class
+
+typedef std::shared_ptr<const FilterProgram> filter_ptr_t;
+
+filter_ptr_t filter_compile(const std::string&, std::string&);
+
+} // @end namespace nodem
+
+#endif // @end FILTER_HH
@@ -25,10 +25,110 @@
 
 using std::boolalpha;
 using std::cerr;
+using std::string;
+using std::vector;
 
 namespace gtm {
 
 #if NODEM_SIMPLE_API == 0
+/*
+ * @function {private} gtm::fixed_arguments
+ * @summary Decode subscripts (or a data node) encoded by nodem::encode_arguments, for the fixed-arity Call-in entry points
+ * @param {string} args - Subscripts or data, encoded as length:data pairs separated by commas
+ * @param {mode_t} mode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ * @param {vector<string>} subs - Filled with each subscript's value, without M quoting
+ * @returns {bool} - Whether the arguments decoded cleanly, and fit a fixed-arity entry point
+ */
+static bool fixed_arguments(const string& args, const nodem::mode_t mode, vector<string>& subs)
+{
+    size_t position = 0;
+
+    while (position < args.length()) {
+        size_t colon = args.find(':', position);
+
+        if (colon == string::npos || subs.size() == FIXED_MAX) return false;
+
+        size_t length = strtoul(args.c_str() + position, NULL, 10);
+
+        if (colon + 1 + length > args.length()) return false;
+
+        string data = args.substr(colon + 1, length);
+
+        // Mirrors inputConvert in v4wNode.m: strings lose their quotes, and short numbers lose their leading zero
+        if (length > 1 && data[0] == '"' && data[length - 1] == '"') {
+            data = data.substr(1, length - 2);
+        } else if (mode == nodem::CANONICAL && length <= 16 && data.find('e') == string::npos) {
+            if (data.substr(0, 2) == "0.") data = data.substr(1, string::npos);
+            if (data.substr(0, 3) == "-0.") data = "-" + data.substr(2, string::npos);
+        }
+
+        subs.push_back(std::move(data));
+        position = colon + 1 + length + 1;
+    }
+
+    return true;
+} // @end gtm::fixed_arguments function
+
+/*
+ * @function {private} gtm::fixed_call
+ * @summary Call a fixed-arity entry point in v4wNode.m, passing each subscript as its own argument, avoiding any M parsing
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {mode_t} mode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ * @member {gtm_char_t*} result - Data returned from YottaDB/GT.M, via the Call-in interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @param {char*} api - Call-in table entry prefix (data, get, set, order, or previous)
+ * @param {vector<string>} subs - Subscripts, from fixed_arguments
+ * @param {string*} value - Data to set, from fixed_arguments; only used by set
+ * @returns {gtm_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+static gtm_status_t fixed_call(nodem::NodemBaton* nodem_baton, const char* api, const vector<string>& subs,
+  const string* value = NULL)
+{
+    gtm_char_t gtm_fixed[32];
+    snprintf(gtm_fixed, sizeof(gtm_fixed), "%s_%u", api, static_cast<unsigned int>(subs.size()));
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call fixed-arity entry point: ", gtm_fixed);
+
+    const gtm_char_t* sub[FIXED_MAX];
+
+    for (unsigned int i = 0; i < FIXED_MAX; i++) sub[i] = (i < subs.size()) ? subs[i].c_str() : "";
+
+    /*
+     * Every slot is always passed, so one call covers each depth; the Call-in interface only reads as many of the
+     * trailing arguments as the entry point's signature in nodem.ci declares
+     */
+    const gtm_char_t* name = nodem_baton->name.c_str();
+    gtm_status_t status;
+
+#if NODEM_CIP_API == 1
+    ci_name_descriptor fixed_access;
+
+    fixed_access.rtn_name.address = gtm_fixed;
+    fixed_access.rtn_name.length = strlen(gtm_fixed);
+    fixed_access.handle = NULL;
+
+    if (value) {
+        status = gtm_cip(&fixed_access, nodem_baton->mode, name, value->c_str(),
+                 sub[0], sub[1], sub[2], sub[3], sub[4], sub[5], sub[6], sub[7]);
+    } else {
+        status = gtm_cip(&fixed_access, nodem_baton->result, nodem_baton->mode, name,
+                 sub[0], sub[1], sub[2], sub[3], sub[4], sub[5], sub[6], sub[7]);
+    }
+#else
+    if (value) {
+        status = gtm_ci(gtm_fixed, nodem_baton->mode, name, value->c_str(),
+                 sub[0], sub[1], sub[2], sub[3], sub[4], sub[5], sub[6], sub[7]);
+    } else {
+        status = gtm_ci(gtm_fixed, nodem_baton->result, nodem_baton->mode, name,
+                 sub[0], sub[1], sub[2], sub[3], sub[4], sub[5], sub[6], sub[7]);
+    }
+#endif
+
+    return status;
+} // @end gtm::fixed_call function
+
 // ***Begin Public APIs***
 
 /*
@@ -56,7 +156,7 @@ gtm_status_t data(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -68,22 +168,28 @@ gtm_status_t data(nodem::NodemBaton* nodem_baton)
         flockfile(stderr);
     }
 
-    gtm_char_t gtm_data[] = "data";
+    vector<string> subs;
+
+    if (nodem_baton->name[0] != '$' && fixed_arguments(nodem_baton->args, nodem_baton->mode, subs)) {
+        status = fixed_call(nodem_baton, "data", subs);
+    } else {
+        gtm_char_t gtm_data[] = "data";
 
 #if NODEM_CIP_API == 1
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
 
-    ci_name_descriptor data_access;
+        ci_name_descriptor data_access;
 
-    data_access.rtn_name.address = gtm_data;
-    data_access.rtn_name.length = strlen(gtm_data);
-    data_access.handle = NULL;
+        data_access.rtn_name.address = gtm_data;
+        data_access.rtn_name.length = strlen(gtm_data);
+        data_access.handle = NULL;
 
-    status = gtm_cip(&data_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        status = gtm_cip(&data_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #else
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
-    status = gtm_ci(gtm_data, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+        status = gtm_ci(gtm_data, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #endif
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
@@ -98,7 +204,7 @@ gtm_status_t data(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::data exit");
 
     return status;
@@ -129,7 +235,7 @@ gtm_status_t get(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -141,22 +247,28 @@ gtm_status_t get(nodem::NodemBaton* nodem_baton)
         flockfile(stderr);
     }
 
-    gtm_char_t gtm_get[] = "get";
+    vector<string> subs;
+
+    if (nodem_baton->name[0] != '$' && fixed_arguments(nodem_baton->args, nodem_baton->mode, subs)) {
+        status = fixed_call(nodem_baton, "get", subs);
+    } else {
+        gtm_char_t gtm_get[] = "get";
 
 #if NODEM_CIP_API == 1
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
 
-    ci_name_descriptor get_access;
+        ci_name_descriptor get_access;
 
-    get_access.rtn_name.address = gtm_get;
-    get_access.rtn_name.length = strlen(gtm_get);
-    get_access.handle = NULL;
+        get_access.rtn_name.address = gtm_get;
+        get_access.rtn_name.length = strlen(gtm_get);
+        get_access.handle = NULL;
 
-    status = gtm_cip(&get_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        status = gtm_cip(&get_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #else
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
-    status = gtm_ci(gtm_get, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+        status = gtm_ci(gtm_get, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #endif
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
@@ -171,7 +283,7 @@ gtm_status_t get(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::get exit");
 
     return status;
@@ -203,7 +315,7 @@ gtm_status_t set(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -215,23 +327,30 @@ gtm_status_t set(nodem::NodemBaton* nodem_baton)
         flockfile(stderr);
     }
 
-    gtm_char_t gtm_set[] = "set";
+    vector<string> subs, value;
+
+    if (nodem_baton->name[0] != '$' && fixed_arguments(nodem_baton->args, nodem_baton->mode, subs) &&
+      fixed_arguments(nodem_baton->value, nodem_baton->mode, value) && value.size() == 1) {
+        status = fixed_call(nodem_baton, "set", subs, &value[0]);
+    } else {
+        gtm_char_t gtm_set[] = "set";
 
 #if NODEM_CIP_API == 1
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
 
-    ci_name_descriptor set_access;
+        ci_name_descriptor set_access;
 
-    set_access.rtn_name.address = gtm_set;
-    set_access.rtn_name.length = strlen(gtm_set);
-    set_access.handle = NULL;
+        set_access.rtn_name.address = gtm_set;
+        set_access.rtn_name.length = strlen(gtm_set);
+        set_access.handle = NULL;
 
-    status = gtm_cip(&set_access, nodem_baton->name.c_str(), nodem_baton->args.c_str(),
-             nodem_baton->value.c_str(), nodem_baton->mode);
+        status = gtm_cip(&set_access, nodem_baton->name.c_str(), nodem_baton->args.c_str(),
+                 nodem_baton->value.c_str(), nodem_baton->mode);
 #else
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
-    status = gtm_ci(gtm_set, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->value.c_str(), nodem_baton->mode);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+        status = gtm_ci(gtm_set, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->value.c_str(), nodem_baton->mode);
 #endif
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
@@ -246,7 +365,7 @@ gtm_status_t set(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::set exit");
 
     return status;
@@ -278,7 +397,7 @@ gtm_status_t kill(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -320,7 +439,7 @@ gtm_status_t kill(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::kill exit");
 
     return status;
@@ -351,7 +470,7 @@ gtm_status_t order(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -363,22 +482,28 @@ gtm_status_t order(nodem::NodemBaton* nodem_baton)
         flockfile(stderr);
     }
 
-    gtm_char_t gtm_order[] = "order";
+    vector<string> subs;
+
+    if (!nodem_baton->args.empty() && fixed_arguments(nodem_baton->args, nodem_baton->mode, subs)) {
+        status = fixed_call(nodem_baton, "order", subs);
+    } else {
+        gtm_char_t gtm_order[] = "order";
 
 #if NODEM_CIP_API == 1
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
 
-    ci_name_descriptor order_access;
+        ci_name_descriptor order_access;
 
-    order_access.rtn_name.address = gtm_order;
-    order_access.rtn_name.length = strlen(gtm_order);
-    order_access.handle = NULL;
+        order_access.rtn_name.address = gtm_order;
+        order_access.rtn_name.length = strlen(gtm_order);
+        order_access.handle = NULL;
 
-    status = gtm_cip(&order_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        status = gtm_cip(&order_access, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #else
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
-    status = gtm_ci(gtm_order, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+        status = gtm_ci(gtm_order, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #endif
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
@@ -393,7 +518,7 @@ gtm_status_t order(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::order exit");
 
     return status;
@@ -424,7 +549,7 @@ gtm_status_t previous(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -436,23 +561,29 @@ gtm_status_t previous(nodem::NodemBaton* nodem_baton)
         flockfile(stderr);
     }
 
-    gtm_char_t gtm_previous[] = "previous";
+    vector<string> subs;
+
+    if (!nodem_baton->args.empty() && fixed_arguments(nodem_baton->args, nodem_baton->mode, subs)) {
+        status = fixed_call(nodem_baton, "previous", subs);
+    } else {
+        gtm_char_t gtm_previous[] = "previous";
 
 #if NODEM_CIP_API == 1
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
 
-    ci_name_descriptor previous_access;
+        ci_name_descriptor previous_access;
 
-    previous_access.rtn_name.address = gtm_previous;
-    previous_access.rtn_name.length = strlen(gtm_previous);
-    previous_access.handle = NULL;
+        previous_access.rtn_name.address = gtm_previous;
+        previous_access.rtn_name.length = strlen(gtm_previous);
+        previous_access.handle = NULL;
 
-    status = gtm_cip(&previous_access, nodem_baton->result, nodem_baton->name.c_str(),
-             nodem_baton->args.c_str(), nodem_baton->mode);
+        status = gtm_cip(&previous_access, nodem_baton->result, nodem_baton->name.c_str(),
+                 nodem_baton->args.c_str(), nodem_baton->mode);
 #else
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
-    status = gtm_ci(gtm_previous, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+        status = gtm_ci(gtm_previous, nodem_baton->result, nodem_baton->name.c_str(), nodem_baton->args.c_str(), nodem_baton->mode);
 #endif
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
@@ -467,7 +598,7 @@ gtm_status_t previous(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::previous exit");
 
     return status;
@@ -498,7 +629,7 @@ gtm_status_t next_node(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -541,7 +672,7 @@ gtm_status_t next_node(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::next_node exit");
 
     return status;
@@ -572,7 +703,7 @@ gtm_status_t previous_node(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -617,7 +748,7 @@ gtm_status_t previous_node(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::previous_node exit");
 
     return status;
@@ -650,7 +781,7 @@ gtm_status_t increment(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -695,7 +826,7 @@ gtm_status_t increment(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::increment exit");
 
     return status;
@@ -727,8 +858,10 @@ gtm_status_t lock(nodem::NodemBaton* nodem_baton)
     }
 
     gtm_status_t status;
+    uint64_t start;
+    uint64_t wait;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -751,13 +884,17 @@ gtm_status_t lock(nodem::NodemBaton* nodem_baton)
     lock_access.rtn_name.length = strlen(gtm_lock);
     lock_access.handle = NULL;
 
+    start = uv_hrtime();
     status = gtm_cip(&lock_access, nodem_baton->result, nodem_baton->name.c_str(),
              nodem_baton->args.c_str(), nodem_baton->option, nodem_baton->mode);
+    wait = uv_hrtime() - start;
 #else
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
 
+    start = uv_hrtime();
     status = gtm_ci(gtm_lock, nodem_baton->result, nodem_baton->name.c_str(),
              nodem_baton->args.c_str(), nodem_baton->option, nodem_baton->mode);
+    wait = uv_hrtime() - start;
 #endif
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
@@ -773,7 +910,13 @@ gtm_status_t lock(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
+
+    if (status == EXIT_SUCCESS) {
+        nodem::lock_stats_acquire(nodem::lock_resource(nodem_baton->name, nodem_baton->args), nodem_baton->nodem_state->tid,
+          wait, strstr(nodem_baton->result, "true") != NULL);
+    }
+
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::lock exit");
 
     return status;
@@ -803,7 +946,7 @@ gtm_status_t unlock(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    uv_mutex_lock(&nodem::mutex_g);
+    nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -845,7 +988,12 @@ gtm_status_t unlock(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    uv_mutex_unlock(&nodem::mutex_g);
+    nodem::unlock_mutex();
+
+    if (status == EXIT_SUCCESS) {
+        nodem::lock_stats_release(nodem::lock_resource(nodem_baton->name, nodem_baton->args), nodem_baton->nodem_state->tid);
+    }
+
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::unlock exit");
 
     return status;
@@ -871,7 +1019,7 @@ gtm_status_t version(nodem::NodemBaton* nodem_baton)
     gtm_status_t status;
 
     if (nodem::nodem_state_g < nodem::OPEN) return 0;
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -913,7 +1061,7 @@ gtm_status_t version(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::version exit");
 
     return status;
@@ -947,7 +1095,9 @@ gtm_status_t merge(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    nodem::move_written(nodem_baton->to_name, nodem_baton->to_subs_array, true);
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -992,7 +1142,7 @@ gtm_status_t merge(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::merge exit");
 
     return status;
@@ -1027,7 +1177,10 @@ gtm_status_t function(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    // M code can write any node, so every tree being moved has to be brought up to date in full
+    nodem::move_written_all();
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -1072,7 +1225,7 @@ gtm_status_t function(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::function exit");
 
     return status;
@@ -1106,7 +1259,9 @@ gtm_status_t procedure(nodem::NodemBaton* nodem_baton)
 
     gtm_status_t status;
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    nodem::move_written_all();
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) {
         if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -1151,12 +1306,86 @@ gtm_status_t procedure(nodem::NodemBaton* nodem_baton)
         }
     }
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::procedure exit");
 
     return status;
 } // @end gtm::procedure function
 
+/*
+ * @function gtm::batch
+ * @summary Run several data, get, set, kill, order, previous, or increment operations in one Call-in
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name of the first operation
+ * @member {string} args - Operations, four fields each, encoded with their lengths
+ * @member {mode_t} mode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ * @member {gtm_char_t*} result - Data returned from YottaDB/GT.M, via the Call-in interface
+ * @member {gtm_char_t*} error - Error message returned from YottaDB/GT.M, via the Call-in interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {gtm_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+gtm_status_t batch(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::batch enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    operations: ", nodem_baton->args);
+        nodem::debug_log(">>>    mode: ", nodem_baton->mode);
+    }
+
+    gtm_status_t status;
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    nodem::move_written_all();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
+            char error[BUFSIZ];
+
+            cerr << strerror_r(errno, error, BUFSIZ);
+        }
+
+        flockfile(stderr);
+    }
+
+    gtm_char_t gtm_batch[] = "batch";
+
+#if NODEM_CIP_API == 1
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_cip");
+
+    ci_name_descriptor batch_access;
+
+    batch_access.rtn_name.address = gtm_batch;
+    batch_access.rtn_name.length = strlen(gtm_batch);
+    batch_access.handle = NULL;
+
+    status = gtm_cip(&batch_access, nodem_baton->result, nodem_baton->args.c_str(), nodem_baton->mode);
+#else
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using gtm_ci");
+    status = gtm_ci(gtm_batch, nodem_baton->result, nodem_baton->args.c_str(), nodem_baton->mode);
+#endif
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != EXIT_SUCCESS) gtm_zstatus(nodem_baton->error, ERR_LEN);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        funlockfile(stderr);
+
+        if (dup2(nodem::save_stdout_g, STDOUT_FILENO) == -1) {
+            char error[BUFSIZ];
+
+            cerr << strerror_r(errno, error, BUFSIZ);
+        }
+    }
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   gtm::batch exit");
+
+    return status;
+} // @end gtm::batch function
+
 // ***End Public APIs***
 
 } // @end gtm namespace
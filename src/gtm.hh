@@ -26,6 +26,9 @@
 
 #include "nodem.hh"
 
+// Deepest subscript count with its own fixed-arity entry point in v4wNode.m and nodem.ci
+#define FIXED_MAX 8
+
 namespace gtm {
 
 #if NODEM_SIMPLE_API == 0
@@ -46,6 +49,7 @@ gtm_status_t version(nodem::NodemBaton*);
 gtm_status_t merge(nodem::NodemBaton*);
 gtm_status_t function(nodem::NodemBaton*);
 gtm_status_t procedure(nodem::NodemBaton*);
+gtm_status_t batch(nodem::NodemBaton*);
 
 } // @end gtm namespace
 
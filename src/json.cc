@@ -0,0 +1,897 @@
+/*
+ * Package:    NodeM
+ * File:       json.cc
+ * Summary:    Native JSON serialization and parsing of global and local subtrees
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "json.hh"
+#include "utility.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+/*
+ * @class nodem::JsonWriter
+ * @constructor JsonWriter
+ * @summary Start the JSON text of a subtree
+ * @param {json_shape_t} shape - JSON_NESTED for an object per node with children, or JSON_FLAT for an array of nodes
+ * @param {bool} utf8 - Whether the data is UTF-8, or bytes, which are written as \u00XX escapes
+ * @param {bool} canonical - Whether to write canonical numbers as JSON numbers, rather than strings
+ * @param {vector<string>} root - Subscripts of the root of the subtree
+ */
+JsonWriter::JsonWriter(const json_shape_t shape, const bool utf8, const bool canonical, const vector<string>& root) :
+    root {root},
+    shape {shape},
+    utf8 {utf8},
+    canonical {canonical},
+    has_pending {false},
+    started {false}
+{
+    buffer.reserve(65536);
+    return;
+}
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} {private} write_string
+ * @summary Write a JSON string, escaping quotes, backslashes, control characters, and bytes that are not UTF-8 data
+ * @param {string} data - The subscript or value to write
+ * @returns {void}
+ */
+void JsonWriter::write_string(const string& data)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    buffer.push_back('"');
+
+    for (const char c : data) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+
+        if (byte == '"' || byte == '\\') {
+            buffer.push_back('\\');
+            buffer.push_back(c);
+        } else if (byte == '\n') {
+            buffer.append("\\n");
+        } else if (byte == '\r') {
+            buffer.append("\\r");
+        } else if (byte == '\t') {
+            buffer.append("\\t");
+        } else if (byte < 0x20 || byte == 0x7F || (byte >= 0x80 && !utf8)) {
+            buffer.append("\\u00");
+            buffer.push_back(hex[byte >> 4]);
+            buffer.push_back(hex[byte & 0x0F]);
+        } else {
+            buffer.push_back(c);
+        }
+    }
+
+    buffer.push_back('"');
+    return;
+} // @end JsonWriter::write_string method
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} {private} write_value
+ * @summary Write a subscript or value, as a JSON number in canonical mode when it is a canonical number, otherwise as a string
+ * @param {string} data - The subscript or value to write
+ * @returns {void}
+ */
+void JsonWriter::write_value(const string& data)
+{
+    if (!canonical || !is_number(data)) {
+        write_string(data);
+        return;
+    }
+
+    // M drops the leading zero of a fraction, e.g. .5 and -.5, which JSON requires
+    if (data[0] == '.') {
+        buffer.push_back('0');
+    } else if (data[0] == '-' && data[1] == '.') {
+        buffer.append("-0");
+        buffer.append(data, 1, string::npos);
+
+        return;
+    }
+
+    buffer.append(data);
+    return;
+} // @end JsonWriter::write_value method
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} {private} write_key
+ * @summary Write an object key, after a comma if it is not the first one in its object
+ * @param {string} key - The subscript to write
+ * @returns {void}
+ */
+void JsonWriter::write_key(const string& key)
+{
+    if (!first.back()) buffer.push_back(',');
+
+    first.back() = false;
+
+    write_string(key);
+    buffer.push_back(':');
+
+    return;
+} // @end JsonWriter::write_key method
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} {private} write_node
+ * @summary Write the pending node, closing the objects it is not in, and opening the ones it is in that have no value
+ * @param {bool} has_children - Whether the next node is a child of the pending one, so that it is written as an object
+ * @returns {void}
+ */
+void JsonWriter::write_node(const bool has_children)
+{
+    // Flat subscripts are relative to the root, as fromJSON appends them to the root it is given
+    if (shape == JSON_FLAT) {
+        buffer.push_back(started ? ',' : '[');
+        buffer.append("{\"subscripts\":[");
+
+        for (size_t i = root.size(); i < pending.size(); i++) {
+            if (i > root.size()) buffer.push_back(',');
+            write_value(pending[i]);
+        }
+
+        buffer.append("],\"data\":");
+        write_value(pending_value);
+        buffer.push_back('}');
+
+        started = true;
+        return;
+    }
+
+    const size_t depth = root.size();
+
+    // The root is written as its value, or as an object with its value under the empty key, when it has children
+    if (pending.size() == depth) {
+        started = true;
+
+        if (!has_children) {
+            write_value(pending_value);
+            return;
+        }
+
+        buffer.push_back('{');
+        first.push_back(true);
+
+        write_key("");
+        write_value(pending_value);
+
+        return;
+    }
+
+    if (!started) {
+        buffer.push_back('{');
+        first.push_back(true);
+
+        started = true;
+    }
+
+    const size_t level = pending.size() - depth;
+
+    while (!open.empty() && !(open.size() < level && std::equal(open.begin(), open.end(), pending.begin() + depth))) {
+        buffer.push_back('}');
+
+        open.pop_back();
+        first.pop_back();
+    }
+
+    for (size_t i = open.size(); i + 1 < level; i++) {
+        write_key(pending[depth + i]);
+        buffer.push_back('{');
+
+        open.push_back(pending[depth + i]);
+        first.push_back(true);
+    }
+
+    write_key(pending.back());
+
+    if (has_children) {
+        buffer.push_back('{');
+
+        open.push_back(pending.back());
+        first.push_back(true);
+
+        write_key("");
+    }
+
+    write_value(pending_value);
+    return;
+} // @end JsonWriter::write_node method
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} add
+ * @summary Add a node that has a value; nodes must be added depth first, in collation order, starting with the root if it has a value
+ * @param {vector<string>} subs - Subscripts of the node, starting with those of the root
+ * @param {string} value - Value of the node
+ * @returns {void}
+ */
+void JsonWriter::add(const vector<string>& subs, const string& value)
+{
+    // Whether a node is written as a value or an object depends on whether the next node is one of its children
+    if (has_pending) {
+        write_node(subs.size() > pending.size() && std::equal(pending.begin(), pending.end(), subs.begin()));
+    }
+
+    pending = subs;
+    pending_value = value;
+    has_pending = true;
+
+    return;
+} // @end JsonWriter::add method
+
+/*
+ * @class nodem::JsonWriter
+ * @method {instance} finish
+ * @summary Write the last node, close every open object or array, and hand over the text, which leaves the writer empty
+ * @returns {string} - The JSON text; null, or an empty array, when no nodes were added
+ */
+string JsonWriter::finish(void)
+{
+    if (has_pending) write_node(false);
+
+    has_pending = false;
+
+    if (shape == JSON_FLAT) {
+        buffer.append(started ? "]" : "[]");
+    } else if (!started) {
+        buffer.append("null");
+    } else {
+        buffer.append(first.size(), '}');
+    }
+
+    open.clear();
+    first.clear();
+
+    string text;
+    text.swap(buffer);
+
+    return text;
+} // @end JsonWriter::finish method
+
+/*
+ * @class nodem::JsonReader
+ * @constructor JsonReader
+ * @summary Set up a parse of JSON text, which is not copied, so it must outlive the reader
+ * @param {char*} data - The JSON text, encoded as UTF-8
+ * @param {size_t} length - Length of the JSON text in bytes
+ * @param {json_shape_t} shape - JSON_NESTED for objects and arrays keyed by subscript, or JSON_FLAT for an array of nodes
+ * @param {bool} utf8 - Whether to store strings as UTF-8, or as bytes, which only allows characters up to U+00FF
+ * @param {bool} canonical - Whether to convert JSON numbers to M canonical numbers, e.g. 0.50 to .5
+ * @param {size_t} max_subs - Maximum number of subscripts a node can have
+ */
+JsonReader::JsonReader(const char* data, const size_t length, const json_shape_t shape, const bool utf8, const bool canonical,
+  const size_t max_subs) :
+    data {data},
+    length {length},
+    position {0},
+    max_subs {max_subs},
+    nesting {0},
+    shape {shape},
+    utf8 {utf8},
+    canonical {canonical}
+{
+    return;
+}
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} error
+ * @summary Describe why the last parse failed
+ * @returns {string} - The error message, with the byte offset it happened at; empty if the parse did not fail on the JSON text
+ */
+const string& JsonReader::error(void) const
+{
+    return message;
+} // @end JsonReader::error method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} fail
+ * @summary Record a syntax error at the current position
+ * @param {char*} reason - What was wrong
+ * @returns {json_result_t} - JSON_SYNTAX
+ */
+json_result_t JsonReader::fail(const char* reason)
+{
+    char prefix[64];
+
+    snprintf(prefix, sizeof(prefix), "Invalid JSON at byte %lu: ", static_cast<unsigned long>(position));
+
+    message = string {prefix} + reason;
+    return JSON_SYNTAX;
+} // @end JsonReader::fail method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} skip_space
+ * @summary Move past JSON whitespace
+ * @returns {void}
+ */
+void JsonReader::skip_space(void)
+{
+    while (position < length && (data[position] == ' ' || data[position] == '\t' || data[position] == '\n' || data[position] == '\r')) {
+        position++;
+    }
+
+    return;
+} // @end JsonReader::skip_space method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} literal
+ * @summary Move past a keyword, if it is next
+ * @param {char*} word - The keyword: true, false, or null
+ * @returns {bool} - Whether the keyword was next
+ */
+bool JsonReader::literal(const char* word)
+{
+    size_t size = strlen(word);
+
+    if (length - position < size || strncmp(data + position, word, size) != 0) return false;
+
+    position += size;
+    return true;
+} // @end JsonReader::literal method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} parse_string
+ * @summary Parse a JSON string, decoding its escapes, and encoding it as UTF-8 or as bytes
+ * @param {string} value - The decoded string, on output
+ * @returns {json_result_t} - JSON_OK, or JSON_SYNTAX
+ */
+json_result_t JsonReader::parse_string(string& value)
+{
+    value.clear();
+    position++;
+
+    while (position < length) {
+        unsigned char byte = static_cast<unsigned char>(data[position]);
+        unsigned long code;
+
+        if (byte == '"') {
+            position++;
+            return JSON_OK;
+        } else if (byte < 0x20) {
+            return fail("control character in a string");
+        } else if (byte == '\\') {
+            if (++position >= length) break;
+
+            switch (data[position++]) {
+                case '"':  code = '"'; break;
+                case '\\': code = '\\'; break;
+                case '/':  code = '/'; break;
+                case 'b':  code = '\b'; break;
+                case 'f':  code = '\f'; break;
+                case 'n':  code = '\n'; break;
+                case 'r':  code = '\r'; break;
+                case 't':  code = '\t'; break;
+                case 'u': {
+                    if (length - position < 4) return fail("truncated \\u escape");
+
+                    char hex[5] = {data[position], data[position + 1], data[position + 2], data[position + 3], '\0'};
+                    char* end;
+
+                    code = strtoul(hex, &end, 16);
+
+                    if (end != hex + 4) return fail("invalid \\u escape");
+
+                    position += 4;
+
+                    // A surrogate pair is two escapes, which together make one character above U+FFFF
+                    if (code >= 0xD800 && code <= 0xDBFF && length - position >= 6 && data[position] == '\\' &&
+                      data[position + 1] == 'u') {
+                        char low_hex[5] = {data[position + 2], data[position + 3], data[position + 4], data[position + 5], '\0'};
+                        unsigned long low = strtoul(low_hex, &end, 16);
+
+                        if (end == low_hex + 4 && low >= 0xDC00 && low <= 0xDFFF) {
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                            position += 6;
+                        }
+                    }
+
+                    break;
+                }
+                default:
+                    position--;
+                    return fail("invalid escape in a string");
+            }
+        } else if (byte < 0x80 || utf8) {
+            // UTF-8 text is stored as it is, so only escapes need encoding
+            value.push_back(static_cast<char>(byte));
+            position++;
+
+            continue;
+        } else {
+            unsigned int extra = (byte >= 0xF0) ? 3 : (byte >= 0xE0) ? 2 : (byte >= 0xC0) ? 1 : 0;
+
+            if (extra == 0 || length - position <= extra) return fail("invalid UTF-8 in a string");
+
+            code = byte & (0x3F >> extra);
+
+            for (unsigned int i = 1; i <= extra; i++) code = (code << 6) | (static_cast<unsigned char>(data[position + i]) & 0x3F);
+
+            position += extra + 1;
+        }
+
+        if (!utf8) {
+            if (code > 0xFF) return fail("character above U+00FF in M mode");
+
+            value.push_back(static_cast<char>(code));
+        } else if (code < 0x80) {
+            value.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            value.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            value.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            value.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            value.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    return fail("unterminated string");
+} // @end JsonReader::parse_string method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} parse_number
+ * @summary Parse a JSON number, converting it to an M canonical number in canonical mode
+ * @param {string} value - The number, on output
+ * @returns {json_result_t} - JSON_OK, or JSON_SYNTAX
+ */
+json_result_t JsonReader::parse_number(string& value)
+{
+    size_t start = position;
+
+    if (position < length && data[position] == '-') position++;
+
+    size_t digits = position;
+
+    while (position < length && isdigit(static_cast<unsigned char>(data[position]))) position++;
+
+    if (position == digits) return fail("invalid number");
+
+    if (position < length && data[position] == '.') {
+        size_t fraction = ++position;
+
+        while (position < length && isdigit(static_cast<unsigned char>(data[position]))) position++;
+
+        if (position == fraction) return fail("invalid number");
+    }
+
+    if (position < length && (data[position] == 'e' || data[position] == 'E')) {
+        position++;
+
+        if (position < length && (data[position] == '+' || data[position] == '-')) position++;
+
+        size_t exponent = position;
+
+        while (position < length && isdigit(static_cast<unsigned char>(data[position]))) position++;
+
+        if (position == exponent) return fail("invalid number");
+    }
+
+    value.assign(data + start, position - start);
+
+    if (!canonical || (is_number(value) && value.compare(0, 2, "-0") != 0)) return JSON_OK;
+
+    // M drops leading zeros of a fraction, and trailing zeros after a decimal point, e.g. 0.50 is .5
+    char number[32];
+
+    snprintf(number, sizeof(number), "%.15g", strtod(value.c_str(), NULL));
+    value = number;
+
+    if (value.compare(0, 2, "0.") == 0) {
+        value.erase(0, 1);
+    } else if (value.compare(0, 3, "-0.") == 0) {
+        value.erase(1, 1);
+    } else if (value == "-0") {
+        value = "0";
+    }
+
+    return JSON_OK;
+} // @end JsonReader::parse_number method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} parse_scalar
+ * @summary Parse a string, number, true, false, or null
+ * @param {string} value - The value, on output; true is 1 and false is 0
+ * @param {bool} present - Whether there is a value, which is false for null
+ * @returns {json_result_t} - JSON_OK, or JSON_SYNTAX
+ */
+json_result_t JsonReader::parse_scalar(string& value, bool& present)
+{
+    skip_space();
+
+    if (position >= length) return fail("unexpected end of text");
+
+    present = true;
+
+    char c = data[position];
+
+    if (c == '"') return parse_string(value);
+    if (c == '-' || isdigit(static_cast<unsigned char>(c))) return parse_number(value);
+
+    if (literal("true")) {
+        value = "1";
+    } else if (literal("false")) {
+        value = "0";
+    } else if (literal("null")) {
+        present = false;
+    } else {
+        return fail("expected a string, number, true, false, or null");
+    }
+
+    return JSON_OK;
+} // @end JsonReader::parse_scalar method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} parse_node
+ * @summary Parse a value in the nested shape, setting scalars at the current subscripts, and recursing in to objects and arrays
+ * @returns {json_result_t} - JSON_OK, JSON_SYNTAX, JSON_DEPTH, or JSON_STOPPED if the leaf function failed
+ */
+json_result_t JsonReader::parse_node(void)
+{
+    skip_space();
+
+    if (position >= length) return fail("unexpected end of text");
+
+    char open = data[position];
+
+    if (open != '{' && open != '[') {
+        string value;
+        bool present;
+        json_result_t result = parse_scalar(value, present);
+
+        if (result != JSON_OK) return result;
+        if (present && !leaf(subs, value)) return JSON_STOPPED;
+
+        return JSON_OK;
+    }
+
+    if (++nesting > JSON_NESTING) return fail("nested too deeply");
+
+    char close = (open == '{') ? '}' : ']';
+    unsigned long index = 0;
+
+    position++;
+    skip_space();
+
+    if (position < length && data[position] == close) {
+        position++;
+        nesting--;
+
+        return JSON_OK;
+    }
+
+    while (true) {
+        string key;
+
+        if (open == '{') {
+            skip_space();
+
+            if (position >= length || data[position] != '"') return fail("expected a string key");
+
+            json_result_t result = parse_string(key);
+
+            if (result != JSON_OK) return result;
+
+            skip_space();
+
+            if (position >= length || data[position] != ':') return fail("expected ':'");
+
+            position++;
+        } else {
+            key = std::to_string(index++);
+        }
+
+        // The empty key holds the value of the node itself, as written by JsonWriter
+        bool child = open == '[' || !key.empty();
+
+        if (child) {
+            if (subs.size() >= max_subs) {
+                message = "Too many subscripts";
+                return JSON_DEPTH;
+            }
+
+            subs.push_back(key);
+        }
+
+        json_result_t result = parse_node();
+
+        if (result != JSON_OK) return result;
+        if (child) subs.pop_back();
+
+        skip_space();
+
+        if (position < length && data[position] == ',') {
+            position++;
+        } else if (position < length && data[position] == close) {
+            position++;
+            nesting--;
+
+            return JSON_OK;
+        } else {
+            return fail(open == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+        }
+    }
+} // @end JsonReader::parse_node method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} skip_value
+ * @summary Parse and discard any value, e.g. an unknown property of a node in the flat shape
+ * @returns {json_result_t} - JSON_OK, or JSON_SYNTAX
+ */
+json_result_t JsonReader::skip_value(void)
+{
+    skip_space();
+
+    if (position >= length) return fail("unexpected end of text");
+
+    char open = data[position];
+
+    if (open != '{' && open != '[') {
+        string value;
+        bool present;
+
+        return parse_scalar(value, present);
+    }
+
+    if (++nesting > JSON_NESTING) return fail("nested too deeply");
+
+    char close = (open == '{') ? '}' : ']';
+
+    position++;
+    skip_space();
+
+    if (position < length && data[position] == close) {
+        position++;
+        nesting--;
+
+        return JSON_OK;
+    }
+
+    while (true) {
+        if (open == '{') {
+            string key;
+
+            skip_space();
+
+            if (position >= length || data[position] != '"') return fail("expected a string key");
+
+            json_result_t result = parse_string(key);
+
+            if (result != JSON_OK) return result;
+
+            skip_space();
+
+            if (position >= length || data[position] != ':') return fail("expected ':'");
+
+            position++;
+        }
+
+        json_result_t result = skip_value();
+
+        if (result != JSON_OK) return result;
+
+        skip_space();
+
+        if (position < length && data[position] == ',') {
+            position++;
+        } else if (position < length && data[position] == close) {
+            position++;
+            nesting--;
+
+            return JSON_OK;
+        } else {
+            return fail(open == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+        }
+    }
+} // @end JsonReader::skip_value method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} {private} parse_entry
+ * @summary Parse one node in the flat shape, an object with subscripts and data properties, and set it if it has data
+ * @returns {json_result_t} - JSON_OK, JSON_SYNTAX, JSON_DEPTH, or JSON_STOPPED if the leaf function failed
+ */
+json_result_t JsonReader::parse_entry(void)
+{
+    skip_space();
+
+    if (position >= length || data[position] != '{') return fail("expected an object with subscripts and data");
+
+    const size_t depth = subs.size();
+    string value;
+    bool present = false;
+
+    position++;
+    skip_space();
+
+    if (position < length && data[position] == '}') {
+        position++;
+        return JSON_OK;
+    }
+
+    while (true) {
+        string key;
+
+        skip_space();
+
+        if (position >= length || data[position] != '"') return fail("expected a string key");
+
+        json_result_t result = parse_string(key);
+
+        if (result != JSON_OK) return result;
+
+        skip_space();
+
+        if (position >= length || data[position] != ':') return fail("expected ':'");
+
+        position++;
+
+        if (key == "data") {
+            result = parse_scalar(value, present);
+        } else if (key == "subscripts") {
+            subs.resize(depth);
+            skip_space();
+
+            if (position >= length || data[position] != '[') return fail("expected an array of subscripts");
+
+            position++;
+            skip_space();
+
+            if (position < length && data[position] == ']') {
+                position++;
+            } else {
+                while (result == JSON_OK) {
+                    string subscript;
+                    bool defined;
+
+                    result = parse_scalar(subscript, defined);
+
+                    if (result != JSON_OK) break;
+                    if (!defined) return fail("null subscript");
+
+                    if (subs.size() >= max_subs) {
+                        message = "Too many subscripts";
+                        return JSON_DEPTH;
+                    }
+
+                    subs.push_back(subscript);
+                    skip_space();
+
+                    if (position < length && data[position] == ',') {
+                        position++;
+                    } else if (position < length && data[position] == ']') {
+                        position++;
+                        break;
+                    } else {
+                        return fail("expected ',' or ']'");
+                    }
+                }
+            }
+        } else {
+            result = skip_value();
+        }
+
+        if (result != JSON_OK) return result;
+
+        skip_space();
+
+        if (position < length && data[position] == ',') {
+            position++;
+        } else if (position < length && data[position] == '}') {
+            position++;
+            break;
+        } else {
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    bool stopped = present && !leaf(subs, value);
+
+    subs.resize(depth);
+
+    return stopped ? JSON_STOPPED : JSON_OK;
+} // @end JsonReader::parse_entry method
+
+/*
+ * @class nodem::JsonReader
+ * @method {instance} parse
+ * @summary Parse the whole JSON text, calling the leaf function for each node, in the order the nodes appear in the text
+ * @param {vector<string>} root - Subscripts of the root of the subtree, which every node's subscripts start with
+ * @param {json_leaf_t} leaf_function - Called with the subscripts and value of each node; returning false stops the parse
+ * @returns {json_result_t} - JSON_OK, JSON_SYNTAX, JSON_DEPTH, or JSON_STOPPED if the leaf function failed
+ */
+json_result_t JsonReader::parse(const vector<string>& root, const json_leaf_t& leaf_function)
+{
+    // A transaction restart parses the text again from the start
+    position = 0;
+    nesting = 0;
+    subs = root;
+    leaf = leaf_function;
+    message.clear();
+
+    json_result_t result;
+
+    if (shape == JSON_FLAT) {
+        skip_space();
+
+        if (position >= length || data[position] != '[') return fail("expected an array of nodes");
+
+        position++;
+        skip_space();
+
+        if (position < length && data[position] == ']') {
+            position++;
+            result = JSON_OK;
+        } else {
+            while (true) {
+                result = parse_entry();
+
+                if (result != JSON_OK) return result;
+
+                skip_space();
+
+                if (position < length && data[position] == ',') {
+                    position++;
+                } else if (position < length && data[position] == ']') {
+                    position++;
+                    break;
+                } else {
+                    return fail("expected ',' or ']'");
+                }
+            }
+        }
+    } else {
+        result = parse_node();
+
+        if (result != JSON_OK) return result;
+    }
+
+    skip_space();
+
+    if (position < length) return fail("unexpected text after the end");
+
+    return result;
+} // @end JsonReader::parse method
+
+} // @end namespace nodem
@@ -0,0 +1,145 @@
+/*
+ * Package:    NodeM
+ * File:       json.hh
+ * Summary:    Native JSON serialization and parsing of global and local subtrees
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef JSON_HH
+#   define JSON_HH
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define JSON_NESTING 256
+
+namespace nodem {
+
+enum json_shape_t {
+    JSON_NESTED,
+    JSON_FLAT
+};
+
+enum json_result_t {
+    JSON_OK,
+    JSON_SYNTAX,
+    JSON_DEPTH,
+    JSON_STOPPED
+};
+
+typedef std::function<bool (const std::vector<std::string>&, const std::string&)> json_leaf_t;
+
+/*
+ * @class nodem::JsonWriter
+ * @summary Write the nodes of a subtree, visited depth first in collation order, as JSON text
+ * @constructor JsonWriter
+ * @method {instance} add
+ * @method {instance} finish
+ * @member {string} {private} buffer
+ * @member {vector<string>} {private} root
+ * @member {vector<string>} {private} open
+ * @member {vector<bool>} {private} first
+ * @member {vector<string>} {private} pending
+ * @member {string} {private} pending_value
+ * @member {json_shape_t} {private} shape
+ * @member {bool} {private} utf8
+ * @member {bool} {private} canonical
+ * @member {bool} {private} has_pending
+ * @member {bool} {private} started
+ */
+class JsonWriter {
+public:
+    JsonWriter(const json_shape_t, const bool, const bool, const std::vector<std::string>&);
+
+    void add(const std::vector<std::string>&, const std::string&);
+    std::string finish(void);
+
+private:
+    void write_string(const std::string&);
+    void write_value(const std::string&);
+    void write_key(const std::string&);
+    void write_node(const bool);
+
+    std::string                 buffer;
+    std::vector<std::string>    root;
+    std::vector<std::string>    open;
+    std::vector<bool>           first;
+    std::vector<std::string>    pending;
+    std::string                 pending_value;
+    json_shape_t                shape;
+    bool                        utf8;
+    bool                        canonical;
+    bool                        has_pending;
+    bool                        started;
+}; // @end nodem::JsonWriter class
+
+/*
+ * @class nodem::JsonReader
+ * @summary Parse JSON text in one pass, calling a function for each node it sets, without building a tree of the whole text
+ * @constructor JsonReader
+ * @method {instance} parse
+ * @method {instance} error
+ * @member {char*} {private} data
+ * @member {size_t} {private} length
+ * @member {size_t} {private} position
+ * @member {size_t} {private} max_subs
+ * @member {unsigned int} {private} nesting
+ * @member {json_shape_t} {private} shape
+ * @member {bool} {private} utf8
+ * @member {bool} {private} canonical
+ * @member {vector<string>} {private} subs
+ * @member {json_leaf_t} {private} leaf
+ * @member {string} {private} message
+ */
+class JsonReader {
+public:
+    JsonReader(const char*, const size_t, const json_shape_t, const bool, const bool, const size_t);
+
+    json_result_t parse(const std::vector<std::string>&, const json_leaf_t&);
+    const std::string& error(void) const;
+
+private:
+    json_result_t fail(const char*);
+    void skip_space(void);
+    bool literal(const char*);
+    json_result_t parse_string(std::string&);
+    json_result_t parse_number(std::string&);
+    json_result_t parse_scalar(std::string&, bool&);
+    json_result_t parse_node(void);
+    json_result_t parse_entry(void);
+    json_result_t skip_value(void);
+
+    const char*                 data;
+    size_t                      length;
+    size_t                      position;
+    size_t                      max_subs;
+    unsigned int                nesting;
+    json_shape_t                shape;
+    bool                        utf8;
+    bool                        canonical;
+    std::vector<std::string>    subs;
+    json_leaf_t                 leaf;
+    std::string                 message;
+}; // @end nodem::JsonReader class
+
+} // @end namespace nodem
+
+#endif // @end JSON_HH
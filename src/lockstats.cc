@@ -0,0 +1,307 @@
+/*
+ * Package:    NodeM
+ * File:       lockstats.cc
+ * Summary:    Per-resource lock telemetry and lock-order tracking
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "lockstats.hh"
+#include "utility.hh"
+#include <uv.h>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+using std::map;
+using std::pair;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+const char* const lock_stats_buckets_g[LOCK_STATS_BUCKETS] = {"10us", "100us", "1ms", "10ms", "100ms", "1s", "Infinity"};
+
+static const uint64_t lock_bucket_limits_g[LOCK_STATS_BUCKETS - 1] = {
+    10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+/*
+ * @struct {private} nodem::LockEntry
+ * @summary Running statistics and current holders for one lock resource
+ */
+struct LockEntry {
+    uint64_t                acquisitions = 0;
+    uint64_t                timeouts = 0;
+    uint64_t                wait_total = 0;
+    uint64_t                wait_max = 0;
+    uint64_t                histogram[LOCK_STATS_BUCKETS] = {0};
+    map<pid_t, uint32_t>    holders;
+}; // @end nodem::LockEntry struct
+
+static uv_once_t                                lock_stats_once_g = UV_ONCE_INIT;
+static uv_mutex_t                               lock_stats_mutex_g;
+static map<string, LockEntry>                   lock_entries_g;
+static map<pid_t, set<string>>                  lock_held_g;
+static set<pair<string, string>>                lock_order_g;
+static map<pair<string, string>, uint64_t>      lock_inversions_g;
+static uint64_t                                 lock_dropped_g = 0;
+
+/*
+ * @function {private} nodem::lock_stats_init
+ * @summary Initialize the mutex that protects the lock statistics, once per process
+ * @returns {void}
+ */
+static void lock_stats_init(void)
+{
+    uv_mutex_init(&lock_stats_mutex_g);
+    return;
+} // @end nodem::lock_stats_init function
+
+/*
+ * @function nodem::lock_resource
+ * @summary Build the M reference used to identify a lock resource, from SimpleAPI subscripts
+ * @param {string} name - Global or local variable name
+ * @param {vector<string>} subs_array - Subscripts
+ * @returns {string} - The lock resource, e.g. ^ORDER(42,"line")
+ */
+string lock_resource(const string& name, const vector<string>& subs_array)
+{
+    if (subs_array.empty()) return name;
+
+    string resource = name + "(";
+
+    for (unsigned int i = 0; i < subs_array.size(); i++) {
+        if (i > 0) resource += ",";
+
+        if (is_canonical(subs_array[i])) {
+            resource += subs_array[i];
+        } else {
+            resource += "\"";
+
+            for (char c : subs_array[i]) {
+                if (c == '"') resource += "\"";
+                resource += c;
+            }
+
+            resource += "\"";
+        }
+    }
+
+    return resource + ")";
+} // @end nodem::lock_resource function
+
+/*
+ * @function nodem::lock_resource
+ * @summary Build the M reference used to identify a lock resource, from Call-in subscripts encoded with their lengths
+ * @param {string} name - Global or local variable name
+ * @param {string} args - Subscripts, encoded as length:data pairs separated by commas
+ * @returns {string} - The lock resource, e.g. ^ORDER(42,"line")
+ */
+string lock_resource(const string& name, const string& args)
+{
+    if (args.empty()) return name;
+
+    string resource = name + "(";
+    size_t position = 0;
+
+    while (position < args.length()) {
+        size_t colon = args.find(':', position);
+
+        if (colon == string::npos) break;
+
+        size_t length = strtoul(args.c_str() + position, NULL, 10);
+
+        if (position > 0) resource += ",";
+
+        resource += args.substr(colon + 1, length);
+        position = colon + 1 + length + 1;
+    }
+
+    return resource + ")";
+} // @end nodem::lock_resource function
+
+/*
+ * @function nodem::lock_stats_acquire
+ * @summary Record the outcome of an incremental lock, and check its order against the other locks held by the same thread
+ * @param {string} resource - The lock resource, from lock_resource
+ * @param {pid_t} tid - Thread that made the lock call
+ * @param {uint64_t} wait - Time spent in the lock call, in nanoseconds
+ * @param {bool} acquired - Whether the lock was acquired, or timed out
+ * @returns {void}
+ */
+void lock_stats_acquire(const string& resource, const pid_t tid, const uint64_t wait, const bool acquired)
+{
+    uv_once(&lock_stats_once_g, lock_stats_init);
+    uv_mutex_lock(&lock_stats_mutex_g);
+
+    map<string, LockEntry>::iterator entry = lock_entries_g.find(resource);
+
+    if (entry == lock_entries_g.end()) {
+        if (lock_entries_g.size() >= LOCK_STATS_MAX) {
+            lock_dropped_g++;
+            uv_mutex_unlock(&lock_stats_mutex_g);
+
+            return;
+        }
+
+        entry = lock_entries_g.insert(std::make_pair(resource, LockEntry())).first;
+    }
+
+    unsigned int bucket = 0;
+
+    while (bucket < LOCK_STATS_BUCKETS - 1 && wait > lock_bucket_limits_g[bucket]) bucket++;
+
+    entry->second.histogram[bucket]++;
+    entry->second.wait_total += wait;
+    if (wait > entry->second.wait_max) entry->second.wait_max = wait;
+
+    if (!acquired) {
+        entry->second.timeouts++;
+        uv_mutex_unlock(&lock_stats_mutex_g);
+
+        return;
+    }
+
+    entry->second.acquisitions++;
+
+    if (entry->second.holders[tid]++ == 0) {
+        set<string>& held = lock_held_g[tid];
+
+        for (const string& previous : held) {
+            if (lock_order_g.size() < LOCK_STATS_MAX * 4) lock_order_g.insert(std::make_pair(previous, resource));
+
+            if (lock_order_g.count(std::make_pair(resource, previous)) == 0) continue;
+
+            pair<string, string> key = (previous < resource) ? std::make_pair(previous, resource) : std::make_pair(resource, previous);
+
+            if (lock_inversions_g[key]++ == 0) {
+                std::ostringstream stream;
+
+                stream << "[C " << tid << "] WARNING: Nodem lock order inversion: " << resource << " locked while holding "
+                  << previous << ", which has also been locked in the opposite order" << std::endl;
+
+                std::clog << stream.str();
+            }
+        }
+
+        held.insert(resource);
+    }
+
+    uv_mutex_unlock(&lock_stats_mutex_g);
+    return;
+} // @end nodem::lock_stats_acquire function
+
+/*
+ * @function nodem::lock_stats_release
+ * @summary Record an incremental unlock, or the release of every lock held by the process
+ * @param {string} resource - The lock resource, from lock_resource; an empty string releases all locks
+ * @param {pid_t} tid - Thread that made the unlock call
+ * @returns {void}
+ */
+void lock_stats_release(const string& resource, const pid_t tid)
+{
+    uv_once(&lock_stats_once_g, lock_stats_init);
+    uv_mutex_lock(&lock_stats_mutex_g);
+
+    if (resource.empty()) {
+        for (pair<const string, LockEntry>& entry : lock_entries_g) entry.second.holders.clear();
+
+        lock_held_g.clear();
+        uv_mutex_unlock(&lock_stats_mutex_g);
+
+        return;
+    }
+
+    map<string, LockEntry>::iterator entry = lock_entries_g.find(resource);
+
+    if (entry != lock_entries_g.end()) {
+        map<pid_t, uint32_t>::iterator holder = entry->second.holders.find(tid);
+
+        if (holder != entry->second.holders.end() && --holder->second == 0) {
+            entry->second.holders.erase(holder);
+            lock_held_g[tid].erase(resource);
+
+            if (lock_held_g[tid].empty()) lock_held_g.erase(tid);
+        }
+    }
+
+    uv_mutex_unlock(&lock_stats_mutex_g);
+    return;
+} // @end nodem::lock_stats_release function
+
+/*
+ * @function nodem::lock_stats_snapshot
+ * @summary Copy the current lock statistics, optionally resetting the counters and the recorded lock orders
+ * @param {vector<LockResourceStats>} resources - Filled with one entry per lock resource
+ * @param {vector<LockInversion>} inversions - Filled with one entry per pair of resources locked in both orders
+ * @param {bool} reset - Whether to reset the statistics after copying them; current holders are kept
+ * @returns {uint64_t} - Number of lock calls not recorded, because the resource table was full
+ */
+uint64_t lock_stats_snapshot(vector<LockResourceStats>& resources, vector<LockInversion>& inversions, const bool reset)
+{
+    uv_once(&lock_stats_once_g, lock_stats_init);
+    uv_mutex_lock(&lock_stats_mutex_g);
+
+    for (const pair<const string, LockEntry>& entry : lock_entries_g) {
+        LockResourceStats stats;
+
+        stats.resource = entry.first;
+        stats.acquisitions = entry.second.acquisitions;
+        stats.timeouts = entry.second.timeouts;
+        stats.wait_total = entry.second.wait_total;
+        stats.wait_max = entry.second.wait_max;
+
+        for (unsigned int i = 0; i < LOCK_STATS_BUCKETS; i++) stats.histogram[i] = entry.second.histogram[i];
+        for (const pair<const pid_t, uint32_t>& holder : entry.second.holders) stats.holders.push_back(holder);
+
+        resources.push_back(stats);
+    }
+
+    for (const pair<const pair<string, string>, uint64_t>& inversion : lock_inversions_g) {
+        inversions.push_back(LockInversion {inversion.first.first, inversion.first.second, inversion.second});
+    }
+
+    uint64_t dropped = lock_dropped_g;
+
+    if (reset) {
+        for (map<string, LockEntry>::iterator entry = lock_entries_g.begin(); entry != lock_entries_g.end();) {
+            if (entry->second.holders.empty()) {
+                entry = lock_entries_g.erase(entry);
+            } else {
+                map<pid_t, uint32_t> holders = entry->second.holders;
+
+                entry->second = LockEntry();
+                entry->second.holders = holders;
+                ++entry;
+            }
+        }
+
+        lock_order_g.clear();
+        lock_inversions_g.clear();
+        lock_dropped_g = 0;
+    }
+
+    uv_mutex_unlock(&lock_stats_mutex_g);
+    return dropped;
+} // @end nodem::lock_stats_snapshot function
+
+} // @end namespace nodem
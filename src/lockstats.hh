@@ -0,0 +1,82 @@
+/*
+ * Package:    NodeM
+ * File:       lockstats.hh
+ * Summary:    Per-resource lock telemetry and lock-order tracking
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef LOCKSTATS_HH
+#   define LOCKSTATS_HH
+
+#include <sys/types.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define LOCK_STATS_MAX     4096
+#define LOCK_STATS_BUCKETS 7
+
+namespace nodem {
+
+/*
+ * @struct nodem::LockResourceStats
+ * @summary Statistics for one lock resource (a global or local name, with its subscripts), within this process
+ * @member {string} resource
+ * @member {uint64_t} acquisitions
+ * @member {uint64_t} timeouts
+ * @member {uint64_t} wait_total
+ * @member {uint64_t} wait_max
+ * @member {uint64_t[]} histogram
+ * @member {vector<pair<pid_t, uint32_t>>} holders
+ */
+struct LockResourceStats {
+    std::string                                 resource;
+    uint64_t                                    acquisitions;
+    uint64_t                                    timeouts;
+    uint64_t                                    wait_total;
+    uint64_t                                    wait_max;
+    uint64_t                                    histogram[LOCK_STATS_BUCKETS];
+    std::vector<std::pair<pid_t, uint32_t>>     holders;
+}; // @end nodem::LockResourceStats struct
+
+/*
+ * @struct nodem::LockInversion
+ * @summary Two lock resources that have been acquired in both orders, by threads already holding the other one
+ * @member {string} first
+ * @member {string} second
+ * @member {uint64_t} count
+ */
+struct LockInversion {
+    std::string first;
+    std::string second;
+    uint64_t    count;
+}; // @end nodem::LockInversion struct
+
+extern const char* const lock_stats_buckets_g[LOCK_STATS_BUCKETS];
+
+std::string lock_resource(const std::string&, const std::vector<std::string>&);
+std::string lock_resource(const std::string&, const std::string&);
+void lock_stats_acquire(const std::string&, const pid_t, const uint64_t, const bool);
+void lock_stats_release(const std::string&, const pid_t);
+uint64_t lock_stats_snapshot(std::vector<LockResourceStats>&, std::vector<LockInversion>&, const bool);
+
+} // @end namespace nodem
+
+#endif // @end LOCKSTATS_HH
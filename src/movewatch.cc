@@ -0,0 +1,147 @@
+/*
+ * Package:    NodeM
+ * File:       movewatch.cc
+ * Summary:    The nodes written in the source tree of a chunked move, so that its cutover only has to bring those up to date
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "movewatch.hh"
+#include "registry.hh"
+#include "utility.hh"
+#include <algorithm>
+
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+static Registry<vector<move_watch_ptr_t>> move_watches_g;
+
+/*
+ * @function nodem::move_watch
+ * @summary Start recording the writes to the source tree of a move, before its first chunk is copied
+ * @param {string} name - Global or local name of the source
+ * @param {vector<string>} root - Subscripts of the source root
+ * @param {unsigned int} limit - Most nodes to record; past it, the whole tree is treated as written
+ * @returns {move_watch_ptr_t} - The watch, to read and stop at the cutover
+ */
+move_watch_ptr_t move_watch(const string& name, const vector<string>& root, const unsigned int limit)
+{
+    move_watch_ptr_t watch = std::make_shared<MoveWatch>();
+
+    watch->name = name;
+    watch->root = root;
+    watch->limit = limit;
+
+    move_watches_g.write().push_back(watch);
+    move_watches_g.write_done();
+    return watch;
+} // @end nodem::move_watch function
+
+/*
+ * @function nodem::move_unwatch
+ * @summary Stop recording the writes to the source tree of a move, once it has cut over or failed
+ * @param {move_watch_ptr_t} watch - The watch returned by move_watch
+ * @returns {void}
+ */
+void move_unwatch(const move_watch_ptr_t& watch)
+{
+    vector<move_watch_ptr_t>& watches = move_watches_g.write();
+
+    watches.erase(std::remove(watches.begin(), watches.end(), watch), watches.end());
+
+    move_watches_g.write_done();
+    return;
+} // @end nodem::move_unwatch function
+
+/*
+ * @function nodem::move_written_nodes
+ * @summary Copy the nodes recorded by a watch, so that a cutover transaction replays the same nodes each time YottaDB restarts it
+ * @param {move_watch_ptr_t} watch - The watch returned by move_watch
+ * @returns {MoveWatch} - A copy of the watch
+ */
+MoveWatch move_written_nodes(const move_watch_ptr_t& watch)
+{
+    // Writes are recorded with the lock held for writing, so holding it for reading is enough to copy a watch
+    move_watches_g.read();
+
+    MoveWatch copy = *watch;
+
+    move_watches_g.read_done();
+    return copy;
+} // @end nodem::move_written_nodes function
+
+/*
+ * @function nodem::move_written
+ * @summary Record a write in the moves whose source tree it reaches, without taking a lock when nothing is being moved
+ * @param {string} name - Global or local name written; an empty string is the whole local symbol table
+ * @param {vector<string>} subs - Subscripts of the node written
+ * @param {bool} subtree - Whether the write changes the nodes below the node too, as a kill or merge does
+ * @returns {void}
+ */
+void move_written(const string& name, const vector<string>& subs, const bool subtree)
+{
+    if (move_watches_g.empty()) return;
+
+    const string plain = plain_name(name);
+
+    // Recording changes the watches themselves, so it takes the lock for writing
+    for (const move_watch_ptr_t& watch : move_watches_g.write()) {
+        if (watch->whole || (plain.empty() ? watch->name[0] == '^' : watch->name != plain)) continue;
+
+        const vector<string>& root = watch->root;
+
+        if (subs.size() >= root.size() && std::equal(root.begin(), root.end(), subs.begin())) {
+            bool& written = watch->written[subs];
+            written = written || subtree;
+
+            if (watch->written.size() > watch->limit) {
+                watch->whole = true;
+                watch->written.clear();
+            }
+        } else if (subtree && subs.size() < root.size() && std::equal(subs.begin(), subs.end(), root.begin())) {
+            // A kill or merge above the root can change any node in the tree
+            watch->whole = true;
+            watch->written.clear();
+        }
+    }
+
+    move_watches_g.write_done();
+    return;
+} // @end nodem::move_written function
+
+/*
+ * @function nodem::move_written_all
+ * @summary Treat every node of every tree being moved as written, when M code runs that can write any of them
+ * @returns {void}
+ */
+void move_written_all(void)
+{
+    if (move_watches_g.empty()) return;
+
+    for (const move_watch_ptr_t& watch : move_watches_g.write()) {
+        watch->whole = true;
+        watch->written.clear();
+    }
+
+    move_watches_g.write_done();
+    return;
+} // @end nodem::move_written_all function
+
+} // @end namespace nodem
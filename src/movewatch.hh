@@ -0,0 +1,61 @@
+/*
+ * Package:    NodeM
+ * File:       movewatch.hh
+ * Summary:    The nodes written in the source tree of a chunked move, so that its cutover only has to bring those up to date
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef MOVEWATCH_HH
+#   define MOVEWATCH_HH
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nodem {
+
+/*
+ * @struct nodem::MoveWatch
+ * @summary The nodes written under the source root of a move, each mapped to whether the write reached the nodes below it too
+ * @member {string} name
+ * @member {vector<string>} root
+ * @member {unsigned int} limit
+ * @member {map<vector<string>, bool>} written
+ * @member {bool} whole
+ */
+struct MoveWatch {
+    std::string                             name;
+    std::vector<std::string>                root;
+    unsigned int                            limit = 0;
+    std::map<std::vector<std::string>, bool> written;
+    bool                                    whole = false;
+}; // @end nodem::MoveWatch struct
+
+typedef std::shared_ptr<MoveWatch> move_watch_ptr_t;
+
+move_watch_ptr_t move_watch(const std::string&, const std::vector<std::string>&, const unsigned int);
+void move_unwatch(const move_watch_ptr_t&);
+MoveWatch move_written_nodes(const move_watch_ptr_t&);
+void move_written(const std::string&, const std::vector<std::string>&, const bool);
+void move_written_all(void);
+
+} // @end namespace nodem
+
+#endif // @end MOVEWATCH_HH
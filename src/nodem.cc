@@ -26,10 +26,13 @@
 #include "gtm.hh"
 #include "ydb.hh"
 #include <cerrno>
+#include <cmath>
 #include <csignal>
 #include <cstdlib>
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <random>
 
 #define REVSE "\x1B[7m"
 #define RESET "\x1B[0m"
@@ -64,6 +67,7 @@ using v8::NewStringType;
 #endif
 using v8::Number;
 using v8::Object;
+using v8::Promise;
 using v8::PropertyCallbackInfo;
 #if NODE_MAJOR_VERSION >= 22
 using v8::ReadOnly;
@@ -101,6 +105,8 @@ nodem_state_t nodem_state_g = NOT_OPEN;
 int           save_stdout_g = -1;
 bool          utf8_g = true;
 bool          auto_relink_g = false;
+const uint8_t* trace_category_g = nullptr;
+thread_local unsigned int mutex_depth_g = 0;
 
 static bool   reset_term_g = false;
 static bool   signal_sigint_g = true;
@@ -121,6 +127,11 @@ enum {
 
 static char   deprecated_g = NONE;
 
+#if NODEM_SIMPLE_API == 1
+// Read without the mutex by callin_init, once the Call-in interface is ready
+static std::atomic<bool> callin_ready_g {false};
+#endif
+
 /*
  * @function nodem::clean_shutdown
  * @summary Handle a SIGINT/SIGQUIT/SIGTERM signal, by cleaning up everything, and exiting Node.js
@@ -130,13 +141,13 @@ static char   deprecated_g = NONE;
 void clean_shutdown(const int signal_num)
 {
     if (nodem_state_g == OPEN) {
-        if (uv_mutex_trylock(&mutex_g) == 0) {
+        if (try_lock_mutex()) {
 #if NODEM_SIMPLE_API == 1
             ydb_exit();
 #else
             gtm_exit();
 #endif
-            uv_mutex_unlock(&mutex_g);
+            unlock_mutex();
         }
 
         term_attr_g.c_iflag |= ICRNL;
@@ -189,46 +200,6 @@ inline static void reset_handler(NodemState* nodem_state)
 } // @end nodem::reset_handler function
 #endif
 
-#if NODEM_SIMPLE_API == 1
-/*
- * @function {private} nodem::is_number
- * @summary Check if a value returned from YottaDB's SimpleAPI is a canonical number
- * @param {string} data - The data value to be tested
- * @returns {boolean} - Whether the data value is a canonical number or not
- */
-inline static bool is_number(const string data)
-{
-    /*
-     * YottaDB/GT.M approximate (using number of digits, rather than number value) number limits:
-     *   - 47 digits before overflow (resulting in an overflow error)
-     *   - 18 digits of precision
-     * Node.js/JavaScript approximate (using number of digits, rather than number value) number limits:
-     *   - 309 digits before overflow (represented as the Infinity primitive)
-     *   - 21 digits before conversion to exponent notation
-     *   - 16 digits of precision
-     * This is why anything over 16 characters needs to be treated as a string
-     */
-
-    bool flag = false;
-    size_t neg_cnt = count(data.begin(), data.end(), '-');
-    size_t decp_cnt = count(data.begin(), data.end(), '.');
-
-    if ((decp_cnt == 0 || decp_cnt == 1) && (neg_cnt == 0 || (neg_cnt == 1 && data[0] == '-'))) flag = true;
-    if ((decp_cnt == 1 || neg_cnt == 1) && data.length() <= 1) flag = false;
-    if (data.length() > 16 || data[data.length() - 1] == '.') flag = false;
-
-    if (flag && !data.empty() && all_of(data.begin(), data.end(), [](char c) {return (isdigit(c) || c == '-' || c == '.');})) {
-        if ((data[0] == '0' && data.length() > 1) || (decp_cnt == 1 && data[data.length() - 1] == '0')) {
-            return false;
-        }
-
-        return true;
-    } else {
-        return false;
-    }
-} // @end nodem::is_number function
-#endif
-
 /*
  * @function {private} nodem::invalid_name
  * @summary If a variable name contains subscripts, it is not valid, and cannot be used
@@ -410,6 +381,65 @@ static Local<Value> error_status(gtm_char_t* error, const bool position, const b
     return scope.Escape(result);
 } // @end nodem::error_status function
 
+/*
+ * @function {private} nodem::callin_debug
+ * @summary Set up the debug mode and error handling in v4wNode.m, with the caller holding the mutex
+ * @param {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {gtm_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+static gtm_status_t callin_debug(const NodemState* nodem_state)
+{
+    gtm_char_t debug[] = "debug";
+
+#if NODEM_CIP_API == 1
+    ci_name_descriptor access;
+
+    access.rtn_name.address = debug;
+    access.rtn_name.length = strlen(debug);
+    access.handle = NULL;
+
+    gtm_status_t status = gtm_cip(&access, nodem_state->debug);
+#else
+    gtm_status_t status = gtm_ci(debug, nodem_state->debug);
+#endif
+
+    if (nodem_state->debug > LOW) debug_log(">>   status: ", status);
+
+    return status;
+} // @end nodem::callin_debug function
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @function {private} nodem::callin_init
+ * @summary Initialize the Call-in interface on first use, so that SimpleAPI builds only need v4wNode.m for Call-in APIs
+ * @param {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @member {unsigned int} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {gtm_status_t} status - Return code; 0 is success, any other number is an error code, available from gtm_zstatus
+ */
+static gtm_status_t callin_init(const NodemState* nodem_state)
+{
+    if (callin_ready_g.load(std::memory_order_acquire)) return EXIT_SUCCESS;
+
+    if (nodem_state->debug > LOW) debug_log(">>   callin_init enter");
+    if (nodem_state->tp_level == 0) lock_mutex("callin");
+
+    gtm_status_t status = EXIT_SUCCESS;
+
+    if (!callin_ready_g.load(std::memory_order_relaxed)) {
+        status = callin_debug(nodem_state);
+
+        if (status == EXIT_SUCCESS) callin_ready_g.store(true, std::memory_order_release);
+    }
+
+    if (nodem_state->tp_level == 0) unlock_mutex();
+    if (nodem_state->debug > LOW) debug_log(">>   callin_init exit");
+
+    return status;
+} // @end nodem::callin_init function
+#endif
+
 /*
  * @function {private} nodem::encode_arguments
  * @summary Encode an array of arguments for parsing in v4wNode.m
@@ -570,6 +600,8 @@ static vector<string> build_subscripts(const Local<Value> subscripts, bool& erro
     vector<string> subs_array;
     Local<Value> data;
 
+    subs_array.reserve(length);
+
     for (unsigned int i = 0; i < length; i++) {
         data = get_n(isolate, subscripts_array, i);
 
@@ -593,7 +625,7 @@ static vector<string> build_subscripts(const Local<Value> subscripts, bool& erro
 
         if (nodem_state->debug > MEDIUM) debug_log(">>>    subs_data[", i, "]: ", subs_data);
 
-        subs_array.push_back(subs_data);
+        subs_array.push_back(std::move(subs_data));
     }
 
     if (nodem_state->debug > MEDIUM) debug_log(">>>    build_subscripts exit");
@@ -602,6 +634,160 @@ static vector<string> build_subscripts(const Local<Value> subscripts, bool& erro
 } // @end nodem::build_subscripts function
 #endif
 
+/*
+ * @function {private} nodem::baton_acquire
+ * @summary Take a baton for an asynchronous call from the per-thread free list, or allocate one, along with its error and result buffers
+ * @param {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @member {vector<NodemBaton*>} baton_pool - Batons left over from earlier asynchronous calls
+ * @returns {NodemBaton*} - A baton that is ready to be filled in
+ */
+static NodemBaton* baton_acquire(NodemState* nodem_state)
+{
+    if (!nodem_state->baton_pool.empty()) {
+        NodemBaton* nodem_baton = nodem_state->baton_pool.back();
+
+        nodem_state->baton_pool.pop_back();
+
+        if (nodem_baton->result == nullptr) nodem_baton->result = new gtm_char_t[RES_LEN];
+
+        return nodem_baton;
+    }
+
+    NodemBaton* nodem_baton = new NodemBaton();
+
+    nodem_baton->error = new gtm_char_t[ERR_LEN];
+    nodem_baton->result = new gtm_char_t[RES_LEN];
+
+    return nodem_baton;
+} // @end nodem::baton_acquire function
+
+/*
+ * @function {private} nodem::baton_release
+ * @summary Clear an asynchronous call's baton and put it back on the per-thread free list, or free it if the list is full
+ * @param {NodemBaton*} nodem_baton - The baton, which is not used again by the caller
+ * @returns {void}
+ */
+static void baton_release(NodemBaton* nodem_baton)
+{
+    nodem_baton->callback_p.Reset();
+    nodem_baton->object_p.Reset();
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+#if NODE_MAJOR_VERSION >= 8
+    nodem_baton->resolver_p.Reset();
+#endif
+
+    NodemState* nodem_state = nodem_baton->nodem_state;
+
+    if (nodem_state->baton_pool.size() >= BATON_POOL) {
+        delete[] nodem_baton->error;
+        delete[] nodem_baton->result;
+        delete nodem_baton;
+
+        return;
+    }
+
+    // Only the first BATON_RESULTS batons on the list keep their result buffer, to bound the memory the list holds
+    if (nodem_state->baton_pool.size() >= BATON_RESULTS) {
+        delete[] nodem_baton->result;
+        nodem_baton->result = nullptr;
+    }
+
+    // The results a call builds up are cleared rather than replaced, so that the next call reuses their memory
+    nodem_baton->name.clear();
+    nodem_baton->to_name.clear();
+    nodem_baton->args.clear();
+    nodem_baton->to_args.clear();
+    nodem_baton->value.clear();
+    nodem_baton->subs_array.clear();
+    nodem_baton->to_subs_array.clear();
+    nodem_baton->values_array.clear();
+    nodem_baton->data_array.clear();
+    nodem_baton->nodes_array.clear();
+    nodem_baton->async = false;
+    nodem_baton->local = false;
+    nodem_baton->position = false;
+    nodem_baton->routine = false;
+    nodem_baton->node_only = false;
+    nodem_baton->adaptive = false;
+    nodem_baton->reverse = false;
+    nodem_baton->packed = false;
+    nodem_baton->atomic = false;
+    nodem_baton->sketch = false;
+    nodem_baton->filter.reset();
+    nodem_baton->relink = 0;
+    nodem_baton->option = 0;
+    nodem_baton->status = 0;
+    nodem_baton->info = 0;
+
+    nodem_state->baton_pool.push_back(nodem_baton);
+    return;
+} // @end nodem::baton_release function
+
+/*
+ * @function {private} nodem::hold_values
+ * @summary Keep the V8 values a return function needs; a synchronous call keeps local handles, and only an asynchronous one makes global handles
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {NodemBaton*} nodem_baton - The baton to keep the values in
+ * @param {bool} async - Whether the call returns after the current handle scope is gone
+ * @param {Local<Value>} arguments - Subscripts or arguments the API was called with
+ * @param {Local<Value>} data - Data the API was called with
+ * @param {Local<Object>} object - Object the API was called with; defaults to none
+ * @returns {void}
+ */
+inline static void hold_values(Isolate* isolate, NodemBaton* nodem_baton, const bool async, Local<Value> arguments,
+  Local<Value> data, Local<Object> object = Local<Object>())
+{
+    if (async) {
+        if (!object.IsEmpty()) nodem_baton->object_p.Reset(isolate, object);
+
+        nodem_baton->arguments_p.Reset(isolate, arguments);
+        nodem_baton->data_p.Reset(isolate, data);
+    } else {
+        nodem_baton->object = object;
+        nodem_baton->arguments = arguments;
+        nodem_baton->data = data;
+    }
+
+    return;
+} // @end nodem::hold_values function
+
+/*
+ * @function {private} nodem::held_arguments
+ * @summary Return the subscripts or arguments kept by hold_values
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {NodemBaton*} nodem_baton - The baton the values were kept in
+ * @returns {Local<Value>} - The subscripts or arguments
+ */
+inline static Local<Value> held_arguments(Isolate* isolate, const NodemBaton* nodem_baton)
+{
+    return nodem_baton->async ? Local<Value>::New(isolate, nodem_baton->arguments_p) : nodem_baton->arguments;
+} // @end nodem::held_arguments function
+
+/*
+ * @function {private} nodem::held_data
+ * @summary Return the data kept by hold_values
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {NodemBaton*} nodem_baton - The baton the values were kept in
+ * @returns {Local<Value>} - The data
+ */
+inline static Local<Value> held_data(Isolate* isolate, const NodemBaton* nodem_baton)
+{
+    return nodem_baton->async ? Local<Value>::New(isolate, nodem_baton->data_p) : nodem_baton->data;
+} // @end nodem::held_data function
+
+/*
+ * @function {private} nodem::held_object
+ * @summary Return the object kept by hold_values
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {NodemBaton*} nodem_baton - The baton the values were kept in
+ * @returns {Local<Object>} - The object
+ */
+inline static Local<Object> held_object(Isolate* isolate, const NodemBaton* nodem_baton)
+{
+    return nodem_baton->async ? Local<Object>::New(isolate, nodem_baton->object_p) : nodem_baton->object;
+} // @end nodem::held_object function
+
 /*
  * @class nodem::NodemValue
  * @method {instance} to_byte
@@ -643,6 +829,27 @@ Local<String> NodemValue::from_byte(gtm_char_t buffer[])
 #endif
 } // @end NodemValue::from_byte method
 
+/*
+ * @class nodem::NodemState
+ * @destructor ~NodemState
+ * @summary Release the exports object, and free the batons left on the free list
+ */
+NodemState::~NodemState()
+{
+    if (!exports_p.IsEmpty()) {
+        exports_p.ClearWeak();
+        exports_p.Reset();
+    }
+
+    for (NodemBaton* nodem_baton : baton_pool) {
+        delete[] nodem_baton->error;
+        delete[] nodem_baton->result;
+        delete nodem_baton;
+    }
+
+    return;
+} // @end NodemState::~NodemState destructor
+
 /*
  * @function {private} nodem::version
  * @summary Return the about/version string
@@ -711,7 +918,7 @@ static Local<Value> data(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  data enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -809,7 +1016,7 @@ static Local<Value> get(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  get enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -923,8 +1130,8 @@ static Local<Value> set(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  set enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
-    Local<Value> data_value = Local<Value>::New(isolate, nodem_baton->data_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+    Local<Value> data_value = held_data(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -990,7 +1197,7 @@ static Local<Value> kill(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  kill enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -1031,6 +1238,61 @@ static Local<Value> kill(NodemBaton* nodem_baton)
     return scope.Escape(return_object);
 } // @end nodem::kill function
 
+#if NODEM_SIMPLE_API == 1
+/*
+ * @function {private} nodem::kill_tree
+ * @summary Return the tree that was killed, and how many nodes were in it
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global or local variable name
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {gtm_double_t} option - Maximum number of nodes killed while holding the mutex
+ * @member {gtm_char_t*} result - The number of nodes killed
+ * @member {gtm_status_t} status - Return code; 0 is success, 1 is undefined node
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object containing the killed tree and node count
+ */
+static Local<Value> kill_tree(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  kill_tree enter");
+
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   result: ", nodem_baton->result);
+    }
+
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
+    }
+
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
+
+    set_n(isolate, return_object, new_string_n(isolate, "chunkSize"), Number::New(isolate, nodem_baton->option));
+    set_n(isolate, return_object, new_string_n(isolate, "killed"), Number::New(isolate, atof(nodem_baton->result)));
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  kill_tree exit");
+
+    return scope.Escape(return_object);
+} // @end nodem::kill_tree function
+#endif
+
 /*
  * @function {private} nodem::merge
  * @summary Return data from a merge of a global or local array tree to another global or local array tree
@@ -1051,7 +1313,7 @@ static Local<Value> merge(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  merge enter");
 
-    Local<Object> temp_object = Local<Object>::New(isolate, nodem_baton->object_p);
+    Local<Object> temp_object = held_object(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         Local<Value> object_string = json_method(temp_object, "stringify", nodem_baton->nodem_state);
@@ -1096,7 +1358,7 @@ static Local<Value> order(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  order enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -1208,7 +1470,7 @@ static Local<Value> previous(NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
@@ -1296,1729 +1558,3371 @@ static Local<Value> previous(NodemBaton* nodem_baton)
     return scope.Escape(return_object);
 } // @end nodem::previous function
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @function {private} nodem::next_node
- * @summary Return the next global or local node, depth first
+ * @function {private} nodem::scan_value
+ * @summary Convert a subscript or value returned by a scan, honoring the data mode and character encoding
+ * @param {string} data - The subscript or value
+ * @param {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {mode_t} mode - Data mode; canonical mode returns numbers as numbers
+ * @nested-member {bool} utf8 - Whether to decode the data as UTF-8, or as bytes
+ * @returns {Local<Value>} - The subscript or value
+ */
+inline static Local<Value> scan_value(const string& data, const NodemState* nodem_state)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+
+    if (nodem_state->mode == CANONICAL && is_number(data)) {
+        return Number::New(isolate, atof(data.c_str()));
+    } else if (nodem_state->utf8 == true) {
+        return new_string_n(isolate, data.c_str());
+    } else {
+        return NodemValue::from_byte((gtm_char_t*) data.c_str());
+    }
+} // @end nodem::scan_value function
+
+/*
+ * @function {private} nodem::scan
+ * @summary Return a page of subscripts, with their data and values, and a continuation token for the next page
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
- * @member {gtm_char_t*} result - Data returned from next_node call
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {vector<string>} {ydb only} subs_array - The subscripts of the next node
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {bool} reverse - Whether the scan is in reverse collation order
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the node whose children were scanned
+ * @member {vector<string>} to_subs_array - The subscripts found
+ * @member {vector<string>} values_array - The value of each subscript found that has data
+ * @member {vector<unsigned int>} data_array - The $DATA of each subscript found
+ * @member {gtm_double_t} option - Maximum number of subscripts in a page
+ * @member {bool} packed - Whether to return the results packed in a Buffer, rather than as an array of objects
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing the page of results, and the token to pass back for the next one
  */
-static Local<Value> next_node(NodemBaton* nodem_baton)
+static Local<Value> scan(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  scan enter");
+
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+    unsigned int count = nodem_baton->to_subs_array.size();
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
-        debug_log(">>   result: ", nodem_baton->result);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
         debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
         debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   count: ", count);
     }
 
-#if NODEM_SIMPLE_API == 1
-    Local<Object> temp_object = Object::New(isolate);
+    Local<Value> results;
 
-    if (nodem_baton->status == YDB_NODE_END) {
-        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, false));
-    } else {
-        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, true));
-    }
+    if (nodem_baton->packed) {
+        PackWriter pack_writer {PACK_SCAN, nodem_baton->nodem_state->utf8, nodem_baton->nodem_state->mode == CANONICAL};
+        const string none;
 
-    if (nodem_baton->status != YDB_NODE_END) {
-        string data(nodem_baton->result);
+        for (unsigned int i = 0; i < count; i++) {
+            const unsigned int data = nodem_baton->data_array[i];
 
-        if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
-            set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
-        } else {
-            if (nodem_baton->nodem_state->utf8 == true) {
-                set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
-            } else {
-                set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
-            }
+            pack_writer.add(&nodem_baton->to_subs_array[i], 1, data, data % 10 == 1 ? nodem_baton->values_array[i] : none);
         }
-    }
 
-    Local<Array> subs_array = Array::New(isolate);
+        const string& packed = pack_writer.finish();
+        results = new_buffer_n(isolate, packed.data(), packed.length());
 
-    if (nodem_baton->subs_array.size()) {
-        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-            if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   subs_array[", i, "]: ", nodem_baton->subs_array[i]);
+        if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   packed: ", packed.length());
+    } else {
+        Local<Array> results_array = Array::New(isolate, count);
 
-            if (nodem_baton->nodem_state->mode == CANONICAL && is_number(nodem_baton->subs_array[i])) {
-                set_n(isolate, subs_array, i, Number::New(isolate, atof(nodem_baton->subs_array[i].c_str())));
-            } else {
-                if (nodem_baton->nodem_state->utf8 == true) {
-                    set_n(isolate, subs_array, i, new_string_n(isolate, nodem_baton->subs_array[i].c_str()));
-                } else {
-                    set_n(isolate, subs_array, i, NodemValue::from_byte((gtm_char_t*) nodem_baton->subs_array[i].c_str()));
-                }
+        for (unsigned int i = 0; i < count; i++) {
+            Local<Object> result = Object::New(isolate);
+
+            set_n(isolate, result, new_string_n(isolate, "subscript"), scan_value(nodem_baton->to_subs_array[i], nodem_baton->nodem_state));
+            set_n(isolate, result, new_string_n(isolate, "defined"), Number::New(isolate, nodem_baton->data_array[i]));
+
+            if (nodem_baton->data_array[i] % 10 == 1) {
+                set_n(isolate, result, new_string_n(isolate, "data"), scan_value(nodem_baton->values_array[i], nodem_baton->nodem_state));
             }
+
+            set_n(isolate, results_array, i, result);
         }
 
-        set_n(isolate, temp_object, new_string_n(isolate, "subscripts"), subs_array);
+        results = results_array;
     }
-#else
-    Local<String> json_string;
 
-    if (nodem_baton->nodem_state->utf8 == true) {
-        json_string = new_string_n(isolate, nodem_baton->result);
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
     } else {
-        json_string = NodemValue::from_byte(nodem_baton->result);
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-#   if NODE_MAJOR_VERSION >= 1
-    TryCatch try_catch(isolate);
-#   else
-    TryCatch try_catch;
-#   endif
+    set_n(isolate, return_object, new_string_n(isolate, "results"), results);
 
-    Local<Object> temp_object;
-    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
+    // A scan that stopped early resumes after the last subscript it visited, which may be past the last one returned
+    if (nodem_baton->info == 1) {
+        string token = token_encode(nodem_baton->name, nodem_baton->subs_array, nodem_baton->reverse, nodem_baton->value);
 
-    if (try_catch.HasCaught()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
-        return scope.Escape(try_catch.Exception());
+        set_n(isolate, return_object, new_string_n(isolate, "token"), new_string_n(isolate, token.c_str()));
     } else {
-        temp_object = to_object_n(isolate, json);
+        set_n(isolate, return_object, new_string_n(isolate, "token"), Null(isolate));
     }
-#endif
-
-    Local<Object> return_object = Object::New(isolate);
-    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
-
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node exit");
 
-        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  scan exit");
 
-        if (temp_subs->IsUndefined()) {
-            return scope.Escape(Array::New(isolate));
-        }
+    return scope.Escape(return_object);
+} // @end nodem::scan function
 
-        return scope.Escape(temp_subs);
-    } else {
-        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+/*
+ * @function {private} nodem::to_json
+ * @summary Return the JSON text of a subtree, in a Buffer
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global or local variable name
+ * @member {string} value - The JSON text
+ * @member {gtm_uint_t} info - Shape of the JSON text: JSON_NESTED or JSON_FLAT
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object containing the JSON text
+ */
+static Local<Value> to_json(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-        if (nodem_baton->local) {
-            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
-        } else {
-            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
-        }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  to_json enter");
 
-        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
-        if (!temp_subs->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), temp_subs);
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   length: ", nodem_baton->value.length());
+    }
 
-        Local<Value> temp_data = get_n(isolate, temp_object, new_string_n(isolate, "data"));
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        if (!temp_data->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "data"), temp_data);
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-        set_n(isolate, return_object, new_string_n(isolate, "defined"),
-              get_n(isolate, temp_object, new_string_n(isolate, "defined")));
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node exit");
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
+
+    set_n(isolate, return_object, new_string_n(isolate, "shape"),
+      new_string_n(isolate, nodem_baton->info == JSON_FLAT ? "flat" : "nested"));
+    set_n(isolate, return_object, new_string_n(isolate, "json"),
+      new_buffer_n(isolate, nodem_baton->value.data(), nodem_baton->value.length()));
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  to_json exit");
 
     return scope.Escape(return_object);
-} // @end nodem::next_node function
+} // @end nodem::to_json function
 
 /*
- * @function {private} nodem::previous_node
- * @summary Return the previous global or local node, depth first
+ * @function {private} nodem::from_json
+ * @summary Return the number of nodes set from JSON text
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
- * @member {gtm_char_t*} result - Data returned from previous_node call
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {vector<string>} {ydb only} subs_array - The subscripts of the previous node
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global or local variable name
+ * @member {gtm_char_t*} result - Number of nodes set
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing the number of nodes set
  */
-static Local<Value> previous_node(NodemBaton* nodem_baton)
+static Local<Value> from_json(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  from_json enter");
+
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
-        debug_log(">>   result: ", nodem_baton->result);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
         debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
         debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   result: ", nodem_baton->result);
     }
 
-#if NODEM_SIMPLE_API == 1
-    Local<Object> temp_object = Object::New(isolate);
-
-    if (nodem_baton->status == YDB_NODE_END) {
-        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, false));
-    } else {
-        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, true));
-    }
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-    if (nodem_baton->status != YDB_NODE_END) {
-        string data(nodem_baton->result);
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-        if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
-            set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
-        } else {
-            if (nodem_baton->nodem_state->utf8 == true) {
-                set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
-            } else {
-                set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
-            }
-        }
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    Local<Array> subs_array = Array::New(isolate);
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-    if (nodem_baton->subs_array.size()) {
-        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-            if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   subs_array[", i, "]: ", nodem_baton->subs_array[i]);
+    set_n(isolate, return_object, new_string_n(isolate, "count"), Number::New(isolate, atof(nodem_baton->result)));
 
-            if (nodem_baton->nodem_state->mode == CANONICAL && is_number(nodem_baton->subs_array[i])) {
-                set_n(isolate, subs_array, i, Number::New(isolate, atof(nodem_baton->subs_array[i].c_str())));
-            } else {
-                if (nodem_baton->nodem_state->utf8 == true) {
-                    set_n(isolate, subs_array, i, new_string_n(isolate, nodem_baton->subs_array[i].c_str()));
-                } else {
-                    set_n(isolate, subs_array, i, NodemValue::from_byte((gtm_char_t*) nodem_baton->subs_array[i].c_str()));
-                }
-            }
-        }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  from_json exit");
 
-        set_n(isolate, temp_object, new_string_n(isolate, "subscripts"), subs_array);
-    }
-#else
-    Local<String> json_string;
+    return scope.Escape(return_object);
+} // @end nodem::from_json function
 
-    if (nodem_baton->nodem_state->utf8 == true) {
-        json_string = new_string_n(isolate, nodem_baton->result);
-    } else {
-        json_string = NodemValue::from_byte(nodem_baton->result);
-    }
+/*
+ * @function {private} nodem::count_distinct
+ * @summary Return the estimated number of distinct values or subscripts, and optionally the sketch it came from
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {bool} sketch - Whether to return the serialized sketch
+ * @member {string} name - Global or local variable name
+ * @member {string} value - The serialized sketch
+ * @member {gtm_uint_t} info - Subscript level that was counted, or 0 for values
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object containing the estimate
+ */
+static Local<Value> count_distinct(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) {
-        debug_log(">  previous_node JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
-    }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  count_distinct enter");
 
-#   if NODE_MAJOR_VERSION >= 1
-    TryCatch try_catch(isolate);
-#   else
-    TryCatch try_catch;
-#   endif
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+    DistinctSketch sketch;
 
-    Local<Object> temp_object;
-    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
+    sketch.merge(nodem_baton->value.data(), nodem_baton->value.length());
 
-    if (try_catch.HasCaught()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
-        return scope.Escape(try_catch.Exception());
-    } else {
-        temp_object = to_object_n(isolate, json);
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   estimate: ", sketch.estimate());
     }
-#endif
-
-    if (!get_n(isolate, temp_object, new_string_n(isolate, "status"))->IsUndefined()) return scope.Escape(temp_object);
 
     Local<Object> return_object = Object::New(isolate);
     Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node exit");
-
-        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
-
-        if (temp_subs->IsUndefined()) {
-            return scope.Escape(Array::New(isolate));
-        }
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-        return scope.Escape(temp_subs);
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
     } else {
-        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
-
-        if (nodem_baton->local) {
-            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
-        } else {
-            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
-        }
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
+    }
 
-        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
-        if (!temp_subs->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), temp_subs);
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-        Local<Value> temp_data = get_n(isolate, temp_object, new_string_n(isolate, "data"));
+    if (nodem_baton->info == 0) {
+        set_n(isolate, return_object, new_string_n(isolate, "of"), new_string_n(isolate, "value"));
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "of"), Number::New(isolate, nodem_baton->info));
+    }
 
-        if (!temp_data->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "data"), temp_data);
+    set_n(isolate, return_object, new_string_n(isolate, "estimate"), Number::New(isolate, sketch.estimate()));
 
-        set_n(isolate, return_object, new_string_n(isolate, "defined"),
-              get_n(isolate, temp_object, new_string_n(isolate, "defined")));
+    if (nodem_baton->sketch) {
+        set_n(isolate, return_object, new_string_n(isolate, "sketch"),
+          new_buffer_n(isolate, sketch.serialized().data(), sketch.serialized().length()));
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node exit");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  count_distinct exit");
 
     return scope.Escape(return_object);
-} // @end nodem::previous_node function
+} // @end nodem::count_distinct function
 
 /*
- * @function {private} nodem::increment
- * @summary Return the value of an incremented or decremented number in a global or local node
+ * @function {private} nodem::read_consistent
+ * @summary Return the value of each node read, in the order they were asked for
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
- * @member {gtm_char_t*} result - Data returned from increment call
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {gtm_double_t} option - The increment value
- * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {vector<vector<string>>} nodes_array - Each node, as its name followed by its subscripts
+ * @member {vector<string>} values_array - The value of each node
+ * @member {vector<unsigned int>} data_array - Whether each node has a value
+ * @member {bool} packed - Whether to return the results packed in a Buffer, rather than as an array of objects
+ * @member {Persistent/Global<Value>} arguments_p - V8 array of the nodes that were asked for
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing an array of results, one for each node
  */
-static Local<Value> increment(NodemBaton* nodem_baton)
+static Local<Value> read_consistent(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  read_consistent enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Array> nodes = Local<Array>::Cast(held_arguments(isolate, nodem_baton));
+    unsigned int count = nodem_baton->values_array.size();
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
-        debug_log(">>   result: ", nodem_baton->result);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
-        debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
-        debug_log(">>   name: ", nodem_baton->name);
-
-        if (!subscripts->IsUndefined()) {
-            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
-            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
-        }
-
-        debug_log(">>   increment: ", nodem_baton->option);
+        debug_log(">>   count: ", count);
     }
 
-#if NODEM_SIMPLE_API == 1
-    Local<Object> temp_object = Object::New(isolate);
-    string data(nodem_baton->result);
+    if (nodem_baton->packed) {
+        PackWriter pack_writer {PACK_CONSISTENT, nodem_baton->nodem_state->utf8, nodem_baton->nodem_state->mode == CANONICAL};
 
-    if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
-        set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
-    } else {
-        if (nodem_baton->nodem_state->utf8 == true) {
-            set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
-        } else {
-            set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
-        }
-    }
-#else
-    Local<String> json_string;
+        for (unsigned int i = 0; i < count; i++) {
+            const vector<string>& node = nodem_baton->nodes_array[i];
 
-    if (nodem_baton->nodem_state->utf8 == true) {
-        json_string = new_string_n(isolate, nodem_baton->result);
-    } else {
-        json_string = NodemValue::from_byte(nodem_baton->result);
-    }
+            pack_writer.add(node.data(), node.size(), nodem_baton->data_array[i] != 0, nodem_baton->values_array[i]);
+        }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
+        const string& packed = pack_writer.finish();
+        Local<Object> return_object = Object::New(isolate);
 
-#   if NODE_MAJOR_VERSION >= 1
-    TryCatch try_catch(isolate);
-#   else
-    TryCatch try_catch;
-#   endif
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+        set_n(isolate, return_object, new_string_n(isolate, "results"), new_buffer_n(isolate, packed.data(), packed.length()));
 
-    Local<Object> temp_object;
-    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  read_consistent exit");
 
-    if (try_catch.HasCaught()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
-        return scope.Escape(try_catch.Exception());
-    } else {
-        temp_object = to_object_n(isolate, json);
+        return scope.Escape(return_object);
     }
-#endif
 
-    Local<Object> return_object = Object::New(isolate);
-    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
+    Local<Array> results = Array::New(isolate, count);
 
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment exit");
-        return scope.Escape(get_n(isolate, temp_object, new_string_n(isolate, "data")));
-    } else {
-        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    for (unsigned int i = 0; i < count; i++) {
+        Local<Object> node = to_object_n(isolate, get_n(isolate, nodes, i));
+        Local<Object> result = Object::New(isolate);
+        Local<Value> glvn = get_n(isolate, node, new_string_n(isolate, "global"));
 
-        if (nodem_baton->local) {
-            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+        if (glvn->IsUndefined()) {
+            set_n(isolate, result, new_string_n(isolate, "local"), get_n(isolate, node, new_string_n(isolate, "local")));
         } else {
-            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
+            set_n(isolate, result, new_string_n(isolate, "global"), glvn);
         }
 
-        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
+        Local<Value> subscripts = get_n(isolate, node, new_string_n(isolate, "subscripts"));
 
-        set_n(isolate, return_object, new_string_n(isolate, "increment"), Number::New(isolate, nodem_baton->option));
-        set_n(isolate, return_object, new_string_n(isolate, "data"), get_n(isolate, temp_object, new_string_n(isolate, "data")));
+        if (!subscripts->IsUndefined()) set_n(isolate, result, new_string_n(isolate, "subscripts"), subscripts);
+
+        set_n(isolate, result, new_string_n(isolate, "data"), scan_value(nodem_baton->values_array[i], nodem_baton->nodem_state));
+        set_n(isolate, result, new_string_n(isolate, "defined"), Boolean::New(isolate, nodem_baton->data_array[i] != 0));
+        set_n(isolate, results, i, result);
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment exit");
+    Local<Object> return_object = Object::New(isolate);
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "results"), results);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  read_consistent exit");
 
     return scope.Escape(return_object);
-} // @end nodem::increment function
+} // @end nodem::read_consistent function
 
 /*
- * @function {private} nodem::lock
- * @summary Return data about an incremental lock of a global or local node
+ * @function {private} nodem::sample
+ * @summary Return the nodes chosen by a sample, each with its subscripts and value
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
- * @member {gtm_char_t*} result - Data returned from lock call
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global or local variable name
+ * @member {string} value - Number of nodes with values a reservoir sample has seen
+ * @member {gtm_double_t} option - Number of nodes asked for
+ * @member {gtm_uint_t} info - Sampling method: RESERVOIR or DESCENT
+ * @member {vector<vector<string>>} nodes_array - The subscripts of each node chosen
+ * @member {vector<string>} values_array - The value of each node chosen
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing an array of results, one for each node chosen
  */
-static Local<Value> lock(NodemBaton* nodem_baton)
+static Local<Value> sample(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sample enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+    vector<vector<string>>& nodes = nodem_baton->nodes_array;
+    vector<string>& values = nodem_baton->values_array;
+    size_t size = static_cast<size_t>(nodem_baton->option);
 
-    if (nodem_baton->nodem_state->debug > LOW) {
-        debug_log(">>   status: ", nodem_baton->status);
-        debug_log(">>   result: ", nodem_baton->result);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+    // Descents in a sharded global choose a full sample in every shard, so a random subset of them is kept
+    if (nodes.size() > size) {
+        std::mt19937_64 generator {std::random_device {}()};
+
+        for (size_t i = 0; i < size; i++) {
+            size_t j = std::uniform_int_distribution<size_t> {i, nodes.size() - 1}(generator);
+
+            std::swap(nodes[i], nodes[j]);
+            std::swap(values[i], values[j]);
+        }
+
+        nodes.resize(size);
+        values.resize(size);
+    }
+
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
         debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
         debug_log(">>   name: ", nodem_baton->name);
-
-        if (!subscripts->IsUndefined()) {
-            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
-            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
-        }
+        debug_log(">>   count: ", nodes.size());
     }
 
-#if NODEM_SIMPLE_API == 1
-    Local<Object> temp_object = Object::New(isolate);
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
+    Local<Array> results = Array::New(isolate, nodes.size());
 
-    set_n(isolate, temp_object, new_string_n(isolate, "result"), Boolean::New(isolate, atoi(nodem_baton->result)));
-#else
-    Local<String> json_string;
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-    if (nodem_baton->nodem_state->utf8 == true) {
-        json_string = new_string_n(isolate, nodem_baton->result);
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
     } else {
-        json_string = NodemValue::from_byte(nodem_baton->result);
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
-
-#   if NODE_MAJOR_VERSION >= 1
-    TryCatch try_catch(isolate);
-#   else
-    TryCatch try_catch;
-#   endif
-
-    Local<Object> temp_object;
-    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-    if (try_catch.HasCaught()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
-        return scope.Escape(try_catch.Exception());
+    if (nodem_baton->info == RESERVOIR) {
+        set_n(isolate, return_object, new_string_n(isolate, "method"), new_string_n(isolate, "reservoir"));
+        set_n(isolate, return_object, new_string_n(isolate, "count"), Number::New(isolate, strtod(nodem_baton->value.c_str(), NULL)));
     } else {
-        temp_object = to_object_n(isolate, json);
+        set_n(isolate, return_object, new_string_n(isolate, "method"), new_string_n(isolate, "descent"));
     }
-#endif
 
-    Local<Object> return_object = Object::New(isolate);
-    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+        Local<Object> result = Object::New(isolate);
+        Local<Array> node = Array::New(isolate, nodes[i].size());
 
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock exit");
+        for (unsigned int j = 0; j < nodes[i].size(); j++) set_n(isolate, node, j, scan_value(nodes[i][j], nodem_baton->nodem_state));
 
-        Local<Value> result = get_n(isolate, temp_object, new_string_n(isolate, "result"));
-        return scope.Escape(result);
-    } else {
-        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+        set_n(isolate, result, new_string_n(isolate, "subscripts"), node);
+        set_n(isolate, result, new_string_n(isolate, "data"), scan_value(values[i], nodem_baton->nodem_state));
+        set_n(isolate, results, i, result);
+    }
 
-        if (nodem_baton->local) {
-            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
-        } else {
-            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
-        }
+    set_n(isolate, return_object, new_string_n(isolate, "results"), results);
 
-        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sample exit");
 
-        if (nodem_baton->option > -1) {
-            set_n(isolate, return_object, new_string_n(isolate, "timeout"), Number::New(isolate, nodem_baton->option));
-        } else {
-            set_n(isolate, return_object, new_string_n(isolate, "timeout"),
-                  Number::New(isolate, numeric_limits<double>::infinity()));
-        }
+    return scope.Escape(return_object);
+} // @end nodem::sample function
 
-        set_n(isolate, return_object, new_string_n(isolate, "result"),
-              get_n(isolate, temp_object, new_string_n(isolate, "result")));
+/*
+ * @function {private} nodem::sorter_write
+ * @summary Return the number of sort records written
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {vector<string>} to_subs_array - The sort keys written
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object containing the count
+ */
+static Local<Value> sorter_write(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sorter_write enter");
+
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   count: ", nodem_baton->to_subs_array.size());
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock exit");
+    Local<Object> return_object = Object::New(isolate);
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "count"), Number::New(isolate, nodem_baton->to_subs_array.size()));
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sorter_write exit");
 
     return scope.Escape(return_object);
-} // @end nodem::lock function
+} // @end nodem::sorter_write function
 
 /*
- * @function {private} nodem::unlock
- * @summary Return data about unlocking a global or local node, or releasing all locks
+ * @function {private} nodem::sorter_read
+ * @summary Return a page of sort records, in key order, and where the next page starts
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {vector<string>} to_subs_array - The key of each record read
+ * @member {vector<string>} values_array - Each record read
+ * @member {string} value - Sequence number of the last record read
+ * @member {gtm_double_t} option - Maximum number of records to read; a shorter page is the last one
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @nested-member {bool} utf8 - Whether to decode the data as UTF-8, or as bytes
+ * @returns {Local<Value>} - An object containing an array of results, and the position to pass back for the next page
  */
-static Local<Value> unlock(NodemBaton* nodem_baton)
+static Local<Value> sorter_read(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sorter_read enter");
 
-    Local<Value> subscripts = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    const vector<string>& keys = nodem_baton->to_subs_array;
+    const vector<string>& records = nodem_baton->values_array;
+    unsigned int count = keys.size();
 
     if (nodem_baton->nodem_state->debug > LOW) {
         debug_log(">>   status: ", nodem_baton->status);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
-        debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
-        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   count: ", count);
+    }
 
-        if (!subscripts->IsUndefined()) {
-            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
-            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
-        }
+    Local<Array> results = Array::New(isolate, count);
+
+    for (unsigned int i = 0; i < count; i++) {
+        Local<Object> result = Object::New(isolate);
+
+        set_n(isolate, result, new_string_n(isolate, "key"), scan_value(keys[i], nodem_baton->nodem_state));
+        set_n(isolate, result, new_string_n(isolate, "record"), scan_value(records[i], nodem_baton->nodem_state));
+        set_n(isolate, results, i, result);
     }
 
     Local<Object> return_object = Object::New(isolate);
-    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-    if (name->StrictEquals(new_string_n(isolate, "")) || nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock exit");
-        Local<Value> ret_data = Undefined(isolate);
-        return scope.Escape(ret_data);
-    } else {
-        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "results"), results);
 
-        if (nodem_baton->local) {
-            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+    // The position holds the stored key as a string, not as a number, so it is passed back exactly as it was stored
+    if (count > 0 && count == static_cast<unsigned int>(nodem_baton->option)) {
+        Local<Array> next = Array::New(isolate, 2);
+
+        if (nodem_baton->nodem_state->utf8 == true) {
+            set_n(isolate, next, 0, new_string_n(isolate, keys[count - 1].c_str()));
         } else {
-            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
+            set_n(isolate, next, 0, NodemValue::from_byte((gtm_char_t*) keys[count - 1].c_str()));
         }
 
-        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
+        set_n(isolate, next, 1, new_string_n(isolate, nodem_baton->value.c_str()));
+        set_n(isolate, return_object, new_string_n(isolate, "next"), next);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "next"), Null(isolate));
     }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock exit");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  sorter_read exit");
 
     return scope.Escape(return_object);
-} // @end nodem::unlock function
+} // @end nodem::sorter_read function
 
 /*
- * @function {private} nodem::function
- * @summary Return value from an arbitrary extrinsic function
+ * @function {private} nodem::bloom
+ * @summary Return the size and hit counts of the Bloom filter that was built, or whether one was dropped
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_char_t*} result - Data returned from function call
- * @member {gtm_uint_t*} info - Indirection limit on input - (0|1) Return data type on output; 0 is string, 1 is canonical number
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
- * @member {string} relink - Whether to relink the function before calling it
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {bool} node_only - Whether the filter was dropped, rather than built
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the node the filter is under
+ * @member {char*} result - Whether a filter was dropped
+ * @member {gtm_uint_t} info - Subscript level of the keys in the filter
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object describing the filter
  */
-static Local<Value> function(NodemBaton* nodem_baton)
+static Local<Value> bloom(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  bloom enter");
 
-    Local<Value> arguments = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
+    bloom_ptr_t filter;
+
+    if (!nodem_baton->node_only) filter = bloom_find(nodem_baton->name, nodem_baton->subs_array, nodem_baton->info);
 
     if (nodem_baton->nodem_state->debug > LOW) {
-        debug_log(">>   result: ", nodem_baton->result);
-        debug_log(">>   info: ", nodem_baton->info);
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   status: ", nodem_baton->status);
         debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
         debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   result: ", nodem_baton->result);
+    }
 
-        if (!arguments->IsUndefined()) {
-            Local<Value> argument_string = json_method(arguments, "stringify", nodem_baton->nodem_state);
-            debug_log(">>   arguments: ", *(UTF8_VALUE_TEMP_N(isolate, argument_string)));
-        }
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        debug_log(">>   relink: ", nodem_baton->relink);
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    Local<Value> ret_string;
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-    if (nodem_baton->nodem_state->utf8 == true) {
-        ret_string = new_string_n(isolate, nodem_baton->result);
-    } else {
-        ret_string = NodemValue::from_byte(nodem_baton->result);
+    set_n(isolate, return_object, new_string_n(isolate, "level"), Number::New(isolate, nodem_baton->info));
+
+    if (nodem_baton->node_only) {
+        set_n(isolate, return_object, new_string_n(isolate, "dropped"),
+          Boolean::New(isolate, strcmp(nodem_baton->result, "1") == 0));
+    } else if (filter) {
+        set_n(isolate, return_object, new_string_n(isolate, "count"), Number::New(isolate, filter->count.load()));
+        set_n(isolate, return_object, new_string_n(isolate, "bits"), Number::New(isolate, filter->bits));
+        set_n(isolate, return_object, new_string_n(isolate, "hashes"), Number::New(isolate, filter->hashes));
+        set_n(isolate, return_object, new_string_n(isolate, "stale"), Boolean::New(isolate, filter->state.load() == STALE));
+        set_n(isolate, return_object, new_string_n(isolate, "probes"), Number::New(isolate, filter->probes.load()));
+        set_n(isolate, return_object, new_string_n(isolate, "negatives"), Number::New(isolate, filter->negatives.load()));
     }
 
-    if (nodem_baton->info == 1) ret_string = to_number_n(isolate, ret_string);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  bloom exit");
 
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function exit");
-        return scope.Escape(ret_string);
+    return scope.Escape(return_object);
+} // @end nodem::bloom function
+
+/*
+ * @function {private} nodem::define_aggregate
+ * @summary Return the aggregate that was defined, with the number of source nodes in its totals, or whether one was dropped
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} node_only - Whether the definition was dropped, rather than made
+ * @member {string} name - Source global name
+ * @member {string} to_name - Target global name
+ * @member {gtm_uint_t} info - Number of leading subscripts that group the source nodes
+ * @member {gtm_double_t} option - Subscript level of the source nodes whose values are totaled
+ * @member {vector<string>} values_array - The totals kept
+ * @member {char*} result - The number of source nodes totaled, or whether a definition was dropped
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object describing the aggregate
+ */
+static Local<Value> define_aggregate(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  define_aggregate enter");
+
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   to_name: ", nodem_baton->to_name);
+        debug_log(">>   result: ", nodem_baton->result);
     }
 
     Local<Object> return_object = Object::New(isolate);
-    Local<String> function = new_string_n(isolate, nodem_baton->name.c_str());
 
     set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
-    set_n(isolate, return_object, new_string_n(isolate, "function"), localize_name(function, nodem_baton->nodem_state));
 
-    if (!arguments->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "arguments"), arguments);
+    aggregate_ptr_t aggregate = nodem_baton->node_only ? aggregate_ptr_t {} : aggregate_find(nodem_baton->to_name);
 
-    set_n(isolate, return_object, new_string_n(isolate, "autoRelink"), Boolean::New(isolate, nodem_baton->relink));
-    set_n(isolate, return_object, new_string_n(isolate, "result"), ret_string);
+    if (aggregate) {
+        set_n(isolate, return_object, new_string_n(isolate, "source"),
+          localize_name(new_string_n(isolate, aggregate->source.c_str()), nodem_baton->nodem_state));
+    }
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function exit");
+    set_n(isolate, return_object, new_string_n(isolate, "target"),
+      localize_name(new_string_n(isolate, nodem_baton->to_name.c_str()), nodem_baton->nodem_state));
+
+    if (aggregate) {
+        Local<Array> ops = Array::New(isolate);
+
+        if (aggregate->ops & AGGREGATE_COUNT) set_n(isolate, ops, ops->Length(), new_string_n(isolate, "count"));
+        if (aggregate->ops & AGGREGATE_SUM) set_n(isolate, ops, ops->Length(), new_string_n(isolate, "sum"));
+
+        set_n(isolate, return_object, new_string_n(isolate, "groupLevel"), Number::New(isolate, aggregate->group_level));
+        set_n(isolate, return_object, new_string_n(isolate, "valueLevel"), Number::New(isolate, aggregate->value_level));
+        set_n(isolate, return_object, new_string_n(isolate, "ops"), ops);
+        set_n(isolate, return_object, new_string_n(isolate, "stale"), Boolean::New(isolate, aggregate->stale.load()));
+    }
+
+    if (nodem_baton->node_only) {
+        set_n(isolate, return_object, new_string_n(isolate, "dropped"),
+          Boolean::New(isolate, strcmp(nodem_baton->result, "1") == 0));
+    } else if (!nodem_baton->name.empty()) {
+        set_n(isolate, return_object, new_string_n(isolate, "count"), Number::New(isolate, atof(nodem_baton->result)));
+    }
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  define_aggregate exit");
 
     return scope.Escape(return_object);
-} // @end nodem::function function
+} // @end nodem::define_aggregate function
 
 /*
- * @function {private} nodem::procedure
- * @summary Return value from an arbitrary procedure/routine
+ * @function {private} nodem::prune
+ * @summary Return how many nodes were run against the filter and pruned, and a token to resume from if the walk is not done
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {gtm_uint_t} info - Indirection limit
- * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
- * @member {bool} local - Whether the API was called on a local variable, or a global variable
- * @member {bool} async - Whether the API was called asynchronously, or synchronously
- * @member {string} name - The name of the global or local variable
- * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
- * @member {string} relink - Whether to relink the procedure before calling it
+ * @member {bool} local - Whether the API was called on a local variable or a global variable
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the subtree root
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {gtm_uint_t} info - Subscript level of the nodes the filter was run against
+ * @member {gtm_double_t} option - Maximum number of nodes visited in each transaction
+ * @member {string} value - The where expression, which the token is scoped to
+ * @member {vector<string>} to_subs_array - The path to resume after, below the root; empty once the walk is done
+ * @member {gtm_char_t*} result - The number of nodes run against the filter, pruned, and the chunks committed
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing the node counts and continuation token
  */
-static Local<Value> procedure(NodemBaton* nodem_baton)
+static Local<Value> prune(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
     EscapableHandleScope scope(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  prune enter");
 
-    Local<Value> arguments = Local<Value>::New(isolate, nodem_baton->arguments_p);
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
-        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   status: ", nodem_baton->status);
         debug_log(">>   local: ", boolalpha, nodem_baton->local);
         debug_log(">>   async: ", boolalpha, nodem_baton->async);
         debug_log(">>   name: ", nodem_baton->name);
-
-        if (!arguments->IsUndefined()) {
-            Local<Value> argument_string = json_method(arguments, "stringify", nodem_baton->nodem_state);
-            debug_log(">>   arguments: ", *(UTF8_VALUE_TEMP_N(isolate, argument_string)));
-        }
-
-        debug_log(">>   relink: ", nodem_baton->relink);
+        debug_log(">>   result: ", nodem_baton->result);
     }
 
-    if (nodem_baton->position) {
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure exit");
-        Local<Value> ret_data = Undefined(isolate);
-        return scope.Escape(ret_data);
-    }
+    char* counts = nodem_baton->result;
+    double scanned = strtod(counts, &counts);
+    double pruned = strtod(counts, &counts);
+    double chunks = strtod(counts, NULL);
 
     Local<Object> return_object = Object::New(isolate);
-    Local<String> procedure = new_string_n(isolate, nodem_baton->name.c_str());
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
     set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-    if (nodem_baton->routine) {
-        set_n(isolate, return_object, new_string_n(isolate, "routine"), localize_name(procedure, nodem_baton->nodem_state));
+    if (nodem_baton->local) {
+        set_n(isolate, return_object, new_string_n(isolate, "local"), name);
     } else {
-        set_n(isolate, return_object, new_string_n(isolate, "procedure"), localize_name(procedure, nodem_baton->nodem_state));
+        set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
     }
 
-    if (!arguments->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "arguments"), arguments);
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-    set_n(isolate, return_object, new_string_n(isolate, "autoRelink"), Boolean::New(isolate, nodem_baton->relink));
+    set_n(isolate, return_object, new_string_n(isolate, "level"), Number::New(isolate, nodem_baton->info));
+    set_n(isolate, return_object, new_string_n(isolate, "chunkSize"), Number::New(isolate, nodem_baton->option));
+    set_n(isolate, return_object, new_string_n(isolate, "scanned"), Number::New(isolate, scanned));
+    set_n(isolate, return_object, new_string_n(isolate, "pruned"), Number::New(isolate, pruned));
+    set_n(isolate, return_object, new_string_n(isolate, "chunks"), Number::New(isolate, chunks));
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure exit");
+    if (nodem_baton->to_subs_array.empty()) {
+        set_n(isolate, return_object, new_string_n(isolate, "token"), Null(isolate));
+    } else {
+        vector<string> token_scope = nodem_baton->subs_array;
+
+        token_scope.push_back(std::to_string(nodem_baton->info));
+        token_scope.push_back(nodem_baton->value);
+
+        string token = token_encode(nodem_baton->name, token_scope, false, token_join(nodem_baton->to_subs_array));
+
+        set_n(isolate, return_object, new_string_n(isolate, "token"), new_string_n(isolate, token.c_str()));
+    }
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  prune exit");
 
     return scope.Escape(return_object);
-} // @end nodem::procedure function
+} // @end nodem::prune function
 
-#if NODEM_SIMPLE_API == 1
 /*
- * @function {private} nodem::transaction
- * @summary Call a JavaScript function within a YottaDB transaction
- * @param {void*} data - Cast in to a NodemBaton struct containing the following members
+ * @function {private} nodem::move
+ * @summary Return the trees a move was made between, and how many nodes were moved
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {Persistent<Value>} object_p - V8 object containing the input object
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {gtm_double_t} option - Maximum number of nodes copied in each transaction
+ * @member {bool} atomic - Whether the move was made in one transaction, rather than in chunks
+ * @member {gtm_char_t*} result - The number of nodes moved, and the transactions committed
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
- * @returns {Local<Value>} return_object - Data returned to Node.js
+ * @returns {Local<Value>} - An object containing the from and to trees, and the node count
  */
-static int transaction(void *data)
+static Local<Value> move(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-    NodemBaton* nodem_baton = (NodemBaton*) data;
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  move enter");
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction enter");
+    Local<Object> temp_object = held_object(isolate, nodem_baton);
 
     if (nodem_baton->nodem_state->debug > LOW) {
-        debug_log(">>   tp_level: ", nodem_baton->nodem_state->tp_level);
-        debug_log(">>   tp_restart: ", nodem_baton->nodem_state->tp_restart);
-    }
-
-    if (nodem_baton->nodem_state->tp_restart == 3) {
-        nodem_baton->nodem_state->tp_restart = 0;
-
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: max restart");
-
-        return YDB_TP_ROLLBACK;
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   result: ", nodem_baton->result);
     }
 
-    Local<Value> value = call_n(isolate, Local<Function>::New(isolate, nodem_baton->callback_p), Null(isolate), 0, NULL);
-
-    if (value->IsNull()) {
-        if (nodem_baton->nodem_state->tp_level == 1) nodem_baton->nodem_state->tp_restart = 0;
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: error thrown");
-
-        return YDB_TP_ROLLBACK;
-    } else if (value->StrictEquals(new_string_n(isolate, "Rollback")) || value->StrictEquals(new_string_n(isolate, "rollback")) ||
-      value->StrictEquals(new_string_n(isolate, "ROLLBACK")) || value->StrictEquals(Number::New(isolate, YDB_TP_ROLLBACK))) {
-        nodem_baton->nodem_state->tp_restart = 0;
-
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: rollback");
-
-        return YDB_TP_ROLLBACK;
-    } else if (value->StrictEquals(new_string_n(isolate, "Restart")) || value->StrictEquals(new_string_n(isolate, "restart")) ||
-      value->StrictEquals(new_string_n(isolate, "RESTART")) || value->StrictEquals(Number::New(isolate, YDB_TP_RESTART))) {
-        if (nodem_baton->nodem_state->tp_level == 1) nodem_baton->nodem_state->tp_restart++;
-        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: restart");
+    char* counts = nodem_baton->result;
+    double moved = strtod(counts, &counts);
+    double chunks = strtod(counts, NULL);
 
-        return YDB_TP_RESTART;
-    }
+    Local<Object> return_object = Object::New(isolate);
 
-    nodem_baton->nodem_state->tp_restart = 0;
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "from"), get_n(isolate, temp_object, new_string_n(isolate, "from")));
+    set_n(isolate, return_object, new_string_n(isolate, "to"), get_n(isolate, temp_object, new_string_n(isolate, "to")));
+    set_n(isolate, return_object, new_string_n(isolate, "chunkSize"), Number::New(isolate, nodem_baton->option));
+    set_n(isolate, return_object, new_string_n(isolate, "chunked"), Boolean::New(isolate, !nodem_baton->atomic));
+    set_n(isolate, return_object, new_string_n(isolate, "moved"), Number::New(isolate, moved));
+    set_n(isolate, return_object, new_string_n(isolate, "chunks"), Number::New(isolate, chunks));
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: commit");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  move exit");
 
-    return YDB_OK;
-} // @end nodem::transaction function
+    return scope.Escape(return_object);
+} // @end nodem::move function
 #endif
 
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
 /*
- * @function {private} nodem::cleanup_nodem_state
- * @summary Delete heap resources after worker threads exit
- * @param {void*} class_name - The class instance to delete
- * @returns {void}
+ * @function {private} nodem::next_node
+ * @summary Return the next global or local node, depth first
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
+ * @member {gtm_char_t*} result - Data returned from next_node call
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {vector<string>} {ydb only} subs_array - The subscripts of the next node
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
  */
-inline static void cleanup_nodem_state(void* class_name)
+static Local<Value> next_node(NodemBaton* nodem_baton)
 {
-  delete static_cast<NodemState*>(class_name);
-  return;
-} // @end nodem::cleanup_nodem_state
-#endif
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-/*
- * @function nodem::async_work
- * @summary Call in to YottaDB/GT.M asynchronously, via a Node.js worker thread
- * @param {uv_work_t*} request - A pointer to the NodemBaton structure for transferring data between the main and worker threads
- * @returns {void}
- */
-void async_work(uv_work_t* request)
-{
-    NodemBaton* nodem_baton = static_cast<NodemBaton*>(request->data);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node enter");
 
-    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_work enter");
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+    }
 
-    nodem_baton->status = (*nodem_baton->nodem_function)(nodem_baton);
+#if NODEM_SIMPLE_API == 1
+    Local<Object> temp_object = Object::New(isolate);
 
-    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
-    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_work exit\n");
+    if (nodem_baton->status == YDB_NODE_END) {
+        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, false));
+    } else {
+        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, true));
+    }
 
-    return;
-} // @end nodem::async_work function
+    if (nodem_baton->status != YDB_NODE_END) {
+        string data(nodem_baton->result);
 
-/*
- * @function nodem::async_after
- * @summary Call in to the return functions, passing the data from YottaDB/GT.M, after receiving the data from the worker thread
- * @param {uv_work_t*} request - A pointer to the NodemBaton structure for transferring data between the main and worker threads
- * @returns {void}
- */
-void async_after(uv_work_t* request, int status)
-{
-    Isolate* isolate = Isolate::GetCurrent();
-    HandleScope scope(isolate);
+        if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
+            set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
+        } else {
+            if (nodem_baton->nodem_state->utf8 == true) {
+                set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
+            } else {
+                set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
+            }
+        }
+    }
 
-    NodemBaton* nodem_baton = static_cast<NodemBaton*>(request->data);
+    Local<Array> subs_array = Array::New(isolate);
 
-    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_after enter: ", status);
+    if (nodem_baton->subs_array.size()) {
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   subs_array[", i, "]: ", nodem_baton->subs_array[i]);
 
-    Local<Value> error_code = Null(isolate);
-    Local<Value> return_object;
-    Local<Value> error_object;
+            if (nodem_baton->nodem_state->mode == CANONICAL && is_number(nodem_baton->subs_array[i])) {
+                set_n(isolate, subs_array, i, Number::New(isolate, atof(nodem_baton->subs_array[i].c_str())));
+            } else {
+                if (nodem_baton->nodem_state->utf8 == true) {
+                    set_n(isolate, subs_array, i, new_string_n(isolate, nodem_baton->subs_array[i].c_str()));
+                } else {
+                    set_n(isolate, subs_array, i, NodemValue::from_byte((gtm_char_t*) nodem_baton->subs_array[i].c_str()));
+                }
+            }
+        }
 
-#if NODEM_SIMPLE_API == 1
-    if (nodem_baton->status == -1) {
-        nodem_baton->callback_p.Reset();
-        nodem_baton->object_p.Reset();
-        nodem_baton->arguments_p.Reset();
-        nodem_baton->data_p.Reset();
+        set_n(isolate, temp_object, new_string_n(isolate, "subscripts"), subs_array);
+    }
+#else
+    Local<String> json_string;
 
-        delete[] nodem_baton->error;
-        delete[] nodem_baton->result;
-        delete nodem_baton;
+    if (nodem_baton->nodem_state->utf8 == true) {
+        json_string = new_string_n(isolate, nodem_baton->result);
+    } else {
+        json_string = NodemValue::from_byte(nodem_baton->result);
+    }
 
-        char error[BUFSIZ];
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-        return;
-    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_ERR_GVUNDEF &&
-               nodem_baton->status != YDB_ERR_LVUNDEF && nodem_baton->status != YDB_NODE_END) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   " NODEM_DB " error code: ", nodem_baton->status);
+#   if NODE_MAJOR_VERSION >= 1
+    TryCatch try_catch(isolate);
+#   else
+    TryCatch try_catch;
+#   endif
 
-        error_object = error_status(nodem_baton->error, nodem_baton->position, nodem_baton->async, nodem_baton->nodem_state);
+    Local<Object> temp_object;
+    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
 
-        error_code = Exception::Error(new_string_n(isolate, *(UTF8_VALUE_TEMP_N(isolate,
-                     get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorMessage"))))));
+    if (try_catch.HasCaught()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
+        return scope.Escape(try_catch.Exception());
+    } else {
+        temp_object = to_object_n(isolate, json);
+    }
+#endif
 
-        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "ok"),
-              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "ok")));
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "errorCode"),
-              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorCode")));
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node exit");
 
-        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "errorMessage"),
-              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorMessage")));
+        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
 
-        return_object = Undefined(isolate);
+        if (temp_subs->IsUndefined()) {
+            return scope.Escape(Array::New(isolate));
+        }
+
+        return scope.Escape(temp_subs);
     } else {
-        return_object = (*nodem_baton->ret_function)(nodem_baton);
-    }
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-    Local<Value> argv[2] = {error_code, return_object};
-    call_n(isolate, Local<Function>::New(isolate, nodem_baton->callback_p), Null(isolate), 2, argv);
+        if (nodem_baton->local) {
+            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+        } else {
+            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
+        }
 
-    nodem_baton->callback_p.Reset();
-    nodem_baton->arguments_p.Reset();
-    nodem_baton->data_p.Reset();
+        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
 
-    delete[] nodem_baton->error;
-    delete[] nodem_baton->result;
+        if (!temp_subs->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), temp_subs);
 
-    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_after exit\n");
+        Local<Value> temp_data = get_n(isolate, temp_object, new_string_n(isolate, "data"));
+
+        if (!temp_data->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "data"), temp_data);
 
-    delete nodem_baton;
+        set_n(isolate, return_object, new_string_n(isolate, "defined"),
+              get_n(isolate, temp_object, new_string_n(isolate, "defined")));
+    }
 
-    return;
-} // @end nodem::async_after function
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  next_node exit");
 
-// ***Begin Public APIs***
+    return scope.Escape(return_object);
+} // @end nodem::next_node function
 
 /*
- * @method nodem::Nodem::open
- * @summary Open a connection with YottaDB/GT.M
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
- * @returns {void}
+ * @function {private} nodem::previous_node
+ * @summary Return the previous global or local node, depth first
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
+ * @member {gtm_char_t*} result - Data returned from previous_node call
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {vector<string>} {ydb only} subs_array - The subscripts of the previous node
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
  */
-void Nodem::open(const FunctionCallbackInfo<Value>& info)
+static Local<Value> previous_node(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
-    HandleScope scope(isolate);
+    EscapableHandleScope scope(isolate);
 
-    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node enter");
 
-    if (nodem_state->pid != nodem_state->tid) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection must be managed by main thread")));
-        return;
-    } else if (nodem_state_g == CLOSED) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection cannot be reopened")));
-        return;
-    } else if (nodem_state_g == OPEN) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection already open")));
-        return;
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
     }
 
-    char* relink = getenv("NODEM_AUTO_RELINK");
-
-    if (relink != NULL) auto_relink_g = nodem_state->auto_relink = static_cast<bool>(atoi(relink));
+#if NODEM_SIMPLE_API == 1
+    Local<Object> temp_object = Object::New(isolate);
 
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
+    if (nodem_baton->status == YDB_NODE_END) {
+        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, false));
+    } else {
+        set_n(isolate, temp_object, new_string_n(isolate, "defined"), Boolean::New(isolate, true));
+    }
 
-        if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
-            UTF8_VALUE_N(isolate, debug, get_n(isolate, arg_object, new_string_n(isolate, "debug")));
+    if (nodem_baton->status != YDB_NODE_END) {
+        string data(nodem_baton->result);
 
-            if (strcasecmp(*debug, "off") == 0) {
-                debug_g = nodem_state->debug = OFF;
-            } else if (strcasecmp(*debug, "low") == 0) {
-                debug_g = nodem_state->debug = LOW;
-            } else if (strcasecmp(*debug, "medium") == 0) {
-                debug_g = nodem_state->debug = MEDIUM;
-            } else if (strcasecmp(*debug, "high") == 0) {
-                debug_g = nodem_state->debug = HIGH;
+        if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
+            set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
+        } else {
+            if (nodem_baton->nodem_state->utf8 == true) {
+                set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
             } else {
-                debug_g = nodem_state->debug = static_cast<debug_t>
-                  (uint32_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "debug"))));
-
-                if (nodem_state->debug < 0) {
-                    debug_g = nodem_state->debug = OFF;
-                } else if (nodem_state->debug > 3) {
-                    debug_g = nodem_state->debug = HIGH;
-                }
+                set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
             }
         }
+    }
 
-        if (nodem_state->debug > OFF) {
-            debug_log(">  Nodem::open enter");
+    Local<Array> subs_array = Array::New(isolate);
 
-            char* debug_display = (char*) "off";
+    if (nodem_baton->subs_array.size()) {
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   subs_array[", i, "]: ", nodem_baton->subs_array[i]);
 
-            if (nodem_state->debug == LOW) {
-                debug_display = (char*) "low";
-            } else if (nodem_state->debug == MEDIUM) {
-                debug_display = (char*) "medium";
+            if (nodem_baton->nodem_state->mode == CANONICAL && is_number(nodem_baton->subs_array[i])) {
+                set_n(isolate, subs_array, i, Number::New(isolate, atof(nodem_baton->subs_array[i].c_str())));
             } else {
-                debug_display = (char*) "high";
+                if (nodem_baton->nodem_state->utf8 == true) {
+                    set_n(isolate, subs_array, i, new_string_n(isolate, nodem_baton->subs_array[i].c_str()));
+                } else {
+                    set_n(isolate, subs_array, i, NodemValue::from_byte((gtm_char_t*) nodem_baton->subs_array[i].c_str()));
+                }
             }
-
-            debug_log(">  debug: ", debug_display);
         }
 
-        Local<Value> global_dir = get_n(isolate, arg_object, new_string_n(isolate, "globalDirectory"));
-
-        if (global_dir->IsUndefined()) global_dir = get_n(isolate, arg_object, new_string_n(isolate, "namespace"));
-
-        if (!global_dir->IsUndefined() && global_dir->IsString()) {
-            if (nodem_state->debug > LOW) debug_log(">>   globalDirectory: ", *(UTF8_VALUE_TEMP_N(isolate, global_dir)));
-
-#if NODEM_SIMPLE_API == 1
-            if (setenv("ydb_gbldir", *(UTF8_VALUE_TEMP_N(isolate, global_dir)), 1) == -1) {
+        set_n(isolate, temp_object, new_string_n(isolate, "subscripts"), subs_array);
+    }
 #else
-            if (setenv("gtmgbldir", *(UTF8_VALUE_TEMP_N(isolate, global_dir)), 1) == -1) {
-#endif
-                char error[BUFSIZ];
+    Local<String> json_string;
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-        }
+    if (nodem_baton->nodem_state->utf8 == true) {
+        json_string = new_string_n(isolate, nodem_baton->result);
+    } else {
+        json_string = NodemValue::from_byte(nodem_baton->result);
+    }
 
-        Local<Value> routines_path = get_n(isolate, arg_object, new_string_n(isolate, "routinesPath"));
+    if (nodem_baton->nodem_state->debug > OFF) {
+        debug_log(">  previous_node JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
+    }
 
-        if (!routines_path->IsUndefined() && routines_path->IsString()) {
-            if (nodem_state->debug > LOW) debug_log(">>   routinesPath: ", *(UTF8_VALUE_TEMP_N(isolate, routines_path)));
+#   if NODE_MAJOR_VERSION >= 1
+    TryCatch try_catch(isolate);
+#   else
+    TryCatch try_catch;
+#   endif
 
-#if NODEM_SIMPLE_API == 1
-            if (setenv("ydb_routines", *(UTF8_VALUE_TEMP_N(isolate, routines_path)), 1) == -1) {
-#else
-            if (setenv("gtmroutines", *(UTF8_VALUE_TEMP_N(isolate, routines_path)), 1) == -1) {
+    Local<Object> temp_object;
+    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
+
+    if (try_catch.HasCaught()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
+        return scope.Escape(try_catch.Exception());
+    } else {
+        temp_object = to_object_n(isolate, json);
+    }
 #endif
-                char error[BUFSIZ];
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-        }
+    if (!get_n(isolate, temp_object, new_string_n(isolate, "status"))->IsUndefined()) return scope.Escape(temp_object);
 
-        Local<Value> callin_table = get_n(isolate, arg_object, new_string_n(isolate, "callinTable"));
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        if (!callin_table->IsUndefined() && callin_table->IsString()) {
-            if (nodem_state->debug > LOW) debug_log(">>   callinTable: ", *(UTF8_VALUE_TEMP_N(isolate, callin_table)));
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node exit");
 
-#if NODEM_SIMPLE_API == 1
-            if (setenv("ydb_ci", *(UTF8_VALUE_TEMP_N(isolate, callin_table)), 1) == -1) {
-#else
-            if (setenv("GTMCI", *(UTF8_VALUE_TEMP_N(isolate, callin_table)), 1) == -1) {
-#endif
-                char error[BUFSIZ];
+        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
+        if (temp_subs->IsUndefined()) {
+            return scope.Escape(Array::New(isolate));
         }
 
-        Local<Value> addr = get_n(isolate, arg_object, new_string_n(isolate, "ipAddress"));
-
-        if (addr->IsUndefined()) {
-            addr = get_n(isolate, arg_object, new_string_n(isolate, "ip_address"));
-
-            if (!addr->IsUndefined()) {
-                if (!addr->IsString()) {
-                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "ip_address must be a string")));
-                    return;
-                }
+        return scope.Escape(temp_subs);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-                debug_log(">>   ip_address: ", *(UTF8_VALUE_TEMP_N(isolate, addr)), " [DEPRECATED - Use ipAddress instead]");
-            }
+        if (nodem_baton->local) {
+            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
         } else {
-            if (!addr->IsString()) {
-                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "ipAddress must be a string")));
-                return;
-            }
-
-            if (nodem_state->debug > LOW) debug_log(">>   ipAddress: ", *(UTF8_VALUE_TEMP_N(isolate, addr)));
+            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
         }
 
-        Local<Value> port = get_n(isolate, arg_object, new_string_n(isolate, "tcpPort"));
-
-        if (port->IsUndefined()) {
-            port = get_n(isolate, arg_object, new_string_n(isolate, "tcp_port"));
+        Local<Value> temp_subs = get_n(isolate, temp_object, new_string_n(isolate, "subscripts"));
+        if (!temp_subs->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), temp_subs);
 
-            if (!port->IsUndefined()) {
-                if (!port->IsNumber() && !port->IsString()) {
-                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "tcp_port must be a number or string")));
-                    return;
-                }
+        Local<Value> temp_data = get_n(isolate, temp_object, new_string_n(isolate, "data"));
 
-                debug_log(">>   tcp_port: ", *(UTF8_VALUE_TEMP_N(isolate, port)), " [DEPRECATED - Use tcpPort instead]");
-            }
-        } else {
-            if (!port->IsNumber() && !port->IsString()) {
-                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "tcpPort must be a number or string")));
-                return;
-            }
+        if (!temp_data->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "data"), temp_data);
 
-            if (nodem_state->debug > LOW) debug_log(">>   tcpPort: ", *(UTF8_VALUE_TEMP_N(isolate, port)));
-        }
+        set_n(isolate, return_object, new_string_n(isolate, "defined"),
+              get_n(isolate, temp_object, new_string_n(isolate, "defined")));
+    }
 
-        if (!addr->IsUndefined() || !port->IsUndefined()) {
-            if (addr->IsUndefined()) addr = Local<Value>::New(isolate, new_string_n(isolate, "127.0.0.1"));
-            if (port->IsUndefined()) port = Local<Value>::New(isolate, new_string_n(isolate, "6789"));
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  previous_node exit");
 
-            Local<String> gtcm_port = concat_n(isolate, new_string_n(isolate, ":"), to_string_n(isolate, port));
-            Local<Value> gtcm_nodem = concat_n(isolate, to_string_n(isolate, addr), gtcm_port);
+    return scope.Escape(return_object);
+} // @end nodem::previous_node function
 
-#if NODEM_SIMPLE_API == 1
-            if (nodem_state->debug > LOW) debug_log(">>   ydb_cm_NODEM: ", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)));
+/*
+ * @function {private} nodem::increment
+ * @summary Return the value of an incremented or decremented number in a global or local node
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
+ * @member {gtm_char_t*} result - Data returned from increment call
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {gtm_double_t} option - The increment value
+ * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
+ */
+static Local<Value> increment(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-            if (setenv("ydb_cm_NODEM", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)), 1) == -1) {
-                char error[BUFSIZ];
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment enter");
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-#else
-            if (nodem_state->debug > LOW) debug_log(">>   GTCM_NODEM: ", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)));
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
-            if (setenv("GTCM_NODEM", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)), 1) == -1) {
-                char error[BUFSIZ];
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-#endif
+        if (!subscripts->IsUndefined()) {
+            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
+            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
         }
 
-        if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
-            nodem_state->auto_relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
-            auto_relink_g = nodem_state->auto_relink;
-        }
+        debug_log(">>   increment: ", nodem_baton->option);
+    }
 
-        if (nodem_state->debug > LOW) debug_log(">>   autoRelink: ", boolalpha, nodem_state->auto_relink);
+#if NODEM_SIMPLE_API == 1
+    Local<Object> temp_object = Object::New(isolate);
+    string data(nodem_baton->result);
 
-        UTF8_VALUE_N(isolate, nodem_mode, get_n(isolate, arg_object, new_string_n(isolate, "mode")));
+    if (nodem_baton->nodem_state->mode == CANONICAL && is_number(data)) {
+        set_n(isolate, temp_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
+    } else {
+        if (nodem_baton->nodem_state->utf8 == true) {
+            set_n(isolate, temp_object, new_string_n(isolate, "data"), new_string_n(isolate, nodem_baton->result));
+        } else {
+            set_n(isolate, temp_object, new_string_n(isolate, "data"), NodemValue::from_byte(nodem_baton->result));
+        }
+    }
+#else
+    Local<String> json_string;
 
-        if (strcasecmp(*nodem_mode, "strict") == 0) {
-            mode_g = nodem_state->mode = STRING;
+    if (nodem_baton->nodem_state->utf8 == true) {
+        json_string = new_string_n(isolate, nodem_baton->result);
+    } else {
+        json_string = NodemValue::from_byte(nodem_baton->result);
+    }
 
-            if (nodem_state->debug > OFF || !(deprecated_g & STRICT)) {
-                deprecated_g |= STRICT;
-                debug_log(">>   mode: strict [DEPRECATED - Use string instead]");
-            }
-        } else if (strcasecmp(*nodem_mode, "string") == 0) {
-            mode_g = nodem_state->mode = STRING;
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
-            if (nodem_state->debug > LOW) debug_log(">>   mode: string");
-        } else if (strcasecmp(*nodem_mode, "canonical") == 0) {
-            mode_g = nodem_state->mode = CANONICAL;
+#   if NODE_MAJOR_VERSION >= 1
+    TryCatch try_catch(isolate);
+#   else
+    TryCatch try_catch;
+#   endif
 
-            if (nodem_state->debug > LOW) debug_log(">>   mode: canonical");
-        } else if (nodem_state->debug > LOW) {
-            if (nodem_state->mode == STRING) {
-                debug_log(">>   mode: string");
-            } else {
-                debug_log(">>   mode: canonical");
-            }
-        }
+    Local<Object> temp_object;
+    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
 
-        Local<Value> charset = get_n(isolate, arg_object, new_string_n(isolate, "charset"));
+    if (try_catch.HasCaught()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
+        return scope.Escape(try_catch.Exception());
+    } else {
+        temp_object = to_object_n(isolate, json);
+    }
+#endif
 
-        if (charset->IsUndefined()) charset = get_n(isolate, arg_object, new_string_n(isolate, "encoding"));
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        UTF8_VALUE_N(isolate, data_charset, charset);
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment exit");
+        return scope.Escape(get_n(isolate, temp_object, new_string_n(isolate, "data")));
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-        if (strcasecmp(*data_charset, "m") == 0 || strcasecmp(*data_charset, "binary") == 0 ||
-          strcasecmp(*data_charset, "ascii") == 0) {
-            utf8_g = nodem_state->utf8 = false;
-        } else if (strcasecmp(*data_charset, "utf-8") == 0 || strcasecmp(*data_charset, "utf8") == 0) {
-            utf8_g = nodem_state->utf8 = true;
+        if (nodem_baton->local) {
+            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+        } else {
+            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
         }
 
-        if (nodem_state->debug > LOW) {
-            char* encoding = (char*) "utf-8";
+        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-            if (nodem_state->utf8 == false) encoding = (char*) "m";
+        set_n(isolate, return_object, new_string_n(isolate, "increment"), Number::New(isolate, nodem_baton->option));
+        set_n(isolate, return_object, new_string_n(isolate, "data"), get_n(isolate, temp_object, new_string_n(isolate, "data")));
+    }
 
-            debug_log(">>   charset: ", encoding);
-        }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  increment exit");
 
-        if (has_n(isolate, arg_object, new_string_n(isolate, "signalHandler"))) {
-            if (get_n(isolate, arg_object, new_string_n(isolate, "signalHandler"))->IsObject()) {
-                Local<Object> signal_handler =
-                  to_object_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "signalHandler")));
+    return scope.Escape(return_object);
+} // @end nodem::increment function
 
-                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGINT"))) {
-                    signal_sigint_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGINT")));
-                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigint"))) {
-                    signal_sigint_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigint")));
-                }
+#if NODEM_SIMPLE_API == 1
+/*
+ * @function {private} nodem::striped_counter
+ * @summary Return the stripe that was incremented, or the value of a striped counter
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {bool} async - Whether the API was called asynchronously
+ * @member {string} name - Global variable name
+ * @member {Persistent/Global<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {gtm_double_t} option - The amount the counter was incremented by, or 0 if it was read
+ * @member {gtm_uint_t} info - Number of stripes
+ * @member {gtm_char_t*} result - The new value of the stripe, or the sum of the stripes
+ * @member {gtm_status_t} status - Return code; 0 is success
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {pid_t} tid - Thread ID, which picked the stripe that was incremented
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} - An object containing the counter, and its stripe or value
+ */
+static Local<Value> striped_counter(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGQUIT"))) {
-                    signal_sigquit_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGQUIT")));
-                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigquit"))) {
-                    signal_sigquit_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigquit")));
-                }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  striped_counter enter");
 
-                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGTERM"))) {
-                    signal_sigterm_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGTERM")));
-                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigterm"))) {
-                    signal_sigterm_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigterm")));
-                }
-            } else {
-                Local<Value> signal_handler = get_n(isolate, arg_object, new_string_n(isolate, "signalHandler"));
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
-                signal_sigint_g = signal_sigquit_g = signal_sigterm_g = boolean_value_n(isolate, signal_handler);
-            }
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+        debug_log(">>   result: ", nodem_baton->result);
+    }
 
-            if (nodem_state->debug > LOW) {
-                debug_log(">>   SIGINT: ", boolalpha, signal_sigint_g);
-                debug_log(">>   SIGQUIT: ", boolalpha, signal_sigquit_g);
-                debug_log(">>   SIGTERM: ", boolalpha, signal_sigterm_g);
-            }
-        }
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-        Local<Value> threadpool_size = get_n(isolate, arg_object, new_string_n(isolate, "threadpoolSize"));
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
 
-        if (!threadpool_size->IsUndefined() && (threadpool_size->IsNumber() || threadpool_size->IsString())) {
-            if (nodem_state->debug > LOW) debug_log(">>   threadpoolSize: ", *(UTF8_VALUE_TEMP_N(isolate, threadpool_size)));
+    if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-            if (setenv("UV_THREADPOOL_SIZE", *(UTF8_VALUE_TEMP_N(isolate, threadpool_size)), 1) == -1) {
-                char error[BUFSIZ];
+    set_n(isolate, return_object, new_string_n(isolate, "stripes"), Number::New(isolate, nodem_baton->info));
 
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-        }
+    if (nodem_baton->option != 0) {
+        set_n(isolate, return_object, new_string_n(isolate, "increment"), Number::New(isolate, nodem_baton->option));
+        set_n(isolate, return_object, new_string_n(isolate, "stripe"),
+          Number::New(isolate, nodem_baton->nodem_state->tid % nodem_baton->info));
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "data"), Number::New(isolate, atof(nodem_baton->result)));
     }
 
-    if (signal_sigint_g == true) {
-        if (getenv("ydb_nocenable") != NULL) {
-            if (setenv("ydb_nocenable", "0", 1) == -1) {
-                char error[BUFSIZ];
-
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-        }
-
-        if (getenv("gtm_nocenable") != NULL) {
-            if (setenv("gtm_nocenable", "0", 1) == -1) {
-                char error[BUFSIZ];
-
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-                return;
-            }
-        }
-    }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  striped_counter exit");
 
-    if (isatty(STDIN_FILENO)) {
-        if (tcgetattr(STDIN_FILENO, &term_attr_g) == -1) {
-            char error[BUFSIZ];
+    return scope.Escape(return_object);
+} // @end nodem::striped_counter function
+#endif
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
-        }
-    } else if (isatty(STDOUT_FILENO)) {
-        if (tcgetattr(STDOUT_FILENO, &term_attr_g) == -1) {
-            char error[BUFSIZ];
+/*
+ * @function {private} nodem::lock
+ * @summary Return data about an incremental lock of a global or local node
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
+ * @member {gtm_char_t*} result - Data returned from lock call
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
+ */
+static Local<Value> lock(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
-        }
-    } else if (isatty(STDERR_FILENO)) {
-        if (tcgetattr(STDERR_FILENO, &term_attr_g) == -1) {
-            char error[BUFSIZ];
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock enter");
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
-        }
-    }
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
-    if (signal_sigint_g == true) {
-        if (sigaction(SIGINT, NULL, &nodem_state->signal_attr) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGINT handler")));
-            return;
-        }
-    }
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
 
-    if (signal_sigquit_g == true) {
-        if (sigaction(SIGQUIT, NULL, &nodem_state->signal_attr) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGQUIT handler")));
-            return;
+        if (!subscripts->IsUndefined()) {
+            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
+            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
         }
     }
 
-    if (signal_sigterm_g == true) {
-        if (sigaction(SIGTERM, NULL, &nodem_state->signal_attr) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGTERM handler")));
-            return;
-        }
-    }
+#if NODEM_SIMPLE_API == 1
+    Local<Object> temp_object = Object::New(isolate);
 
-    if ((save_stdout_g = dup(STDOUT_FILENO)) == -1) {
-        char error[BUFSIZ];
+    set_n(isolate, temp_object, new_string_n(isolate, "result"), Boolean::New(isolate, atoi(nodem_baton->result)));
+#else
+    Local<String> json_string;
 
-        cerr << strerror_r(errno, error, BUFSIZ);
+    if (nodem_baton->nodem_state->utf8 == true) {
+        json_string = new_string_n(isolate, nodem_baton->result);
+    } else {
+        json_string = NodemValue::from_byte(nodem_baton->result);
     }
 
-    uv_mutex_lock(&mutex_g);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
-    if (nodem_state->debug > LOW) {
-        if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
-            char error[BUFSIZ];
+#   if NODE_MAJOR_VERSION >= 1
+    TryCatch try_catch(isolate);
+#   else
+    TryCatch try_catch;
+#   endif
 
-            cerr << strerror_r(errno, error, BUFSIZ);
-        }
+    Local<Object> temp_object;
+    Local<Value> json = json_method(json_string, "parse", nodem_baton->nodem_state);
 
-        flockfile(stderr);
+    if (try_catch.HasCaught()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function has missing or invalid JSON data")));
+        return scope.Escape(try_catch.Exception());
+    } else {
+        temp_object = to_object_n(isolate, json);
     }
-
-#if NODEM_SIMPLE_API == 1
-    if (ydb_init() != YDB_OK) {
-#else
-    if (gtm_init() != EXIT_SUCCESS) {
 #endif
-        gtm_char_t msg_buf[ERR_LEN];
-        gtm_zstatus(msg_buf, ERR_LEN);
 
-        if (nodem_state->debug > LOW) {
-            funlockfile(stderr);
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-            if (dup2(save_stdout_g, STDOUT_FILENO) == -1) {
-                char error[BUFSIZ];
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock exit");
 
-                cerr << strerror_r(errno, error, BUFSIZ);
-            }
+        Local<Value> result = get_n(isolate, temp_object, new_string_n(isolate, "result"));
+        return scope.Escape(result);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+
+        if (nodem_baton->local) {
+            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+        } else {
+            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
         }
 
-        uv_mutex_unlock(&mutex_g);
+        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
 
-        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
-        return;
+        if (nodem_baton->option > -1) {
+            set_n(isolate, return_object, new_string_n(isolate, "timeout"), Number::New(isolate, nodem_baton->option));
+        } else {
+            set_n(isolate, return_object, new_string_n(isolate, "timeout"),
+                  Number::New(isolate, numeric_limits<double>::infinity()));
+        }
+
+        set_n(isolate, return_object, new_string_n(isolate, "result"),
+              get_n(isolate, temp_object, new_string_n(isolate, "result")));
     }
 
-    if (nodem_state->debug > LOW) {
-        funlockfile(stderr);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  lock exit");
 
-        if (dup2(save_stdout_g, STDOUT_FILENO) == -1) {
-            char error[BUFSIZ];
+    return scope.Escape(return_object);
+} // @end nodem::lock function
 
-            cerr << strerror_r(errno, error, BUFSIZ);
-        }
-    }
+/*
+ * @function {private} nodem::unlock
+ * @summary Return data about unlocking a global or local node, or releasing all locks
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t} status - Return code; 0 is success, anything else is an error or message
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
+ */
+static Local<Value> unlock(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-    uv_mutex_unlock(&mutex_g);
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock enter");
 
-    struct sigaction signal_attr;
+    Local<Value> subscripts = held_arguments(isolate, nodem_baton);
 
-    if (signal_sigint_g == true || signal_sigquit_g == true || signal_sigterm_g == true) {
-        signal_attr.sa_handler = clean_shutdown;
-        signal_attr.sa_flags = 0;
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   status: ", nodem_baton->status);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
 
-        if (sigfillset(&signal_attr.sa_mask) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot set mask for signal handlers")));
-            return;
+        if (!subscripts->IsUndefined()) {
+            Local<Value> subscript_string = json_method(subscripts, "stringify", nodem_baton->nodem_state);
+            debug_log(">>   subscripts: ", *(UTF8_VALUE_TEMP_N(isolate, subscript_string)));
         }
     }
 
-    if (signal_sigint_g == true) {
-        if (sigaction(SIGINT, &signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGINT handler")));
-            return;
-        }
-    }
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> name = new_string_n(isolate, nodem_baton->name.c_str());
 
-    if (signal_sigquit_g == true) {
-        if (sigaction(SIGQUIT, &signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGQUIT handler")));
-            return;
-        }
-    }
+    if (name->StrictEquals(new_string_n(isolate, "")) || nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock exit");
+        Local<Value> ret_data = Undefined(isolate);
+        return scope.Escape(ret_data);
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-    if (signal_sigterm_g == true) {
-        if (sigaction(SIGTERM, &signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGTERM handler")));
-            return;
+        if (nodem_baton->local) {
+            set_n(isolate, return_object, new_string_n(isolate, "local"), name);
+        } else {
+            set_n(isolate, return_object, new_string_n(isolate, "global"), localize_name(name, nodem_baton->nodem_state));
         }
+
+        if (!subscripts->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "subscripts"), subscripts);
     }
 
-    gtm_status_t status;
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  unlock exit");
 
-    uv_mutex_lock(&mutex_g);
+    return scope.Escape(return_object);
+} // @end nodem::unlock function
 
-    gtm_char_t debug[] = "debug";
+/*
+ * @function {private} nodem::function
+ * @summary Return value from an arbitrary extrinsic function
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_char_t*} result - Data returned from function call
+ * @member {gtm_uint_t*} info - Indirection limit on input - (0|1) Return data type on output; 0 is string, 1 is canonical number
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {string} relink - Whether to relink the function before calling it
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
+ */
+static Local<Value> function(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-#if NODEM_CIP_API == 1
-    ci_name_descriptor access;
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function enter");
 
-    access.rtn_name.address = debug;
-    access.rtn_name.length = strlen(debug);
-    access.handle = NULL;
+    Local<Value> arguments = held_arguments(isolate, nodem_baton);
 
-    status = gtm_cip(&access, nodem_state->debug);
-#else
-    status = gtm_ci(debug, nodem_state->debug);
-#endif
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   info: ", nodem_baton->info);
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
 
-    if (nodem_state->debug > LOW) debug_log(">>   status: ", status);
+        if (!arguments->IsUndefined()) {
+            Local<Value> argument_string = json_method(arguments, "stringify", nodem_baton->nodem_state);
+            debug_log(">>   arguments: ", *(UTF8_VALUE_TEMP_N(isolate, argument_string)));
+        }
 
-    if (status != EXIT_SUCCESS) {
-        gtm_char_t msg_buf[ERR_LEN];
-        gtm_zstatus(msg_buf, ERR_LEN);
+        debug_log(">>   relink: ", nodem_baton->relink);
+    }
 
-        uv_mutex_unlock(&mutex_g);
+    Local<Value> ret_string;
 
-        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
-        return;
+    if (nodem_baton->nodem_state->utf8 == true) {
+        ret_string = new_string_n(isolate, nodem_baton->result);
+    } else {
+        ret_string = NodemValue::from_byte(nodem_baton->result);
     }
 
-    uv_mutex_unlock(&mutex_g);
+    if (nodem_baton->info == 1) ret_string = to_number_n(isolate, ret_string);
 
-    nodem_state_g = OPEN;
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function exit");
+        return scope.Escape(ret_string);
+    }
 
-    Local<Object> result = Object::New(isolate);
-    set_n(isolate, result, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
-    set_n(isolate, result, new_string_n(isolate, "pid"), Number::New(isolate, nodem_state->pid));
-    set_n(isolate, result, new_string_n(isolate, "tid"), Number::New(isolate, nodem_state->tid));
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> function = new_string_n(isolate, nodem_baton->name.c_str());
 
-    info.GetReturnValue().Set(result);
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "function"), localize_name(function, nodem_baton->nodem_state));
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::open exit\n");
+    if (!arguments->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "arguments"), arguments);
 
-    return;
-} // @end nodem::Nodem::open method
+    set_n(isolate, return_object, new_string_n(isolate, "autoRelink"), Boolean::New(isolate, nodem_baton->relink));
+    set_n(isolate, return_object, new_string_n(isolate, "result"), ret_string);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  function exit");
+
+    return scope.Escape(return_object);
+} // @end nodem::function function
 
 /*
- * @method nodem::Nodem::configure
- * @summary Configure per-thread parameters of the YottaDB/GT.M connection
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
- * @returns {void}
+ * @function {private} nodem::procedure
+ * @summary Return value from an arbitrary procedure/routine
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_uint_t} info - Indirection limit
+ * @member {bool} position - Whether the API was called by position, or with a specially-formatted JavaScript object
+ * @member {bool} local - Whether the API was called on a local variable, or a global variable
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {string} name - The name of the global or local variable
+ * @member {Persistent<Value>} arguments_p - V8 object containing the subscripts that were called
+ * @member {string} relink - Whether to relink the procedure before calling it
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {mode_t} mode - Data mode: STRING or CANONICAL; defaults to CANONICAL
+ * @returns {Local<Value>} return_object - Data returned to Node.js
  */
-void Nodem::configure(const FunctionCallbackInfo<Value>& info)
+static Local<Value> procedure(NodemBaton* nodem_baton)
 {
     Isolate* isolate = Isolate::GetCurrent();
-    HandleScope scope(isolate);
+    EscapableHandleScope scope(isolate);
 
-    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure enter");
 
-    if (nodem_state_g < OPEN) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
-        return;
+    Local<Value> arguments = held_arguments(isolate, nodem_baton);
+
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   position: ", boolalpha, nodem_baton->position);
+        debug_log(">>   local: ", boolalpha, nodem_baton->local);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
+        debug_log(">>   name: ", nodem_baton->name);
+
+        if (!arguments->IsUndefined()) {
+            Local<Value> argument_string = json_method(arguments, "stringify", nodem_baton->nodem_state);
+            debug_log(">>   arguments: ", *(UTF8_VALUE_TEMP_N(isolate, argument_string)));
+        }
+
+        debug_log(">>   relink: ", nodem_baton->relink);
     }
 
-    if (info.Length() >= 1 && !info[0]->IsObject()) {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
-        return;
+    if (nodem_baton->position) {
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure exit");
+        Local<Value> ret_data = Undefined(isolate);
+        return scope.Escape(ret_data);
     }
 
-    Local<Object> arg_object = Object::New(isolate);
+    Local<Object> return_object = Object::New(isolate);
+    Local<String> procedure = new_string_n(isolate, nodem_baton->name.c_str());
 
-    if (info[0]->IsObject()) arg_object = to_object_n(isolate, info[0]);
-
-    if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
-        UTF8_VALUE_N(isolate, debug, get_n(isolate, arg_object, new_string_n(isolate, "debug")));
-
-        if (strcasecmp(*debug, "off") == 0) {
-            nodem_state->debug = OFF;
-        } else if (strcasecmp(*debug, "low") == 0) {
-            nodem_state->debug = LOW;
-        } else if (strcasecmp(*debug, "medium") == 0) {
-            nodem_state->debug = MEDIUM;
-        } else if (strcasecmp(*debug, "high") == 0) {
-            nodem_state->debug = HIGH;
-        } else {
-            nodem_state->debug = static_cast<debug_t>
-              (uint32_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "debug"))));
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
 
-            if (nodem_state->debug < 0) {
-                nodem_state->debug = OFF;
-            } else if (nodem_state->debug > 3) {
-                nodem_state->debug = HIGH;
-            }
-        }
+    if (nodem_baton->routine) {
+        set_n(isolate, return_object, new_string_n(isolate, "routine"), localize_name(procedure, nodem_baton->nodem_state));
+    } else {
+        set_n(isolate, return_object, new_string_n(isolate, "procedure"), localize_name(procedure, nodem_baton->nodem_state));
     }
 
-    if (nodem_state->debug > OFF) {
-        debug_log(">  Nodem::configure enter");
-
-        char* debug_display = (char*) "off";
+    if (!arguments->IsUndefined()) set_n(isolate, return_object, new_string_n(isolate, "arguments"), arguments);
 
-        if (nodem_state->debug == LOW) {
-            debug_display = (char*) "low";
-        } else if (nodem_state->debug == MEDIUM) {
-            debug_display = (char*) "medium";
-        } else {
-            debug_display = (char*) "high";
-        }
+    set_n(isolate, return_object, new_string_n(isolate, "autoRelink"), Boolean::New(isolate, nodem_baton->relink));
 
-        debug_log(">  debug: ", debug_display);
-    }
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  procedure exit");
 
-    if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
-        nodem_state->auto_relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
-    }
+    return scope.Escape(return_object);
+} // @end nodem::procedure function
 
-    if (nodem_state->debug > LOW) debug_log(">>   autoRelink: ", boolalpha, nodem_state->auto_relink);
+/*
+ * @function {private} nodem::batch
+ * @summary Return the results of a batch of operations, decoded from one length-encoded Call-in result
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_char_t*} result - The JSON result of each operation, in order, each encoded with its length
+ * @member {bool} async - Whether the API was called asynchronously, or synchronously
+ * @member {Persistent<Value>} arguments_p - V8 array containing the operations that were called
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {bool} utf8 - UTF-8 character encoding; defaults to true
+ * @returns {Local<Value>} return_object - Data returned to Node.js
+ */
+static Local<Value> batch(NodemBaton* nodem_baton)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    EscapableHandleScope scope(isolate);
 
-    if (has_n(isolate, arg_object, new_string_n(isolate, "mode"))) {
-        UTF8_VALUE_N(isolate, nodem_mode, get_n(isolate, arg_object, new_string_n(isolate, "mode")));
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  batch enter");
 
-        if (strcasecmp(*nodem_mode, "strict") == 0) {
-            nodem_state->mode = STRING;
+    Local<Array> operations = Local<Array>::Cast(held_arguments(isolate, nodem_baton));
 
-            if (nodem_state->debug > OFF || !(deprecated_g & STRICT)) {
-                deprecated_g |= STRICT;
-                debug_log(">>   mode: strict [DEPRECATED - Use string instead]");
-            }
-        } else if (strcasecmp(*nodem_mode, "string") == 0) {
-            nodem_state->mode = STRING;
-        } else if (strcasecmp(*nodem_mode, "canonical") == 0) {
-            nodem_state->mode = CANONICAL;
-        }
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   result: ", nodem_baton->result);
+        debug_log(">>   async: ", boolalpha, nodem_baton->async);
     }
 
-    if (nodem_state->debug > LOW) {
-        if (nodem_state->mode == STRING) {
-            debug_log(">>   mode: string");
-        } else {
-            debug_log(">>   mode: canonical");
-        }
-    }
+    // Strip the lengths, so that every result is turned in to a V8 value with one JSON parse
+    string json {"["};
+    const char* position = nodem_baton->result;
+    unsigned int count = 0;
 
-    if (has_n(isolate, arg_object, new_string_n(isolate, "charset"))) {
-        Local<Value> charset = get_n(isolate, arg_object, new_string_n(isolate, "charset"));
-        UTF8_VALUE_N(isolate, data_charset, charset);
+    while (*position != '\0') {
+        char* colon;
+        size_t length = strtoul(position, &colon, 10);
 
-        if (strcasecmp(*data_charset, "m") == 0 || strcasecmp(*data_charset, "binary") == 0 ||
-          strcasecmp(*data_charset, "ascii") == 0) {
-            nodem_state->utf8 = false;
-        } else if (strcasecmp(*data_charset, "utf-8") == 0 || strcasecmp(*data_charset, "utf8") == 0) {
-            nodem_state->utf8 = true;
-        }
-    } else if (has_n(isolate, arg_object, new_string_n(isolate, "encoding"))) {
-        Local<Value> encoding = get_n(isolate, arg_object, new_string_n(isolate, "encoding"));
-        UTF8_VALUE_N(isolate, data_encoding, encoding);
+        if (*colon != ':' || strnlen(colon + 1, length) < length) break;
+        if (count++ > 0) json += ",";
 
-        if (strcasecmp(*data_encoding, "m") == 0 || strcasecmp(*data_encoding, "binary") == 0 ||
-          strcasecmp(*data_encoding, "ascii") == 0) {
-            nodem_state->utf8 = false;
-        } else if (strcasecmp(*data_encoding, "utf-8") == 0 || strcasecmp(*data_encoding, "utf8") == 0) {
-            nodem_state->utf8 = true;
-        }
+        json.append(colon + 1, length);
+        position = colon + 1 + length;
+
+        if (*position == ',') position++;
     }
 
-    if (nodem_state->debug > LOW) {
-        char* charset = (char*) "utf-8";
+    json += "]";
 
-        if (nodem_state->utf8 == false) charset = (char*) "m";
+    Local<String> json_string;
 
-        debug_log(">>   charset: ", charset);
+    if (nodem_baton->nodem_state->utf8 == true) {
+        json_string = new_string_n(isolate, json.c_str());
+    } else {
+        json_string = NodemValue::from_byte((gtm_char_t*) json.c_str());
     }
 
-    if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
-        gtm_status_t status;
-
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
-
-        gtm_char_t debug[] = "debug";
+#if NODE_MAJOR_VERSION >= 1
+    TryCatch try_catch(isolate);
+#else
+    TryCatch try_catch;
+#endif
 
-#if NODEM_CIP_API == 1
-        ci_name_descriptor access;
+    Local<Value> results = json_method(json_string, "parse", nodem_baton->nodem_state);
 
-        access.rtn_name.address = debug;
-        access.rtn_name.length = strlen(debug);
-        access.handle = NULL;
+    if (try_catch.HasCaught() || count != operations->Length()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Batch has missing or invalid JSON data")));
+        return scope.Escape(try_catch.HasCaught() ? try_catch.Exception() : Local<Value>(Undefined(isolate)));
+    }
 
-        status = gtm_cip(&access, nodem_state->debug);
-#else
-        status = gtm_ci(debug, nodem_state->debug);
-#endif
+    Local<Array> result_array = Local<Array>::Cast(results);
+    Local<Array> return_array = Array::New(isolate, count);
+    const char* const fields[] = {"global", "local", "subscripts", "defined", "data", "result"};
 
-        if (nodem_state->debug > LOW) debug_log(">>   status: ", status);
+    for (unsigned int i = 0; i < count; i++) {
+        Local<Object> operation = to_object_n(isolate, get_n(isolate, operations, i));
+        Local<Object> result = to_object_n(isolate, get_n(isolate, result_array, i));
+        Local<Object> temp_object = Object::New(isolate);
 
-        if (status != EXIT_SUCCESS) {
-            gtm_char_t msg_buf[ERR_LEN];
-            gtm_zstatus(msg_buf, ERR_LEN);
+        set_n(isolate, temp_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+        set_n(isolate, temp_object, new_string_n(isolate, "op"), get_n(isolate, operation, new_string_n(isolate, "op")));
 
-            if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        for (unsigned int j = 0; j < 6; j++) {
+            Local<Object> source = j < 3 ? operation : result;
+            Local<String> field = new_string_n(isolate, fields[j]);
 
-            info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
-            return;
+            if (has_n(isolate, source, field)) set_n(isolate, temp_object, field, get_n(isolate, source, field));
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        set_n(isolate, return_array, i, temp_object);
     }
 
-    Local<Object> result = Object::New(isolate);
-    set_n(isolate, result, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
-    set_n(isolate, result, new_string_n(isolate, "pid"), Number::New(isolate, nodem_state->pid));
-    set_n(isolate, result, new_string_n(isolate, "tid"), Number::New(isolate, nodem_state->tid));
+    Local<Object> return_object = Object::New(isolate);
 
-    info.GetReturnValue().Set(result);
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "results"), return_array);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::configure exit\n");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  batch exit");
 
-    return;
-} // @end nodem::Nodem::configure method
+    return scope.Escape(return_object);
+} // @end nodem::batch function
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::close
- * @summary Close a connection with YottaDB/GT.M
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
- * @returns {void}
+ * @function {private} nodem::transaction
+ * @summary Call a JavaScript function within a YottaDB transaction
+ * @param {void*} data - Cast in to a NodemBaton struct containing the following members
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {Local<Value>} return_object - Data returned to Node.js
  */
-void Nodem::close(const FunctionCallbackInfo<Value>& info)
+static int transaction(void *data)
 {
     Isolate* isolate = Isolate::GetCurrent();
-    HandleScope scope(isolate);
 
-    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+    NodemBaton* nodem_baton = (NodemBaton*) data;
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::close enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction enter");
 
-    if (nodem_state->pid != nodem_state->tid) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection must be managed by main thread")));
-        return;
-    } else if (nodem_state_g < OPEN) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
-        return;
+    if (nodem_baton->nodem_state->debug > LOW) {
+        debug_log(">>   tp_level: ", nodem_baton->nodem_state->tp_level);
+        debug_log(">>   tp_restart: ", nodem_baton->nodem_state->tp_restart);
     }
 
-    uv_mutex_lock(&mutex_g);
+    if (nodem_baton->nodem_state->tp_restart == 3) {
+        nodem_baton->nodem_state->tp_restart = 0;
 
-    if (info[0]->IsObject() && has_n(isolate, to_object_n(isolate, info[0]), new_string_n(isolate, "resetTerminal"))) {
-        reset_term_g = boolean_value_n(isolate, get_n(isolate, to_object_n(isolate, info[0]),
-                       new_string_n(isolate, "resetTerminal")));
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: max restart");
+
+        return YDB_TP_ROLLBACK;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   resetTerminal: ", boolalpha, reset_term_g);
+    Local<Value> value = call_n(isolate, nodem_baton->callback, Null(isolate), 0, NULL);
 
-#if NODEM_SIMPLE_API == 1
-    if (ydb_exit() != YDB_OK) {
-#else
-    if (gtm_exit() != EXIT_SUCCESS) {
-#endif
-        gtm_char_t msg_buf[ERR_LEN];
-        gtm_zstatus(msg_buf, ERR_LEN);
+    if (value->IsNull()) {
+        if (nodem_baton->nodem_state->tp_level == 1) nodem_baton->nodem_state->tp_restart = 0;
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: error thrown");
+
+        return YDB_TP_ROLLBACK;
+    } else if (value->StrictEquals(new_string_n(isolate, "Rollback")) || value->StrictEquals(new_string_n(isolate, "rollback")) ||
+      value->StrictEquals(new_string_n(isolate, "ROLLBACK")) || value->StrictEquals(Number::New(isolate, YDB_TP_ROLLBACK))) {
+        nodem_baton->nodem_state->tp_restart = 0;
 
-        uv_mutex_unlock(&mutex_g);
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: rollback");
 
-        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
-        return;
+        return YDB_TP_ROLLBACK;
+    } else if (value->StrictEquals(new_string_n(isolate, "Restart")) || value->StrictEquals(new_string_n(isolate, "restart")) ||
+      value->StrictEquals(new_string_n(isolate, "RESTART")) || value->StrictEquals(Number::New(isolate, YDB_TP_RESTART))) {
+        if (nodem_baton->nodem_state->tp_level == 1) nodem_baton->nodem_state->tp_restart++;
+        if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: restart");
+
+        return YDB_TP_RESTART;
     }
 
-    nodem_state_g = CLOSED;
+    nodem_baton->nodem_state->tp_restart = 0;
 
-    if (unistd_close(save_stdout_g) == -1) {
-        char error[BUFSIZ];
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  transaction exit: commit");
 
-        cerr << strerror_r(errno, error, BUFSIZ);
-    }
+    return YDB_OK;
+} // @end nodem::transaction function
+#endif
 
-    uv_mutex_unlock(&mutex_g);
+#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
+/*
+ * @function {private} nodem::cleanup_nodem_state
+ * @summary Delete heap resources after worker threads exit
+ * @param {void*} class_name - The class instance to delete
+ * @returns {void}
+ */
+inline static void cleanup_nodem_state(void* class_name)
+{
+  delete static_cast<NodemState*>(class_name);
+  return;
+} // @end nodem::cleanup_nodem_state
+#endif
 
-    if (signal_sigint_g == true) {
-        if (sigaction(SIGINT, &nodem_state->signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGINT handler")));
-            return;
-        }
-    }
+#if NODEM_SIMPLE_API == 1
+/*
+ * @function {private} nodem::bloom_writing
+ * @summary Keep the Bloom filters current before a call writes: add the key it writes, or mark the filters it may outdate stale
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t *(NodemBaton*)} nodem_function - The function that will call in to YottaDB/GT.M
+ * @member {string} name - Global or local name the call writes to
+ * @member {vector<string>} subs_array - Subscripts of the node the call writes to
+ * @member {string} to_name - Global or local name a merge writes to
+ * @member {vector<string>} to_subs_array - Subscripts of the node a merge writes to
+ * @returns {void}
+ */
+static void bloom_writing(const NodemBaton* nodem_baton)
+{
+    gtm_status_t (*function)(NodemBaton*) = nodem_baton->nodem_function;
 
-    if (signal_sigquit_g == true) {
-        if (sigaction(SIGQUIT, &nodem_state->signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGQUIT handler")));
-            return;
-        }
+    if (function == &ydb::set || function == &ydb::increment) {
+        bloom_written(nodem_baton->name, nodem_baton->subs_array, false);
+    } else if (function == &ydb::merge || function == &gtm::merge || function == &ydb::define_aggregate ||
+      function == &ydb::move) {
+        bloom_written(nodem_baton->to_name, nodem_baton->to_subs_array, true);
+    } else if (function == &ydb::from_json || function == &ydb::striped_counter || function == &ydb::sorter_write) {
+        bloom_written(nodem_baton->name, nodem_baton->subs_array, true);
+    } else if (function == &gtm::function || function == &gtm::procedure || function == &gtm::batch) {
+        // M code can write any node, and a filter can only be trusted again once it is rebuilt
+        bloom_stale_all();
     }
 
-    if (signal_sigterm_g == true) {
-        if (sigaction(SIGTERM, &nodem_state->signal_attr, NULL) == -1) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGTERM handler")));
-            return;
-        }
-    }
+    return;
+} // @end nodem::bloom_writing function
 
-    if (reset_term_g == true) {
-        term_attr_g.c_iflag |= ICRNL;
-        term_attr_g.c_lflag |= (ISIG | ECHO);
+/*
+ * @function {private} nodem::aggregate_writing
+ * @summary Mark the aggregates a call will write to the source of stale, when the call cannot keep their totals current
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t *(NodemBaton*)} nodem_function - The function that will call in to YottaDB/GT.M
+ * @member {string} name - Global or local name the call writes to
+ * @member {string} to_name - Global or local name a merge writes to
+ * @returns {void}
+ */
+static void aggregate_writing(const NodemBaton* nodem_baton)
+{
+    gtm_status_t (*function)(NodemBaton*) = nodem_baton->nodem_function;
+
+    if (function == &ydb::merge || function == &gtm::merge) {
+        aggregate_stale(nodem_baton->to_name);
+    } else if (function == &ydb::move) {
+        aggregate_stale(nodem_baton->name);
+        aggregate_stale(nodem_baton->to_name);
+    } else if (function == &ydb::from_json || function == &ydb::striped_counter || function == &ydb::sorter_write) {
+        aggregate_stale(nodem_baton->name);
+    } else if (function == &gtm::function || function == &gtm::procedure || function == &gtm::batch) {
+        aggregate_stale("");
     }
 
-    if (isatty(STDIN_FILENO)) {
-        if (tcsetattr(STDIN_FILENO, TCSANOW, &term_attr_g) == -1) {
-            char error[BUFSIZ];
+    return;
+} // @end nodem::aggregate_writing function
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
+/*
+ * @function {private} nodem::read_ahead_written
+ * @summary Invalidate the read-ahead windows a call may have made stale, once it has run
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t *(NodemBaton*)} nodem_function - The function that called in to YottaDB/GT.M
+ * @member {string} name - Global or local name the call wrote to
+ * @member {string} to_name - Global or local name a merge, or an aggregate's totals, wrote to
+ * @returns {void}
+ */
+static void read_ahead_written(const NodemBaton* nodem_baton)
+{
+    gtm_status_t (*function)(NodemBaton*) = nodem_baton->nodem_function;
+
+    if (function == &ydb::set || function == &ydb::kill || function == &ydb::kill_tree || function == &ydb::increment ||
+      function == &ydb::striped_counter || function == &ydb::from_json || function == &ydb::sorter_write ||
+      function == &ydb::prune) {
+        read_ahead_invalidate(nodem_baton->name);
+    } else if (function == &ydb::merge || function == &gtm::merge || function == &ydb::define_aggregate) {
+        read_ahead_invalidate(nodem_baton->to_name);
+    } else if (function == &ydb::move) {
+        read_ahead_invalidate(nodem_baton->name);
+        read_ahead_invalidate(nodem_baton->to_name);
+    } else if (function != &ydb::data && function != &ydb::get && function != &ydb::order && function != &ydb::previous &&
+      function != &ydb::next_node && function != &ydb::previous_node && function != &ydb::scan && function != &ydb::to_json &&
+      function != &ydb::count_distinct && function != &ydb::sample && function != &ydb::sorter_read &&
+      function != &ydb::bloom &&
+      function != &ydb::read_consistent && function != &ydb::lock && function != &ydb::unlock && function != &ydb::version &&
+      function != &gtm::version) {
+        // M code run by function, procedure, or batch can write to any name
+        read_ahead_invalidate_all();
+    }
+
+    return;
+} // @end nodem::read_ahead_written function
+#endif
+
+/*
+ * @function {private} nodem::call_nodem_function
+ * @summary Call in to YottaDB/GT.M through the baton, tracing the call as a "db" span when the nodem trace category is enabled
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local name, passed to the trace event
+ * @member {gtm_status_t *(NodemBaton*)} nodem_function - The function that calls in to YottaDB/GT.M
+ * @returns {gtm_status_t} - Return code from the YottaDB/GT.M call
+ */
+inline static gtm_status_t call_nodem_function(NodemBaton* nodem_baton)
+{
+    TraceSpan trace_span("db", nodem_baton->name);
+
+#if NODEM_SIMPLE_API == 1
+    if (bloom_active()) bloom_writing(nodem_baton);
+    if (aggregate_active()) aggregate_writing(nodem_baton);
+
+    gtm_status_t status = (*nodem_baton->nodem_function)(nodem_baton);
+
+    read_ahead_written(nodem_baton);
+
+    return status;
+#else
+    return (*nodem_baton->nodem_function)(nodem_baton);
+#endif
+} // @end nodem::call_nodem_function function
+
+/*
+ * @function {private} nodem::call_ret_function
+ * @summary Build the data returned to Node.js, tracing the conversion as a "marshal" span when the nodem trace category is enabled
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local name, passed to the trace event
+ * @member {Local<Value> *(NodemBaton*)} ret_function - The function that builds the return value
+ * @returns {Local<Value>} - Data returned to Node.js
+ */
+inline static Local<Value> call_ret_function(NodemBaton* nodem_baton)
+{
+    TraceSpan trace_span("marshal", nodem_baton->name);
+    return (*nodem_baton->ret_function)(nodem_baton);
+} // @end nodem::call_ret_function function
+
+/*
+ * @function {private} nodem::adaptive_key
+ * @summary Identify the kind of call a baton makes, for adaptive latency estimates
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t (*)(NodemBaton*)} nodem_function - The API function to call
+ * @member {string} name - Global or local name, or routine name
+ * @member {vector<string>} subs_array - Subscripts, with the SimpleAPI
+ * @returns {AdaptiveKey} - The key for the call's latency estimate
+ */
+inline static AdaptiveKey adaptive_key(const NodemBaton* nodem_baton)
+{
+    return AdaptiveKey {reinterpret_cast<uintptr_t>(nodem_baton->nodem_function), nodem_baton->name,
+      static_cast<unsigned int>(nodem_baton->subs_array.size())};
+} // @end nodem::adaptive_key function
+
+/*
+ * @function nodem::async_work
+ * @summary Call in to YottaDB/GT.M asynchronously, via a Node.js worker thread
+ * @param {uv_work_t*} request - A pointer to the NodemBaton structure for transferring data between the main and worker threads
+ * @returns {void}
+ */
+void async_work(uv_work_t* request)
+{
+    NodemBaton* nodem_baton = static_cast<NodemBaton*>(request->data);
+
+    if (trace_enabled()) trace_event('e', "queue", nodem_baton->name, nodem_baton);
+    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_work enter");
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    uint64_t start = nodem_baton->adaptive ? uv_hrtime() : 0;
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_baton->adaptive) adaptive_record(adaptive_key(nodem_baton), uv_hrtime() - start);
+
+    if (nodem_baton->nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_work exit\n");
+
+    return;
+} // @end nodem::async_work function
+
+/*
+ * @function nodem::async_after
+ * @summary Call in to the return functions, passing the data from YottaDB/GT.M, after receiving the data from the worker thread
+ * @param {uv_work_t*} request - A pointer to the NodemBaton structure for transferring data between the main and worker threads
+ * @returns {void}
+ */
+void async_after(uv_work_t* request, int status)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemBaton* nodem_baton = static_cast<NodemBaton*>(request->data);
+
+    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_after enter: ", status);
+
+    Local<Value> error_code = Null(isolate);
+    Local<Value> return_object;
+    Local<Value> error_object;
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        char error[BUFSIZ];
+        Local<Value> exception = Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ)));
+
+#if NODE_MAJOR_VERSION >= 8
+        if (nodem_baton->adaptive) {
+            Local<Promise::Resolver>::New(isolate, nodem_baton->resolver_p)->Reject(isolate->GetCurrentContext(), exception).FromJust();
+            nodem_baton->resolver_p.Reset();
+        } else {
+            isolate->ThrowException(exception);
         }
-    } else if (isatty(STDOUT_FILENO)) {
-        if (tcsetattr(STDOUT_FILENO, TCSANOW, &term_attr_g) == -1) {
-            char error[BUFSIZ];
+#else
+        isolate->ThrowException(exception);
+#endif
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
+        baton_release(nodem_baton);
+        return;
+    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_ERR_GVUNDEF &&
+               nodem_baton->status != YDB_ERR_LVUNDEF && nodem_baton->status != YDB_NODE_END) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   " NODEM_DB " error code: ", nodem_baton->status);
+
+        error_object = error_status(nodem_baton->error, nodem_baton->position, nodem_baton->async, nodem_baton->nodem_state);
+
+        error_code = Exception::Error(new_string_n(isolate, *(UTF8_VALUE_TEMP_N(isolate,
+                     get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorMessage"))))));
+
+        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "ok"),
+              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "ok")));
+
+        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "errorCode"),
+              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorCode")));
+
+        set_n(isolate, ((Object*) *error_code), new_string_n(isolate, "errorMessage"),
+              get_n(isolate, ((Object*) *error_object), new_string_n(isolate, "errorMessage")));
+
+        return_object = Undefined(isolate);
+    } else {
+        return_object = call_ret_function(nodem_baton);
+    }
+
+#if NODE_MAJOR_VERSION >= 8
+    if (nodem_baton->adaptive) {
+        Local<Promise::Resolver> resolver = Local<Promise::Resolver>::New(isolate, nodem_baton->resolver_p);
+
+        if (error_code->IsNull()) {
+            resolver->Resolve(isolate->GetCurrentContext(), return_object).FromJust();
+        } else {
+            resolver->Reject(isolate->GetCurrentContext(), error_code).FromJust();
         }
-    } else if (isatty(STDERR_FILENO)) {
-        if (tcsetattr(STDERR_FILENO, TCSANOW, &term_attr_g) == -1) {
-            char error[BUFSIZ];
 
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
-            return;
+        nodem_baton->resolver_p.Reset();
+    } else {
+        Local<Value> argv[2] = {error_code, return_object};
+        call_n(isolate, Local<Function>::New(isolate, nodem_baton->callback_p), Null(isolate), 2, argv);
+    }
+#else
+    Local<Value> argv[2] = {error_code, return_object};
+    call_n(isolate, Local<Function>::New(isolate, nodem_baton->callback_p), Null(isolate), 2, argv);
+#endif
+
+    if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   async_after exit\n");
+
+    baton_release(nodem_baton);
+    return;
+} // @end nodem::async_after function
+
+/*
+ * @function {private} nodem::adaptive_offload
+ * @summary Predict whether an adaptive call will be slow enough to stall the event loop, and should run in a worker thread
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t (*)(NodemBaton*)} nodem_function - The API function to call
+ * @member {bool} node_only - Whether a kill is only of a single node
+ * @member {gtm_double_t} option - Timeout of a lock
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {uint64_t} adaptive_threshold - Latency, in nanoseconds, above which calls run in a worker thread
+ * @returns {bool} - Whether to run the call in a worker thread
+ */
+static bool adaptive_offload(const NodemBaton* nodem_baton)
+{
+    uint64_t latency;
+
+    if (adaptive_predict(adaptive_key(nodem_baton), latency)) return latency > nodem_baton->nodem_state->adaptive_threshold;
+
+    // Until there is an estimate, assume that calls that can take an unbounded time will be slow
+    gtm_status_t (*function)(NodemBaton*) = nodem_baton->nodem_function;
+
+#if NODEM_SIMPLE_API == 1
+    if (function == &ydb::kill) return !nodem_baton->node_only;
+    if (function == &ydb::lock) return nodem_baton->option != 0;
+    if (function == &ydb::merge || function == &ydb::kill_tree || function == &ydb::prune || function == &ydb::move) return true;
+#else
+    if (function == &gtm::kill) return !nodem_baton->node_only;
+    if (function == &gtm::lock) return nodem_baton->option != 0;
+#endif
+
+    return function == &gtm::merge || function == &gtm::function || function == &gtm::procedure;
+} // @end nodem::adaptive_offload function
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @struct {private} nodem::GroupCommit
+ * @summary A batch of asynchronous global updates, committed together in one durable transaction
+ * @member {uv_timer_t} timer - Flushes the batch when its window closes
+ * @member {uv_work_t} request - The libuv work request that commits the batch
+ * @member {vector<NodemBaton*>} batons - Every update in the batch, in the order it was called
+ * @member {vector<NodemBaton*>} active - The updates still in the transaction, once any that failed are dropped
+ * @member {NodemBaton*} failed - The update that rolled back the last try of the transaction, if any
+ * @member {NodemState*} nodem_state - Per-thread state class the batch was opened for
+ * @member {unsigned int} pending - Callbacks still to run, closing the timer and finishing the work, before the batch is freed
+ */
+struct GroupCommit {
+    uv_timer_t          timer;
+    uv_work_t           request;
+    vector<NodemBaton*> batons;
+    vector<NodemBaton*> active;
+    NodemBaton*         failed;
+    NodemState*         nodem_state;
+    unsigned int        pending;
+}; // @end nodem::GroupCommit struct
+
+/*
+ * @function {private} nodem::group_eligible
+ * @summary Check whether an asynchronous call can join a group commit: a set, kill, or increment of a global, outside a transaction
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {gtm_status_t (*)(NodemBaton*)} nodem_function - The API function to call
+ * @member {string} name - Global or local name
+ * @member {bool} local - Whether the call is on a local variable
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {bool} group_commit - Whether group commit is turned on
+ * @nested-member {short} tp_level - Current transaction level
+ * @returns {bool} - Whether to add the call to the open batch
+ */
+inline static bool group_eligible(const NodemBaton* nodem_baton)
+{
+    const NodemState* nodem_state = nodem_baton->nodem_state;
+
+    if (!nodem_state->group_commit || nodem_state->tp_level != 0 || nodem_baton->local) return false;
+
+    // Extended references switch the global directory for the call, so they are always committed on their own
+    const string& name = nodem_baton->name;
+
+    if (name.compare(0, 1, "^") != 0 || name.compare(0, 2, "^[") == 0 || name.compare(0, 2, "^|") == 0) return false;
+
+    gtm_status_t (*function)(NodemBaton*) = nodem_baton->nodem_function;
+
+    return function == &ydb::set || function == &ydb::kill || function == &ydb::increment;
+} // @end nodem::group_eligible function
+
+/*
+ * @function {private} nodem::group_tp
+ * @summary Run every update still in a batch, as the callback of its transaction; YottaDB calls it again on a restart
+ * @param {void*} data - Cast in to the GroupCommit struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to restart, or YDB_TP_ROLLBACK if an update failed
+ */
+static int group_tp(void* data)
+{
+    GroupCommit* group = static_cast<GroupCommit*>(data);
+
+    group->failed = nullptr;
+
+    for (NodemBaton* nodem_baton : group->active) {
+        nodem_baton->status = call_nodem_function(nodem_baton);
+
+        if (nodem_baton->status == YDB_TP_RESTART) return YDB_TP_RESTART;
+
+        if (nodem_baton->status != YDB_OK) {
+            group->failed = nodem_baton;
+            return YDB_TP_ROLLBACK;
         }
     }
 
-    info.GetReturnValue().Set(Undefined(isolate));
+    return YDB_OK;
+} // @end nodem::group_tp function
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::close exit\n");
+/*
+ * @function {private} nodem::group_work
+ * @summary Commit a batch of updates in one durable transaction, via a Node.js worker thread
+ * @param {uv_work_t*} request - A pointer to the GroupCommit structure for the batch
+ * @returns {void}
+ */
+static void group_work(uv_work_t* request)
+{
+    GroupCommit* group = static_cast<GroupCommit*>(request->data);
+    NodemState* nodem_state = group->nodem_state;
+
+    if (nodem_state->debug > LOW) debug_log(">>   group_work enter: ", group->batons.size());
+
+    if (trace_enabled()) {
+        for (NodemBaton* nodem_baton : group->batons) trace_event('e', "queue", nodem_baton->name, nodem_baton);
+    }
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    group->active = group->batons;
+
+    lock_mutex(group->batons[0]->name);
+
+    ydb_status_t status = YDB_OK;
+
+    // An update that fails rolls back the batch, keeping its own error, and the rest are committed again without it
+    while (!group->active.empty()) {
+        status = ydb_tp_s(&group_tp, group, "", 0, NULL);
+
+        if (status != YDB_TP_ROLLBACK || group->failed == nullptr) break;
+
+        group->active.erase(std::find(group->active.begin(), group->active.end(), group->failed));
+    }
+
+    if (status != YDB_OK && !group->active.empty()) {
+        for (NodemBaton* nodem_baton : group->active) {
+            nodem_baton->status = status;
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        }
+    }
+
+    unlock_mutex();
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   group_work exit\n");
 
     return;
-} // @end nodem::Nodem::close method
+} // @end nodem::group_work function
 
 /*
- * @method nodem::Nodem::help
- * @summary Built-in help menu for Nodem methods
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @function {private} nodem::group_release
+ * @summary Drop one of the pending callbacks of a batch, freeing the batch once both have run
+ * @param {GroupCommit*} group - The batch
  * @returns {void}
  */
-void Nodem::help(const FunctionCallbackInfo<Value>& info)
+inline static void group_release(GroupCommit* group)
 {
-    Isolate* isolate = Isolate::GetCurrent();
-    HandleScope scope(isolate);
+    if (--group->pending == 0) delete group;
+    return;
+} // @end nodem::group_release function
 
-    if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "open"))) {
-        cout << REVSE "open" RESET " method: "
-            "Open connection to " NODEM_DB " - all methods, except for help and version, require an open connection\n\n"
-            "Required arguments:\n"
-            "None\n\n"
-            "Optional arguments:\n"
-            "{\n"
-            "\tglobalDirectory|namespace:\t{string} <none>,\n"
-            "\troutinesPath:\t\t\t{string} <none>,\n"
-            "\tcallinTable:\t\t\t{string} <none>,\n"
-            "\tipAddress:\t\t\t{string} <none>,\n"
-            "\ttcpPort:\t\t\t{number} <none>,\n"
-            "\tcharset|encoding:\t\t{string} [<utf8|utf-8>|m|binary|ascii]/i,\n"
-            "\tmode:\t\t\t\t{string} [<canonical>|string]/i,\n"
-            "\tautoRelink:\t\t\t{boolean} <false>,\n"
-            "\tdebug:\t\t\t\t{boolean} <false>|{string} [<off>|low|medium|high]/i|{number} [<0>|1|2|3],\n"
-            "\tthreadpoolSize:\t\t\t{number} [1-1024] <4>,\n"
-            "\tsignalHandler:\t\t\t{boolean} <true>|{object}\n"
-            "\t{\n"
-            "\t\tsigint|SIGINT:\t\t{boolean} <true>,\n"
-            "\t\tsigterm|SIGTERM:\t{boolean} <true>,\n"
-            "\t\tsigquit|SIGQUIT:\t{boolean} <true>\n"
-            "\t}\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tpid:\t\t\t\t{number},\n"
-            "\ttid:\t\t\t\t{number}\n"
-            "}\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the open method, please refer to the README.md file\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "configure"))) {
-        cout << REVSE "configure" RESET " method: "
-            "Configure per-thread parameters of the connection to " NODEM_DB "\n\n"
-            "Required arguments:\n"
-            "None\n\n"
-            "Optional arguments:\n"
-            "{\n"
-            "\tcharset|encoding:\t\t{string} [<utf8|utf-8>|m|binary|ascii]/i,\n"
-            "\tmode:\t\t\t\t{string} [<canonical>|string]/i,\n"
-            "\tautoRelink:\t\t\t{boolean} <false>,\n"
-            "\tdebug:\t\t\t\t{boolean} <false>|{string} [<off>|low|medium|high]/i|{number} [<0>|1|2|3]\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tpid:\t\t\t\t{number},\n"
+/*
+ * @function {private} nodem::group_after
+ * @summary Return the result of each update in a batch, after the batch has been committed
+ * @param {uv_work_t*} request - A pointer to the GroupCommit structure for the batch
+ * @returns {void}
+ */
+static void group_after(uv_work_t* request, int status)
+{
+    GroupCommit* group = static_cast<GroupCommit*>(request->data);
+
+    for (NodemBaton* nodem_baton : group->batons) async_after(&nodem_baton->request, status);
+
+    group_release(group);
+    return;
+} // @end nodem::group_after function
+
+/*
+ * @function {private} nodem::group_close
+ * @summary Release a batch once its timer has been closed
+ * @param {uv_handle_t*} handle - The timer of the batch
+ * @returns {void}
+ */
+static void group_close(uv_handle_t* handle)
+{
+    group_release(static_cast<GroupCommit*>(handle->data));
+    return;
+} // @end nodem::group_close function
+
+/*
+ * @function {private} nodem::group_flush
+ * @summary Close the open batch to new updates, and queue it to be committed
+ * @param {GroupCommit*} group - The open batch
+ * @returns {void}
+ */
+static void group_flush(GroupCommit* group)
+{
+    if (group->nodem_state->debug > LOW) debug_log(">>   group commit: ", group->batons.size());
+
+    group->nodem_state->group_batch = nullptr;
+
+    uv_timer_stop(&group->timer);
+    uv_close(reinterpret_cast<uv_handle_t*>(&group->timer), &group_close);
+    uv_queue_work(group->timer.loop, &group->request, &group_work, &group_after);
+
+    return;
+} // @end nodem::group_flush function
+
+/*
+ * @function {private} nodem::group_committed
+ * @summary Stand in for the work of a batch that has already been committed, so that its callbacks still run from the event loop
+ * @param {uv_work_t*} request - A pointer to the GroupCommit structure for the batch
+ * @returns {void}
+ */
+static void group_committed(uv_work_t* request)
+{
+    return;
+} // @end nodem::group_committed function
+
+/*
+ * @function {private} nodem::group_finish
+ * @summary Close the open batch to new updates, and commit it in the current thread, before the database is closed
+ * @param {GroupCommit*} group - The open batch
+ * @returns {void}
+ */
+static void group_finish(GroupCommit* group)
+{
+    if (group->nodem_state->debug > LOW) debug_log(">>   group finish: ", group->batons.size());
+
+    group->nodem_state->group_batch = nullptr;
+
+    uv_timer_stop(&group->timer);
+    uv_close(reinterpret_cast<uv_handle_t*>(&group->timer), &group_close);
+
+    group_work(&group->request);
+    uv_queue_work(group->timer.loop, &group->request, &group_committed, &group_after);
+
+    return;
+} // @end nodem::group_finish function
+
+/*
+ * @function {private} nodem::group_timeout
+ * @summary Flush the open batch when its window closes
+ * @param {uv_timer_t*} timer - The timer of the batch
+ * @returns {void}
+ */
+static void group_timeout(uv_timer_t* timer)
+{
+    group_flush(static_cast<GroupCommit*>(timer->data));
+    return;
+} // @end nodem::group_timeout function
+
+/*
+ * @function {private} nodem::group_add
+ * @summary Add an update to the open batch, opening a new one if needed, and flush it once it holds the most updates allowed
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {uint64_t} group_window - Time, in milliseconds, a batch stays open for
+ * @nested-member {unsigned int} group_max - Most updates in a batch
+ * @nested-member {GroupCommit*} group_batch - The open batch, if any
+ * @param {uv_loop_t*} loop - The event loop of the current thread
+ * @returns {void}
+ */
+static void group_add(NodemBaton* nodem_baton, uv_loop_t* loop)
+{
+    NodemState* nodem_state = nodem_baton->nodem_state;
+    GroupCommit* group = nodem_state->group_batch;
+
+    if (group == nullptr) {
+        group = new GroupCommit();
+
+        group->failed = nullptr;
+        group->nodem_state = nodem_state;
+        group->pending = 2;
+        group->timer.data = group;
+        group->request.data = group;
+
+        uv_timer_init(loop, &group->timer);
+        uv_timer_start(&group->timer, &group_timeout, nodem_state->group_window, 0);
+
+        nodem_state->group_batch = group;
+    }
+
+    group->batons.push_back(nodem_baton);
+
+    if (group->batons.size() >= nodem_state->group_max) group_flush(group);
+
+    return;
+} // @end nodem::group_add function
+#endif
+
+/*
+ * @function {private} nodem::queue_work
+ * @summary Queue an asynchronous call to a worker thread or a group commit batch; or, for an adaptive call predicted to be fast, run it right away
+ * @param {Isolate*} isolate - The current V8 isolate
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {uv_work_t} request - The libuv work request
+ * @member {string} name - Global or local name, or routine name, for tracing
+ * @member {Global<Promise::Resolver>} resolver_p - Set to a new Promise resolver, for an adaptive call
+ * @member {bool} adaptive - Set to whether the call is adaptive
+ * @param {bool} adaptive - Whether the call is adaptive, and returns a Promise, rather than having a callback
+ * @returns {Local<Value>} - The Promise for an adaptive call, or undefined
+ */
+static Local<Value> queue_work(Isolate* isolate, NodemBaton* nodem_baton, const bool adaptive)
+{
+    EscapableHandleScope scope(isolate);
+
+    Local<Value> return_value = Undefined(isolate);
+
+    nodem_baton->adaptive = adaptive;
+
+    if (trace_enabled()) trace_event('b', "queue", nodem_baton->name, nodem_baton);
+
+#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
+    uv_loop_t* loop = GetCurrentEventLoop(isolate);
+#else
+    uv_loop_t* loop = uv_default_loop();
+#endif
+
+#if NODE_MAJOR_VERSION >= 8
+    if (adaptive) {
+        Local<Promise::Resolver> resolver = Promise::Resolver::New(isolate->GetCurrentContext()).ToLocalChecked();
+
+        nodem_baton->resolver_p.Reset(isolate, resolver);
+        return_value = resolver->GetPromise();
+    }
+#endif
+
+#if NODEM_SIMPLE_API == 1
+    if (group_eligible(nodem_baton)) {
+        group_add(nodem_baton, loop);
+        return scope.Escape(return_value);
+    }
+#endif
+
+#if NODE_MAJOR_VERSION >= 8
+    if (adaptive) {
+        if (!adaptive_offload(nodem_baton)) {
+            if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   adaptive: inline");
+
+            async_work(&nodem_baton->request);
+            async_after(&nodem_baton->request, 0);
+
+            return scope.Escape(return_value);
+        }
+
+        if (nodem_baton->nodem_state->debug > LOW) debug_log(">>   adaptive: worker");
+    }
+#endif
+
+    uv_queue_work(loop, &nodem_baton->request, async_work, async_after);
+
+    return scope.Escape(return_value);
+} // @end nodem::queue_work function
+
+// ***Begin Public APIs***
+
+/*
+ * @method nodem::Nodem::open
+ * @summary Open a connection with YottaDB/GT.M
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::open(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->pid != nodem_state->tid) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection must be managed by main thread")));
+        return;
+    } else if (nodem_state_g == CLOSED) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection cannot be reopened")));
+        return;
+    } else if (nodem_state_g == OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection already open")));
+        return;
+    }
+
+    char* relink = getenv("NODEM_AUTO_RELINK");
+
+    if (relink != NULL) auto_relink_g = nodem_state->auto_relink = static_cast<bool>(atoi(relink));
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
+            UTF8_VALUE_N(isolate, debug, get_n(isolate, arg_object, new_string_n(isolate, "debug")));
+
+            if (strcasecmp(*debug, "off") == 0) {
+                debug_g = nodem_state->debug = OFF;
+            } else if (strcasecmp(*debug, "low") == 0) {
+                debug_g = nodem_state->debug = LOW;
+            } else if (strcasecmp(*debug, "medium") == 0) {
+                debug_g = nodem_state->debug = MEDIUM;
+            } else if (strcasecmp(*debug, "high") == 0) {
+                debug_g = nodem_state->debug = HIGH;
+            } else {
+                debug_g = nodem_state->debug = static_cast<debug_t>
+                  (uint32_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "debug"))));
+
+                if (nodem_state->debug < 0) {
+                    debug_g = nodem_state->debug = OFF;
+                } else if (nodem_state->debug > 3) {
+                    debug_g = nodem_state->debug = HIGH;
+                }
+            }
+        }
+
+        if (nodem_state->debug > OFF) {
+            debug_log(">  Nodem::open enter");
+
+            char* debug_display = (char*) "off";
+
+            if (nodem_state->debug == LOW) {
+                debug_display = (char*) "low";
+            } else if (nodem_state->debug == MEDIUM) {
+                debug_display = (char*) "medium";
+            } else {
+                debug_display = (char*) "high";
+            }
+
+            debug_log(">  debug: ", debug_display);
+        }
+
+        Local<Value> global_dir = get_n(isolate, arg_object, new_string_n(isolate, "globalDirectory"));
+
+        if (global_dir->IsUndefined()) global_dir = get_n(isolate, arg_object, new_string_n(isolate, "namespace"));
+
+        if (!global_dir->IsUndefined() && global_dir->IsString()) {
+            if (nodem_state->debug > LOW) debug_log(">>   globalDirectory: ", *(UTF8_VALUE_TEMP_N(isolate, global_dir)));
+
+#if NODEM_SIMPLE_API == 1
+            if (setenv("ydb_gbldir", *(UTF8_VALUE_TEMP_N(isolate, global_dir)), 1) == -1) {
+#else
+            if (setenv("gtmgbldir", *(UTF8_VALUE_TEMP_N(isolate, global_dir)), 1) == -1) {
+#endif
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+
+        Local<Value> routines_path = get_n(isolate, arg_object, new_string_n(isolate, "routinesPath"));
+
+        if (!routines_path->IsUndefined() && routines_path->IsString()) {
+            if (nodem_state->debug > LOW) debug_log(">>   routinesPath: ", *(UTF8_VALUE_TEMP_N(isolate, routines_path)));
+
+#if NODEM_SIMPLE_API == 1
+            if (setenv("ydb_routines", *(UTF8_VALUE_TEMP_N(isolate, routines_path)), 1) == -1) {
+#else
+            if (setenv("gtmroutines", *(UTF8_VALUE_TEMP_N(isolate, routines_path)), 1) == -1) {
+#endif
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+
+        Local<Value> callin_table = get_n(isolate, arg_object, new_string_n(isolate, "callinTable"));
+
+        if (!callin_table->IsUndefined() && callin_table->IsString()) {
+            if (nodem_state->debug > LOW) debug_log(">>   callinTable: ", *(UTF8_VALUE_TEMP_N(isolate, callin_table)));
+
+#if NODEM_SIMPLE_API == 1
+            if (setenv("ydb_ci", *(UTF8_VALUE_TEMP_N(isolate, callin_table)), 1) == -1) {
+#else
+            if (setenv("GTMCI", *(UTF8_VALUE_TEMP_N(isolate, callin_table)), 1) == -1) {
+#endif
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+
+        Local<Value> addr = get_n(isolate, arg_object, new_string_n(isolate, "ipAddress"));
+
+        if (addr->IsUndefined()) {
+            addr = get_n(isolate, arg_object, new_string_n(isolate, "ip_address"));
+
+            if (!addr->IsUndefined()) {
+                if (!addr->IsString()) {
+                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "ip_address must be a string")));
+                    return;
+                }
+
+                debug_log(">>   ip_address: ", *(UTF8_VALUE_TEMP_N(isolate, addr)), " [DEPRECATED - Use ipAddress instead]");
+            }
+        } else {
+            if (!addr->IsString()) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "ipAddress must be a string")));
+                return;
+            }
+
+            if (nodem_state->debug > LOW) debug_log(">>   ipAddress: ", *(UTF8_VALUE_TEMP_N(isolate, addr)));
+        }
+
+        Local<Value> port = get_n(isolate, arg_object, new_string_n(isolate, "tcpPort"));
+
+        if (port->IsUndefined()) {
+            port = get_n(isolate, arg_object, new_string_n(isolate, "tcp_port"));
+
+            if (!port->IsUndefined()) {
+                if (!port->IsNumber() && !port->IsString()) {
+                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "tcp_port must be a number or string")));
+                    return;
+                }
+
+                debug_log(">>   tcp_port: ", *(UTF8_VALUE_TEMP_N(isolate, port)), " [DEPRECATED - Use tcpPort instead]");
+            }
+        } else {
+            if (!port->IsNumber() && !port->IsString()) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "tcpPort must be a number or string")));
+                return;
+            }
+
+            if (nodem_state->debug > LOW) debug_log(">>   tcpPort: ", *(UTF8_VALUE_TEMP_N(isolate, port)));
+        }
+
+        if (!addr->IsUndefined() || !port->IsUndefined()) {
+            if (addr->IsUndefined()) addr = Local<Value>::New(isolate, new_string_n(isolate, "127.0.0.1"));
+            if (port->IsUndefined()) port = Local<Value>::New(isolate, new_string_n(isolate, "6789"));
+
+            Local<String> gtcm_port = concat_n(isolate, new_string_n(isolate, ":"), to_string_n(isolate, port));
+            Local<Value> gtcm_nodem = concat_n(isolate, to_string_n(isolate, addr), gtcm_port);
+
+#if NODEM_SIMPLE_API == 1
+            if (nodem_state->debug > LOW) debug_log(">>   ydb_cm_NODEM: ", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)));
+
+            if (setenv("ydb_cm_NODEM", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)), 1) == -1) {
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+#else
+            if (nodem_state->debug > LOW) debug_log(">>   GTCM_NODEM: ", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)));
+
+            if (setenv("GTCM_NODEM", *(UTF8_VALUE_TEMP_N(isolate, gtcm_nodem)), 1) == -1) {
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+#endif
+        }
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
+            nodem_state->auto_relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
+            auto_relink_g = nodem_state->auto_relink;
+        }
+
+        if (nodem_state->debug > LOW) debug_log(">>   autoRelink: ", boolalpha, nodem_state->auto_relink);
+
+        UTF8_VALUE_N(isolate, nodem_mode, get_n(isolate, arg_object, new_string_n(isolate, "mode")));
+
+        if (strcasecmp(*nodem_mode, "strict") == 0) {
+            mode_g = nodem_state->mode = STRING;
+
+            if (nodem_state->debug > OFF || !(deprecated_g & STRICT)) {
+                deprecated_g |= STRICT;
+                debug_log(">>   mode: strict [DEPRECATED - Use string instead]");
+            }
+        } else if (strcasecmp(*nodem_mode, "string") == 0) {
+            mode_g = nodem_state->mode = STRING;
+
+            if (nodem_state->debug > LOW) debug_log(">>   mode: string");
+        } else if (strcasecmp(*nodem_mode, "canonical") == 0) {
+            mode_g = nodem_state->mode = CANONICAL;
+
+            if (nodem_state->debug > LOW) debug_log(">>   mode: canonical");
+        } else if (nodem_state->debug > LOW) {
+            if (nodem_state->mode == STRING) {
+                debug_log(">>   mode: string");
+            } else {
+                debug_log(">>   mode: canonical");
+            }
+        }
+
+        Local<Value> charset = get_n(isolate, arg_object, new_string_n(isolate, "charset"));
+
+        if (charset->IsUndefined()) charset = get_n(isolate, arg_object, new_string_n(isolate, "encoding"));
+
+        UTF8_VALUE_N(isolate, data_charset, charset);
+
+        if (strcasecmp(*data_charset, "m") == 0 || strcasecmp(*data_charset, "binary") == 0 ||
+          strcasecmp(*data_charset, "ascii") == 0) {
+            utf8_g = nodem_state->utf8 = false;
+        } else if (strcasecmp(*data_charset, "utf-8") == 0 || strcasecmp(*data_charset, "utf8") == 0) {
+            utf8_g = nodem_state->utf8 = true;
+        }
+
+        if (nodem_state->debug > LOW) {
+            char* encoding = (char*) "utf-8";
+
+            if (nodem_state->utf8 == false) encoding = (char*) "m";
+
+            debug_log(">>   charset: ", encoding);
+        }
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "signalHandler"))) {
+            if (get_n(isolate, arg_object, new_string_n(isolate, "signalHandler"))->IsObject()) {
+                Local<Object> signal_handler =
+                  to_object_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "signalHandler")));
+
+                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGINT"))) {
+                    signal_sigint_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGINT")));
+                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigint"))) {
+                    signal_sigint_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigint")));
+                }
+
+                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGQUIT"))) {
+                    signal_sigquit_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGQUIT")));
+                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigquit"))) {
+                    signal_sigquit_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigquit")));
+                }
+
+                if (has_n(isolate, signal_handler, new_string_n(isolate, "SIGTERM"))) {
+                    signal_sigterm_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "SIGTERM")));
+                } else if (has_n(isolate, signal_handler, new_string_n(isolate, "sigterm"))) {
+                    signal_sigterm_g = boolean_value_n(isolate, get_n(isolate, signal_handler, new_string_n(isolate, "sigterm")));
+                }
+            } else {
+                Local<Value> signal_handler = get_n(isolate, arg_object, new_string_n(isolate, "signalHandler"));
+
+                signal_sigint_g = signal_sigquit_g = signal_sigterm_g = boolean_value_n(isolate, signal_handler);
+            }
+
+            if (nodem_state->debug > LOW) {
+                debug_log(">>   SIGINT: ", boolalpha, signal_sigint_g);
+                debug_log(">>   SIGQUIT: ", boolalpha, signal_sigquit_g);
+                debug_log(">>   SIGTERM: ", boolalpha, signal_sigterm_g);
+            }
+        }
+
+        Local<Value> threadpool_size = get_n(isolate, arg_object, new_string_n(isolate, "threadpoolSize"));
+
+        if (!threadpool_size->IsUndefined() && (threadpool_size->IsNumber() || threadpool_size->IsString())) {
+            if (nodem_state->debug > LOW) debug_log(">>   threadpoolSize: ", *(UTF8_VALUE_TEMP_N(isolate, threadpool_size)));
+
+            if (setenv("UV_THREADPOOL_SIZE", *(UTF8_VALUE_TEMP_N(isolate, threadpool_size)), 1) == -1) {
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+    }
+
+    if (signal_sigint_g == true) {
+        if (getenv("ydb_nocenable") != NULL) {
+            if (setenv("ydb_nocenable", "0", 1) == -1) {
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+
+        if (getenv("gtm_nocenable") != NULL) {
+            if (setenv("gtm_nocenable", "0", 1) == -1) {
+                char error[BUFSIZ];
+
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+                return;
+            }
+        }
+    }
+
+    if (isatty(STDIN_FILENO)) {
+        if (tcgetattr(STDIN_FILENO, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    } else if (isatty(STDOUT_FILENO)) {
+        if (tcgetattr(STDOUT_FILENO, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    } else if (isatty(STDERR_FILENO)) {
+        if (tcgetattr(STDERR_FILENO, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    }
+
+    if (signal_sigint_g == true) {
+        if (sigaction(SIGINT, NULL, &nodem_state->signal_attr) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGINT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigquit_g == true) {
+        if (sigaction(SIGQUIT, NULL, &nodem_state->signal_attr) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGQUIT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigterm_g == true) {
+        if (sigaction(SIGTERM, NULL, &nodem_state->signal_attr) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot retrieve SIGTERM handler")));
+            return;
+        }
+    }
+
+    if ((save_stdout_g = dup(STDOUT_FILENO)) == -1) {
+        char error[BUFSIZ];
+
+        cerr << strerror_r(errno, error, BUFSIZ);
+    }
+
+    lock_mutex("open");
+
+    if (nodem_state->debug > LOW) {
+        if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
+            char error[BUFSIZ];
+
+            cerr << strerror_r(errno, error, BUFSIZ);
+        }
+
+        flockfile(stderr);
+    }
+
+#if NODEM_SIMPLE_API == 1
+    if (ydb_init() != YDB_OK) {
+#else
+    if (gtm_init() != EXIT_SUCCESS) {
+#endif
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        if (nodem_state->debug > LOW) {
+            funlockfile(stderr);
+
+            if (dup2(save_stdout_g, STDOUT_FILENO) == -1) {
+                char error[BUFSIZ];
+
+                cerr << strerror_r(errno, error, BUFSIZ);
+            }
+        }
+
+        unlock_mutex();
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+
+    if (nodem_state->debug > LOW) {
+        funlockfile(stderr);
+
+        if (dup2(save_stdout_g, STDOUT_FILENO) == -1) {
+            char error[BUFSIZ];
+
+            cerr << strerror_r(errno, error, BUFSIZ);
+        }
+    }
+
+    unlock_mutex();
+
+    struct sigaction signal_attr;
+
+    if (signal_sigint_g == true || signal_sigquit_g == true || signal_sigterm_g == true) {
+        signal_attr.sa_handler = clean_shutdown;
+        signal_attr.sa_flags = 0;
+
+        if (sigfillset(&signal_attr.sa_mask) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot set mask for signal handlers")));
+            return;
+        }
+    }
+
+    if (signal_sigint_g == true) {
+        if (sigaction(SIGINT, &signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGINT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigquit_g == true) {
+        if (sigaction(SIGQUIT, &signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGQUIT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigterm_g == true) {
+        if (sigaction(SIGTERM, &signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGTERM handler")));
+            return;
+        }
+    }
+
+#if NODEM_SIMPLE_API == 0
+    // The SimpleAPI build defers this until the first Call-in, in callin_init
+    lock_mutex("open");
+
+    gtm_status_t status = callin_debug(nodem_state);
+
+    if (status != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        unlock_mutex();
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+
+    unlock_mutex();
+#endif
+
+    nodem_state_g = OPEN;
+
+    Local<Object> result = Object::New(isolate);
+    set_n(isolate, result, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, result, new_string_n(isolate, "pid"), Number::New(isolate, nodem_state->pid));
+    set_n(isolate, result, new_string_n(isolate, "tid"), Number::New(isolate, nodem_state->tid));
+
+    info.GetReturnValue().Set(result);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::open exit\n");
+
+    return;
+} // @end nodem::Nodem::open method
+
+/*
+ * @method nodem::Nodem::configure
+ * @summary Configure per-thread parameters of the YottaDB/GT.M connection
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::configure(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    if (info.Length() >= 1 && !info[0]->IsObject()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
+        return;
+    }
+
+    Local<Object> arg_object = Object::New(isolate);
+
+    if (info[0]->IsObject()) arg_object = to_object_n(isolate, info[0]);
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
+        UTF8_VALUE_N(isolate, debug, get_n(isolate, arg_object, new_string_n(isolate, "debug")));
+
+        if (strcasecmp(*debug, "off") == 0) {
+            nodem_state->debug = OFF;
+        } else if (strcasecmp(*debug, "low") == 0) {
+            nodem_state->debug = LOW;
+        } else if (strcasecmp(*debug, "medium") == 0) {
+            nodem_state->debug = MEDIUM;
+        } else if (strcasecmp(*debug, "high") == 0) {
+            nodem_state->debug = HIGH;
+        } else {
+            nodem_state->debug = static_cast<debug_t>
+              (uint32_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "debug"))));
+
+            if (nodem_state->debug < 0) {
+                nodem_state->debug = OFF;
+            } else if (nodem_state->debug > 3) {
+                nodem_state->debug = HIGH;
+            }
+        }
+    }
+
+    if (nodem_state->debug > OFF) {
+        debug_log(">  Nodem::configure enter");
+
+        char* debug_display = (char*) "off";
+
+        if (nodem_state->debug == LOW) {
+            debug_display = (char*) "low";
+        } else if (nodem_state->debug == MEDIUM) {
+            debug_display = (char*) "medium";
+        } else {
+            debug_display = (char*) "high";
+        }
+
+        debug_log(">  debug: ", debug_display);
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
+        nodem_state->auto_relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   autoRelink: ", boolalpha, nodem_state->auto_relink);
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "adaptive"))) {
+        Local<Value> adaptive = get_n(isolate, arg_object, new_string_n(isolate, "adaptive"));
+
+#if NODE_MAJOR_VERSION >= 8
+        if (adaptive->IsNumber()) {
+            double threshold = number_value_n(isolate, adaptive);
+
+            if (!std::isfinite(threshold) || threshold < 0 || threshold > ADAPTIVE_MAX_THRESHOLD) {
+                isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                  "Property 'adaptive' must be a boolean, or a number from 0 to " NODEM_STRING(ADAPTIVE_MAX_THRESHOLD))));
+                return;
+            }
+
+            nodem_state->adaptive = threshold > 0;
+            if (threshold > 0) nodem_state->adaptive_threshold = static_cast<uint64_t>(threshold * 1000000);
+        } else {
+            nodem_state->adaptive = boolean_value_n(isolate, adaptive);
+            nodem_state->adaptive_threshold = ADAPTIVE_THRESHOLD;
+        }
+#else
+        if (boolean_value_n(isolate, adaptive)) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Adaptive mode requires Node.js 8 or later")));
+            return;
+        }
+#endif
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   adaptive: ", boolalpha, nodem_state->adaptive);
+        debug_log(">>   adaptiveThreshold: ", nodem_state->adaptive_threshold);
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "groupCommit"))) {
+        Local<Value> group_commit = get_n(isolate, arg_object, new_string_n(isolate, "groupCommit"));
+
+#if NODEM_SIMPLE_API == 1
+        uint64_t group_window = GROUP_WINDOW;
+        unsigned int group_max = GROUP_MAX;
+
+        if (group_commit->IsObject()) {
+            Local<Object> group_object = to_object_n(isolate, group_commit);
+
+            if (has_n(isolate, group_object, new_string_n(isolate, "window"))) {
+                Local<Value> window = get_n(isolate, group_object, new_string_n(isolate, "window"));
+
+                if (!window->IsUint32() || uint32_value_n(isolate, window) > GROUP_MAX_WINDOW) {
+                    isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                      "Property 'window' must be an integer from 0 to " NODEM_STRING(GROUP_MAX_WINDOW))));
+                    return;
+                }
+
+                group_window = uint32_value_n(isolate, window);
+            }
+
+            if (has_n(isolate, group_object, new_string_n(isolate, "maxOps"))) {
+                Local<Value> max_ops = get_n(isolate, group_object, new_string_n(isolate, "maxOps"));
+
+                if (!max_ops->IsUint32() || uint32_value_n(isolate, max_ops) < 1 ||
+                  uint32_value_n(isolate, max_ops) > GROUP_MAX_OPS) {
+                    isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                      "Property 'maxOps' must be an integer from 1 to " NODEM_STRING(GROUP_MAX_OPS))));
+                    return;
+                }
+
+                group_max = uint32_value_n(isolate, max_ops);
+            }
+
+            nodem_state->group_commit = true;
+        } else {
+            nodem_state->group_commit = boolean_value_n(isolate, group_commit);
+        }
+
+        nodem_state->group_window = group_window;
+        nodem_state->group_max = group_max;
+
+        if (!nodem_state->group_commit && nodem_state->group_batch != nullptr) group_flush(nodem_state->group_batch);
+#else
+        if (boolean_value_n(isolate, group_commit)) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Group commit requires the YottaDB SimpleAPI")));
+            return;
+        }
+#endif
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   groupCommit: ", boolalpha, nodem_state->group_commit);
+        debug_log(">>   groupWindow: ", nodem_state->group_window);
+        debug_log(">>   groupMaxOps: ", nodem_state->group_max);
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "readAhead"))) {
+        Local<Value> read_ahead = get_n(isolate, arg_object, new_string_n(isolate, "readAhead"));
+
+#if NODEM_SIMPLE_API == 1
+        unsigned int read_ahead_size = READ_AHEAD_SIZE;
+        bool read_ahead_values = false;
+
+        if (read_ahead->IsObject()) {
+            Local<Object> read_ahead_object = to_object_n(isolate, read_ahead);
+
+            if (has_n(isolate, read_ahead_object, new_string_n(isolate, "window"))) {
+                Local<Value> window = get_n(isolate, read_ahead_object, new_string_n(isolate, "window"));
+
+                if (!window->IsUint32() || uint32_value_n(isolate, window) < 1) {
+                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                      "Property 'window' must be a positive integer")));
+                    return;
+                }
+
+                read_ahead_size = uint32_value_n(isolate, window);
+            }
+
+            if (has_n(isolate, read_ahead_object, new_string_n(isolate, "values"))) {
+                read_ahead_values = boolean_value_n(isolate, get_n(isolate, read_ahead_object, new_string_n(isolate, "values")));
+            }
+        } else if (read_ahead->IsNumber()) {
+            if (!read_ahead->IsUint32() || uint32_value_n(isolate, read_ahead) < 1) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                  "Property 'readAhead' must be a boolean, a positive integer, or an object")));
+                return;
+            }
+
+            read_ahead_size = uint32_value_n(isolate, read_ahead);
+        } else if (!boolean_value_n(isolate, read_ahead)) {
+            read_ahead_size = 0;
+        }
+
+        nodem_state->read_ahead = read_ahead_size;
+        nodem_state->read_ahead_values = read_ahead_values;
+
+        for (ReadAheadWindow& window : nodem_state->read_ahead_windows) window = ReadAheadWindow();
+#else
+        if (boolean_value_n(isolate, read_ahead)) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Read-ahead requires the YottaDB SimpleAPI")));
+            return;
+        }
+#endif
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   readAhead: ", nodem_state->read_ahead);
+        debug_log(">>   readAheadValues: ", boolalpha, nodem_state->read_ahead_values);
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "mode"))) {
+        UTF8_VALUE_N(isolate, nodem_mode, get_n(isolate, arg_object, new_string_n(isolate, "mode")));
+
+        if (strcasecmp(*nodem_mode, "strict") == 0) {
+            nodem_state->mode = STRING;
+
+            if (nodem_state->debug > OFF || !(deprecated_g & STRICT)) {
+                deprecated_g |= STRICT;
+                debug_log(">>   mode: strict [DEPRECATED - Use string instead]");
+            }
+        } else if (strcasecmp(*nodem_mode, "string") == 0) {
+            nodem_state->mode = STRING;
+        } else if (strcasecmp(*nodem_mode, "canonical") == 0) {
+            nodem_state->mode = CANONICAL;
+        }
+    }
+
+    if (nodem_state->debug > LOW) {
+        if (nodem_state->mode == STRING) {
+            debug_log(">>   mode: string");
+        } else {
+            debug_log(">>   mode: canonical");
+        }
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "charset"))) {
+        Local<Value> charset = get_n(isolate, arg_object, new_string_n(isolate, "charset"));
+        UTF8_VALUE_N(isolate, data_charset, charset);
+
+        if (strcasecmp(*data_charset, "m") == 0 || strcasecmp(*data_charset, "binary") == 0 ||
+          strcasecmp(*data_charset, "ascii") == 0) {
+            nodem_state->utf8 = false;
+        } else if (strcasecmp(*data_charset, "utf-8") == 0 || strcasecmp(*data_charset, "utf8") == 0) {
+            nodem_state->utf8 = true;
+        }
+    } else if (has_n(isolate, arg_object, new_string_n(isolate, "encoding"))) {
+        Local<Value> encoding = get_n(isolate, arg_object, new_string_n(isolate, "encoding"));
+        UTF8_VALUE_N(isolate, data_encoding, encoding);
+
+        if (strcasecmp(*data_encoding, "m") == 0 || strcasecmp(*data_encoding, "binary") == 0 ||
+          strcasecmp(*data_encoding, "ascii") == 0) {
+            nodem_state->utf8 = false;
+        } else if (strcasecmp(*data_encoding, "utf-8") == 0 || strcasecmp(*data_encoding, "utf8") == 0) {
+            nodem_state->utf8 = true;
+        }
+    }
+
+    if (nodem_state->debug > LOW) {
+        char* charset = (char*) "utf-8";
+
+        if (nodem_state->utf8 == false) charset = (char*) "m";
+
+        debug_log(">>   charset: ", charset);
+    }
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "debug"))) {
+        gtm_status_t status = EXIT_SUCCESS;
+
+        if (nodem_state->tp_level == 0) lock_mutex("configure");
+
+#if NODEM_SIMPLE_API == 1
+        // Until the first Call-in, callin_init will pass the new debug mode on to v4wNode.m
+        if (callin_ready_g.load(std::memory_order_acquire)) status = callin_debug(nodem_state);
+#else
+        status = callin_debug(nodem_state);
+#endif
+
+        if (status != EXIT_SUCCESS) {
+            gtm_char_t msg_buf[ERR_LEN];
+            gtm_zstatus(msg_buf, ERR_LEN);
+
+            if (nodem_state->tp_level == 0) unlock_mutex();
+
+            info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+            return;
+        }
+
+        if (nodem_state->tp_level == 0) unlock_mutex();
+    }
+
+    Local<Object> result = Object::New(isolate);
+    set_n(isolate, result, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, result, new_string_n(isolate, "pid"), Number::New(isolate, nodem_state->pid));
+    set_n(isolate, result, new_string_n(isolate, "tid"), Number::New(isolate, nodem_state->tid));
+
+    info.GetReturnValue().Set(result);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::configure exit\n");
+
+    return;
+} // @end nodem::Nodem::configure method
+
+/*
+ * @method nodem::Nodem::close
+ * @summary Close a connection with YottaDB/GT.M
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::close(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::close enter");
+
+    if (nodem_state->pid != nodem_state->tid) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection must be managed by main thread")));
+        return;
+    } else if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_state->group_batch != nullptr) group_finish(nodem_state->group_batch);
+#endif
+
+    lock_mutex("close");
+
+    if (info[0]->IsObject() && has_n(isolate, to_object_n(isolate, info[0]), new_string_n(isolate, "resetTerminal"))) {
+        reset_term_g = boolean_value_n(isolate, get_n(isolate, to_object_n(isolate, info[0]),
+                       new_string_n(isolate, "resetTerminal")));
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   resetTerminal: ", boolalpha, reset_term_g);
+
+#if NODEM_SIMPLE_API == 1
+    if (ydb_exit() != YDB_OK) {
+#else
+    if (gtm_exit() != EXIT_SUCCESS) {
+#endif
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        unlock_mutex();
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+
+    nodem_state_g = CLOSED;
+
+    if (unistd_close(save_stdout_g) == -1) {
+        char error[BUFSIZ];
+
+        cerr << strerror_r(errno, error, BUFSIZ);
+    }
+
+    unlock_mutex();
+
+    if (signal_sigint_g == true) {
+        if (sigaction(SIGINT, &nodem_state->signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGINT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigquit_g == true) {
+        if (sigaction(SIGQUIT, &nodem_state->signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGQUIT handler")));
+            return;
+        }
+    }
+
+    if (signal_sigterm_g == true) {
+        if (sigaction(SIGTERM, &nodem_state->signal_attr, NULL) == -1) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Cannot initialize SIGTERM handler")));
+            return;
+        }
+    }
+
+    if (reset_term_g == true) {
+        term_attr_g.c_iflag |= ICRNL;
+        term_attr_g.c_lflag |= (ISIG | ECHO);
+    }
+
+    if (isatty(STDIN_FILENO)) {
+        if (tcsetattr(STDIN_FILENO, TCSANOW, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    } else if (isatty(STDOUT_FILENO)) {
+        if (tcsetattr(STDOUT_FILENO, TCSANOW, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    } else if (isatty(STDERR_FILENO)) {
+        if (tcsetattr(STDERR_FILENO, TCSANOW, &term_attr_g) == -1) {
+            char error[BUFSIZ];
+
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+            return;
+        }
+    }
+
+    info.GetReturnValue().Set(Undefined(isolate));
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::close exit\n");
+
+    return;
+} // @end nodem::Nodem::close method
+
+/*
+ * @method nodem::Nodem::help
+ * @summary Built-in help menu for Nodem methods
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::help(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "open"))) {
+        cout << REVSE "open" RESET " method: "
+            "Open connection to " NODEM_DB " - all methods, except for help and version, require an open connection\n\n"
+            "Required arguments:\n"
+            "None\n\n"
+            "Optional arguments:\n"
+            "{\n"
+            "\tglobalDirectory|namespace:\t{string} <none>,\n"
+            "\troutinesPath:\t\t\t{string} <none>,\n"
+            "\tcallinTable:\t\t\t{string} <none>,\n"
+            "\tipAddress:\t\t\t{string} <none>,\n"
+            "\ttcpPort:\t\t\t{number} <none>,\n"
+            "\tcharset|encoding:\t\t{string} [<utf8|utf-8>|m|binary|ascii]/i,\n"
+            "\tmode:\t\t\t\t{string} [<canonical>|string]/i,\n"
+            "\tautoRelink:\t\t\t{boolean} <false>,\n"
+            "\tdebug:\t\t\t\t{boolean} <false>|{string} [<off>|low|medium|high]/i|{number} [<0>|1|2|3],\n"
+            "\tthreadpoolSize:\t\t\t{number} [1-1024] <4>,\n"
+            "\tsignalHandler:\t\t\t{boolean} <true>|{object}\n"
+            "\t{\n"
+            "\t\tsigint|SIGINT:\t\t{boolean} <true>,\n"
+            "\t\tsigterm|SIGTERM:\t{boolean} <true>,\n"
+            "\t\tsigquit|SIGQUIT:\t{boolean} <true>\n"
+            "\t}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tpid:\t\t\t\t{number},\n"
+            "\ttid:\t\t\t\t{number}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the open method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "configure"))) {
+        cout << REVSE "configure" RESET " method: "
+            "Configure per-thread parameters of the connection to " NODEM_DB "\n\n"
+            "Required arguments:\n"
+            "None\n\n"
+            "Optional arguments:\n"
+            "{\n"
+            "\tcharset|encoding:\t\t{string} [<utf8|utf-8>|m|binary|ascii]/i,\n"
+            "\tmode:\t\t\t\t{string} [<canonical>|string]/i,\n"
+            "\tautoRelink:\t\t\t{boolean} <false>,\n"
+            "\tadaptive:\t\t\t{boolean} <false>|{number} <1>,\n"
+            "\tgroupCommit:\t\t\t{boolean} <false>|{object} {window: {number} <1>, maxOps: {number} <64>},\n"
+            "\treadAhead:\t\t\t{boolean} <false>|{number} <64>|{object} {window: {number} <64>, values: {boolean} <false>},\n"
+            "\tdebug:\t\t\t\t{boolean} <false>|{string} [<off>|low|medium|high]/i|{number} [<0>|1|2|3]\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tpid:\t\t\t\t{number},\n"
             "\ttid:\t\t\t\t{number}\n"
             "}\n\n"
             "Returns on failure:\n"
@@ -3028,58 +4932,712 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the configure method, please refer to the README.md file\n"
+            "For more information about the configure method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "close"))) {
+        cout << REVSE "close" RESET " method: "
+            "Close connection to " NODEM_DB " - once closed, cannot be reopened in the current process\n\n"
+            "Required arguments:\n"
+            "None\n\n"
+            "Optional arguments:\n"
+            "{\n"
+            "\tresetTerminal:\t\t\t{boolean} <false>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{undefined}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the close method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "version"))) {
+        cout << REVSE "version" RESET " or " REVSE "about" RESET " method: "
+            "Display Nodem version - includes " NODEM_DB " version if connection has been established\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments:\n"
+            "None\n\n"
+            "Returns on success:\n"
+            "{string}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the version/about method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "data"))) {
+        cout << REVSE "data" RESET " method: "
+            "Retrieve information about the existence of data and/or children in global or local variables\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tdefined:\t\t\t{number} [0|1|10|11]\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|local, [subscripts+]\n\n"
+            "Returns on success:\n"
+            "{number} [0|1|10|11]\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the data method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "get"))) {
+        cout << REVSE "get" RESET " method: "
+            "Retrieve the data stored at a global or local node, or in an intrinsic special variable (ISV)\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tdata:\t\t\t\t{number|string},\n"
+            "\tdefined:\t\t\t{boolean}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|$ISV|local, [subscripts+]\n\n"
+            "Returns on success:\n"
+            "{number|string}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the get method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "set"))) {
+        cout << REVSE "set" RESET " method: "
+            "Store data in a global or local node, or in an intrinsic special variable (ISV)\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tdata:\t\t\t\t(required) {number|string}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tdata:\t\t\t\t{number|string}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|$ISV|local, [subscripts+], data\n\n"
+            "Returns on success:\n"
+            "{undefined}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the set method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "kill"))) {
+        cout << REVSE "kill" RESET " method: "
+            "Remove data stored in a global or global node, or in a local or local node, or remove all local variables\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Required arguments:\n"
+            "None - Without an argument, will clear the entire local symbol table for that process\n\n"
+            "Returns on success:\n"
+            "{undefined}\n\n"
+            "Optional arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tnodeOnly:\t\t\t(optional) {boolean} <false>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tnodeOnly:\t\t\t{boolean}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|local, [subscripts+]\n\n"
+            "Returns on success:\n"
+            "{undefined}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the kill method, please refer to the README.md file\n"
+            << endl;
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "killTree"))) {
+        cout << REVSE "killTree" RESET " method: "
+            "Kill a global or local tree in chunks, letting other calls run between them\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tchunkSize:\t\t\t(optional) {number} <1000>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tchunkSize:\t\t\t{number},\n"
+            "\tkilled:\t\t\t\t{number}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - At most chunkSize nodes are killed while holding the database mutex; the root node is killed last\n"
+            " - Nodes set under the tree while it is being killed are killed too, if they are set before the root is killed\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the killTree method, please refer to the README.md file\n"
+            << endl;
+#endif
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "merge"))) {
+        cout << REVSE "merge" RESET " method: "
+            "Copy the data from all of the nodes in a global or local tree, to another global or local tree\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Required arguments:\n"
+            "{\n"
+            "\tfrom:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t(required) {string},\n"
+            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
+            "\t},\n"
+            "\tto:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t(required) {string},\n"
+            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
+            "\t}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tfrom:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t{string},\n"
+            "\t\tsubscripts:\t\t{array {number|string}}\n"
+            "\t},\n"
+            "\tto:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t{string},\n"
+            "\t\tsubscripts:\t\t{array {number|string}}\n"
+            "\t}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the merge method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "order"))) {
+        cout << REVSE "order" RESET " or " REVSE "next" RESET " method: "
+            "Retrieve the next node, at the current subscript level\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tresult:\t\t\t\t{number|string}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|local, [subscripts+]\n\n"
+            "Returns on success:\n"
+            "{number|string}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the order/next method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "previous"))) {
+        cout << REVSE "previous" RESET " method: "
+            "Retrieve the previous node, at the current subscript level\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tresult:\t\t\t\t{number|string}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Arguments - via position:\n"
+            "^global|local, [subscripts+]\n\n"
+            "Returns on success:\n"
+            "{number|string}\n\n"
+            "Returns on failure:\n"
+            "{Error object}\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the previous method, please refer to the README.md file\n"
+            << endl;
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "scan"))) {
+        cout << REVSE "scan" RESET " method: "
+            "Retrieve a page of the subscripts under a node, with their data, and a token to resume from\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tlimit:\t\t\t\t(optional) {number} <100>,\n"
+            "\treverse:\t\t\t(optional) {boolean} <false>,\n"
+            "\tpacked:\t\t\t\t(optional) {boolean} <false>,\n"
+            "\tfilter:\t\t\t\t(optional) {string},\n"
+            "\ttoken:\t\t\t\t(optional) {string|null}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tresults:\t\t\t{array {object}} [{subscript: {number|string}, defined: {number}, data: {number|string}}],\n"
+            "\ttoken:\t\t\t\t{string|null}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Pass the token back, with the same global|local, subscripts, and reverse, to get the next page; it is null on the last page\n"
+            " - data is only returned for subscripts that have a value; defined is the same as in the data method\n"
+            " - With packed, results is a Buffer of the same results, compressed, to be read with the Packed class exported by Nodem\n"
+            " - filter is an expression, e.g. \"value > 10 and subscript startsWith 'a'\", run natively; only nodes it matches are returned\n"
+            " - A page visits at most 10 times limit nodes, so a filtered page can be short, or empty, and still have a token\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the scan method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "close"))) {
-        cout << REVSE "close" RESET " method: "
-            "Close connection to " NODEM_DB " - once closed, cannot be reopened in the current process\n\n"
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "toJSON"))) {
+        cout << REVSE "toJSON" RESET " method: "
+            "Serialize a global or local subtree as JSON text, natively, in to a Buffer\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tshape:\t\t\t\t(optional) {string} <nested>|flat\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tshape:\t\t\t\t{string},\n"
+            "\tjson:\t\t\t\t{Buffer}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - nested is an object per node with children, with the node's own value under the \"\" key, and flat is an array of\n"
+            "   {subscripts, data} objects, one per node with a value, with subscripts below the root; a subtree with no nodes is null or []\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the toJSON method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "fromJSON"))) {
+        cout << REVSE "fromJSON" RESET " method: "
+            "Parse JSON text natively, setting a global or local node for each value in it\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Required arguments:\n"
-            "None\n\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "},\n"
+            "{Buffer|string} - The JSON text\n\n"
             "Optional arguments:\n"
             "{\n"
-            "\tresetTerminal:\t\t\t{boolean} <false>\n"
+            "\ttransaction:\t\t\t(optional) {boolean} <false>,\n"
+            "\tshape:\t\t\t\t(optional) {string} <nested>|flat\n"
             "}\n\n"
             "Returns on success:\n"
-            "{undefined}\n\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tcount:\t\t\t\t{number}\n"
+            "}\n\n"
             "Returns on failure:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} false,\n"
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
+            " - The shapes are the same as in toJSON; true and false are set as 1 and 0, and null values are skipped\n"
+            " - With transaction, either every node is set or none are; without it, nodes set before an error are kept\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the close method, please refer to the README.md file\n"
+            "For more information about the fromJSON method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "version"))) {
-        cout << REVSE "version" RESET " or " REVSE "about" RESET " method: "
-            "Display Nodem version - includes " NODEM_DB " version if connection has been established\n"
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "countDistinct"))) {
+        cout << REVSE "countDistinct" RESET " method: "
+            "Estimate the number of distinct values, or subscripts at a level, in a subtree\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments:\n"
-            "None\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tof:\t\t\t\t(optional) {string|number} <value>|{level},\n"
+            "\tsketch:\t\t\t\t(optional) {boolean} <false>,\n"
+            "\tmerge:\t\t\t\t(optional) {array {Buffer}}\n"
+            "}\n\n"
             "Returns on success:\n"
-            "{string}\n\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tof:\t\t\t\t{string|number},\n"
+            "\testimate:\t\t\t{number},\n"
+            "\tsketch:\t\t\t\t{Buffer}\n"
+            "}\n\n"
             "Returns on failure:\n"
-            "{Error object}\n\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - of is 'value', to count the distinct values in the subtree, or a subscript level, counting from 1 at the name\n"
+            " - The estimate is from a HyperLogLog sketch, usually within 2% of the true count, using 16 KiB however many nodes there are\n"
+            " - sketch returns the sketch, which can be passed back in merge, to estimate the union of several subtrees or shards\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the version/about method, please refer to the README.md file\n"
+            "For more information about the countDistinct method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "data"))) {
-        cout << REVSE "data" RESET " method: "
-            "Retrieve information about the existence of data and/or children in global or local variables\n"
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "sample"))) {
+        cout << REVSE "sample" RESET " method: "
+            "Choose a random sample of the nodes with values in a subtree\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tn:\t\t\t\t(optional) {number} <10>,\n"
+            "\tmethod:\t\t\t\t(optional) {string} <reservoir>|descent\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tmethod:\t\t\t\t{string},\n"
+            "\tcount:\t\t\t\t{number},\n"
+            "\tresults:\t\t\t{array {object}} [{subscripts: {array {number|string}}, data: {number|string}}]\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - reservoir reads every node, choosing each with the same chance, and returns count, the number of nodes with values\n"
+            " - descent takes a random path from the root for each node, reading only a few levels, so it is fast but not uniform\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the sample method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "sorterWrite"))) {
+        cout << REVSE "sorterWrite" RESET " method: "
+            "Write a batch of sort records under their keys, for the Sorter class\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tkeys:\t\t\t\t(required) {array {number|string}},\n"
+            "\trecords:\t\t\t(required) {array {number|string}},\n"
+            "\tsequence:\t\t\t(optional) {number} <0>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tcount:\t\t\t\t{number}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Each record is set under its key and a sequence number, counting up from sequence, so equal keys keep their order\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the sorterWrite method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "sorterRead"))) {
+        cout << REVSE "sorterRead" RESET " method: "
+            "Read the next page of sort records, in key order, for the Sorter class\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tlimit:\t\t\t\t(optional) {number} <100>,\n"
+            "\tnext:\t\t\t\t(optional) {array|null}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tresults:\t\t\t{array {object}} [{key: {number|string}, record: {number|string}}],\n"
+            "\tnext:\t\t\t\t{array|null}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Pass next back to read the following page; it is null on the last page\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the sorterRead method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "bloom"))) {
+        cout << REVSE "bloom" RESET " method: "
+            "Build a Bloom filter over the keys at one subscript level, so data and get answer for missing keys without the database\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tlevel:\t\t\t\t(optional) {number} <subscripts.length + 1>,\n"
+            "\tbitsPerKey:\t\t\t(optional) {number} <10>,\n"
+            "\tdrop:\t\t\t\t(optional) {boolean} <false>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tlevel:\t\t\t\t{number},\n"
+            "\tcount:\t\t\t\t{number},\n"
+            "\tbits:\t\t\t\t{number},\n"
+            "\thashes:\t\t\t\t{number},\n"
+            "\tstale:\t\t\t\t{boolean},\n"
+            "\tprobes:\t\t\t\t{number},\n"
+            "\tnegatives:\t\t\t{number},\n"
+            "\tdropped:\t\t\t{boolean}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - level counts from 1 at the name, and a key is the subscripts below the node down to that level\n"
+            " - data and get on a node at or below the level, whose key is not in the filter, return without a database call\n"
+            " - Writes made through Nodem keep the filter current; writes by other processes are not seen, so rebuild after them\n"
+            " - function, procedure, and batch calls mark every filter stale, and a stale filter is not used until it is rebuilt\n"
+            " - drop removes the filter, returning dropped instead of the filter's size and counts\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the bloom method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "defineAggregate"))) {
+        cout << REVSE "defineAggregate" RESET " method: "
+            "Keep count and sum totals of a global in another global, updated by sets and kills in the same transaction\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\ttarget:\t\t\t\t(required) {string},\n"
+            "\tsource:\t\t\t\t(optional) {string},\n"
+            "\tvalueLevel:\t\t\t(optional) {number},\n"
+            "\tgroupLevel:\t\t\t(optional) {number} <0>,\n"
+            "\tops:\t\t\t\t(optional) {array {string}} <['count', 'sum']>,\n"
+            "\tdrop:\t\t\t\t(optional) {boolean} <false>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tsource:\t\t\t\t{string},\n"
+            "\ttarget:\t\t\t\t{string},\n"
+            "\tgroupLevel:\t\t\t{number},\n"
+            "\tvalueLevel:\t\t\t{number},\n"
+            "\tops:\t\t\t\t{array {string}},\n"
+            "\tstale:\t\t\t\t{boolean},\n"
+            "\tcount:\t\t\t\t{number},\n"
+            "\tdropped:\t\t\t{boolean}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - Passing source and valueLevel defines the aggregate; passing only target shows its definition\n"
+            " - The values of the source nodes at valueLevel are totaled by their first groupLevel subscripts\n"
+            " - Each total is kept in target, under the group's subscripts, followed by 'count' or 'sum'\n"
+            " - The totals are computed in one transaction, and count is the number of source nodes in them\n"
+            " - set, increment, kill, and killTree calls on the source update the totals in the same transaction as the write\n"
+            " - merge, fromJSON, function, procedure, and batch calls mark the totals stale; call defineAggregate again\n"
+            " - Writes by other processes are not seen, and do not mark the totals stale\n"
+            " - drop removes the definition, returning dropped, and leaves the target as it is\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the defineAggregate method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "prune"))) {
+        cout << REVSE "prune" RESET " method: "
+            "Kill the nodes at one level of a subtree that match a where expression, in chunked transactions\n"
+            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
+            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+            "Arguments - via object:\n"
+            "{\n"
+            "\tglobal|local:\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\twhere:\t\t\t\t(required) {string},\n"
+            "\tlevel:\t\t\t\t(optional) {number} <subscripts.length + 1>,\n"
+            "\tchunkSize:\t\t\t(optional) {number} <1000>,\n"
+            "\tlimit:\t\t\t\t(optional) {number},\n"
+            "\ttoken:\t\t\t\t(optional) {string|null}\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal|local:\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tlevel:\t\t\t\t{number},\n"
+            "\tchunkSize:\t\t\t{number},\n"
+            "\tscanned:\t\t\t{number},\n"
+            "\tpruned:\t\t\t\t{number},\n"
+            "\tchunks:\t\t\t\t{number},\n"
+            "\ttoken:\t\t\t\t{string|null}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - where is a scan filter expression, run natively against the subscript, value, and defined of each node at level\n"
+            " - Each node it matches is killed with its subtree; scanned counts the nodes it was run against\n"
+            " - At most chunkSize nodes are visited in each transaction, and the database mutex is released between them\n"
+            " - limit stops after visiting that many nodes, returning a token to pass back, with the same arguments, to go on\n"
+            " - token is null once the whole subtree has been walked\n"
+            " - Aggregates defined on a global are updated in the same transaction as each node is killed\n"
+            " - Extended references and sharded globals are not supported\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the prune method, please refer to the README.md file\n"
+            << endl;
+#endif
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "move"))) {
+        cout << REVSE "move" RESET " method: "
+            "Move a global or local tree to another one atomically, so its data is never in both places or in neither\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
             "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "\tfrom:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t(required) {string},\n"
+            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
+            "\t},\n"
+            "\tto:\n"
+            "\t{\n"
+            "\t\tglobal|local:\t\t(required) {string},\n"
+            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
+            "\t},\n"
+            "\tchunked:\t\t\t(optional) {boolean} <false>,\n"
+            "\tchunkSize:\t\t\t(optional) {number} <1000>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tdefined:\t\t\t{number} [0|1|10|11]\n"
+            "\tfrom:\t\t\t\t{object},\n"
+            "\tto:\t\t\t\t{object},\n"
+            "\tchunkSize:\t\t\t{number},\n"
+            "\tchunked:\t\t\t{boolean},\n"
+            "\tmoved:\t\t\t\t{number},\n"
+            "\tchunks:\t\t\t\t{number}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3087,18 +5645,23 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
-            "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
-            "Returns on success:\n"
-            "{number} [0|1|10|11]\n\n"
-            "Returns on failure:\n"
-            "{Error object}\n\n"
+            " - By default, the whole tree is copied and killed in one transaction\n"
+            " - With chunked, a tree of more than chunkSize nodes is copied in chunks of one transaction each, releasing the\n"
+            "   database mutex between them, and then a final transaction copies again the source nodes written through Nodem\n"
+            "   in between, and kills the source\n"
+            " - If more than chunkSize nodes were written, or M code was run, the final transaction reads the whole tree again\n"
+            " - Writes made by other processes between chunks are lost; only use chunked when no other process writes the tree\n"
+            " - Other calls can see the target partly copied, but the source stays whole until the final transaction\n"
+            " - The target must not have any data; moved is the number of nodes with values moved\n"
+            " - Aggregates defined on either global are marked stale\n"
+            " - Extended references and sharded globals are not supported\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the data method, please refer to the README.md file\n"
+            "For more information about the move method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "get"))) {
-        cout << REVSE "get" RESET " method: "
-            "Retrieve the data stored at a global or local node, or in an intrinsic special variable (ISV)\n"
+#endif
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "nextNode"))) {
+        cout << REVSE "nextNode" RESET " method: "
+            "Retrieve the next node, regardless of subscript level\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
@@ -3121,31 +5684,31 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
             "Arguments - via position:\n"
-            "^global|$ISV|local, [subscripts+]\n\n"
+            "^global|local, [subscripts+]\n\n"
             "Returns on success:\n"
-            "{number|string}\n\n"
+            "{array {number|string}}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the get method, please refer to the README.md file\n"
+            "For more information about the nextNode method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "set"))) {
-        cout << REVSE "set" RESET " method: "
-            "Store data in a global or local node, or in an intrinsic special variable (ISV)\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "previousNode"))) {
+        cout << REVSE "previousNode" RESET " method: "
+            "Retrieve the previous node, regardless of subscript level\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
             "{\n"
             "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
-            "\tdata:\t\t\t\t(required) {number|string}\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
             "\tglobal|local:\t\t\t{string},\n"
             "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tdata:\t\t\t\t{number|string}\n"
+            "\tdata:\t\t\t\t{number|string},\n"
+            "\tdefined:\t\t\t{boolean}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3154,35 +5717,32 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
             "Arguments - via position:\n"
-            "^global|$ISV|local, [subscripts+], data\n\n"
+            "^global|local, [subscripts+]\n\n"
             "Returns on success:\n"
-            "{undefined}\n\n"
+            "{array {number|string}}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the set method, please refer to the README.md file\n"
+            "For more information about the previousNode method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "kill"))) {
-        cout << REVSE "kill" RESET " method: "
-            "Remove data stored in a global or global node, or in a local or local node, or remove all local variables\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "increment"))) {
+        cout << REVSE "increment" RESET " method: "
+            "Atomically increment or decrement a global or local data node\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Required arguments:\n"
-            "None - Without an argument, will clear the entire local symbol table for that process\n\n"
-            "Returns on success:\n"
-            "{undefined}\n\n"
-            "Optional arguments - via object:\n"
+            "Arguments - via object:\n"
             "{\n"
             "\tglobal|local:\t\t\t(required) {string},\n"
             "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
-            "\tnodeOnly:\t\t\t(optional) {boolean} <false>\n"
+            "\tincrement:\t\t\t(optional) {number} <1>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
             "\tglobal|local:\t\t\t{string},\n"
             "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tnodeOnly:\t\t\t{boolean}\n"
+            "\tincrement:\t\t\t{number},\n"
+            "\tdata:\t\t\t\t{number|string}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3193,43 +5753,41 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "Arguments - via position:\n"
             "^global|local, [subscripts+]\n\n"
             "Returns on success:\n"
-            "{undefined}\n\n"
+            "{number|string}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the kill method, please refer to the README.md file\n"
+            "For more information about the increment method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "merge"))) {
-        cout << REVSE "merge" RESET " method: "
-            "Copy the data from all of the nodes in a global or local tree, to another global or local tree\n"
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "stripedCounter"))) {
+        cout << REVSE "stripedCounter" RESET " method: "
+            "Increment a counter spread across stripes, one per thread, or read it by summing the stripes\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Required arguments:\n"
+            "Arguments - via object:\n"
             "{\n"
-            "\tfrom:\n"
-            "\t{\n"
-            "\t\tglobal|local:\t\t(required) {string},\n"
-            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
-            "\t},\n"
-            "\tto:\n"
-            "\t{\n"
-            "\t\tglobal|local:\t\t(required) {string},\n"
-            "\t\tsubscripts:\t\t(optional) {array {number|string}}\n"
-            "\t}\n"
+            "\tglobal:\t\t\t\t(required) {string},\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\tstripes:\t\t\t(optional) {number} <16>,\n"
+            "\tincrement:\t\t\t(optional) {number} <0>\n"
             "}\n\n"
-            "Returns on success:\n"
+            "Returns on success, when incrementing:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tfrom:\n"
-            "\t{\n"
-            "\t\tglobal|local:\t\t{string},\n"
-            "\t\tsubscripts:\t\t{array {number|string}}\n"
-            "\t},\n"
-            "\tto:\n"
-            "\t{\n"
-            "\t\tglobal|local:\t\t{string},\n"
-            "\t\tsubscripts:\t\t{array {number|string}}\n"
-            "\t}\n"
+            "\tglobal:\t\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tstripes:\t\t\t{number},\n"
+            "\tincrement:\t\t\t{number},\n"
+            "\tstripe:\t\t\t\t{number}\n"
+            "}\n\n"
+            "Returns on success, when reading:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tglobal:\t\t\t\t{string},\n"
+            "\tsubscripts:\t\t\t{array {number|string}},\n"
+            "\tstripes:\t\t\t{number},\n"
+            "\tdata:\t\t\t\t{number}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3237,25 +5795,30 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
+            " - Each stripe is a child of the counter node, subscripted 0 through stripes - 1; stripes can be at most 1024\n"
+            " - Omitting increment, or passing 0, reads the counter; always use the same number of stripes for a counter\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the merge method, please refer to the README.md file\n"
+            "For more information about the stripedCounter method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "order"))) {
-        cout << REVSE "order" RESET " or " REVSE "next" RESET " method: "
-            "Retrieve the next node, at the current subscript level\n"
+#endif
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "lock"))) {
+        cout << REVSE "lock" RESET " method: "
+            "Lock a global or local tree, or individual node, incrementally - locks are advisory, not mandatory\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
             "{\n"
             "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
+            "\ttimeout:\t\t\t(optional) {number} <Infinity>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
             "\tglobal|local:\t\t\t{string},\n"
             "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tresult:\t\t\t\t{number|string}\n"
+            "\ttimeout:\t\t\t{number},\n"
+            "\tresult:\t\t\t\t{boolean}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3266,18 +5829,22 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "Arguments - via position:\n"
             "^global|local, [subscripts+]\n\n"
             "Returns on success:\n"
-            "{number|string}\n\n"
+            "{boolean}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the order/next method, please refer to the README.md file\n"
+            "For more information about the lock method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "previous"))) {
-        cout << REVSE "previous" RESET " method: "
-            "Retrieve the previous node, at the current subscript level\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "unlock"))) {
+        cout << REVSE "unlock" RESET " method: "
+            "Unlock a global or local tree, or individual node, incrementally; or release all locks held by a process\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments - via object:\n"
+            "Required arguments:\n"
+            "None - Without an argument, will clear the entire lock table for that process\n\n"
+            "Returns on success:\n"
+            "{undefined}\n\n"
+            "Optional arguments - via object:\n"
             "{\n"
             "\tglobal|local:\t\t\t(required) {string},\n"
             "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
@@ -3286,8 +5853,7 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
             "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tresult:\t\t\t\t{number|string}\n"
+            "\tsubscripts:\t\t\t{array {number|string}}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3298,29 +5864,75 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "Arguments - via position:\n"
             "^global|local, [subscripts+]\n\n"
             "Returns on success:\n"
-            "{number|string}\n\n"
+            "{undefined}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the previous method, please refer to the README.md file\n"
+            "For more information about the unlock method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "nextNode"))) {
-        cout << REVSE "nextNode" RESET " method: "
-            "Retrieve the next node, regardless of subscript level\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "lockStats"))) {
+        cout << REVSE "lockStats" RESET " method: "
+            "Report lock statistics, current lock holders, and lock-order inversions for the current process\n\n"
+            "Required arguments:\n"
+            "None\n\n"
+            "Optional arguments - via object:\n"
+            "{\n"
+            "\treset:\t\t\t\t{boolean} <false>\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tresources:\t\t\t{array {object}},\n"
+            "\tinversions:\t\t\t{array {object}},\n"
+            "\tdropped:\t\t\t{number}\n"
+            "}\n\n"
+            " - Each resource has acquisitions, timeouts, waitTime (total, max, and histogram, in milliseconds), and holders\n"
+            " - Each inversion names two resources that have been locked in both orders, which can lead to a deadlock\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the lockStats method, please refer to the README.md file\n"
+            << endl;
+#if NODEM_SIMPLE_API == 1
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "transaction"))) {
+        cout << REVSE "transaction" RESET " method: "
+            "Run a function containing Nodem API calls as an ACID transaction in YottaDB - synchronous only\n\n"
+            "Required arguments:\n"
+            "{function} - A JavaScript function, taking no arguments, which will be run in a YottaDB transaction\n\n"
+            "Optional arguments - via object:\n"
+            "{\n"
+            "\tvariables:\t\t\t{array {string}},\n"
+            "\ttype:\t\t\t\t{string} Batch|batch|BATCH\n"
+            "}\n\n"
+            "Returns on success:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tstatusCode:\t\t\t{number},\n"
+            "\tstatusMessage:\t\t\t{string}\n"
+            "}\n\n"
+            "Returns on failure:\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
+            " - tpRollback and tpRestart are provided as convenience properties on the instance object\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the transaction method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "readConsistent"))) {
+        cout << REVSE "readConsistent" RESET " method: "
+            "Read several global or local nodes in one read-only transaction, so they are consistent with each other\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments - via object:\n"
+            "Required arguments:\n"
+            "{array {object}} [{global|local: {string}, subscripts: {array {number|string}}}]\n\n"
+            "Optional arguments:\n"
             "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "\tpacked:\t\t\t\t(optional) {boolean} <false>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tdata:\t\t\t\t{number|string},\n"
-            "\tdefined:\t\t\t{boolean}\n"
+            "\tresults:\t\t\t{array {object}} [{global|local: {string}, subscripts: {array}, data: {number|string}, defined: {boolean}}]\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3328,32 +5940,57 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
-            "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
+            " - Results are in the same order as the nodes; restarts are handled by " NODEM_DB ", without calling back in to JavaScript\n"
+            " - With packed, results is a Buffer of the same results, compressed, to be read with the Packed class exported by Nodem\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the readConsistent method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "shardedGlobal"))) {
+        cout << REVSE "shardedGlobal" RESET " method: "
+            "Spread a global across several global directories, routing each call by one of its subscripts\n\n"
+            "Required arguments:\n"
+            "{\n"
+            "\tname:\t\t\t\t{string}\n"
+            "}\n\n"
+            "Optional arguments - via object:\n"
+            "{\n"
+            "\tshards:\t\t\t\t{array {object}} [{gld: {string}, region: {string}}],\n"
+            "\tkeyLevel:\t\t\t{number} <1>,\n"
+            "\thash:\t\t\t\t{string} <fnv1a>|modulo\n"
+            "}\n\n"
             "Returns on success:\n"
-            "{array {number|string}}\n\n"
-            "Returns on failure:\n"
-            "{Error object}\n\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} true,\n"
+            "\tname:\t\t\t\t{string},\n"
+            "\tshards:\t\t\t\t{array {object}},\n"
+            "\tkeyLevel:\t\t\t{number},\n"
+            "\thash:\t\t\t\t{string}\n"
+            "}\n\n"
+            " - Without shards, the current definition is returned; an empty shards array removes the definition\n"
+            " - Nodes with fewer subscripts than keyLevel are kept in the first shard; order, previous, nextNode, and previousNode\n"
+            "   merge the shards in collation order\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the nextNode method, please refer to the README.md file\n"
+            "For more information about the shardedGlobal method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "previousNode"))) {
-        cout << REVSE "previousNode" RESET " method: "
-            "Retrieve the previous node, regardless of subscript level\n"
+#endif
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "function"))) {
+        cout << REVSE "function" RESET " method: "
+            "Call a " NODEM_DB " extrinsic function\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
             "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "\tfunction:\t\t\t(required) {string},\n"
+            "\targuments:\t\t\t(optional) {array {number|string|empty}},\n"
+            "\tautoRelink:\t\t\t(optional) {boolean} <false>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tdata:\t\t\t\t{number|string},\n"
-            "\tdefined:\t\t\t{boolean}\n"
+            "\tfunction:\t\t\t{string},\n"
+            "\targuments:\t\t\t{array {number|string|empty}},\n"
+            "\tautoRelink:\t\t\t{boolean},\n"
+            "\tresult:\t\t\t\t{number|string}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3362,32 +5999,31 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
             "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
+            "function, [arguments+]\n\n"
             "Returns on success:\n"
-            "{array {number|string}}\n\n"
+            "{number|string}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the previousNode method, please refer to the README.md file\n"
+            "For more information about the function method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "increment"))) {
-        cout << REVSE "increment" RESET " method: "
-            "Atomically increment or decrement a global or local data node\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "procedure"))) {
+        cout << REVSE "procedure" RESET " or " REVSE "routine" RESET " method: "
+            "Call a " NODEM_DB " routine label\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
             "Arguments - via object:\n"
             "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
-            "\tincrement:\t\t\t(optional) {number} <1>\n"
+            "\tprocedure|routine:\t\t(required) {string},\n"
+            "\targuments:\t\t\t(optional) {array {number|string|empty}},\n"
+            "\tautoRelink:\t\t\t(optional) {boolean} <false>\n"
             "}\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\tincrement:\t\t\t{number},\n"
-            "\tdata:\t\t\t\t{number|string}\n"
+            "\tprocedure|routine:\t\t{string},\n"
+            "\targuments:\t\t\t{array {number|string|empty}},\n"
+            "\tautoRelink:\t\t\t{boolean}\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3396,32 +6032,27 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
             "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
+            "procedure, [arguments+]\n\n"
             "Returns on success:\n"
-            "{number|string}\n\n"
+            "{undefined}\n\n"
             "Returns on failure:\n"
             "{Error object}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the increment method, please refer to the README.md file\n"
+            "For more information about the procedure/routine method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "lock"))) {
-        cout << REVSE "lock" RESET " method: "
-            "Lock a global or local tree, or individual node, incrementally - locks are advisory, not mandatory\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "batch"))) {
+        cout << REVSE "batch" RESET " method: "
+            "Run several data, get, set, kill, order, previous, or increment operations with one Call-in, in order\n"
             " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
             " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments - via object:\n"
-            "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}},\n"
-            "\ttimeout:\t\t\t(optional) {number} <Infinity>\n"
-            "}\n\n"
+            "Required arguments:\n"
+            "{array {object}} [{op: {string}, global|local: {string}, subscripts: {array {number|string}}, data: {number|string}, "
+            "increment: {number}}]\n\n"
             "Returns on success:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}},\n"
-            "\ttimeout:\t\t\t{number},\n"
-            "\tresult:\t\t\t\t{boolean}\n"
+            "\tresults:\t\t\t{array {object}} [{ok: {boolean} true, op: {string}, global|local: {string}, subscripts: {array}, "
+            "...}]\n"
             "}\n\n"
             "Returns on failure:\n"
             "{\n"
@@ -3429,272 +6060,3945 @@ void Nodem::help(const FunctionCallbackInfo<Value>& info)
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
-            "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
-            "Returns on success:\n"
-            "{boolean}\n\n"
-            "Returns on failure:\n"
-            "{Error object}\n\n"
+            " - op is one of data, get, set, kill, order, previous, or increment; data is required by set, and increment defaults to 1\n"
+            " - Each result has the same data, defined, or result property as the single API would return\n"
+            " - Operations run in order, in v4wNode.m; if one fails, the ones before it have still taken effect\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the lock method, please refer to the README.md file\n"
+            "For more information about the batch method, please refer to the README.md file\n"
             << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "unlock"))) {
-        cout << REVSE "unlock" RESET " method: "
-            "Unlock a global or local tree, or individual node, incrementally; or release all locks held by a process\n"
-            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
-            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "globalDirectory"))) {
+        cout << REVSE "globalDirectory" RESET " method: "
+            "List globals stored in the database\n\n"
             "Required arguments:\n"
-            "None - Without an argument, will clear the entire lock table for that process\n\n"
-            "Returns on success:\n"
-            "{undefined}\n\n"
-            "Optional arguments - via object:\n"
+            "None - Without an argument, will list all the globals stored in the database\n\n"
+            "Optional arguments:\n"
             "{\n"
-            "\tglobal|local:\t\t\t(required) {string},\n"
-            "\tsubscripts:\t\t\t(optional) {array {number|string}}\n"
+            "\tmax:\t\t\t\t{number},\n"
+            "\tlo:\t\t\t\t{string},\n"
+            "\thi:\t\t\t\t{string}\n"
             "}\n\n"
             "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tglobal|local:\t\t\t{string},\n"
-            "\tsubscripts:\t\t\t{array {number|string}}\n"
-            "}\n\n"
+            "[\n"
+            "\t<global variable name>*\t\t{string}\n"
+            "]\n\n"
             "Returns on failure:\n"
             "{\n"
             "\tok:\t\t\t\t{boolean} false,\n"
             "\terrorCode:\t\t\t{number},\n"
             "\terrorMessage:\t\t\t{string}\n"
             "}\n\n"
-            "Arguments - via position:\n"
-            "^global|local, [subscripts+]\n\n"
+            " - Some failures can result in thrown exceptions and/or stack traces\n"
+            "For more information about the globalDirectory method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "localDirectory"))) {
+        cout << REVSE "localDirectory" RESET " method: "
+            "List local variables stored in the symbol table\n\n"
+            "Required arguments:\n"
+            "None - Without an argument, will list all the variables in the local symbol table\n\n"
+            "Optional arguments:\n"
+            "{\n"
+            "\tmax:\t\t\t\t{number},\n"
+            "\tlo:\t\t\t\t{string},\n"
+            "\thi:\t\t\t\t{string}\n"
+            "}\n\n"
             "Returns on success:\n"
-            "{undefined}\n\n"
+            "[\n"
+            "\t<local variable name>*\t\t{string}\n"
+            "]\n\n"
             "Returns on failure:\n"
-            "{Error object}\n\n"
+            "{\n"
+            "\tok:\t\t\t\t{boolean} false,\n"
+            "\terrorCode:\t\t\t{number},\n"
+            "\terrorMessage:\t\t\t{string}\n"
+            "}\n\n"
             " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the unlock method, please refer to the README.md file\n"
+            "For more information about the localDirectory method, please refer to the README.md file\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "retrieve"))) {
+        cout << REVSE "retrieve" RESET " method: "
+            "Retrieve a global or local tree structure as an object - NOT YET IMPLEMENTED\n"
+            << endl;
+    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "update"))) {
+        cout << REVSE "update" RESET " method: "
+            "Store an object as a global or local tree structure - NOT YET IMPLEMENTED\n"
+            << endl;
+    } else {
+        cout << REVSE "NodeM" RESET " API Help Menu - Methods:\n\n"
+            "open\t\t\tOpen connection to " NODEM_DB " - all methods, except for help and version, require an open connection\n"
+            "configure\t\tConfigure per-thread parameters of the connection to " NODEM_DB "\n"
+            "close\t\t\tClose connection to " NODEM_DB " - once closed, cannot be reopened in the current process\n"
+            "version\t\t\tDisplay Nodem version - includes " NODEM_DB " version if connection has been established (AKA about)\n"
+            "data\t\t\tRetrieve information about the existence of data and/or children in global or local variables\n"
+            "get\t\t\tRetrieve the data stored at a global or local node, or in an intrinsic special variable (ISV)\n"
+            "set\t\t\tStore data in a global or local node, or in an intrinsic special variable (ISV)\n"
+            "kill\t\t\tRemove data stored in a global or global node, or in a local or local node; or remove all local variables\n"
+#if NODEM_SIMPLE_API == 1
+            "killTree\t\tKill a global or local tree in chunks, letting other calls run between them\n"
+#endif
+            "merge\t\t\tCopy the data from all of the nodes in a global or local tree, to another global or local tree\n"
+            "order\t\t\tRetrieve the next node, at the current subscript level (AKA next)\n"
+            "previous\t\tRetrieve the previous node, at the current subscript level\n"
+#if NODEM_SIMPLE_API == 1
+            "scan\t\t\tRetrieve a page of the subscripts under a node, with their data, and a token to resume from\n"
+            "toJSON\t\t\tSerialize a global or local subtree as JSON text, natively, in to a Buffer\n"
+            "fromJSON\t\tParse JSON text natively, setting a global or local node for each value in it\n"
+            "countDistinct\t\tEstimate the number of distinct values, or subscripts at a level, in a subtree\n"
+            "sample\t\t\tChoose a random sample of the nodes with values in a subtree\n"
+            "sorterWrite\t\tWrite a batch of sort records under their keys, for the Sorter class\n"
+            "sorterRead\t\tRead the next page of sort records, in key order, for the Sorter class\n"
+            "bloom\t\t\tBuild a Bloom filter over the keys at one level, answering data and get for missing keys\n"
+            "defineAggregate\t\tKeep count and sum totals of a global in another global, updated as it is written\n"
+            "prune\t\t\tKill the nodes at one level of a subtree that match a where expression, in chunked transactions\n"
+            "move\t\t\tMove a global or local tree to another one atomically, so its data is never in both places or in neither\n"
+#endif
+            "nextNode\t\tRetrieve the next node, regardless of subscript level\n"
+            "previousNode\t\tRetrieve the previous node, regardless of subscript level\n"
+            "increment\t\tAtomically increment or decrement a global or local data node\n"
+#if NODEM_SIMPLE_API == 1
+            "stripedCounter\t\tIncrement a counter spread across stripes, one per thread, or read it by summing the stripes\n"
+#endif
+            "lock\t\t\tLock a global or local tree, or individual node, incrementally - locks are advisory, not mandatory\n"
+            "unlock\t\t\tUnlock a global or local tree, or individual node, incrementally; or release all locks held by a process\n"
+            "lockStats\t\tReport lock statistics, current lock holders, and lock-order inversions for the current process\n"
+#if NODEM_SIMPLE_API == 1
+            "transaction\t\tRun a function containing Nodem API calls as an ACID transaction in YottaDB - synchronous only\n"
+            "readConsistent\t\tRead several global or local nodes in one read-only transaction, so they are consistent with each other\n"
+            "shardedGlobal\t\tSpread a global across several global directories, routing each call by one of its subscripts\n"
+#endif
+            "function\t\tCall a " NODEM_DB " extrinsic function\n"
+            "procedure\t\tCall a " NODEM_DB " routine label (AKA routine)\n"
+            "batch\t\t\tRun several data, get, set, kill, order, previous, or increment operations with one Call-in\n"
+            "globalDirectory\t\tList globals stored in the database\n"
+            "localDirectory\t\tList local variables stored in the symbol table\n"
+            "retrieve\t\tRetrieve a global or local tree structure as an object - NOT YET IMPLEMENTED\n"
+            "update\t\t\tStore an object as a global or local tree structure - NOT YET IMPLEMENTED\n\n"
+            "For more information about each method, call help with the method name as an argument\n"
             << endl;
+    }
+
+    info.GetReturnValue().Set(new_string_n(isolate, "NodeM - Copyright (C) 2012-2024 Fourth Watch Software LC"));
+    return;
+} // @end nodem::Nodem::help method
+
+/*
+ * @method nodem::Nodem::version
+ * @summary Return the about/version string
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::version(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::version enter");
+
+    bool async = false;
+
+    if (info[0]->IsFunction()) {
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[0]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate));
+    nodem_baton->name = NODEM_VERSION;
+    nodem_baton->async = async;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::version;
+#else
+    nodem_baton->nodem_function = &gtm::version;
+#endif
+    nodem_baton->ret_function = &nodem::version;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into ", NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::version exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from ", NODEM_DB);
+
+    if (nodem_baton->status != EXIT_SUCCESS) {
+        isolate->ThrowException(Exception::Error(to_string_n(isolate, error_status(nodem_baton->error, true, async, nodem_state))));
+        info.GetReturnValue().Set(Undefined(isolate));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into version");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::version exit\n");
+
+    return;
+} // @end nodem::Nodem::version
+
+/*
+ * @method nodem::Nodem::data
+ * @summary Check if global or local node has data and/or children or not
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::data(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::data enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> glvn;
+    Local<Value> subscripts = Undefined(isolate);
+    bool local = false;
+    bool position = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    } else {
+        glvn = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subs = Undefined(isolate);
+    vector<string> subs_array;
+
+    if (subscripts->IsUndefined()) {
+        subs = String::Empty(isolate);
+    } else if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#else
+        subs = encode_arguments(subscripts, nodem_state);
+
+        if (subs->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#endif
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::data;
+#else
+    nodem_baton->nodem_function = &gtm::data;
+#endif
+    nodem_baton->ret_function = &nodem::data;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::data exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error( to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into data");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::data exit\n");
+
+    return;
+} // @end nodem::Nodem::data method
+
+/*
+ * @method nodem::Nodem::get
+ * @summary Get data from a global or local node, or an intrinsic special variable
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::get(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::get enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> glvn;
+    Local<Value> subscripts = Undefined(isolate);
+    bool local = false;
+    bool position = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    } else {
+        glvn = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subs = Undefined(isolate);
+    vector<string> subs_array;
+
+    if (subscripts->IsUndefined()) {
+        subs = String::Empty(isolate);
+    } else if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#else
+        subs = encode_arguments(subscripts, nodem_state);
+
+        if (subs->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#endif
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::get;
+#else
+    nodem_baton->nodem_function = &gtm::get;
+#endif
+    nodem_baton->ret_function = &nodem::get;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::get exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_ERR_GVUNDEF && nodem_baton->status != YDB_ERR_LVUNDEF) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into get");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::get exit\n");
+
+    return;
+} // @end nodem::Nodem::get method
+
+/*
+ * @method nodem::Nodem::set
+ * @summary Set a global or local node, or an intrinsic special variable
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::set(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::set enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> glvn;
+    Local<Value> subscripts = Undefined(isolate);
+    Local<Value> data_value;
+    bool local = false;
+    bool position = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+        data_value = get_n(isolate, arg_object, new_string_n(isolate, "data"));
+    } else {
+        if (args_cnt < 2) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+            return;
+        }
+
+        glvn = info[0];
+        data_value = info[args_cnt - 1];
+
+        if (args_cnt > 2) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 2);
+
+            for (unsigned int i = 1; i < args_cnt - 1; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subs = Undefined(isolate);
+    vector<string> subs_array;
+
+    if (subscripts->IsUndefined()) {
+        subs = String::Empty(isolate);
+    } else if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#else
+        subs = encode_arguments(subscripts, nodem_state);
+
+        if (subs->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#endif
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    if (data_value->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'data' property")));
+        return;
+    }
+
+    Local<Value> data_node;
+
+#if NODEM_SIMPLE_API == 1
+    data_node = data_value;
+#else
+    Local<Array> data_array = Array::New(isolate, 1);
+    set_n(isolate, data_array, 0, data_value);
+
+    data_node = encode_arguments(data_array, nodem_state);
+#endif
+
+    if (data_node->IsSymbol() || data_node->IsSymbolObject() || data_node->IsObject() ||
+      data_node->IsArray() || data_node->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Property 'data' contains invalid data")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub, value;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+        value = *(UTF8_VALUE_TEMP_N(isolate, data_node));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+        NodemValue nodem_data_node {data_node};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+        value = nodem_data_node.to_byte();
+    }
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_state->mode == CANONICAL && data_value->IsNumber()) {
+        if (value.substr(0, 2) == "0.") value = value.substr(1, string::npos);
+        if (value.substr(0, 3) == "-0.") value = "-" + value.substr(2, string::npos);
+    }
+#endif
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+        debug_log(">>   data: ", value);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, data_value);
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->value = std::move(value);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::set;
+#else
+    nodem_baton->nodem_function = &gtm::set;
+#endif
+    nodem_baton->ret_function = &nodem::set;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::set exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into set");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::set exit\n");
+
+    return;
+} // @end nodem::Nodem::set method
+
+/*
+ * @method nodem::Nodem::kill
+ * @summary Kill a global or local, or global or local node, or remove the entire symbol table
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::kill(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    Local<Value> glvn = Undefined(isolate);
+    Local<Value> subscripts = Undefined(isolate);
+    bool local = false;
+    bool position = false;
+    bool node_only = false;
+
+    if (info[0]->IsObject() && !info[0]->IsFunction()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "nodeOnly"))) {
+            node_only = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "nodeOnly")));
+        }
+    } else if (args_cnt > 0) {
+        glvn = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    Local<Value> subs = String::Empty(isolate);
+    vector<string> subs_array;
+
+    if (!glvn->IsUndefined() && !glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    } else if (glvn->IsUndefined()) {
+        glvn = String::Empty(isolate);
+        local = true;
+    } else {
+        if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+            bool error = false;
+            subs_array = build_subscripts(subscripts, error, nodem_state);
+
+            if (error) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+                return;
+            }
+#else
+            subs = encode_arguments(subscripts, nodem_state);
+
+            if (subs->IsUndefined()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+                return;
+            }
+#endif
+        } else if (!subscripts->IsUndefined()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+            return;
+        }
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->node_only = node_only;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::kill;
+#else
+    nodem_baton->nodem_function = &gtm::kill;
+#endif
+    nodem_baton->ret_function = &nodem::kill;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::kill exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into kill");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill exit\n");
+
+    return;
+} // @end nodem::Nodem::kill method
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::kill_tree
+ * @summary Kill a global or local tree in bounded chunks, so that a large kill does not hold up every other call in the process
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::kill_tree(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill_tree enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    double chunk_size = KILL_CHUNK;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "chunkSize"))) {
+        Local<Value> chunk = get_n(isolate, arg_object, new_string_n(isolate, "chunkSize"));
+
+        if (!chunk->IsUint32() || uint32_value_n(isolate, chunk) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'chunkSize' must be a positive integer")));
+            return;
+        }
+
+        chunk_size = static_cast<double>(uint32_value_n(isolate, chunk));
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   chunkSize: ", chunk_size);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->option = chunk_size;
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->node_only = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::kill_tree;
+    nodem_baton->ret_function = &nodem::kill_tree;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::kill_tree exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into kill_tree");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill_tree exit\n");
+
+    return;
+} // @end nodem::Nodem::kill_tree method
+#endif
+
+/*
+ * @method nodem::Nodem::merge
+ * @summary Merge a global or local array tree to another global or local array tree
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::merge(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::merge enter");
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an argument")));
+        return;
+    } else if (!info[0]->IsObject()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> from_object = get_n(isolate, arg_object, new_string_n(isolate, "from"));
+    Local<Value> to_object = get_n(isolate, arg_object, new_string_n(isolate, "to"));
+    bool from_local = false;
+    bool to_local = false;
+
+    if (!has_n(isolate, arg_object, new_string_n(isolate, "from"))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'from' property")));
+        return;
+    } else if (!from_object->IsObject()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "'from' property must be an object")));
+        return;
+    }
+
+    Local<Object> from = to_object_n(isolate, from_object);
+
+    if (!has_n(isolate, arg_object, new_string_n(isolate, "to"))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'to' property")));
+        return;
+    } else if (!to_object->IsObject()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "'to' property must be an object")));
+        return;
+    }
+
+    Local<Object> to = to_object_n(isolate, to_object);
+    Local<Value> from_glvn = get_n(isolate, from, new_string_n(isolate, "global"));
+
+    if (from_glvn->IsUndefined()) {
+        from_glvn = get_n(isolate, from, new_string_n(isolate, "local"));
+
+        if (from_glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+                     "Need a 'global' or 'local' property in your 'from' object")));
+
+            return;
+        } else {
+            from_local = true;
+        }
+    }
+
+    if (!from_glvn->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global in 'from' must be a string")));
+        return;
+    } else if (from_glvn->StrictEquals(new_string_n(isolate, ""))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global in 'from' must not be an empty string")));
+        return;
+    }
+
+    Local<Value> to_glvn = get_n(isolate, to, new_string_n(isolate, "global"));
+
+    if (to_glvn->IsUndefined()) {
+        to_glvn = get_n(isolate, to, new_string_n(isolate, "local"));
+
+        if (to_glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+                     "Need a 'global' or 'local' property in your 'to' object")));
+
+            return;
+        } else {
+            to_local = true;
+        }
+    }
+
+    if (!to_glvn->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global in 'to' must be a string")));
+        return;
+    } else if (to_glvn->StrictEquals(new_string_n(isolate, ""))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global in 'to' must not be an empty string")));
+        return;
+    }
+
+#if NODEM_SIMPLE_API == 1
+    /*
+     * Merges are done natively, with the SimpleAPI, unless either side is an extended reference, because
+     * the SimpleAPI can only use one global directory at a time; those still use the Call-in interface
+     */
+    string from_ref = *(UTF8_VALUE_TEMP_N(isolate, from_glvn));
+    string to_ref = *(UTF8_VALUE_TEMP_N(isolate, to_glvn));
+    size_t from_start = (from_ref[0] == '^') ? 1 : 0;
+    size_t to_start = (to_ref[0] == '^') ? 1 : 0;
+
+    bool callin = (!from_local && (from_ref[from_start] == '[' || from_ref[from_start] == '|')) ||
+      (!to_local && (to_ref[to_start] == '[' || to_ref[to_start] == '|'));
+#endif
+
+    Local<Value> from_subscripts = get_n(isolate, from, new_string_n(isolate, "subscripts"));
+    Local<Value> from_subs = String::Empty(isolate);
+    vector<string> from_subs_array;
+
+    if (from_subscripts->IsUndefined()) {
+        from_subs = String::Empty(isolate);
+    } else if (from_subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+
+        if (!callin) {
+            from_subs_array = build_subscripts(from_subscripts, error, nodem_state);
+        } else {
+            from_subs = encode_arguments(from_subscripts, nodem_state);
+            error = from_subs->IsUndefined();
+        }
+
+        if (error) {
+#else
+        from_subs = encode_arguments(from_subscripts, nodem_state);
+
+        if (from_subs->IsUndefined()) {
+#endif
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+                     "Property 'subscripts' in 'from' object contains invalid data")));
+
+            return;
+        }
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                 "Property 'subscripts' in 'from' must contain an array")));
+
+        return;
+    }
+
+    Local<Value> to_subscripts = get_n(isolate, to, new_string_n(isolate, "subscripts"));
+    Local<Value> to_subs = String::Empty(isolate);
+    vector<string> to_subs_array;
+
+    if (to_subscripts->IsUndefined()) {
+        to_subs = String::Empty(isolate);
+    } else if (to_subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+
+        if (!callin) {
+            to_subs_array = build_subscripts(to_subscripts, error, nodem_state);
+        } else {
+            to_subs = encode_arguments(to_subscripts, nodem_state);
+            error = to_subs->IsUndefined();
+        }
+
+        if (error) {
+#else
+        to_subs = encode_arguments(to_subscripts, nodem_state);
+
+        if (to_subs->IsUndefined()) {
+#endif
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+                     "Property 'subscripts' in 'to' object contains invalid data")));
+
+            return;
+        }
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' in 'to' must contain an array")));
+        return;
+    }
+
+#if NODEM_SIMPLE_API == 1
+    if (callin && callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
+    const char* from_name_msg;
+    Local<Value> from_name;
+
+    if (from_local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, from_glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'local' in 'from' is an invalid name")));
+            return;
+        }
+
+        from_name_msg = ">>   from_local: ";
+        from_name = localize_name(from_glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, from_name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'local' in 'from' cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, from_glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'global' in 'from' is an invalid name")));
+            return;
+        }
+
+        from_name_msg = ">>   from_global: ";
+        from_name = globalize_name(from_glvn, nodem_state);
+    }
+
+    const char* to_name_msg;
+    Local<Value> to_name;
+
+    if (to_local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, to_glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'local' in 'to' is an invalid name")));
+            return;
+        }
+
+        to_name_msg = ">>   to_local: ";
+        to_name = localize_name(to_glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, to_name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'local' in 'to' cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, to_glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'global' in 'to' is an invalid name")));
+            return;
+        }
+
+        to_name_msg = ">>   to_global: ";
+        to_name = globalize_name(to_glvn, nodem_state);
+    }
+
+    string from_gvn, from_sub, to_gvn, to_sub;
+
+    if (nodem_state->utf8 == true) {
+        from_gvn = *(UTF8_VALUE_TEMP_N(isolate, from_name));
+        from_sub = *(UTF8_VALUE_TEMP_N(isolate, from_subs));
+        to_gvn = *(UTF8_VALUE_TEMP_N(isolate, to_name));
+        to_sub = *(UTF8_VALUE_TEMP_N(isolate, to_subs));
+
+        if (nodem_state->debug > LOW) {
+            debug_log(from_name_msg, from_gvn);
+            debug_log(">>   from_subscripts: ", from_sub);
+            debug_log(to_name_msg, to_gvn);
+            debug_log(">>   to_subscripts: ", to_sub);
+        }
+    } else {
+        NodemValue gtm_from_name {from_name};
+        NodemValue gtm_from_subs {from_subs};
+        NodemValue gtm_to_name {to_name};
+        NodemValue gtm_to_subs {to_subs};
+
+        from_gvn = gtm_from_name.to_byte();
+        from_sub = gtm_from_subs.to_byte();
+        to_gvn = gtm_to_name.to_byte();
+        to_sub = gtm_to_subs.to_byte();
+
+        if (nodem_state->debug > LOW) {
+            debug_log(from_name_msg, from_gvn);
+            debug_log(">>   from_subscripts: ", from_sub);
+            debug_log(to_name_msg, to_gvn);
+            debug_log(">>   to_subscripts: ", to_sub);
+        }
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate), arg_object);
+    nodem_baton->name = std::move(from_gvn);
+    nodem_baton->args = std::move(from_sub);
+    nodem_baton->to_name = std::move(to_gvn);
+    nodem_baton->to_args = std::move(to_sub);
+    nodem_baton->subs_array = std::move(from_subs_array);
+    nodem_baton->to_subs_array = std::move(to_subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = from_local;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &gtm::merge;
+    nodem_baton->ret_function = &nodem::merge;
+    nodem_baton->nodem_state = nodem_state;
+
+#if NODEM_SIMPLE_API == 1
+    if (!callin) nodem_baton->nodem_function = &ydb::merge;
+#endif
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::merge exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status != EXIT_SUCCESS) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->object_p.Reset();
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into merge");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->object_p.Reset();
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::merge exit\n");
+
+    return;
+} // @end nodem::Nodem::merge method
+
+/*
+ * @method nodem::Nodem::order
+ * @summary Return the next global or local node at the same level
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::order(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::order enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> glvn;
+    Local<Value> subscripts = Undefined(isolate);
+    bool local = false;
+    bool position = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    } else {
+        glvn = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subs = Undefined(isolate);
+    vector<string> subs_array;
+
+    if (subscripts->IsUndefined()) {
+        subs = String::Empty(isolate);
+    } else if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#else
+        subs = encode_arguments(subscripts, nodem_state);
+
+        if (subs->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#endif
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::order;
+#else
+    nodem_baton->nodem_function = &gtm::order;
+#endif
+    nodem_baton->ret_function = &nodem::order;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::order exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_NODE_END) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into order");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::order exit\n");
+
+    return;
+} // @end nodem::Nodem::order method
+
+/*
+ * @method nodem::Nodem::previous
+ * @summary Return the previous global or local node at the same level
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::previous(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> glvn;
+    Local<Value> subscripts = Undefined(isolate);
+    bool local = false;
+    bool position = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
+        }
+
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        }
+
+        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    } else {
+        glvn = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            }
+
+            subscripts = temp_subscripts;
+        }
+
+        position = true;
+        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
+        if (test[0] != '^') local = true;
+    }
+
+    if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subs = Undefined(isolate);
+    vector<string> subs_array;
+
+    if (subscripts->IsUndefined()) {
+        subs = String::Empty(isolate);
+    } else if (subscripts->IsArray()) {
+#if NODEM_SIMPLE_API == 1
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#else
+        subs = encode_arguments(subscripts, nodem_state);
+
+        if (subs->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+#endif
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn, sub;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_subs {subs};
+
+        gvn = nodem_name.to_byte();
+        sub = nodem_subs.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+#if NODEM_SIMPLE_API == 1
+        if (subs_array.size()) {
+            for (unsigned int i = 0; i < subs_array.size(); i++) {
+                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+            }
+        }
+#else
+        debug_log(">>   subscripts: ", sub);
+#endif
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->status = 0;
+#if NODEM_SIMPLE_API == 1
+    nodem_baton->nodem_function = &ydb::previous;
+#else
+    nodem_baton->nodem_function = &gtm::previous;
+#endif
+    nodem_baton->ret_function = &nodem::previous;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::previous exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+#if NODEM_SIMPLE_API == 1
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_NODE_END) {
+#else
+    if (nodem_baton->status != EXIT_SUCCESS) {
+#endif
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into previous");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous exit\n");
+
+    return;
+} // @end nodem::Nodem::previous method
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::scan
+ * @summary Page through the subscripts under a global or local node, resuming each page from an opaque continuation token
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::scan(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::scan enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    double limit = SCAN_LIMIT;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "limit"))) {
+        Local<Value> limit_value = get_n(isolate, arg_object, new_string_n(isolate, "limit"));
+
+        if (!limit_value->IsUint32() || uint32_value_n(isolate, limit_value) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'limit' must be a positive integer")));
+            return;
+        }
+
+        limit = static_cast<double>(uint32_value_n(isolate, limit_value));
+    }
+
+    bool reverse = false;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "reverse"))) {
+        reverse = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "reverse")));
+    }
+
+    bool packed = false;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "packed"))) {
+        packed = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "packed")));
+    }
+
+    Local<Value> token = get_n(isolate, arg_object, new_string_n(isolate, "token"));
+
+    if (!token->IsUndefined() && !token->IsNull() && !token->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'token' must be a string")));
+        return;
+    }
+
+    Local<Value> filter_value = get_n(isolate, arg_object, new_string_n(isolate, "filter"));
+    filter_ptr_t filter;
+
+    if (!filter_value->IsUndefined() && !filter_value->IsNull()) {
+        if (!filter_value->IsString()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'filter' must be a string")));
+            return;
+        }
+
+        string expression;
+        string filter_error;
+
+        if (nodem_state->utf8 == true) {
+            expression = *(UTF8_VALUE_TEMP_N(isolate, filter_value));
+        } else {
+            NodemValue nodem_filter {filter_value};
+            expression = nodem_filter.to_byte();
+        }
+
+        filter = filter_compile(expression, filter_error);
+
+        if (!filter) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, ("Property 'filter' " + filter_error).c_str())));
+            return;
+        }
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   limit: ", limit);
+        debug_log(">>   reverse: ", boolalpha, reverse);
+        debug_log(">>   packed: ", boolalpha, packed);
+        debug_log(">>   filter: ", boolalpha, static_cast<bool>(filter));
+    }
+
+    string start;
+
+    if (token->IsString() && !token->StrictEquals(new_string_n(isolate, ""))) {
+        if (!token_decode(*(UTF8_VALUE_TEMP_N(isolate, token)), gvn, subs_array, reverse, start)) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'token' is not a continuation token for this scan")));
+            return;
+        }
+
+        if (nodem_state->debug > LOW) debug_log(">>   start: ", start);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->value = std::move(start);
+    nodem_baton->option = limit;
+    nodem_baton->reverse = reverse;
+    nodem_baton->packed = packed;
+    nodem_baton->filter = std::move(filter);
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->node_only = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::scan;
+    nodem_baton->ret_function = &nodem::scan;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::scan exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into scan");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::scan exit\n");
+
+    return;
+} // @end nodem::Nodem::scan method
+#endif
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::to_json
+ * @summary Serialize a global or local subtree as JSON text, in a worker thread when called asynchronously
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::to_json(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::to_json enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    json_shape_t shape = JSON_NESTED;
+    Local<Value> shape_value = get_n(isolate, arg_object, new_string_n(isolate, "shape"));
+
+    if (shape_value->StrictEquals(new_string_n(isolate, "flat"))) {
+        shape = JSON_FLAT;
+    } else if (!shape_value->IsUndefined() && !shape_value->StrictEquals(new_string_n(isolate, "nested"))) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'shape' must be 'nested' or 'flat'")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   shape: ", shape == JSON_FLAT ? "flat" : "nested");
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->info = shape;
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::to_json;
+    nodem_baton->ret_function = &nodem::to_json;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::to_json exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into to_json");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::to_json exit\n");
+
+    return;
+} // @end nodem::Nodem::to_json method
+#endif
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::from_json
+ * @summary Parse JSON text, setting a global or local node for each value in it, in a worker thread when called asynchronously
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::from_json(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::from_json enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    if (subs_array.size() >= YDB_MAX_SUBS) {
+        isolate->ThrowException(Exception::RangeError(new_string_n(isolate, "Too many subscripts to add JSON nodes under")));
+        return;
+    }
+
+    string json;
+
+    if (args_cnt > 1 && node::Buffer::HasInstance(info[1])) {
+        json.assign(node::Buffer::Data(info[1]), node::Buffer::Length(info[1]));
+    } else if (args_cnt > 1 && info[1]->IsString()) {
+        json = *(UTF8_VALUE_TEMP_N(isolate, info[1]));
+    } else {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply JSON text, in a Buffer or a string")));
+        return;
+    }
+
+    json_shape_t shape = JSON_NESTED;
+    bool atomic = false;
+
+    if (args_cnt > 2) {
+        if (!info[2]->IsObject() || info[2]->IsFunction() || info[2]->IsArray()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Options must be an object")));
+            return;
+        }
+
+        Local<Object> options = to_object_n(isolate, info[2]);
+        Local<Value> shape_value = get_n(isolate, options, new_string_n(isolate, "shape"));
+
+        if (shape_value->StrictEquals(new_string_n(isolate, "flat"))) {
+            shape = JSON_FLAT;
+        } else if (!shape_value->IsUndefined() && !shape_value->StrictEquals(new_string_n(isolate, "nested"))) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'shape' must be 'nested' or 'flat'")));
+            return;
+        }
+
+        if (has_n(isolate, options, new_string_n(isolate, "transaction"))) {
+            atomic = boolean_value_n(isolate, get_n(isolate, options, new_string_n(isolate, "transaction")));
+        }
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   length: ", json.length());
+        debug_log(">>   shape: ", shape == JSON_FLAT ? "flat" : "nested");
+        debug_log(">>   transaction: ", boolalpha, atomic);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->value = std::move(json);
+    nodem_baton->info = shape;
+    nodem_baton->atomic = atomic;
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::from_json;
+    nodem_baton->ret_function = &nodem::from_json;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::from_json exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into from_json");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::from_json exit\n");
+
+    return;
+} // @end nodem::Nodem::from_json method
+#endif
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::count_distinct
+ * @summary Estimate the number of distinct values or subscripts in a subtree, in a worker thread when called asynchronously
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::count_distinct(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::count_distinct enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    unsigned int level = 0;
+    Local<Value> of = get_n(isolate, arg_object, new_string_n(isolate, "of"));
+
+    if (of->IsNumber() && number_value_n(isolate, of) == uint32_value_n(isolate, of) &&
+      uint32_value_n(isolate, of) > subs_array.size() && uint32_value_n(isolate, of) <= YDB_MAX_SUBS) {
+        level = uint32_value_n(isolate, of);
+    } else if (!of->IsUndefined() && !of->StrictEquals(new_string_n(isolate, "value"))) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+          "Property 'of' must be 'value', or a subscript level below the last subscript")));
+        return;
+    }
+
+    bool return_sketch = false;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "sketch"))) {
+        return_sketch = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "sketch")));
+    }
+
+    Local<Value> merge = get_n(isolate, arg_object, new_string_n(isolate, "merge"));
+    DistinctSketch seed;
+    bool merged = false;
+
+    if (merge->IsArray()) {
+        Local<Array> sketches = Local<Array>::Cast(merge);
+
+        for (unsigned int i = 0; i < sketches->Length(); i++) {
+            Local<Value> sketch = get_n(isolate, sketches, i);
+
+            if (!node::Buffer::HasInstance(sketch) ||
+              !seed.merge(node::Buffer::Data(sketch), node::Buffer::Length(sketch))) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                  "Property 'merge' must be an array of sketches returned by countDistinct")));
+                return;
+            }
+
+            merged = true;
+        }
+    } else if (!merge->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'merge' must contain an array")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
+
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   of: ", level);
+        debug_log(">>   sketch: ", boolalpha, return_sketch);
+        debug_log(">>   merged: ", boolalpha, merged);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->info = level;
+    nodem_baton->sketch = return_sketch;
+
+    if (merged) nodem_baton->value = seed.serialized();
+
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::count_distinct;
+    nodem_baton->ret_function = &nodem::count_distinct;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::count_distinct exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into count_distinct");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::count_distinct exit\n");
+
+    return;
+} // @end nodem::Nodem::count_distinct method
+#endif
+
 #if NODEM_SIMPLE_API == 1
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "transaction"))) {
-        cout << REVSE "transaction" RESET " method: "
-            "Run a function containing Nodem API calls as an ACID transaction in YottaDB - synchronous only\n\n"
-            "Required arguments:\n"
-            "{function} - A JavaScript function, taking no arguments, which will be run in a YottaDB transaction\n\n"
-            "Optional arguments - via object:\n"
-            "{\n"
-            "\tvariables:\t\t\t{array {string}},\n"
-            "\ttype:\t\t\t\t{string} Batch|batch|BATCH\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tstatusCode:\t\t\t{number},\n"
-            "\tstatusMessage:\t\t\t{string}\n"
-            "}\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            " - tpRollback and tpRestart are provided as convenience properties on the instance object\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the transaction method, please refer to the README.md file\n"
-            << endl;
+/*
+ * @method nodem::Nodem::sample
+ * @summary Choose a random sample of the nodes with values in a subtree, in a worker thread when called asynchronously
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::sample(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sample enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
 #endif
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "function"))) {
-        cout << REVSE "function" RESET " method: "
-            "Call a " NODEM_DB " extrinsic function\n"
-            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
-            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments - via object:\n"
-            "{\n"
-            "\tfunction:\t\t\t(required) {string},\n"
-            "\targuments:\t\t\t(optional) {array {number|string|empty}},\n"
-            "\tautoRelink:\t\t\t(optional) {boolean} <false>\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tfunction:\t\t\t{string},\n"
-            "\targuments:\t\t\t{array {number|string|empty}},\n"
-            "\tautoRelink:\t\t\t{boolean},\n"
-            "\tresult:\t\t\t\t{number|string}\n"
-            "}\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            "Arguments - via position:\n"
-            "function, [arguments+]\n\n"
-            "Returns on success:\n"
-            "{number|string}\n\n"
-            "Returns on failure:\n"
-            "{Error object}\n\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the function method, please refer to the README.md file\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "procedure"))) {
-        cout << REVSE "procedure" RESET " or " REVSE "routine" RESET " method: "
-            "Call a " NODEM_DB " routine label\n"
-            " - Passing a function, taking two arguments (error and result), as the last argument, calls the API asynchronously\n"
-            " - Callbacks return `error === {null}` on success, and `result === {undefined}` on failure\n\n"
-            "Arguments - via object:\n"
-            "{\n"
-            "\tprocedure|routine:\t\t(required) {string},\n"
-            "\targuments:\t\t\t(optional) {array {number|string|empty}},\n"
-            "\tautoRelink:\t\t\t(optional) {boolean} <false>\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} true,\n"
-            "\tprocedure|routine:\t\t{string},\n"
-            "\targuments:\t\t\t{array {number|string|empty}},\n"
-            "\tautoRelink:\t\t\t{boolean}\n"
-            "}\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            "Arguments - via position:\n"
-            "procedure, [arguments+]\n\n"
-            "Returns on success:\n"
-            "{undefined}\n\n"
-            "Returns on failure:\n"
-            "{Error object}\n\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the procedure/routine method, please refer to the README.md file\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "globalDirectory"))) {
-        cout << REVSE "globalDirectory" RESET " method: "
-            "List globals stored in the database\n\n"
-            "Required arguments:\n"
-            "None - Without an argument, will list all the globals stored in the database\n\n"
-            "Optional arguments:\n"
-            "{\n"
-            "\tmax:\t\t\t\t{number},\n"
-            "\tlo:\t\t\t\t{string},\n"
-            "\thi:\t\t\t\t{string}\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "[\n"
-            "\t<global variable name>*\t\t{string}\n"
-            "]\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the globalDirectory method, please refer to the README.md file\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "localDirectory"))) {
-        cout << REVSE "localDirectory" RESET " method: "
-            "List local variables stored in the symbol table\n\n"
-            "Required arguments:\n"
-            "None - Without an argument, will list all the variables in the local symbol table\n\n"
-            "Optional arguments:\n"
-            "{\n"
-            "\tmax:\t\t\t\t{number},\n"
-            "\tlo:\t\t\t\t{string},\n"
-            "\thi:\t\t\t\t{string}\n"
-            "}\n\n"
-            "Returns on success:\n"
-            "[\n"
-            "\t<local variable name>*\t\t{string}\n"
-            "]\n\n"
-            "Returns on failure:\n"
-            "{\n"
-            "\tok:\t\t\t\t{boolean} false,\n"
-            "\terrorCode:\t\t\t{number},\n"
-            "\terrorMessage:\t\t\t{string}\n"
-            "}\n\n"
-            " - Some failures can result in thrown exceptions and/or stack traces\n"
-            "For more information about the localDirectory method, please refer to the README.md file\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "retrieve"))) {
-        cout << REVSE "retrieve" RESET " method: "
-            "Retrieve a global or local tree structure as an object - NOT YET IMPLEMENTED\n"
-            << endl;
-    } else if (to_string_n(isolate, info[0])->StrictEquals(new_string_n(isolate, "update"))) {
-        cout << REVSE "update" RESET " method: "
-            "Store an object as a global or local tree structure - NOT YET IMPLEMENTED\n"
-            << endl;
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    double size = SAMPLE_SIZE;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "n"))) {
+        Local<Value> size_value = get_n(isolate, arg_object, new_string_n(isolate, "n"));
+
+        if (!size_value->IsUint32() || uint32_value_n(isolate, size_value) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'n' must be a positive integer")));
+            return;
+        }
+
+        size = static_cast<double>(uint32_value_n(isolate, size_value));
+    }
+
+    sample_t method = RESERVOIR;
+    Local<Value> method_value = get_n(isolate, arg_object, new_string_n(isolate, "method"));
+
+    if (method_value->StrictEquals(new_string_n(isolate, "descent"))) {
+        method = DESCENT;
+    } else if (!method_value->IsUndefined() && !method_value->StrictEquals(new_string_n(isolate, "reservoir"))) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'method' must be 'reservoir' or 'descent'")));
+        return;
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
     } else {
-        cout << REVSE "NodeM" RESET " API Help Menu - Methods:\n\n"
-            "open\t\t\tOpen connection to " NODEM_DB " - all methods, except for help and version, require an open connection\n"
-            "configure\t\tConfigure per-thread parameters of the connection to " NODEM_DB "\n"
-            "close\t\t\tClose connection to " NODEM_DB " - once closed, cannot be reopened in the current process\n"
-            "version\t\t\tDisplay Nodem version - includes " NODEM_DB " version if connection has been established (AKA about)\n"
-            "data\t\t\tRetrieve information about the existence of data and/or children in global or local variables\n"
-            "get\t\t\tRetrieve the data stored at a global or local node, or in an intrinsic special variable (ISV)\n"
-            "set\t\t\tStore data in a global or local node, or in an intrinsic special variable (ISV)\n"
-            "kill\t\t\tRemove data stored in a global or global node, or in a local or local node; or remove all local variables\n"
-            "merge\t\t\tCopy the data from all of the nodes in a global or local tree, to another global or local tree\n"
-            "order\t\t\tRetrieve the next node, at the current subscript level (AKA next)\n"
-            "previous\t\tRetrieve the previous node, at the current subscript level\n"
-            "nextNode\t\tRetrieve the next node, regardless of subscript level\n"
-            "previousNode\t\tRetrieve the previous node, regardless of subscript level\n"
-            "increment\t\tAtomically increment or decrement a global or local data node\n"
-            "lock\t\t\tLock a global or local tree, or individual node, incrementally - locks are advisory, not mandatory\n"
-            "unlock\t\t\tUnlock a global or local tree, or individual node, incrementally; or release all locks held by a process\n"
-#if NODEM_SIMPLE_API == 1
-            "transaction\t\tRun a function containing Nodem API calls as an ACID transaction in YottaDB - synchronous only\n"
-#endif
-            "function\t\tCall a " NODEM_DB " extrinsic function\n"
-            "procedure\t\tCall a " NODEM_DB " routine label (AKA routine)\n"
-            "globalDirectory\t\tList globals stored in the database\n"
-            "localDirectory\t\tList local variables stored in the symbol table\n"
-            "retrieve\t\tRetrieve a global or local tree structure as an object - NOT YET IMPLEMENTED\n"
-            "update\t\t\tStore an object as a global or local tree structure - NOT YET IMPLEMENTED\n\n"
-            "For more information about each method, call help with the method name as an argument\n"
-            << endl;
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
     }
 
-    info.GetReturnValue().Set(new_string_n(isolate, "NodeM - Copyright (C) 2012-2024 Fourth Watch Software LC"));
+    string gvn;
+
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
+
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   n: ", size);
+        debug_log(">>   method: ", method == DESCENT ? "descent" : "reservoir");
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->option = size;
+    nodem_baton->info = method;
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::sample;
+    nodem_baton->ret_function = &nodem::sample;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::sample exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into sample");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sample exit\n");
+
     return;
-} // @end nodem::Nodem::help method
+} // @end nodem::Nodem::sample method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::version
- * @summary Return the about/version string
+ * @method nodem::Nodem::sorter_write
+ * @summary Write a batch of sort records under their keys, in a worker thread when called asynchronously
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::version(const FunctionCallbackInfo<Value>& info)
+void Nodem::sorter_write(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
-    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_write enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
+
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
+
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
+    }
+
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        if (local) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        }
+
+        return;
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        if (local) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
+        } else {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
+        }
+
+        return;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    Local<Value> keys = get_n(isolate, arg_object, new_string_n(isolate, "keys"));
+    Local<Value> records = get_n(isolate, arg_object, new_string_n(isolate, "records"));
+
+    if (!keys->IsArray() || !records->IsArray() || Local<Array>::Cast(keys)->Length() != Local<Array>::Cast(records)->Length()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+          "Properties 'keys' and 'records' must be arrays of the same length")));
+        return;
+    }
+
+    bool error = false;
+    vector<string> keys_array = build_subscripts(keys, error, nodem_state);
+
+    if (error) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Keys contain invalid data")));
+        return;
+    }
+
+    vector<string> records_array = build_subscripts(records, error, nodem_state);
+
+    if (error) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Records contain invalid data")));
+        return;
+    }
+
+    double sequence = 0;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "sequence"))) {
+        Local<Value> sequence_value = get_n(isolate, arg_object, new_string_n(isolate, "sequence"));
+
+        if (!sequence_value->IsNumber() || number_value_n(isolate, sequence_value) < 0) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'sequence' must be a non-negative number")));
+            return;
+        }
+
+        sequence = floor(number_value_n(isolate, sequence_value));
+    }
+
+    const char* name_msg;
+    Local<Value> name;
+
+    if (local) {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   local: ";
+        name = localize_name(glvn, nodem_state);
+
+        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
+    } else {
+        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+            return;
+        }
+
+        name_msg = ">>   global: ";
+        name = globalize_name(glvn, nodem_state);
+    }
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::version enter");
+    string gvn;
 
-    bool async = false;
+    if (nodem_state->utf8 == true) {
+        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+    } else {
+        NodemValue nodem_name {name};
+        gvn = nodem_name.to_byte();
+    }
 
-    if (info[0]->IsFunction()) {
-        async = true;
+    if (nodem_state->debug > LOW) {
+        debug_log(name_msg, gvn);
 
-        if (nodem_state->tp_level > 0) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
-            return;
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
         }
+
+        debug_log(">>   count: ", keys_array.size());
+        debug_log(">>   sequence: ", sequence);
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[0]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -3705,37 +10009,44 @@ void Nodem::version(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = NODEM_VERSION;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->to_subs_array = std::move(keys_array);
+    nodem_baton->values_array = std::move(records_array);
+    nodem_baton->option = sequence;
+    nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-    nodem_baton->nodem_function = &gtm::version;
-    nodem_baton->ret_function = &nodem::version;
+    nodem_baton->nodem_function = &ydb::sorter_write;
+    nodem_baton->ret_function = &nodem::sorter_write;
     nodem_baton->nodem_state = nodem_state;
 
-    if (nodem_state->debug > OFF) debug_log(">  call into ", NODEM_DB);
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::version exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_write exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
-    if (nodem_state->debug > OFF) debug_log(">  return from ", NODEM_DB);
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-    if (nodem_baton->status != EXIT_SUCCESS) {
-        isolate->ThrowException(Exception::Error(to_string_n(isolate, error_status(nodem_baton->error, true, async, nodem_state))));
-        info.GetReturnValue().Set(Undefined(isolate));
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -3743,34 +10054,36 @@ void Nodem::version(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into version");
+    if (nodem_state->debug > LOW) debug_log(">>   call into sorter_write");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::version exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_write exit\n");
 
     return;
-} // @end nodem::Nodem::version
+} // @end nodem::Nodem::sorter_write method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::data
- * @summary Check if global or local node has data and/or children or not
+ * @method nodem::Nodem::sorter_read
+ * @summary Read the next page of sort records, in key order, in a worker thread when called asynchronously
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::data(const FunctionCallbackInfo<Value>& info)
+void Nodem::sorter_read(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::data enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_read enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -3784,7 +10097,7 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -3794,50 +10107,24 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
         return;
     }
 
-    Local<Value> glvn;
-    Local<Value> subscripts = Undefined(isolate);
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
     bool local = false;
-    bool position = false;
-
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
-
-        if (glvn->IsUndefined()) {
-            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
-            local = true;
-        }
-
-        if (glvn->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
-            return;
-        }
-
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-    } else {
-        glvn = info[0];
-
-        if (args_cnt > 1) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
-
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
-            }
-
-            subscripts = temp_subscripts;
-        }
 
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
     }
 
-    if (!glvn->IsString()) {
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
         if (local) {
             isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
         } else {
@@ -3855,13 +10142,10 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    Local<Value> subs = Undefined(isolate);
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
     vector<string> subs_array;
 
-    if (subscripts->IsUndefined()) {
-        subs = String::Empty(isolate);
-    } else if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
+    if (subscripts->IsArray()) {
         bool error = false;
         subs_array = build_subscripts(subscripts, error, nodem_state);
 
@@ -3869,17 +10153,37 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
             return;
         }
-#else
-        subs = encode_arguments(subscripts, nodem_state);
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
 
-        if (subs->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+    double limit = SCAN_LIMIT;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "limit"))) {
+        Local<Value> limit_value = get_n(isolate, arg_object, new_string_n(isolate, "limit"));
+
+        if (!limit_value->IsUint32() || uint32_value_n(isolate, limit_value) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'limit' must be a positive integer")));
+            return;
+        }
+
+        limit = static_cast<double>(uint32_value_n(isolate, limit_value));
+    }
+
+    Local<Value> next = get_n(isolate, arg_object, new_string_n(isolate, "next"));
+    vector<string> next_array;
+
+    if (!next->IsUndefined() && !next->IsNull()) {
+        bool error = !next->IsArray();
+
+        if (!error) next_array = build_subscripts(next, error, nodem_state);
+
+        if (error || next_array.size() != 2) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+              "Property 'next' must be a position returned by sorterRead")));
             return;
         }
-#endif
-    } else {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
-        return;
     }
 
     const char* name_msg;
@@ -3908,43 +10212,40 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
         name = globalize_name(glvn, nodem_state);
     }
 
-    string gvn, sub;
+    string gvn;
 
     if (nodem_state->utf8 == true) {
         gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
     } else {
         NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-
         gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
     }
 
     if (nodem_state->debug > LOW) {
         debug_log(name_msg, gvn);
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
-            }
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   limit: ", limit);
+
+        for (unsigned int i = 0; i < next_array.size(); i++) {
+            debug_log(">>   next[", i, "]: ", next_array[i]);
         }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -3955,45 +10256,33 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->to_subs_array = std::move(next_array);
+    nodem_baton->option = limit;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
-    nodem_baton->position = position;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::data;
-#else
-    nodem_baton->nodem_function = &gtm::data;
-#endif
-    nodem_baton->ret_function = &nodem::data;
+    nodem_baton->nodem_function = &ydb::sorter_read;
+    nodem_baton->ret_function = &nodem::sorter_read;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::data exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_read exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4003,16 +10292,7 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
     } else if (nodem_baton->status != YDB_OK) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error( to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4020,34 +10300,36 @@ void Nodem::data(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into data");
+    if (nodem_state->debug > LOW) debug_log(">>   call into sorter_read");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::data exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sorter_read exit\n");
 
     return;
-} // @end nodem::Nodem::data method
+} // @end nodem::Nodem::sorter_read method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::get
- * @summary Get data from a global or local node, or an intrinsic special variable
+ * @method nodem::Nodem::bloom
+ * @summary Build a Bloom filter over the keys at one level under a node, so that data and get answer for missing keys without the database
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::get(const FunctionCallbackInfo<Value>& info)
+void Nodem::bloom(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::get enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::bloom enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -4061,7 +10343,7 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -4071,50 +10353,24 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
         return;
     }
 
-    Local<Value> glvn;
-    Local<Value> subscripts = Undefined(isolate);
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
     bool local = false;
-    bool position = false;
-
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
-
-        if (glvn->IsUndefined()) {
-            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
-            local = true;
-        }
-
-        if (glvn->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
-            return;
-        }
 
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-    } else {
-        glvn = info[0];
-
-        if (args_cnt > 1) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
-
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
-            }
-
-            subscripts = temp_subscripts;
-        }
-
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
     }
 
-    if (!glvn->IsString()) {
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
         if (local) {
             isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
         } else {
@@ -4132,13 +10388,10 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    Local<Value> subs = Undefined(isolate);
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
     vector<string> subs_array;
 
-    if (subscripts->IsUndefined()) {
-        subs = String::Empty(isolate);
-    } else if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
+    if (subscripts->IsArray()) {
         bool error = false;
         subs_array = build_subscripts(subscripts, error, nodem_state);
 
@@ -4146,17 +10399,42 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
             return;
         }
-#else
-        subs = encode_arguments(subscripts, nodem_state);
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
 
-        if (subs->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+    unsigned int level = subs_array.size() + 1;
+    Local<Value> level_value = get_n(isolate, arg_object, new_string_n(isolate, "level"));
+
+    if (level_value->IsNumber() && number_value_n(isolate, level_value) == uint32_value_n(isolate, level_value) &&
+      uint32_value_n(isolate, level_value) > subs_array.size() && uint32_value_n(isolate, level_value) <= YDB_MAX_SUBS) {
+        level = uint32_value_n(isolate, level_value);
+    } else if (!level_value->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+          "Property 'level' must be a subscript level below the last subscript")));
+        return;
+    }
+
+    double bits_per_key = BLOOM_BITS_PER_KEY;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "bitsPerKey"))) {
+        Local<Value> bits_value = get_n(isolate, arg_object, new_string_n(isolate, "bitsPerKey"));
+
+        if (!bits_value->IsNumber() || number_value_n(isolate, bits_value) < 1 ||
+          number_value_n(isolate, bits_value) > BLOOM_MAX_BITS) {
+            isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+              "Property 'bitsPerKey' must be a number from 1 to " NODEM_STRING(BLOOM_MAX_BITS))));
             return;
         }
-#endif
-    } else {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
-        return;
+
+        bits_per_key = uint32_value_n(isolate, bits_value);
+    }
+
+    bool drop = false;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "drop"))) {
+        drop = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "drop")));
     }
 
     const char* name_msg;
@@ -4185,43 +10463,44 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
         name = globalize_name(glvn, nodem_state);
     }
 
-    string gvn, sub;
+    string gvn;
 
     if (nodem_state->utf8 == true) {
         gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
     } else {
         NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-
         gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
+    }
+
+    if (gvn.compare(0, 2, "^[") == 0 || gvn.compare(0, 2, "^|") == 0 || shard_find(gvn)) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate,
+          "Bloom filters are not supported with extended references or sharded globals")));
+        return;
     }
 
     if (nodem_state->debug > LOW) {
         debug_log(name_msg, gvn);
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
-            }
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
         }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
+
+        debug_log(">>   level: ", level);
+        debug_log(">>   bitsPerKey: ", bits_per_key);
+        debug_log(">>   drop: ", boolalpha, drop);
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -4232,45 +10511,34 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->info = level;
+    nodem_baton->option = bits_per_key;
+    nodem_baton->node_only = drop;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
-    nodem_baton->position = position;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::get;
-#else
-    nodem_baton->nodem_function = &gtm::get;
-#endif
-    nodem_baton->ret_function = &nodem::get;
+    nodem_baton->nodem_function = &ydb::bloom;
+    nodem_baton->ret_function = &nodem::bloom;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::get exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::bloom exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4279,18 +10547,8 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
 
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
-    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_ERR_GVUNDEF && nodem_baton->status != YDB_ERR_LVUNDEF) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4298,34 +10556,36 @@ void Nodem::get(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into get");
+    if (nodem_state->debug > LOW) debug_log(">>   call into bloom");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::get exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::bloom exit\n");
 
     return;
-} // @end nodem::Nodem::get method
+} // @end nodem::Nodem::bloom method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::set
- * @summary Set a global or local node, or an intrinsic special variable
+ * @method nodem::Nodem::define_aggregate
+ * @summary Keep count and sum totals of a global in another global, updated by each write through Nodem in the same transaction
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::set(const FunctionCallbackInfo<Value>& info)
+void Nodem::define_aggregate(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::set enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::define_aggregate enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -4339,7 +10599,7 @@ void Nodem::set(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -4349,198 +10609,135 @@ void Nodem::set(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
         return;
     }
 
-    Local<Value> glvn;
-    Local<Value> subscripts = Undefined(isolate);
-    Local<Value> data_value;
-    bool local = false;
-    bool position = false;
-
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
-
-        if (glvn->IsUndefined()) {
-            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
-            local = true;
-        }
-
-        if (glvn->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
-            return;
-        }
-
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-        data_value = get_n(isolate, arg_object, new_string_n(isolate, "data"));
-    } else {
-        if (args_cnt < 2) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
-            return;
-        }
-
-        glvn = info[0];
-        data_value = info[args_cnt - 1];
-
-        if (args_cnt > 2) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 2);
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> source = get_n(isolate, arg_object, new_string_n(isolate, "source"));
+    Local<Value> target = get_n(isolate, arg_object, new_string_n(isolate, "target"));
 
-            for (unsigned int i = 1; i < args_cnt - 1; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
-            }
+    bool drop = false;
 
-            subscripts = temp_subscripts;
-        }
+    if (has_n(isolate, arg_object, new_string_n(isolate, "drop"))) {
+        drop = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "drop")));
+    }
 
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
+    if (target->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'target' property")));
+        return;
+    } else if (!target->IsString() || target->StrictEquals(new_string_n(isolate, ""))) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'target' must be a non-empty string")));
+        return;
+    } else if (!source->IsUndefined() && (!source->IsString() || source->StrictEquals(new_string_n(isolate, "")))) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'source' must be a non-empty string")));
+        return;
     }
 
-    if (!glvn->IsString()) {
-        if (local) {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
-        } else {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
-        }
+    string target_name = *(UTF8_VALUE_TEMP_N(isolate, globalize_name(target, nodem_state)));
+    string source_name = source->IsUndefined() ? "" : *(UTF8_VALUE_TEMP_N(isolate, globalize_name(source, nodem_state)));
 
-        return;
-    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
-        if (local) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
-        } else {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
-        }
+    // Without a source, the definition kept in the target is only shown, along with whether it is stale
+    bool define = !drop && !source->IsUndefined();
 
+    if (invalid_name(target_name.c_str()) || target_name.compare(0, 2, "^[") == 0 || target_name.compare(0, 2, "^|") == 0) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'target' is an invalid name")));
+        return;
+    } else if (define && (invalid_name(source_name.c_str()) || source_name.compare(0, 2, "^[") == 0 ||
+      source_name.compare(0, 2, "^|") == 0)) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'source' is an invalid name")));
+        return;
+    } else if (define && source_name == target_name) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Properties 'source' and 'target' must be different globals")));
+        return;
+    } else if (define && (shard_find(source_name) || shard_find(target_name))) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Aggregates are not supported with sharded globals")));
         return;
     }
 
-    Local<Value> subs = Undefined(isolate);
-    vector<string> subs_array;
+    unsigned int group_level = 0;
+    unsigned int value_level = 1;
+    vector<string> ops;
 
-    if (subscripts->IsUndefined()) {
-        subs = String::Empty(isolate);
-    } else if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
-        bool error = false;
-        subs_array = build_subscripts(subscripts, error, nodem_state);
+    if (define) {
+        Local<Value> value_value = get_n(isolate, arg_object, new_string_n(isolate, "valueLevel"));
 
-        if (error) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+        if (value_value->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'valueLevel' property")));
             return;
-        }
-#else
-        subs = encode_arguments(subscripts, nodem_state);
-
-        if (subs->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+        } else if (!value_value->IsUint32() || uint32_value_n(isolate, value_value) < 1 ||
+          uint32_value_n(isolate, value_value) > YDB_MAX_SUBS) {
+            isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+              "Property 'valueLevel' must be an integer from 1 to " NODEM_STRING(YDB_MAX_SUBS))));
             return;
         }
-#endif
-    } else {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
-        return;
-    }
 
-    if (data_value->IsUndefined()) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'data' property")));
-        return;
-    }
+        value_level = uint32_value_n(isolate, value_value);
 
-    Local<Value> data_node;
+        Local<Value> group_value = get_n(isolate, arg_object, new_string_n(isolate, "groupLevel"));
 
-#if NODEM_SIMPLE_API == 1
-    data_node = data_value;
-#else
-    Local<Array> data_array = Array::New(isolate, 1);
-    set_n(isolate, data_array, 0, data_value);
+        // The target has one more subscript than the group, naming each total
+        if (!group_value->IsUndefined()) {
+            if (!group_value->IsUint32() || uint32_value_n(isolate, group_value) > value_level ||
+              uint32_value_n(isolate, group_value) >= YDB_MAX_SUBS) {
+                isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                  "Property 'groupLevel' must be an integer from 0 to 'valueLevel', and less than " NODEM_STRING(YDB_MAX_SUBS))));
+                return;
+            }
 
-    data_node = encode_arguments(data_array, nodem_state);
-#endif
+            group_level = uint32_value_n(isolate, group_value);
+        }
 
-    if (data_node->IsSymbol() || data_node->IsSymbolObject() || data_node->IsObject() ||
-      data_node->IsArray() || data_node->IsUndefined()) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Property 'data' contains invalid data")));
-        return;
-    }
+        Local<Value> ops_value = get_n(isolate, arg_object, new_string_n(isolate, "ops"));
 
-    const char* name_msg;
-    Local<Value> name;
+        if (ops_value->IsUndefined()) {
+            ops = {"count", "sum"};
+        } else if (ops_value->IsArray() && Local<Array>::Cast(ops_value)->Length() > 0) {
+            Local<Array> ops_array = Local<Array>::Cast(ops_value);
 
-    if (local) {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
-            return;
-        }
+            for (unsigned int i = 0; i < ops_array->Length(); i++) {
+                Local<Value> op = get_n(isolate, ops_array, i);
+                string op_name = op->IsString() ? *(UTF8_VALUE_TEMP_N(isolate, op)) : "";
 
-        name_msg = ">>   local: ";
-        name = localize_name(glvn, nodem_state);
+                if (op_name != "count" && op_name != "sum") {
+                    isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                      "Property 'ops' must contain only 'count' and 'sum'")));
+                    return;
+                }
 
-        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
-            return;
-        }
-    } else {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+                if (std::find(ops.begin(), ops.end(), op_name) == ops.end()) ops.push_back(op_name);
+            }
+        } else {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'ops' must contain a non-empty array")));
             return;
         }
-
-        name_msg = ">>   global: ";
-        name = globalize_name(glvn, nodem_state);
     }
 
-    string gvn, sub, value;
-
-    if (nodem_state->utf8 == true) {
-        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
-        value = *(UTF8_VALUE_TEMP_N(isolate, data_node));
-    } else {
-        NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-        NodemValue nodem_data_node {data_node};
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   source: ", source_name);
+        debug_log(">>   target: ", target_name);
+        debug_log(">>   groupLevel: ", group_level);
+        debug_log(">>   valueLevel: ", value_level);
 
-        gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
-        value = nodem_data_node.to_byte();
-    }
+        for (unsigned int i = 0; i < ops.size(); i++) {
+            debug_log(">>   ops[", i, "]: ", ops[i]);
+        }
 
-#if NODEM_SIMPLE_API == 1
-    if (nodem_state->mode == CANONICAL && data_value->IsNumber()) {
-        if (value.substr(0, 2) == "0.") value = value.substr(1, string::npos);
-        if (value.substr(0, 3) == "-0.") value = "-" + value.substr(2, string::npos);
+        debug_log(">>   drop: ", boolalpha, drop);
     }
-#endif
 
-    if (nodem_state->debug > LOW) {
-        debug_log(name_msg, gvn);
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
-            }
-        }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
-        debug_log(">>   data: ", value);
-    }
+    if (adaptive) async = true;
 
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -4551,46 +10748,35 @@ void Nodem::set(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, data_value);
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->value = value;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate));
+    nodem_baton->name = std::move(source_name);
+    nodem_baton->to_name = std::move(target_name);
+    nodem_baton->info = group_level;
+    nodem_baton->option = value_level;
+    nodem_baton->values_array = std::move(ops);
+    nodem_baton->node_only = drop;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
-    nodem_baton->local = local;
-    nodem_baton->position = position;
+    nodem_baton->local = false;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::set;
-#else
-    nodem_baton->nodem_function = &gtm::set;
-#endif
-    nodem_baton->ret_function = &nodem::set;
+    nodem_baton->nodem_function = &ydb::define_aggregate;
+    nodem_baton->ret_function = &nodem::define_aggregate;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::set exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::define_aggregate exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4600,17 +10786,7 @@ void Nodem::set(const FunctionCallbackInfo<Value>& info)
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
     } else if (nodem_baton->status != YDB_OK) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4618,34 +10794,36 @@ void Nodem::set(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into set");
+    if (nodem_state->debug > LOW) debug_log(">>   call into define_aggregate");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::set exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::define_aggregate exit\n");
 
     return;
-} // @end nodem::Nodem::set method
+} // @end nodem::Nodem::define_aggregate method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::kill
- * @summary Kill a global or local, or global or local node, or remove the entire symbol table
+ * @method nodem::Nodem::prune
+ * @summary Kill the nodes at one level of a subtree that match a where expression, in chunks that each commit in a transaction
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::kill(const FunctionCallbackInfo<Value>& info)
+void Nodem::prune(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::prune enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -4659,7 +10837,7 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -4669,53 +10847,24 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    Local<Value> glvn = Undefined(isolate);
-    Local<Value> subscripts = Undefined(isolate);
-    bool local = false;
-    bool position = false;
-    bool node_only = false;
-
-    if (info[0]->IsObject() && !info[0]->IsFunction()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
-
-        if (glvn->IsUndefined()) {
-            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
-            local = true;
-        }
-
-        if (glvn->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
-            return;
-        }
-
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-
-        if (has_n(isolate, arg_object, new_string_n(isolate, "nodeOnly"))) {
-            node_only = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "nodeOnly")));
-        }
-    } else if (args_cnt > 0) {
-        glvn = info[0];
-
-        if (args_cnt > 1) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
-
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
-            }
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
+    }
 
-            subscripts = temp_subscripts;
-        }
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool local = false;
 
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
+    if (glvn->IsUndefined()) {
+        glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+        local = true;
     }
 
-    Local<Value> subs = String::Empty(isolate);
-    vector<string> subs_array;
-
-    if (!glvn->IsUndefined() && !glvn->IsString()) {
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+        return;
+    } else if (!glvn->IsString()) {
         if (local) {
             isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
         } else {
@@ -4731,31 +10880,94 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
         }
 
         return;
-    } else if (glvn->IsUndefined()) {
-        glvn = String::Empty(isolate);
-        local = true;
+    }
+
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+    vector<string> subs_array;
+
+    if (subscripts->IsArray()) {
+        bool error = false;
+        subs_array = build_subscripts(subscripts, error, nodem_state);
+
+        if (error) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            return;
+        }
+    } else if (!subscripts->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+        return;
+    }
+
+    unsigned int level = subs_array.size() + 1;
+    Local<Value> level_value = get_n(isolate, arg_object, new_string_n(isolate, "level"));
+
+    if (level_value->IsNumber() && number_value_n(isolate, level_value) == uint32_value_n(isolate, level_value) &&
+      uint32_value_n(isolate, level_value) > subs_array.size() && uint32_value_n(isolate, level_value) <= YDB_MAX_SUBS) {
+        level = uint32_value_n(isolate, level_value);
+    } else if (!level_value->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+          "Property 'level' must be a subscript level below the last subscript")));
+        return;
+    }
+
+    Local<Value> where_value = get_n(isolate, arg_object, new_string_n(isolate, "where"));
+
+    if (where_value->IsUndefined() || where_value->IsNull()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'where' property")));
+        return;
+    } else if (!where_value->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'where' must be a string")));
+        return;
+    }
+
+    string where;
+    string filter_error;
+
+    if (nodem_state->utf8 == true) {
+        where = *(UTF8_VALUE_TEMP_N(isolate, where_value));
     } else {
-        if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
-            bool error = false;
-            subs_array = build_subscripts(subscripts, error, nodem_state);
+        NodemValue nodem_where {where_value};
+        where = nodem_where.to_byte();
+    }
 
-            if (error) {
-                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
-                return;
-            }
-#else
-            subs = encode_arguments(subscripts, nodem_state);
+    filter_ptr_t filter = filter_compile(where, filter_error);
 
-            if (subs->IsUndefined()) {
-                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
-                return;
-            }
-#endif
-        } else if (!subscripts->IsUndefined()) {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
+    if (!filter) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, ("Property 'where' " + filter_error).c_str())));
+        return;
+    }
+
+    double chunk_size = KILL_CHUNK;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "chunkSize"))) {
+        Local<Value> chunk = get_n(isolate, arg_object, new_string_n(isolate, "chunkSize"));
+
+        if (!chunk->IsUint32() || uint32_value_n(isolate, chunk) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'chunkSize' must be a positive integer")));
+            return;
+        }
+
+        chunk_size = static_cast<double>(uint32_value_n(isolate, chunk));
+    }
+
+    unsigned int limit = 0;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "limit"))) {
+        Local<Value> limit_value = get_n(isolate, arg_object, new_string_n(isolate, "limit"));
+
+        if (!limit_value->IsUint32() || uint32_value_n(isolate, limit_value) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'limit' must be a positive integer")));
             return;
         }
+
+        limit = uint32_value_n(isolate, limit_value);
+    }
+
+    Local<Value> token = get_n(isolate, arg_object, new_string_n(isolate, "token"));
+
+    if (!token->IsUndefined() && !token->IsNull() && !token->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'token' must be a string")));
+        return;
     }
 
     const char* name_msg;
@@ -4784,43 +10996,70 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
         name = globalize_name(glvn, nodem_state);
     }
 
-    string gvn, sub;
+    string gvn;
 
     if (nodem_state->utf8 == true) {
         gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
     } else {
         NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-
         gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
+    }
+
+    // Each chunk commits in one transaction on one global directory, so the walk cannot span regions switched in between
+    if (gvn.compare(0, 2, "^[") == 0 || gvn.compare(0, 2, "^|") == 0 || shard_find(gvn)) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate,
+          "Prune is not supported with extended references or sharded globals")));
+        return;
     }
 
     if (nodem_state->debug > LOW) {
         debug_log(name_msg, gvn);
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
+        }
+
+        debug_log(">>   level: ", level);
+        debug_log(">>   where: ", where);
+        debug_log(">>   chunkSize: ", chunk_size);
+        debug_log(">>   limit: ", limit);
+    }
+
+    vector<string> start;
+
+    if (token->IsString() && !token->StrictEquals(new_string_n(isolate, ""))) {
+        vector<string> token_scope = subs_array;
+        string key;
+
+        token_scope.push_back(std::to_string(level));
+        token_scope.push_back(where);
+
+        // A resume path is one subscript per level walked, down to the prune level at the deepest
+        if (!token_decode(*(UTF8_VALUE_TEMP_N(isolate, token)), gvn, token_scope, false, key) || !token_split(key, start) ||
+          start.empty() || start.size() > level - subs_array.size()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+              "Property 'token' is not a continuation token for this prune")));
+            return;
+        }
+
+        if (nodem_state->debug > LOW) {
+            for (unsigned int i = 0; i < start.size(); i++) {
+                debug_log(">>   start[", i, "]: ", start[i]);
             }
         }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -4831,46 +11070,38 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->to_subs_array = std::move(start);
+    nodem_baton->value = std::move(where);
+    nodem_baton->data_array = vector<unsigned int> {limit};
+    nodem_baton->info = level;
+    nodem_baton->option = chunk_size;
+    nodem_baton->filter = std::move(filter);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
-    nodem_baton->position = position;
-    nodem_baton->node_only = node_only;
+    nodem_baton->position = false;
+    nodem_baton->node_only = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::kill;
-#else
-    nodem_baton->nodem_function = &gtm::kill;
-#endif
-    nodem_baton->ret_function = &nodem::kill;
+    nodem_baton->nodem_function = &ydb::prune;
+    nodem_baton->ret_function = &nodem::prune;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::kill exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::prune exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4880,17 +11111,7 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
     } else if (nodem_baton->status != YDB_OK) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -4898,34 +11119,40 @@ void Nodem::kill(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into kill");
+    if (nodem_state->debug > LOW) debug_log(">>   call into prune");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::kill exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::prune exit\n");
 
     return;
-} // @end nodem::Nodem::kill method
+} // @end nodem::Nodem::prune method
+#endif
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::merge
- * @summary Merge a global or local array tree to another global or local array tree
+ * @method nodem::Nodem::move
+ * @summary Move a global or local tree to another one, atomically, so that its data is never in both places or in neither
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::merge(const FunctionCallbackInfo<Value>& info)
+void Nodem::move(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::merge enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::move enter");
+
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
 
     if (nodem_state_g < OPEN) {
         isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
@@ -4935,7 +11162,7 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -4945,11 +11172,8 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an argument")));
-        return;
-    } else if (!info[0]->IsObject()) {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
         return;
     }
 
@@ -5025,20 +11249,19 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
     }
 
     Local<Value> from_subscripts = get_n(isolate, from, new_string_n(isolate, "subscripts"));
-    Local<Value> from_subs = Undefined(isolate);
+    vector<string> from_subs_array;
 
-    if (from_subscripts->IsUndefined()) {
-        from_subs = String::Empty(isolate);
-    } else if (from_subscripts->IsArray()) {
-        from_subs = encode_arguments(from_subscripts, nodem_state);
+    if (from_subscripts->IsArray()) {
+        bool error = false;
+        from_subs_array = build_subscripts(from_subscripts, error, nodem_state);
 
-        if (from_subs->IsUndefined()) {
+        if (error) {
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
                      "Property 'subscripts' in 'from' object contains invalid data")));
 
             return;
         }
-    } else {
+    } else if (!from_subscripts->IsUndefined()) {
         isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
                  "Property 'subscripts' in 'from' must contain an array")));
 
@@ -5046,24 +11269,42 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
     }
 
     Local<Value> to_subscripts = get_n(isolate, to, new_string_n(isolate, "subscripts"));
-    Local<Value> to_subs = Undefined(isolate);
+    vector<string> to_subs_array;
 
-    if (to_subscripts->IsUndefined()) {
-        to_subs = String::Empty(isolate);
-    } else if (to_subscripts->IsArray()) {
-        to_subs = encode_arguments(to_subscripts, nodem_state);
+    if (to_subscripts->IsArray()) {
+        bool error = false;
+        to_subs_array = build_subscripts(to_subscripts, error, nodem_state);
 
-        if (to_subs->IsUndefined()) {
+        if (error) {
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
                      "Property 'subscripts' in 'to' object contains invalid data")));
 
             return;
         }
-    } else {
+    } else if (!to_subscripts->IsUndefined()) {
         isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' in 'to' must contain an array")));
         return;
     }
 
+    double chunk_size = KILL_CHUNK;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "chunkSize"))) {
+        Local<Value> chunk = get_n(isolate, arg_object, new_string_n(isolate, "chunkSize"));
+
+        if (!chunk->IsUint32() || uint32_value_n(isolate, chunk) < 1) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'chunkSize' must be a positive integer")));
+            return;
+        }
+
+        chunk_size = static_cast<double>(uint32_value_n(isolate, chunk));
+    }
+
+    bool chunked = false;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "chunked"))) {
+        chunked = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "chunked")));
+    }
+
     const char* from_name_msg;
     Local<Value> from_name;
 
@@ -5116,49 +11357,55 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
         to_name = globalize_name(to_glvn, nodem_state);
     }
 
-    string from_gvn, from_sub, to_gvn, to_sub;
+    string from_gvn, to_gvn;
 
     if (nodem_state->utf8 == true) {
         from_gvn = *(UTF8_VALUE_TEMP_N(isolate, from_name));
-        from_sub = *(UTF8_VALUE_TEMP_N(isolate, from_subs));
         to_gvn = *(UTF8_VALUE_TEMP_N(isolate, to_name));
-        to_sub = *(UTF8_VALUE_TEMP_N(isolate, to_subs));
+    } else {
+        NodemValue nodem_from_name {from_name};
+        NodemValue nodem_to_name {to_name};
 
-        if (nodem_state->debug > LOW) {
-            debug_log(from_name_msg, from_gvn);
-            debug_log(">>   from_subscripts: ", from_sub);
-            debug_log(to_name_msg, to_gvn);
-            debug_log(">>   to_subscripts: ", to_sub);
+        from_gvn = nodem_from_name.to_byte();
+        to_gvn = nodem_to_name.to_byte();
+    }
+
+    // Each transaction uses one global directory, so both trees have to be in the current one
+    if (from_gvn.compare(0, 2, "^[") == 0 || from_gvn.compare(0, 2, "^|") == 0 || shard_find(from_gvn) ||
+      to_gvn.compare(0, 2, "^[") == 0 || to_gvn.compare(0, 2, "^|") == 0 || shard_find(to_gvn)) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate,
+          "Move is not supported with extended references or sharded globals")));
+        return;
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(from_name_msg, from_gvn);
+
+        for (unsigned int i = 0; i < from_subs_array.size(); i++) {
+            debug_log(">>   from_subscripts[", i, "]: ", from_subs_array[i]);
         }
-    } else {
-        NodemValue gtm_from_name {from_name};
-        NodemValue gtm_from_subs {from_subs};
-        NodemValue gtm_to_name {to_name};
-        NodemValue gtm_to_subs {to_subs};
 
-        from_gvn = gtm_from_name.to_byte();
-        from_sub = gtm_from_subs.to_byte();
-        to_gvn = gtm_to_name.to_byte();
-        to_sub = gtm_to_subs.to_byte();
+        debug_log(to_name_msg, to_gvn);
 
-        if (nodem_state->debug > LOW) {
-            debug_log(from_name_msg, from_gvn);
-            debug_log(">>   from_subscripts: ", from_sub);
-            debug_log(to_name_msg, to_gvn);
-            debug_log(">>   to_subscripts: ", to_sub);
+        for (unsigned int i = 0; i < to_subs_array.size(); i++) {
+            debug_log(">>   to_subscripts[", i, "]: ", to_subs_array[i]);
         }
+
+        debug_log(">>   chunkSize: ", chunk_size);
+        debug_log(">>   chunked: ", boolalpha, chunked);
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -5169,42 +11416,46 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->object_p.Reset(isolate, arg_object);
-    nodem_baton->arguments_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = from_gvn;
-    nodem_baton->args = from_sub;
-    nodem_baton->to_name = to_gvn;
-    nodem_baton->to_args = to_sub;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate), arg_object);
+    nodem_baton->name = std::move(from_gvn);
+    nodem_baton->to_name = std::move(to_gvn);
+    nodem_baton->subs_array = std::move(from_subs_array);
+    nodem_baton->to_subs_array = std::move(to_subs_array);
+    nodem_baton->option = chunk_size;
+    nodem_baton->atomic = !chunked;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = from_local;
-    nodem_baton->status = 0;
-    nodem_baton->nodem_function = &gtm::merge;
-    nodem_baton->ret_function = &nodem::merge;
+    nodem_baton->position = false;
+    nodem_baton->node_only = false;
+    nodem_baton->status = 0;
+    nodem_baton->nodem_function = &ydb::move;
+    nodem_baton->ret_function = &nodem::move;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::merge exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::move exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-    if (nodem_baton->status != EXIT_SUCCESS) {
+    if (nodem_baton->status == -1) {
+        nodem_baton->object_p.Reset();
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != YDB_OK) {
         info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->object_p.Reset();
@@ -5214,9 +11465,9 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into merge");
+    if (nodem_state->debug > LOW) debug_log(">>   call into move");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->object_p.Reset();
     nodem_baton->arguments_p.Reset();
@@ -5224,25 +11475,42 @@ void Nodem::merge(const FunctionCallbackInfo<Value>& info)
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::merge exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::move exit\n");
 
     return;
-} // @end nodem::Nodem::merge method
+} // @end nodem::Nodem::move method
+#endif
 
 /*
- * @method nodem::Nodem::order
- * @summary Return the next global or local node at the same level
+ * @method nodem::Nodem::next_node_deprecated
+ * @summary Calls nodem::next_node after logging that this method is deprecated
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::order(const FunctionCallbackInfo<Value>& info)
+void Nodem::next_node_deprecated(const FunctionCallbackInfo<Value>& info)
+{
+    if (reinterpret_cast<NodemState*>(info.Data().As<External>()->Value())->debug > OFF || !(deprecated_g & NEXT)) {
+        deprecated_g |= NEXT;
+        debug_log(">  next_node [DEPRECATED - Use nextNode instead]");
+    }
+
+    return Nodem::next_node(info);
+}
+
+/*
+ * @method nodem::Nodem::next_node
+ * @summary Return the next global or local node, depth first
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::order enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -5407,16 +11675,17 @@ void Nodem::order(const FunctionCallbackInfo<Value>& info)
 #endif
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -5427,41 +11696,34 @@ void Nodem::order(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
     nodem_baton->position = position;
     nodem_baton->status = 0;
 #if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::order;
+    nodem_baton->nodem_function = &ydb::next_node;
 #else
-    nodem_baton->nodem_function = &gtm::order;
+    nodem_baton->nodem_function = &gtm::next_node;
 #endif
-    nodem_baton->ret_function = &nodem::order;
+    nodem_baton->ret_function = &nodem::next_node;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
     if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::order exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -5493,34 +11755,50 @@ void Nodem::order(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into order");
+    if (nodem_state->debug > LOW) debug_log(">>   call into next_node");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::order exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node exit\n");
 
     return;
-} // @end nodem::Nodem::order method
+} // @end nodem::Nodem::next_node method
 
 /*
- * @method nodem::Nodem::previous
- * @summary Return the previous global or local node at the same level
+ * @method nodem::Nodem::previous_node_deprecated
+ * @summary Calls nodem::previous_node after logging that this method is deprecated
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::previous(const FunctionCallbackInfo<Value>& info)
+void Nodem::previous_node_deprecated(const FunctionCallbackInfo<Value>& info)
+{
+    if (reinterpret_cast<NodemState*>(info.Data().As<External>()->Value())->debug > OFF || !(deprecated_g & PREVIOUS)) {
+        deprecated_g |= PREVIOUS;
+        debug_log(">  previous_node [DEPRECATED - Use previousNode instead]");
+    }
+
+    return Nodem::previous_node(info);
+}
+
+/*
+ * @method nodem::Nodem::previous_node
+ * @summary Same as Nodem::next_node, only in reverse
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -5685,16 +11963,17 @@ void Nodem::previous(const FunctionCallbackInfo<Value>& info)
 #endif
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -5705,41 +11984,34 @@ void Nodem::previous(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, Undefined(isolate), Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
     nodem_baton->position = position;
     nodem_baton->status = 0;
 #if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::previous;
+    nodem_baton->nodem_function = &ydb::previous_node;
 #else
-    nodem_baton->nodem_function = &gtm::previous;
+    nodem_baton->nodem_function = &gtm::previous_node;
 #endif
-    nodem_baton->ret_function = &nodem::previous;
+    nodem_baton->ret_function = &nodem::previous_node;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
     if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::previous exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -5771,50 +12043,34 @@ void Nodem::previous(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into previous");
+    if (nodem_state->debug > LOW) debug_log(">>   call into previous_node");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node exit\n");
 
     return;
-} // @end nodem::Nodem::previous method
-
-/*
- * @method nodem::Nodem::next_node_deprecated
- * @summary Calls nodem::next_node after logging that this method is deprecated
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
- * @returns {void}
- */
-void Nodem::next_node_deprecated(const FunctionCallbackInfo<Value>& info)
-{
-    if (reinterpret_cast<NodemState*>(info.Data().As<External>()->Value())->debug > OFF || !(deprecated_g & NEXT)) {
-        deprecated_g |= NEXT;
-        debug_log(">  next_node [DEPRECATED - Use nextNode instead]");
-    }
-
-    return Nodem::next_node(info);
-}
+} // @end nodem::Nodem::previous_node method
 
 /*
- * @method nodem::Nodem::next_node
- * @summary Return the next global or local node, depth first
+ * @method nodem::Nodem::increment
+ * @summary Increment or decrement the number in a global or local node
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
+void Nodem::increment(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::increment enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -5845,6 +12101,7 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
 
     Local<Value> glvn;
     Local<Value> subscripts = Undefined(isolate);
+    Local<Value> increment = Number::New(isolate, 1);
     bool local = false;
     bool position = false;
 
@@ -5863,6 +12120,26 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
         }
 
         subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "increment"))) {
+            increment = get_n(isolate, arg_object, new_string_n(isolate, "increment"));
+        } else if (args_cnt > 1) {
+            increment = info[1];
+
+            if (!increment->IsUndefined() && !(deprecated_g & INCREMENT)) {
+                deprecated_g |= INCREMENT;
+                debug_log(">>   increment by-position [DEPRECATED - Use increment property instead]");
+            }
+        }
+
+        // Make sure JavaScript numbers that M won't recognize are changed to 0
+        string test = *(UTF8_VALUE_TEMP_N(isolate, increment));
+
+        if (!all_of(test.begin(), test.end(), [](char c) {return (isdigit(c) || c == '-' || c == '.');})) {
+            increment = Number::New(isolate, 0);
+        } else if (!increment->IsNumber()) {
+            increment = Number::New(isolate, 0);
+        }
     } else {
         glvn = info[0];
 
@@ -5977,18 +12254,21 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
 #else
         debug_log(">>   subscripts: ", sub);
 #endif
+
+        debug_log(">>   increment: ", number_value_n(isolate, increment));
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -5999,41 +12279,35 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->option = number_value_n(isolate, increment);
+    nodem_baton->subs_array = std::move(subs_array);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
     nodem_baton->position = position;
     nodem_baton->status = 0;
 #if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::next_node;
+    nodem_baton->nodem_function = &ydb::increment;
 #else
-    nodem_baton->nodem_function = &gtm::next_node;
+    nodem_baton->nodem_function = &gtm::increment;
 #endif
-    nodem_baton->ret_function = &nodem::next_node;
+    nodem_baton->ret_function = &nodem::increment;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
     if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::increment exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -6046,7 +12320,7 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
 
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
-    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_NODE_END) {
+    } else if (nodem_baton->status != YDB_OK) {
 #else
     if (nodem_baton->status != EXIT_SUCCESS) {
 #endif
@@ -6065,141 +12339,81 @@ void Nodem::next_node(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into next_node");
+    if (nodem_state->debug > LOW) debug_log(">>   call into increment");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::next_node exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::increment exit\n");
 
     return;
-} // @end nodem::Nodem::next_node method
-
-/*
- * @method nodem::Nodem::previous_node_deprecated
- * @summary Calls nodem::previous_node after logging that this method is deprecated
- * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
- * @returns {void}
- */
-void Nodem::previous_node_deprecated(const FunctionCallbackInfo<Value>& info)
-{
-    if (reinterpret_cast<NodemState*>(info.Data().As<External>()->Value())->debug > OFF || !(deprecated_g & PREVIOUS)) {
-        deprecated_g |= PREVIOUS;
-        debug_log(">  previous_node [DEPRECATED - Use previousNode instead]");
-    }
-
-    return Nodem::previous_node(info);
-}
+} // @end nodem::Nodem::increment method
 
+#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::previous_node
- * @summary Same as Nodem::next_node, only in reverse
+ * @method nodem::Nodem::striped_counter
+ * @summary Increment or read a counter that is spread across stripes, so that busy counters do not become a hot spot
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
+void Nodem::striped_counter(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
-    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
-
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node enter");
-
-#if YDB_RELEASE >= 126
-    reset_handler(nodem_state);
-#endif
-
-    if (nodem_state_g < OPEN) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
-        return;
-    }
-
-    bool async = false;
-    unsigned int args_cnt = info.Length();
-
-    if (info[args_cnt - 1]->IsFunction()) {
-        --args_cnt;
-        async = true;
-
-        if (nodem_state->tp_level > 0) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
-            return;
-        }
-    }
-
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
-        return;
-    }
-
-    Local<Value> glvn;
-    Local<Value> subscripts = Undefined(isolate);
-    bool local = false;
-    bool position = false;
-
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
-
-        if (glvn->IsUndefined()) {
-            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
-            local = true;
-        }
-
-        if (glvn->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
-            return;
-        }
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-    } else {
-        glvn = info[0];
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::striped_counter enter");
 
-        if (args_cnt > 1) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+#if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#endif
 
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
-            }
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
 
-            subscripts = temp_subscripts;
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
         }
+    }
 
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
+    if (args_cnt == 0 || !info[0]->IsObject() || info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an object argument")));
+        return;
     }
 
-    if (!glvn->IsString()) {
-        if (local) {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
-        } else {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
-        }
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
 
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' property")));
+        return;
+    } else if (!glvn->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
         return;
     } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
-        if (local) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
-        } else {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
-        }
-
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
         return;
     }
 
-    Local<Value> subs = Undefined(isolate);
+    Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
     vector<string> subs_array;
 
-    if (subscripts->IsUndefined()) {
-        subs = String::Empty(isolate);
-    } else if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
+    if (subscripts->IsArray()) {
         bool error = false;
         subs_array = build_subscripts(subscripts, error, nodem_state);
 
@@ -6207,82 +12421,81 @@ void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
             return;
         }
-#else
-        subs = encode_arguments(subscripts, nodem_state);
-
-        if (subs->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
-            return;
-        }
-#endif
-    } else {
+    } else if (!subscripts->IsUndefined()) {
         isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
         return;
     }
 
-    const char* name_msg;
-    Local<Value> name;
+    if (subs_array.size() >= YDB_MAX_SUBS) {
+        isolate->ThrowException(Exception::RangeError(new_string_n(isolate, "Too many subscripts to add a stripe to")));
+        return;
+    }
 
-    if (local) {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
-            return;
-        }
+    uint32_t stripes = COUNTER_STRIPES;
 
-        name_msg = ">>   local: ";
-        name = localize_name(glvn, nodem_state);
+    if (has_n(isolate, arg_object, new_string_n(isolate, "stripes"))) {
+        Local<Value> stripe_count = get_n(isolate, arg_object, new_string_n(isolate, "stripes"));
 
-        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+        if (!stripe_count->IsUint32() || uint32_value_n(isolate, stripe_count) < 1 ||
+          uint32_value_n(isolate, stripe_count) > COUNTER_MAX_STRIPES) {
+            isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+              "Property 'stripes' must be an integer from 1 to " NODEM_STRING(COUNTER_MAX_STRIPES))));
             return;
         }
-    } else {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+
+        stripes = uint32_value_n(isolate, stripe_count);
+    }
+
+    double increment = 0;
+
+    if (has_n(isolate, arg_object, new_string_n(isolate, "increment"))) {
+        Local<Value> incr = get_n(isolate, arg_object, new_string_n(isolate, "increment"));
+
+        if (!incr->IsNumber()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'increment' must be a number")));
             return;
         }
 
-        name_msg = ">>   global: ";
-        name = globalize_name(glvn, nodem_state);
+        increment = number_value_n(isolate, incr);
     }
 
-    string gvn, sub;
+    if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
+        return;
+    }
+
+    Local<Value> name = globalize_name(glvn, nodem_state);
+    string gvn;
 
     if (nodem_state->utf8 == true) {
         gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
     } else {
         NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-
         gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
     }
 
     if (nodem_state->debug > LOW) {
-        debug_log(name_msg, gvn);
+        debug_log(">>   global: ", gvn);
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
-            }
+        for (unsigned int i = 0; i < subs_array.size(); i++) {
+            debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
         }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
+
+        debug_log(">>   stripes: ", stripes);
+        debug_log(">>   increment: ", increment);
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -6293,45 +12506,33 @@ void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->subs_array = std::move(subs_array);
+    nodem_baton->option = increment;
+    nodem_baton->info = stripes;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
-    nodem_baton->local = local;
-    nodem_baton->position = position;
+    nodem_baton->local = false;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::previous_node;
-#else
-    nodem_baton->nodem_function = &gtm::previous_node;
-#endif
-    nodem_baton->ret_function = &nodem::previous_node;
+    nodem_baton->nodem_function = &ydb::striped_counter;
+    nodem_baton->ret_function = &nodem::striped_counter;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::striped_counter exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -6340,18 +12541,8 @@ void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
 
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
-    } else if (nodem_baton->status != YDB_OK && nodem_baton->status != YDB_NODE_END) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+    } else if (nodem_baton->status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -6359,34 +12550,35 @@ void Nodem::previous_node(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into previous_node");
+    if (nodem_state->debug > LOW) debug_log(">>   call into striped_counter");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::previous_node exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::striped_counter exit\n");
 
     return;
-} // @end nodem::Nodem::previous_node method
+} // @end nodem::Nodem::striped_counter method
+#endif
 
 /*
- * @method nodem::Nodem::increment
- * @summary Increment or decrement the number in a global or local node
+ * @method nodem::Nodem::lock
+ * @summary Lock a global or local node, incrementally
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::increment(const FunctionCallbackInfo<Value>& info)
+void Nodem::lock(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::increment enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -6417,7 +12609,7 @@ void Nodem::increment(const FunctionCallbackInfo<Value>& info)
 
     Local<Value> glvn;
     Local<Value> subscripts = Undefined(isolate);
-    Local<Value> increment = Number::New(isolate, 1);
+    Local<Value> timeout = Number::New(isolate, -1);
     bool local = false;
     bool position = false;
 
@@ -6437,24 +12629,28 @@ void Nodem::increment(const FunctionCallbackInfo<Value>& info)
 
         subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
 
-        if (has_n(isolate, arg_object, new_string_n(isolate, "increment"))) {
-            increment = get_n(isolate, arg_object, new_string_n(isolate, "increment"));
+        if (has_n(isolate, arg_object, new_string_n(isolate, "timeout"))) {
+            timeout = get_n(isolate, arg_object, new_string_n(isolate, "timeout"));
         } else if (args_cnt > 1) {
-            increment = info[1];
+            timeout = info[1];
 
-            if (!increment->IsUndefined() && !(deprecated_g & INCREMENT)) {
-                deprecated_g |= INCREMENT;
-                debug_log(">>   increment by-position [DEPRECATED - Use increment property instead]");
+            if (!timeout->IsUndefined() && !(deprecated_g & TIMEOUT)) {
+                deprecated_g |= TIMEOUT;
+                debug_log(">>   timeout by-position [DEPRECATED - Use timeout property instead]");
             }
         }
 
         // Make sure JavaScript numbers that M won't recognize are changed to 0
-        string test = *(UTF8_VALUE_TEMP_N(isolate, increment));
+        string test = *(UTF8_VALUE_TEMP_N(isolate, timeout));
 
         if (!all_of(test.begin(), test.end(), [](char c) {return (isdigit(c) || c == '-' || c == '.');})) {
-            increment = Number::New(isolate, 0);
-        } else if (!increment->IsNumber()) {
-            increment = Number::New(isolate, 0);
+            if (test == "Infinity") {
+                timeout = Number::New(isolate, -1);
+            } else {
+                timeout = Number::New(isolate, 0);
+            }
+        } else if (!timeout->IsNumber() || number_value_n(isolate, timeout) < -1) {
+            timeout = Number::New(isolate, 0);
         }
     } else {
         glvn = info[0];
@@ -6571,19 +12767,20 @@ void Nodem::increment(const FunctionCallbackInfo<Value>& info)
         debug_log(">>   subscripts: ", sub);
 #endif
 
-        debug_log(">>   increment: ", number_value_n(isolate, increment));
+        debug_log(">>   timeout: ", number_value_n(isolate, timeout));
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -6594,42 +12791,35 @@ void Nodem::increment(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->option = number_value_n(isolate, increment);
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->option = number_value_n(isolate, timeout);
+    nodem_baton->subs_array = std::move(subs_array);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
     nodem_baton->position = position;
     nodem_baton->status = 0;
 #if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::increment;
+    nodem_baton->nodem_function = &ydb::lock;
 #else
-    nodem_baton->nodem_function = &gtm::increment;
+    nodem_baton->nodem_function = &gtm::lock;
 #endif
-    nodem_baton->ret_function = &nodem::increment;
+    nodem_baton->ret_function = &nodem::lock;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
     if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::increment exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::lock exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -6661,34 +12851,34 @@ void Nodem::increment(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into increment");
+    if (nodem_state->debug > LOW) debug_log(">>   call into lock");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::increment exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock exit\n");
 
     return;
-} // @end nodem::Nodem::increment method
+} // @end nodem::Nodem::lock method
 
 /*
- * @method nodem::Nodem::lock
- * @summary Lock a global or local node, incrementally
+ * @method nodem::Nodem::unlock
+ * @summary Unlock a global or local node, incrementally, or release all locks
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::lock(const FunctionCallbackInfo<Value>& info)
+void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock enter");
 
 #if YDB_RELEASE >= 126
     reset_handler(nodem_state);
@@ -6712,18 +12902,12 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
-        return;
-    }
-
-    Local<Value> glvn;
+    Local<Value> glvn = Undefined(isolate);
     Local<Value> subscripts = Undefined(isolate);
-    Local<Value> timeout = Number::New(isolate, -1);
     bool local = false;
     bool position = false;
 
-    if (info[0]->IsObject()) {
+    if (info[0]->IsObject() && !info[0]->IsFunction()) {
         Local<Object> arg_object = to_object_n(isolate, info[0]);
         glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
 
@@ -6738,31 +12922,7 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
         }
 
         subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-
-        if (has_n(isolate, arg_object, new_string_n(isolate, "timeout"))) {
-            timeout = get_n(isolate, arg_object, new_string_n(isolate, "timeout"));
-        } else if (args_cnt > 1) {
-            timeout = info[1];
-
-            if (!timeout->IsUndefined() && !(deprecated_g & TIMEOUT)) {
-                deprecated_g |= TIMEOUT;
-                debug_log(">>   timeout by-position [DEPRECATED - Use timeout property instead]");
-            }
-        }
-
-        // Make sure JavaScript numbers that M won't recognize are changed to 0
-        string test = *(UTF8_VALUE_TEMP_N(isolate, timeout));
-
-        if (!all_of(test.begin(), test.end(), [](char c) {return (isdigit(c) || c == '-' || c == '.');})) {
-            if (test == "Infinity") {
-                timeout = Number::New(isolate, -1);
-            } else {
-                timeout = Number::New(isolate, 0);
-            }
-        } else if (!timeout->IsNumber() || number_value_n(isolate, timeout) < -1) {
-            timeout = Number::New(isolate, 0);
-        }
-    } else {
+    } else if (args_cnt > 0) {
         glvn = info[0];
 
         if (args_cnt > 1) {
@@ -6780,7 +12940,10 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
         if (test[0] != '^') local = true;
     }
 
-    if (!glvn->IsString()) {
+    Local<Value> subs = String::Empty(isolate);
+    vector<string> subs_array;
+
+    if (!glvn->IsUndefined() && !glvn->IsString()) {
         if (local) {
             isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
         } else {
@@ -6794,35 +12957,33 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
         } else {
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
         }
-
-        return;
-    }
-
-    Local<Value> subs = Undefined(isolate);
-    vector<string> subs_array;
-
-    if (subscripts->IsUndefined()) {
-        subs = String::Empty(isolate);
-    } else if (subscripts->IsArray()) {
+
+        return;
+    } else if (glvn->IsUndefined()) {
+        glvn = String::Empty(isolate);
+        local = true;
+    } else {
+        if (subscripts->IsArray()) {
 #if NODEM_SIMPLE_API == 1
-        bool error = false;
-        subs_array = build_subscripts(subscripts, error, nodem_state);
+            bool error = false;
+            subs_array = build_subscripts(subscripts, error, nodem_state);
 
-        if (error) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
-            return;
-        }
+            if (error) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+                return;
+            }
 #else
-        subs = encode_arguments(subscripts, nodem_state);
+            subs = encode_arguments(subscripts, nodem_state);
 
-        if (subs->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+            if (subs->IsUndefined()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+                return;
+            }
+#endif
+        } else if (!subscripts->IsUndefined()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
             return;
         }
-#endif
-    } else {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
-        return;
     }
 
     const char* name_msg;
@@ -6876,20 +13037,19 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
 #else
         debug_log(">>   subscripts: ", sub);
 #endif
-
-        debug_log(">>   timeout: ", number_value_n(isolate, timeout));
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -6900,42 +13060,34 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->option = number_value_n(isolate, timeout);
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, subscripts, Undefined(isolate));
+    nodem_baton->name = std::move(gvn);
+    nodem_baton->args = std::move(sub);
+    nodem_baton->subs_array = std::move(subs_array);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
     nodem_baton->local = local;
     nodem_baton->position = position;
     nodem_baton->status = 0;
 #if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::lock;
+    nodem_baton->nodem_function = &ydb::unlock;
 #else
-    nodem_baton->nodem_function = &gtm::lock;
+    nodem_baton->nodem_function = &gtm::unlock;
 #endif
-    nodem_baton->ret_function = &nodem::lock;
+    nodem_baton->ret_function = &nodem::unlock;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
     if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::lock exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -6967,38 +13119,277 @@ void Nodem::lock(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into lock");
+    if (nodem_state->debug > LOW) debug_log(">>   call into unlock");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock exit\n");
 
     return;
-} // @end nodem::Nodem::lock method
+} // @end nodem::Nodem::unlock method
 
 /*
- * @method nodem::Nodem::unlock
- * @summary Unlock a global or local node, incrementally, or release all locks
+ * @method nodem::Nodem::lock_stats
+ * @summary Return per-resource lock statistics, current lock holders, and lock-order inversions, for this process
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
+void Nodem::lock_stats(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock_stats enter");
 
-#if YDB_RELEASE >= 126
+    bool reset = false;
+
+    if (info[0]->IsObject() && has_n(isolate, to_object_n(isolate, info[0]), new_string_n(isolate, "reset"))) {
+        reset = boolean_value_n(isolate, get_n(isolate, to_object_n(isolate, info[0]), new_string_n(isolate, "reset")));
+    } else if (!info[0]->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   reset: ", boolalpha, reset);
+
+    vector<LockResourceStats> resources;
+    vector<LockInversion> inversions;
+
+    uint64_t dropped = lock_stats_snapshot(resources, inversions, reset);
+
+    Local<Array> resource_array = Array::New(isolate);
+
+    for (unsigned int i = 0; i < resources.size(); i++) {
+        Local<Object> resource = Object::New(isolate);
+        Local<Object> wait_time = Object::New(isolate);
+        Local<Object> histogram = Object::New(isolate);
+        Local<Array> holders = Array::New(isolate);
+
+        for (unsigned int j = 0; j < LOCK_STATS_BUCKETS; j++) {
+            set_n(isolate, histogram, new_string_n(isolate, lock_stats_buckets_g[j]),
+                  Number::New(isolate, resources[i].histogram[j]));
+        }
+
+        set_n(isolate, wait_time, new_string_n(isolate, "total"), Number::New(isolate, resources[i].wait_total / 1e6));
+        set_n(isolate, wait_time, new_string_n(isolate, "max"), Number::New(isolate, resources[i].wait_max / 1e6));
+        set_n(isolate, wait_time, new_string_n(isolate, "histogram"), histogram);
+
+        for (unsigned int j = 0; j < resources[i].holders.size(); j++) {
+            Local<Object> holder = Object::New(isolate);
+
+            set_n(isolate, holder, new_string_n(isolate, "threadId"), Number::New(isolate, resources[i].holders[j].first));
+            set_n(isolate, holder, new_string_n(isolate, "count"), Number::New(isolate, resources[i].holders[j].second));
+            set_n(isolate, holders, j, holder);
+        }
+
+        set_n(isolate, resource, new_string_n(isolate, "resource"), new_string_n(isolate, resources[i].resource.c_str()));
+        set_n(isolate, resource, new_string_n(isolate, "acquisitions"), Number::New(isolate, resources[i].acquisitions));
+        set_n(isolate, resource, new_string_n(isolate, "timeouts"), Number::New(isolate, resources[i].timeouts));
+        set_n(isolate, resource, new_string_n(isolate, "waitTime"), wait_time);
+        set_n(isolate, resource, new_string_n(isolate, "holders"), holders);
+        set_n(isolate, resource_array, i, resource);
+    }
+
+    Local<Array> inversion_array = Array::New(isolate);
+
+    for (unsigned int i = 0; i < inversions.size(); i++) {
+        Local<Object> inversion = Object::New(isolate);
+
+        set_n(isolate, inversion, new_string_n(isolate, "first"), new_string_n(isolate, inversions[i].first.c_str()));
+        set_n(isolate, inversion, new_string_n(isolate, "second"), new_string_n(isolate, inversions[i].second.c_str()));
+        set_n(isolate, inversion, new_string_n(isolate, "count"), Number::New(isolate, inversions[i].count));
+        set_n(isolate, inversion_array, i, inversion);
+    }
+
+    Local<Object> return_object = Object::New(isolate);
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "resources"), resource_array);
+    set_n(isolate, return_object, new_string_n(isolate, "inversions"), inversion_array);
+    set_n(isolate, return_object, new_string_n(isolate, "dropped"), Number::New(isolate, dropped));
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::lock_stats exit\n");
+
+    return;
+} // @end nodem::Nodem::lock_stats method
+
+#if NODEM_SIMPLE_API == 1
+/*
+ * @method nodem::Nodem::transaction
+ * @summary Call a JavaScript function within a YottaDB transaction
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::transaction(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::transaction enter");
+
+#   if YDB_RELEASE >= 126
     reset_handler(nodem_state);
-#endif
+#   endif
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+    unsigned int args_cnt = info.Length();
+    Local<Value> variables = Undefined(isolate);
+
+    ydb_buffer_t vars_array[YDB_MAX_SUBS];
+    unsigned int vars_size;
+    string mode;
+
+    if (args_cnt > 2) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Only two arguments are allowed")));
+        return;
+#   if NODE_MAJOR_VERSION >= 8 || (NODE_MAJOR_VERSION == 7 && NODE_MINOR_VERSION >= 6)
+    } else if (info[0]->IsAsyncFunction()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Async function is not allowed")));
+        return;
+#   endif
+    } else if (!info[0]->IsFunction()) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function is required for first argument")));
+        return;
+    } else {
+        mode = "NODEM";
+        vars_size = 0;
+
+        if (args_cnt == 2) {
+            if (!info[1]->IsObject()) {
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Argument must be an object")));
+                return;
+            } else {
+                Local<Object> arg_object = to_object_n(isolate, info[1]);
+                Local<Value> type = get_n(isolate, arg_object, new_string_n(isolate, "type"));
+
+                if (type->StrictEquals(new_string_n(isolate, "Batch")) || type->StrictEquals(new_string_n(isolate, "batch")) ||
+                    type->StrictEquals(new_string_n(isolate, "BATCH"))) mode = "BATCH";
+
+                variables = get_n(isolate, arg_object, new_string_n(isolate, "variables"));
+
+                if (!variables->IsUndefined() && !variables->IsArray()) {
+                    isolate->ThrowException(Exception::Error(new_string_n(isolate, "Variables must be in an array")));
+                    return;
+                }
+
+                Local<Array> variables_array = Local<Array>::Cast(variables);
+                vars_size = variables_array->Length();
+                string vars_name;
+
+                if (vars_size > YDB_MAX_SUBS) {
+                    isolate->ThrowException(Exception::Error(new_string_n(
+                      isolate, "Max of " NODEM_STRING(YDB_MAX_SUBS) "variables may be passed")));
+
+                    return;
+                }
+
+                if (nodem_state->debug > LOW) debug_log(">>   vars_size: ", vars_size);
+
+                for (unsigned int i = 0; i < vars_size; i++) {
+                    vars_name = *(UTF8_VALUE_TEMP_N(isolate, get_n(isolate, variables_array, i)));
+
+                    if (vars_name[0] == '^' || vars_name[0] == '$') {
+                        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Variables must be local")));
+                        return;
+                    }
+
+                    if (nodem_state->debug > LOW) debug_log(">>   vars_name[", i, "]: ", vars_name[i]);
+
+                    vars_array[i].len_alloc = vars_array[i].len_used = vars_name.length();
+                    vars_array[i].buf_addr = (char*) vars_name.c_str();
+                }
+            }
+        }
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   mode: ", mode);
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    nodem_baton = &new_baton;
+    nodem_baton->request.data = nodem_baton;
+    nodem_baton->callback = Local<Function>::Cast(info[0]);
+    nodem_baton->nodem_state = nodem_state;
+    nodem_baton->error = nodem_state->error;
+
+    if (nodem_state->tp_level == 0) lock_mutex("transaction");
+    if (nodem_state->debug > LOW) debug_log(">>   tp_level: ", nodem_state->tp_level);
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    nodem_state->tp_level++;
+
+    ydb_status_t status = ydb_tp_s(nodem::transaction, nodem_baton, mode.c_str(), vars_size, vars_array);
+
+    nodem_state->tp_level--;
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+    if (nodem_state->debug > LOW) debug_log(">>   tp_level: ", nodem_state->tp_level);
+    if (nodem_state->tp_level == 0) unlock_mutex();
+
+    Local<Object> return_object = Object::New(isolate);
+
+    set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+
+    if (status == YDB_OK) {
+        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
+        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Commit"));
+
+        info.GetReturnValue().Set(return_object);
+    } else if (status == YDB_TP_ROLLBACK) {
+        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
+        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Rollback"));
+
+        info.GetReturnValue().Set(return_object);
+    } else if (status == YDB_TP_RESTART) {
+        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
+        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Restart"));
+
+        info.GetReturnValue().Set(return_object);
+    } else {
+        ydb_zstatus(nodem_baton->error, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, false, nodem_state));
+    }
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::transaction exit\n");
+
+    return;
+} // @end nodem::Nodem::transaction method
+
+/*
+ * @method nodem::Nodem::read_consistent
+ * @summary Read several global or local nodes in one read-only transaction, with no JavaScript run inside it
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::read_consistent(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::read_consistent enter");
+
+#   if YDB_RELEASE >= 126
+    reset_handler(nodem_state);
+#   endif
 
     if (nodem_state_g < OPEN) {
         isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
@@ -7008,7 +13399,7 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -7018,14 +13409,42 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    Local<Value> glvn = Undefined(isolate);
-    Local<Value> subscripts = Undefined(isolate);
-    bool local = false;
-    bool position = false;
+    if (args_cnt == 0 || !info[0]->IsArray()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an array of nodes")));
+        return;
+    }
 
-    if (info[0]->IsObject() && !info[0]->IsFunction()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+    bool packed = false;
+
+    if (args_cnt > 1) {
+        if (!info[1]->IsObject() || info[1]->IsFunction() || info[1]->IsArray()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Options must be an object")));
+            return;
+        }
+
+        Local<Object> options = to_object_n(isolate, info[1]);
+
+        if (has_n(isolate, options, new_string_n(isolate, "packed"))) {
+            packed = boolean_value_n(isolate, get_n(isolate, options, new_string_n(isolate, "packed")));
+        }
+
+        if (nodem_state->debug > LOW) debug_log(">>   packed: ", boolalpha, packed);
+    }
+
+    Local<Array> nodes = Local<Array>::Cast(info[0]);
+    vector<vector<string>> nodes_array;
+
+    for (unsigned int i = 0; i < nodes->Length(); i++) {
+        Local<Value> node = get_n(isolate, nodes, i);
+
+        if (!node->IsObject() || node->IsFunction() || node->IsArray()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Each node must be an object")));
+            return;
+        }
+
+        Local<Object> arg_object = to_object_n(isolate, node);
+        Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+        bool local = false;
 
         if (glvn->IsUndefined()) {
             glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
@@ -7035,52 +13454,35 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
         if (glvn->IsUndefined()) {
             isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
             return;
-        }
-
-        subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
-    } else if (args_cnt > 0) {
-        glvn = info[0];
-
-        if (args_cnt > 1) {
-            Local<Array> temp_subscripts = Array::New(isolate, args_cnt - 1);
+        } else if (!glvn->IsString() || glvn->StrictEquals(new_string_n(isolate, ""))) {
+            if (local) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a non-empty string")));
+            } else {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a non-empty string")));
+            }
 
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_subscripts, i - 1, info[i]);
+            return;
+        } else if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            if (local) {
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            } else {
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
             }
 
-            subscripts = temp_subscripts;
+            return;
         }
 
-        position = true;
-        string test = *(UTF8_VALUE_TEMP_N(isolate, glvn));
-        if (test[0] != '^') local = true;
-    }
+        Local<Value> name = local ? localize_name(glvn, nodem_state) : globalize_name(glvn, nodem_state);
 
-    Local<Value> subs = String::Empty(isolate);
-    vector<string> subs_array;
-
-    if (!glvn->IsUndefined() && !glvn->IsString()) {
-        if (local) {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a string")));
-        } else {
-            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a string")));
+        if (local && invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
         }
 
-        return;
-    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
-        if (local) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Local must not be an empty string")));
-        } else {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Global must not be an empty string")));
-        }
+        vector<string> subs_array;
+        Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
 
-        return;
-    } else if (glvn->IsUndefined()) {
-        glvn = String::Empty(isolate);
-        local = true;
-    } else {
         if (subscripts->IsArray()) {
-#if NODEM_SIMPLE_API == 1
             bool error = false;
             subs_array = build_subscripts(subscripts, error, nodem_state);
 
@@ -7088,83 +13490,41 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
                 isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
                 return;
             }
-#else
-            subs = encode_arguments(subscripts, nodem_state);
-
-            if (subs->IsUndefined()) {
-                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
-                return;
-            }
-#endif
         } else if (!subscripts->IsUndefined()) {
             isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
             return;
         }
-    }
 
-    const char* name_msg;
-    Local<Value> name;
+        string gvn;
 
-    if (local) {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
-            return;
+        if (nodem_state->utf8 == true) {
+            gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
+        } else {
+            NodemValue nodem_name {name};
+            gvn = nodem_name.to_byte();
         }
 
-        name_msg = ">>   local: ";
-        name = localize_name(glvn, nodem_state);
+        if (nodem_state->debug > LOW) {
+            debug_log(local ? ">>   local: " : ">>   global: ", gvn);
 
-        if (invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
-            return;
-        }
-    } else {
-        if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
-            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
-            return;
+            for (unsigned int j = 0; j < subs_array.size(); j++) debug_log(">>   subscripts[", j, "]: ", subs_array[j]);
         }
 
-        name_msg = ">>   global: ";
-        name = globalize_name(glvn, nodem_state);
-    }
-
-    string gvn, sub;
-
-    if (nodem_state->utf8 == true) {
-        gvn = *(UTF8_VALUE_TEMP_N(isolate, name));
-        sub = *(UTF8_VALUE_TEMP_N(isolate, subs));
-    } else {
-        NodemValue nodem_name {name};
-        NodemValue nodem_subs {subs};
-
-        gvn = nodem_name.to_byte();
-        sub = nodem_subs.to_byte();
+        subs_array.insert(subs_array.begin(), gvn);
+        nodes_array.push_back(subs_array);
     }
 
-    if (nodem_state->debug > LOW) {
-        debug_log(name_msg, gvn);
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
 
-#if NODEM_SIMPLE_API == 1
-        if (subs_array.size()) {
-            for (unsigned int i = 0; i < subs_array.size(); i++) {
-                debug_log(">>   subscripts[", i, "]: ", subs_array[i]);
-            }
-        }
-#else
-        debug_log(">>   subscripts: ", sub);
-#endif
-    }
+    if (adaptive) async = true;
 
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -7175,45 +13535,32 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, subscripts);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = gvn;
-    nodem_baton->args = sub;
-    nodem_baton->subs_array = subs_array;
+    hold_values(isolate, nodem_baton, async, nodes, Undefined(isolate));
+    nodem_baton->name = nodes_array.empty() ? string {} : nodes_array[0][0];
+    nodem_baton->nodes_array = std::move(nodes_array);
+    nodem_baton->packed = packed;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
-    nodem_baton->local = local;
-    nodem_baton->position = position;
+    nodem_baton->local = false;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_SIMPLE_API == 1
-    nodem_baton->nodem_function = &ydb::unlock;
-#else
-    nodem_baton->nodem_function = &gtm::unlock;
-#endif
-    nodem_baton->ret_function = &nodem::unlock;
+    nodem_baton->nodem_function = &ydb::read_consistent;
+    nodem_baton->ret_function = &nodem::read_consistent;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", nodem_state->mode);
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::read_consistent exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-#if NODEM_SIMPLE_API == 1
     if (nodem_baton->status == -1) {
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -7223,17 +13570,7 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
         isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
         return;
     } else if (nodem_baton->status != YDB_OK) {
-#else
-    if (nodem_baton->status != EXIT_SUCCESS) {
-#endif
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
-
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -7241,171 +13578,179 @@ void Nodem::unlock(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into unlock");
+    if (nodem_state->debug > LOW) debug_log(">>   call into read_consistent");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::unlock exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::read_consistent exit\n");
 
     return;
-} // @end nodem::Nodem::unlock method
+} // @end nodem::Nodem::read_consistent method
 
-#if NODEM_SIMPLE_API == 1
 /*
- * @method nodem::Nodem::transaction
- * @summary Call a JavaScript function within a YottaDB transaction
+ * @method nodem::Nodem::sharded_global
+ * @summary Spread a global across several global directories, or show or remove how it is spread
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::transaction(const FunctionCallbackInfo<Value>& info)
+void Nodem::sharded_global(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::transaction enter");
-
-#   if YDB_RELEASE >= 126
-    reset_handler(nodem_state);
-#   endif
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sharded_global enter");
 
-    if (nodem_state_g < OPEN) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+    if (info.Length() == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an argument")));
+        return;
+    } else if (!info[0]->IsObject()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Argument must be an object")));
         return;
     }
 
-    unsigned int args_cnt = info.Length();
-    Local<Value> variables = Undefined(isolate);
-
-    ydb_buffer_t vars_array[YDB_MAX_SUBS];
-    unsigned int vars_size;
-    string mode;
+    Local<Object> arg_object = to_object_n(isolate, info[0]);
+    Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "name"));
 
-    if (args_cnt > 2) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Only two arguments are allowed")));
+    if (glvn->IsUndefined()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'name' property")));
         return;
-#   if NODE_MAJOR_VERSION >= 8 || (NODE_MAJOR_VERSION == 7 && NODE_MINOR_VERSION >= 6)
-    } else if (info[0]->IsAsyncFunction()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Async function is not allowed")));
+    } else if (!glvn->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'name' must be a string")));
         return;
-#   endif
-    } else if (!info[0]->IsFunction()) {
-        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Function is required for first argument")));
+    } else if (glvn->StrictEquals(new_string_n(isolate, ""))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Property 'name' must not be an empty string")));
         return;
-    } else {
-        mode = "NODEM";
-        vars_size = 0;
+    }
 
-        if (args_cnt == 2) {
-            if (!info[1]->IsObject()) {
-                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Argument must be an object")));
-                return;
-            } else {
-                Local<Object> arg_object = to_object_n(isolate, info[1]);
-                Local<Value> type = get_n(isolate, arg_object, new_string_n(isolate, "type"));
+    string name = *(UTF8_VALUE_TEMP_N(isolate, globalize_name(glvn, nodem_state)));
 
-                if (type->StrictEquals(new_string_n(isolate, "Batch")) || type->StrictEquals(new_string_n(isolate, "batch")) ||
-                    type->StrictEquals(new_string_n(isolate, "BATCH"))) mode = "BATCH";
+    if (invalid_name(name.c_str()) || name.compare(0, 2, "^[") == 0 || name.compare(0, 2, "^|") == 0) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Property 'name' is an invalid name")));
+        return;
+    }
 
-                variables = get_n(isolate, arg_object, new_string_n(isolate, "variables"));
+    if (nodem_state->debug > LOW) debug_log(">>   name: ", name);
 
-                if (!variables->IsUndefined() && !variables->IsArray()) {
-                    isolate->ThrowException(Exception::Error(new_string_n(isolate, "Variables must be in an array")));
-                    return;
-                }
+    Local<Value> shards = get_n(isolate, arg_object, new_string_n(isolate, "shards"));
 
-                Local<Array> variables_array = Local<Array>::Cast(variables);
-                vars_size = variables_array->Length();
-                string vars_name;
+    if (shards->IsArray() && Local<Array>::Cast(shards)->Length() == 0) {
+        if (nodem_state->debug > LOW) debug_log(">>   removed: ", boolalpha, shard_remove(name));
+    } else if (shards->IsArray()) {
+        Local<Array> shard_array = Local<Array>::Cast(shards);
 
-                if (vars_size > YDB_MAX_SUBS) {
-                    isolate->ThrowException(Exception::Error(new_string_n(
-                      isolate, "Max of " NODEM_STRING(YDB_MAX_SUBS) "variables may be passed")));
+        if (shard_array->Length() > SHARD_MAX) {
+            isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                     "Property 'shards' can contain at most " NODEM_STRING(SHARD_MAX) " shards")));
 
-                    return;
-                }
+            return;
+        }
 
-                if (nodem_state->debug > LOW) debug_log(">>   vars_size: ", vars_size);
+        ShardedGlobal shard;
 
-                for (unsigned int i = 0; i < vars_size; i++) {
-                    vars_name = *(UTF8_VALUE_TEMP_N(isolate, get_n(isolate, variables_array, i)));
+        shard.name = name;
+        shard.key_level = 1;
+        shard.hash = FNV1A;
 
-                    if (vars_name[0] == '^' || vars_name[0] == '$') {
-                        isolate->ThrowException(Exception::Error(new_string_n(isolate, "Variables must be local")));
-                        return;
-                    }
+        for (unsigned int i = 0; i < shard_array->Length(); i++) {
+            Local<Value> element = get_n(isolate, shard_array, i);
 
-                    if (nodem_state->debug > LOW) debug_log(">>   vars_name[", i, "]: ", vars_name[i]);
+            if (!element->IsObject()) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'shards' must contain objects")));
+                return;
+            }
 
-                    vars_array[i].len_alloc = vars_array[i].len_used = vars_name.length();
-                    vars_array[i].buf_addr = (char*) vars_name.c_str();
-                }
+            Local<Value> gld = get_n(isolate, to_object_n(isolate, element), new_string_n(isolate, "gld"));
+            Local<Value> region = get_n(isolate, to_object_n(isolate, element), new_string_n(isolate, "region"));
+
+            if (!gld->IsString() || gld->StrictEquals(new_string_n(isolate, ""))) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate,
+                         "Property 'gld' in each shard must be a non-empty string")));
+
+                return;
+            } else if (!region->IsUndefined() && !region->IsString()) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'region' in each shard must be a string")));
+                return;
             }
+
+            shard.glds.push_back(*(UTF8_VALUE_TEMP_N(isolate, gld)));
+            shard.regions.push_back(region->IsUndefined() ? "" : *(UTF8_VALUE_TEMP_N(isolate, region)));
         }
-    }
 
-    if (nodem_state->debug > LOW) debug_log(">>   mode: ", mode);
+        Local<Value> key_level = get_n(isolate, arg_object, new_string_n(isolate, "keyLevel"));
 
-    NodemBaton* nodem_baton;
-    NodemBaton new_baton;
+        if (!key_level->IsUndefined()) {
+            if (!key_level->IsUint32() || uint32_value_n(isolate, key_level) < 1 || uint32_value_n(isolate, key_level) > YDB_MAX_SUBS) {
+                isolate->ThrowException(Exception::RangeError(new_string_n(isolate,
+                         "Property 'keyLevel' must be an integer from 1 to " NODEM_STRING(YDB_MAX_SUBS))));
 
-    nodem_baton = &new_baton;
-    nodem_baton->request.data = nodem_baton;
-    nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[0]));
-    nodem_baton->nodem_state = nodem_state;
-    nodem_baton->error = nodem_state->error;
+                return;
+            }
 
-    if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
-    if (nodem_state->debug > LOW) debug_log(">>   tp_level: ", nodem_state->tp_level);
-    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+            shard.key_level = uint32_value_n(isolate, key_level);
+        }
 
-    nodem_state->tp_level++;
+        Local<Value> hash = get_n(isolate, arg_object, new_string_n(isolate, "hash"));
 
-    ydb_status_t status = ydb_tp_s(nodem::transaction, nodem_baton, mode.c_str(), vars_size, vars_array);
+        if (!hash->IsUndefined()) {
+            UTF8_VALUE_N(isolate, hash_name, hash);
 
-    nodem_state->tp_level--;
+            if (strcasecmp(*hash_name, "modulo") == 0) {
+                shard.hash = MODULO;
+            } else if (strcasecmp(*hash_name, "fnv1a") != 0) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'hash' must be 'fnv1a' or 'modulo'")));
+                return;
+            }
+        }
 
-    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
-    if (nodem_state->debug > LOW) debug_log(">>   tp_level: ", nodem_state->tp_level);
-    if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        if (nodem_state->debug > LOW) {
+            debug_log(">>   shards: ", shard.glds.size());
+            debug_log(">>   keyLevel: ", shard.key_level);
+            debug_log(">>   hash: ", shard.hash);
+        }
 
-    nodem_baton->callback_p.Reset();
+        shard_define(shard);
+    } else if (!shards->IsUndefined()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'shards' must contain an array")));
+        return;
+    }
 
-    Local<Object> return_object = Object::New(isolate);
+    shard_ptr_t shard = shard_find(name);
+    Local<Array> shard_array = Array::New(isolate);
 
+    Local<Object> return_object = Object::New(isolate);
     set_n(isolate, return_object, new_string_n(isolate, "ok"), Boolean::New(isolate, true));
+    set_n(isolate, return_object, new_string_n(isolate, "name"), localize_name(glvn, nodem_state));
 
-    if (status == YDB_OK) {
-        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
-        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Commit"));
-
-        info.GetReturnValue().Set(return_object);
-    } else if (status == YDB_TP_ROLLBACK) {
-        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
-        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Rollback"));
+    if (shard) {
+        for (unsigned int i = 0; i < shard->glds.size(); i++) {
+            Local<Object> element = Object::New(isolate);
 
-        info.GetReturnValue().Set(return_object);
-    } else if (status == YDB_TP_RESTART) {
-        set_n(isolate, return_object, new_string_n(isolate, "statusCode"), Number::New(isolate, status));
-        set_n(isolate, return_object, new_string_n(isolate, "statusMessage"), new_string_n(isolate, "Restart"));
+            set_n(isolate, element, new_string_n(isolate, "gld"), new_string_n(isolate, shard->glds[i].c_str()));
+            set_n(isolate, element, new_string_n(isolate, "region"), new_string_n(isolate, shard->regions[i].c_str()));
+            set_n(isolate, shard_array, i, element);
+        }
 
-        info.GetReturnValue().Set(return_object);
+        set_n(isolate, return_object, new_string_n(isolate, "shards"), shard_array);
+        set_n(isolate, return_object, new_string_n(isolate, "keyLevel"), Number::New(isolate, shard->key_level));
+        set_n(isolate, return_object, new_string_n(isolate, "hash"),
+              new_string_n(isolate, shard->hash == MODULO ? "modulo" : "fnv1a"));
     } else {
-        ydb_zstatus(nodem_baton->error, ERR_LEN);
-
-        info.GetReturnValue().Set(error_status(nodem_baton->error, false, false, nodem_state));
+        set_n(isolate, return_object, new_string_n(isolate, "shards"), shard_array);
     }
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::transaction exit\n");
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::sharded_global exit\n");
 
     return;
-} // @end nodem::Nodem::transaction method
+} // @end nodem::Nodem::sharded_global method
 #endif
 
 /*
@@ -7428,6 +13773,16 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
+#if NODEM_SIMPLE_API == 1
+    if (callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
     bool async = false;
     unsigned int args_cnt = info.Length();
 
@@ -7526,16 +13881,17 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
         debug_log(">>   arguments: ", args_s);
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
-
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -7546,10 +13902,9 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, arguments);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = func_s;
-    nodem_baton->args = args_s;
+    hold_values(isolate, nodem_baton, async, arguments, Undefined(isolate));
+    nodem_baton->name = std::move(func_s);
+    nodem_baton->args = std::move(args_s);
     nodem_baton->relink = relink;
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
@@ -7574,19 +13929,13 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
     }
 
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
         if (nodem_state->debug > OFF) debug_log(">  Nodem::function exit\n");
-
-        info.GetReturnValue().Set(Undefined(isolate));
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
@@ -7608,7 +13957,7 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
 
     if (nodem_state->debug > LOW) debug_log(">>   call into function");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
@@ -7626,24 +13975,260 @@ void Nodem::function(const FunctionCallbackInfo<Value>& info)
  * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
  * @returns {void}
  */
-void Nodem::procedure(const FunctionCallbackInfo<Value>& info)
+void Nodem::procedure(const FunctionCallbackInfo<Value>& info)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+
+    NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure enter");
+
+    if (nodem_state_g < OPEN) {
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
+        return;
+    }
+
+#if NODEM_SIMPLE_API == 1
+    if (callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
+    bool async = false;
+    unsigned int args_cnt = info.Length();
+
+    if (info[args_cnt - 1]->IsFunction()) {
+        --args_cnt;
+        async = true;
+
+        if (nodem_state->tp_level > 0) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Asynchronous call not allowed within a transaction")));
+            return;
+        }
+    }
+
+    if (args_cnt == 0) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+        return;
+    }
+
+    Local<Value> procedure;
+    Local<Value> arguments = Undefined(isolate);
+    uint32_t relink = nodem_state->auto_relink;
+    bool local = false;
+    bool position = false;
+    bool routine = false;
+
+    if (info[0]->IsObject()) {
+        Local<Object> arg_object = to_object_n(isolate, info[0]);
+        procedure = get_n(isolate, arg_object, new_string_n(isolate, "procedure"));
+
+        if (procedure->IsUndefined()) {
+            procedure = get_n(isolate, arg_object, new_string_n(isolate, "routine"));
+
+            if (procedure->IsUndefined()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+                         "Need to supply a 'procedure' or 'routine' property")));
+
+                return;
+            } else {
+                routine = true;
+            }
+        }
+
+        arguments = get_n(isolate, arg_object, new_string_n(isolate, "arguments"));
+
+        if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
+            relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
+        }
+    } else {
+        procedure = info[0];
+
+        if (args_cnt > 1) {
+            Local<Array> temp_arguments = Array::New(isolate, args_cnt - 1);
+
+            for (unsigned int i = 1; i < args_cnt; i++) {
+                set_n(isolate, temp_arguments, i - 1, info[i]);
+            }
+
+            arguments = temp_arguments;
+        }
+
+        position = true;
+    }
+
+    if (!procedure->IsString()) {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Procedure must be a string")));
+        return;
+    } else if (procedure->StrictEquals(new_string_n(isolate, ""))) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Procedure must not be an empty string")));
+        return;
+    }
+
+    Local<Value> args = Undefined(isolate);
+
+    if (arguments->IsUndefined()) {
+        args = String::Empty(isolate);
+    } else if (arguments->IsArray()) {
+        args = encode_arguments(arguments, nodem_state, true);
+
+        if (args->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Arguments contain invalid data")));
+            return;
+        }
+    } else {
+        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'arguments' must contain an array")));
+        return;
+    }
+
+    Local<Value> name = globalize_name(procedure, nodem_state);
+
+    string proc_s, args_s;
+
+    if (nodem_state->utf8 == true) {
+        proc_s = *(UTF8_VALUE_TEMP_N(isolate, name));
+        args_s = *(UTF8_VALUE_TEMP_N(isolate, args));
+    } else {
+        NodemValue nodem_name {name};
+        NodemValue nodem_args {args};
+
+        proc_s = nodem_name.to_byte();
+        args_s = nodem_args.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   procedure: ", proc_s);
+        debug_log(">>   arguments: ", args_s);
+    }
+
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
+    NodemBaton* nodem_baton;
+    NodemBaton new_baton;
+
+    if (async) {
+        nodem_baton = baton_acquire(nodem_state);
+
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
+    } else {
+        nodem_baton = &new_baton;
+
+        nodem_baton->callback_p.Reset();
+
+        nodem_baton->error = nodem_state->error;
+        nodem_baton->result = nodem_state->result;
+    }
+
+    nodem_baton->request.data = nodem_baton;
+    hold_values(isolate, nodem_baton, async, arguments, Undefined(isolate));
+    nodem_baton->name = std::move(proc_s);
+    nodem_baton->args = std::move(args_s);
+    nodem_baton->relink = relink;
+    nodem_baton->mode = nodem_state->mode;
+    nodem_baton->async = async;
+    nodem_baton->local = local;
+    nodem_baton->position = position;
+    nodem_baton->routine = routine;
+    nodem_baton->status = 0;
+#if NODEM_YDB == 1 && YDB_RELEASE >= 124
+    nodem_baton->info = 32766;
+#else
+    nodem_baton->info = 8192;
+#endif
+    nodem_baton->nodem_function = &gtm::procedure;
+    nodem_baton->ret_function = &nodem::procedure;
+    nodem_baton->nodem_state = nodem_state;
+
+    if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   relink: ", relink);
+        debug_log(">>   mode: ", nodem_state->mode);
+        debug_log(">>   info: ", nodem_baton->info);
+    }
+
+    if (async) {
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
+
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure exit\n");
+        return;
+    }
+
+    nodem_baton->status = call_nodem_function(nodem_baton);
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    if (nodem_baton->status != EXIT_SUCCESS) {
+        if (position) {
+            isolate->ThrowException(Exception::Error(
+              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+
+            info.GetReturnValue().Set(Undefined(isolate));
+        } else {
+            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
+        }
+
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
+
+        return;
+    }
+
+    if (nodem_state->debug > LOW) debug_log(">>   call into procedure");
+
+    Local<Value> return_object = call_ret_function(nodem_baton);
+
+    nodem_baton->arguments_p.Reset();
+    nodem_baton->data_p.Reset();
+
+    info.GetReturnValue().Set(return_object);
+
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure exit\n");
+
+    return;
+} // @end nodem::Nodem::procedure method
+
+/*
+ * @method nodem::Nodem::batch
+ * @summary Run several data, get, set, kill, order, previous, or increment operations with one Call-in
+ * @param {FunctionCallbackInfo<Value>&} info - A special object passed by the Node.js runtime, including passed arguments
+ * @returns {void}
+ */
+void Nodem::batch(const FunctionCallbackInfo<Value>& info)
 {
     Isolate* isolate = Isolate::GetCurrent();
     HandleScope scope(isolate);
 
     NodemState* nodem_state = reinterpret_cast<NodemState*>(info.Data().As<External>()->Value());
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure enter");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::batch enter");
 
     if (nodem_state_g < OPEN) {
         isolate->ThrowException(Exception::Error(new_string_n(isolate, NODEM_DB " connection is not open")));
         return;
     }
 
+#if NODEM_SIMPLE_API == 1
+    if (callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
     bool async = false;
     unsigned int args_cnt = info.Length();
 
-    if (info[args_cnt - 1]->IsFunction()) {
+    if (args_cnt > 0 && info[args_cnt - 1]->IsFunction()) {
         --args_cnt;
         async = true;
 
@@ -7653,110 +14238,160 @@ void Nodem::procedure(const FunctionCallbackInfo<Value>& info)
         }
     }
 
-    if (args_cnt == 0) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an additional argument")));
+    if (args_cnt == 0 || !info[0]->IsArray()) {
+        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply an array of operations")));
         return;
     }
 
-    Local<Value> procedure;
-    Local<Value> arguments = Undefined(isolate);
-    uint32_t relink = nodem_state->auto_relink;
-    bool local = false;
-    bool position = false;
-    bool routine = false;
+    Local<Array> operations = Local<Array>::Cast(info[0]);
+    const char* const ops[] = {"data", "get", "set", "kill", "order", "previous", "increment"};
+    string args_s, first_name;
 
-    if (info[0]->IsObject()) {
-        Local<Object> arg_object = to_object_n(isolate, info[0]);
-        procedure = get_n(isolate, arg_object, new_string_n(isolate, "procedure"));
+    for (unsigned int i = 0; i < operations->Length(); i++) {
+        Local<Value> operation = get_n(isolate, operations, i);
 
-        if (procedure->IsUndefined()) {
-            procedure = get_n(isolate, arg_object, new_string_n(isolate, "routine"));
+        if (!operation->IsObject() || operation->IsFunction() || operation->IsArray()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Each operation must be an object")));
+            return;
+        }
 
-            if (procedure->IsUndefined()) {
-                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
-                         "Need to supply a 'procedure' or 'routine' property")));
+        Local<Object> arg_object = to_object_n(isolate, operation);
+        Local<Value> op = get_n(isolate, arg_object, new_string_n(isolate, "op"));
+        unsigned int op_num = 0;
 
-                return;
-            } else {
-                routine = true;
-            }
+        while (op_num < 7 && !op->StrictEquals(new_string_n(isolate, ops[op_num]))) op_num++;
+
+        if (op_num == 7) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate,
+              "Property 'op' must be data, get, set, kill, order, previous, or increment")));
+            return;
         }
 
-        arguments = get_n(isolate, arg_object, new_string_n(isolate, "arguments"));
+        Local<Value> glvn = get_n(isolate, arg_object, new_string_n(isolate, "global"));
+        bool local = false;
 
-        if (has_n(isolate, arg_object, new_string_n(isolate, "autoRelink"))) {
-            relink = boolean_value_n(isolate, get_n(isolate, arg_object, new_string_n(isolate, "autoRelink")));
+        if (glvn->IsUndefined()) {
+            glvn = get_n(isolate, arg_object, new_string_n(isolate, "local"));
+            local = true;
         }
-    } else {
-        procedure = info[0];
 
-        if (args_cnt > 1) {
-            Local<Array> temp_arguments = Array::New(isolate, args_cnt - 1);
+        if (glvn->IsUndefined()) {
+            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'global' or 'local' property")));
+            return;
+        } else if (!glvn->IsString() || glvn->StrictEquals(new_string_n(isolate, ""))) {
+            if (local) {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Local must be a non-empty string")));
+            } else {
+                isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Global must be a non-empty string")));
+            }
 
-            for (unsigned int i = 1; i < args_cnt; i++) {
-                set_n(isolate, temp_arguments, i - 1, info[i]);
+            return;
+        } else if (invalid_name(*(UTF8_VALUE_TEMP_N(isolate, glvn)))) {
+            if (local) {
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local is an invalid name")));
+            } else {
+                isolate->ThrowException(Exception::Error(new_string_n(isolate, "Global is an invalid name")));
             }
 
-            arguments = temp_arguments;
+            return;
         }
 
-        position = true;
-    }
+        Local<Value> name = local ? localize_name(glvn, nodem_state) : globalize_name(glvn, nodem_state);
 
-    if (!procedure->IsString()) {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Procedure must be a string")));
-        return;
-    } else if (procedure->StrictEquals(new_string_n(isolate, ""))) {
-        isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Procedure must not be an empty string")));
-        return;
-    }
+        if (local && invalid_local(*(UTF8_VALUE_TEMP_N(isolate, name)))) {
+            isolate->ThrowException(Exception::Error(new_string_n(isolate, "Local cannot begin with 'v4w'")));
+            return;
+        }
 
-    Local<Value> args = Undefined(isolate);
+        Local<Value> subscripts = get_n(isolate, arg_object, new_string_n(isolate, "subscripts"));
+        Local<Value> subs = String::Empty(isolate);
 
-    if (arguments->IsUndefined()) {
-        args = String::Empty(isolate);
-    } else if (arguments->IsArray()) {
-        args = encode_arguments(arguments, nodem_state, true);
+        if (subscripts->IsArray()) {
+            subs = encode_arguments(subscripts, nodem_state);
 
-        if (args->IsUndefined()) {
-            isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Arguments contain invalid data")));
+            if (subs->IsUndefined()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Subscripts contain invalid data")));
+                return;
+            }
+        } else if (!subscripts->IsUndefined()) {
+            isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'subscripts' must contain an array")));
             return;
         }
-    } else {
-        isolate->ThrowException(Exception::TypeError(new_string_n(isolate, "Property 'arguments' must contain an array")));
-        return;
-    }
 
-    Local<Value> name = globalize_name(procedure, nodem_state);
+        Local<Value> data_node = String::Empty(isolate);
 
-    string proc_s, args_s;
+        if (op_num == 2) {
+            Local<Value> data_value = get_n(isolate, arg_object, new_string_n(isolate, "data"));
 
-    if (nodem_state->utf8 == true) {
-        proc_s = *(UTF8_VALUE_TEMP_N(isolate, name));
-        args_s = *(UTF8_VALUE_TEMP_N(isolate, args));
-    } else {
-        NodemValue nodem_name {name};
-        NodemValue nodem_args {args};
+            if (data_value->IsUndefined()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Need to supply a 'data' property")));
+                return;
+            } else if (data_value->IsSymbol() || data_value->IsSymbolObject() || data_value->IsObject()) {
+                isolate->ThrowException(Exception::SyntaxError(new_string_n(isolate, "Property 'data' contains invalid data")));
+                return;
+            }
 
-        proc_s = nodem_name.to_byte();
-        args_s = nodem_args.to_byte();
-    }
+            Local<Array> data_array = Array::New(isolate, 1);
+            set_n(isolate, data_array, 0, data_value);
 
-    if (nodem_state->debug > LOW) {
-        debug_log(">>   procedure: ", proc_s);
-        debug_log(">>   arguments: ", args_s);
+            data_node = encode_arguments(data_array, nodem_state);
+        } else if (op_num == 6) {
+            data_node = Number::New(isolate, 1);
+
+            if (has_n(isolate, arg_object, new_string_n(isolate, "increment"))) {
+                data_node = get_n(isolate, arg_object, new_string_n(isolate, "increment"));
+
+                // Make sure JavaScript numbers that M won't recognize are changed to 0, as increment does
+                string test = *(UTF8_VALUE_TEMP_N(isolate, data_node));
+
+                if (!data_node->IsNumber() ||
+                  !all_of(test.begin(), test.end(), [](char c) {return (isdigit(c) || c == '-' || c == '.');})) {
+                    data_node = Number::New(isolate, 0);
+                }
+            }
+        }
+
+        string fields[4];
+
+        fields[0] = ops[op_num];
+
+        if (nodem_state->utf8 == true) {
+            fields[1] = *(UTF8_VALUE_TEMP_N(isolate, name));
+            fields[2] = *(UTF8_VALUE_TEMP_N(isolate, subs));
+            fields[3] = *(UTF8_VALUE_TEMP_N(isolate, data_node));
+        } else {
+            NodemValue nodem_name {name};
+            NodemValue nodem_subs {subs};
+            NodemValue nodem_data_node {data_node};
+
+            fields[1] = nodem_name.to_byte();
+            fields[2] = nodem_subs.to_byte();
+            fields[3] = nodem_data_node.to_byte();
+        }
+
+        if (nodem_state->debug > LOW) {
+            debug_log(">>   op: ", fields[0]);
+            debug_log(local ? ">>   local: " : ">>   global: ", fields[1]);
+            debug_log(">>   subscripts: ", fields[2]);
+            debug_log(">>   data: ", fields[3]);
+        }
+
+        if (i == 0) first_name = fields[1];
+
+        for (unsigned int j = 0; j < 4; j++) args_s += std::to_string(fields[j].length()) + ":" + fields[j] + ",";
     }
 
+    bool adaptive = !async && nodem_state->adaptive && nodem_state->tp_level == 0;
+
+    if (adaptive) async = true;
+
     NodemBaton* nodem_baton;
     NodemBaton new_baton;
 
     if (async) {
-        nodem_baton = new NodemBaton();
+        nodem_baton = baton_acquire(nodem_state);
 
-        nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
-
-        nodem_baton->error = new gtm_char_t[ERR_LEN];
-        nodem_baton->result = new gtm_char_t[RES_LEN];
+        if (!adaptive) nodem_baton->callback_p.Reset(isolate, Local<Function>::Cast(info[args_cnt]));
     } else {
         nodem_baton = &new_baton;
 
@@ -7767,60 +14402,41 @@ void Nodem::procedure(const FunctionCallbackInfo<Value>& info)
     }
 
     nodem_baton->request.data = nodem_baton;
-    nodem_baton->arguments_p.Reset(isolate, arguments);
-    nodem_baton->data_p.Reset(isolate, Undefined(isolate));
-    nodem_baton->name = proc_s;
-    nodem_baton->args = args_s;
-    nodem_baton->relink = relink;
+    hold_values(isolate, nodem_baton, async, operations, Undefined(isolate));
+    nodem_baton->name = std::move(first_name);
+    nodem_baton->args = std::move(args_s);
     nodem_baton->mode = nodem_state->mode;
     nodem_baton->async = async;
-    nodem_baton->local = local;
-    nodem_baton->position = position;
-    nodem_baton->routine = routine;
+    nodem_baton->local = false;
+    nodem_baton->position = false;
     nodem_baton->status = 0;
-#if NODEM_YDB == 1 && YDB_RELEASE >= 124
-    nodem_baton->info = 32766;
-#else
-    nodem_baton->info = 8192;
-#endif
-    nodem_baton->nodem_function = &gtm::procedure;
-    nodem_baton->ret_function = &nodem::procedure;
+    nodem_baton->nodem_function = &gtm::batch;
+    nodem_baton->ret_function = &nodem::batch;
     nodem_baton->nodem_state = nodem_state;
 
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
 
-    if (nodem_state->debug > LOW) {
-        debug_log(">>   relink: ", relink);
-        debug_log(">>   mode: ", nodem_state->mode);
-        debug_log(">>   info: ", nodem_baton->info);
-    }
-
     if (async) {
-#if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
-        uv_queue_work(GetCurrentEventLoop(isolate), &nodem_baton->request, async_work, async_after);
-#else
-        uv_queue_work(uv_default_loop(), &nodem_baton->request, async_work, async_after);
-#endif
-
-        if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure exit\n");
+        info.GetReturnValue().Set(queue_work(isolate, nodem_baton, adaptive));
 
-        info.GetReturnValue().Set(Undefined(isolate));
+        if (nodem_state->debug > OFF) debug_log(">  Nodem::batch exit\n");
         return;
     }
 
-    nodem_baton->status = nodem_baton->nodem_function(nodem_baton);
+    nodem_baton->status = call_nodem_function(nodem_baton);
 
     if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
 
-    if (nodem_baton->status != EXIT_SUCCESS) {
-        if (position) {
-            isolate->ThrowException(Exception::Error(
-              to_string_n(isolate, error_status(nodem_baton->error, position, async, nodem_state))));
+    if (nodem_baton->status == -1) {
+        nodem_baton->arguments_p.Reset();
+        nodem_baton->data_p.Reset();
 
-            info.GetReturnValue().Set(Undefined(isolate));
-        } else {
-            info.GetReturnValue().Set(error_status(nodem_baton->error, position, async, nodem_state));
-        }
+        char error[BUFSIZ];
+
+        isolate->ThrowException(Exception::Error(new_string_n(isolate, strerror_r(errno, error, BUFSIZ))));
+        return;
+    } else if (nodem_baton->status != EXIT_SUCCESS) {
+        info.GetReturnValue().Set(error_status(nodem_baton->error, false, async, nodem_state));
 
         nodem_baton->arguments_p.Reset();
         nodem_baton->data_p.Reset();
@@ -7828,19 +14444,19 @@ void Nodem::procedure(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
-    if (nodem_state->debug > LOW) debug_log(">>   call into procedure");
+    if (nodem_state->debug > LOW) debug_log(">>   call into batch");
 
-    Local<Value> return_object = nodem_baton->ret_function(nodem_baton);
+    Local<Value> return_object = call_ret_function(nodem_baton);
 
     nodem_baton->arguments_p.Reset();
     nodem_baton->data_p.Reset();
 
     info.GetReturnValue().Set(return_object);
 
-    if (nodem_state->debug > OFF) debug_log(">  Nodem::procedure exit\n");
+    if (nodem_state->debug > OFF) debug_log(">  Nodem::batch exit\n");
 
     return;
-} // @end nodem::Nodem::procedure method
+} // @end nodem::Nodem::batch method
 
 /*
  * @method nodem::Nodem::global_directory_deprecated
@@ -7910,6 +14526,63 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
         debug_log(">>   max: ", uint32_value_n(isolate, max));
     }
 
+#if NODEM_SIMPLE_API == 1
+    string lo_name, hi_name;
+
+    if (nodem_state->utf8 == true) {
+        lo_name = *(UTF8_VALUE_TEMP_N(isolate, lo));
+        hi_name = *(UTF8_VALUE_TEMP_N(isolate, hi));
+    } else {
+        NodemValue nodem_lo {lo};
+        NodemValue nodem_hi {hi};
+
+        lo_name = nodem_lo.to_byte();
+        hi_name = nodem_hi.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   lo: ", lo_name);
+        debug_log(">>   hi: ", hi_name);
+    }
+
+    // Match globalDirectory^v4wNode; empty or numeric bounds are ignored, and names are given a leading ^
+    if (lo_name.empty() || is_number(lo_name)) lo_name = "%";
+    if (hi_name.empty() || is_number(hi_name)) hi_name = "";
+    if (lo_name[0] != '^') lo_name.insert(0, "^");
+    if (!hi_name.empty() && hi_name[0] != '^') hi_name.insert(0, "^");
+
+    NodemBaton nodem_baton;
+
+    nodem_baton.name = lo_name;
+    nodem_baton.to_name = hi_name;
+    nodem_baton.option = uint32_value_n(isolate, max);
+    nodem_baton.error = nodem_state->error;
+    nodem_baton.result = nodem_state->result;
+    nodem_baton.nodem_state = nodem_state;
+
+    ydb_status_t status = ydb::global_directory(&nodem_baton);
+
+    if (nodem_state->debug > LOW) debug_log(">>   status: ", status);
+
+    if (status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton.error, false, false, nodem_state));
+        return;
+    }
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    Local<Array> names = Array::New(isolate, nodem_baton.subs_array.size());
+
+    for (unsigned int i = 0; i < nodem_baton.subs_array.size(); i++) {
+        if (nodem_state->utf8 == true) {
+            set_n(isolate, names, i, new_string_n(isolate, nodem_baton.subs_array[i].c_str()));
+        } else {
+            set_n(isolate, names, i, NodemValue::from_byte((gtm_char_t*) nodem_baton.subs_array[i].c_str()));
+        }
+    }
+
+    info.GetReturnValue().Set(names);
+#else
     gtm_status_t status;
     gtm_char_t global_directory[] = "global_directory";
 
@@ -7928,7 +14601,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", *(UTF8_VALUE_TEMP_N(isolate, hi)));
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("globalDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -7951,7 +14624,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", nodem_hi.to_byte());
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("globalDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -7972,7 +14645,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", *(UTF8_VALUE_TEMP_N(isolate, hi)));
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("globalDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -7995,7 +14668,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", nodem_hi.to_byte());
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("globalDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -8028,7 +14701,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
         gtm_char_t msg_buf[ERR_LEN];
         gtm_zstatus(msg_buf, ERR_LEN);
 
-        if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        if (nodem_state->tp_level == 0) unlock_mutex();
 
         info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
         return;
@@ -8044,7 +14717,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
         json_string = NodemValue::from_byte(ret_buf);
     }
 
-    if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+    if (nodem_state->tp_level == 0) unlock_mutex();
     if (nodem_state->debug > OFF) debug_log(">  Nodem::global_directory JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
 #if NODE_MAJOR_VERSION >= 1
@@ -8061,6 +14734,7 @@ void Nodem::global_directory(const FunctionCallbackInfo<Value>& info)
     } else {
         info.GetReturnValue().Set(Local<Array>::Cast(json));
     }
+#endif
 
     if (nodem_state->debug > OFF) debug_log(">  Nodem::global_directory exit\n");
 
@@ -8155,6 +14829,63 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
         debug_log(">>   max: ", uint32_value_n(isolate, max));
     }
 
+#if NODEM_SIMPLE_API == 1
+    string lo_name, hi_name;
+
+    if (nodem_state->utf8 == true) {
+        lo_name = *(UTF8_VALUE_TEMP_N(isolate, lo));
+        hi_name = *(UTF8_VALUE_TEMP_N(isolate, hi));
+    } else {
+        NodemValue nodem_lo {lo};
+        NodemValue nodem_hi {hi};
+
+        lo_name = nodem_lo.to_byte();
+        hi_name = nodem_hi.to_byte();
+    }
+
+    if (nodem_state->debug > LOW) {
+        debug_log(">>   lo: ", lo_name);
+        debug_log(">>   hi: ", hi_name);
+    }
+
+    // Match localDirectory^v4wNode; empty or numeric bounds are ignored, and a leading ^ is dropped
+    if (lo_name.empty() || is_number(lo_name)) lo_name = "%";
+    if (hi_name.empty() || is_number(hi_name)) hi_name = "";
+    if (lo_name[0] == '^') lo_name.erase(0, 1);
+    if (!hi_name.empty() && hi_name[0] == '^') hi_name.erase(0, 1);
+
+    NodemBaton nodem_baton;
+
+    nodem_baton.name = lo_name;
+    nodem_baton.to_name = hi_name;
+    nodem_baton.option = uint32_value_n(isolate, max);
+    nodem_baton.error = nodem_state->error;
+    nodem_baton.result = nodem_state->result;
+    nodem_baton.nodem_state = nodem_state;
+
+    ydb_status_t status = ydb::local_directory(&nodem_baton);
+
+    if (nodem_state->debug > LOW) debug_log(">>   status: ", status);
+
+    if (status != YDB_OK) {
+        info.GetReturnValue().Set(error_status(nodem_baton.error, false, false, nodem_state));
+        return;
+    }
+
+    if (nodem_state->debug > OFF) debug_log(">  return from " NODEM_DB);
+
+    Local<Array> names = Array::New(isolate, nodem_baton.subs_array.size());
+
+    for (unsigned int i = 0; i < nodem_baton.subs_array.size(); i++) {
+        if (nodem_state->utf8 == true) {
+            set_n(isolate, names, i, new_string_n(isolate, nodem_baton.subs_array[i].c_str()));
+        } else {
+            set_n(isolate, names, i, NodemValue::from_byte((gtm_char_t*) nodem_baton.subs_array[i].c_str()));
+        }
+    }
+
+    info.GetReturnValue().Set(names);
+#else
     gtm_status_t status;
     gtm_char_t local_directory[] = "local_directory";
 
@@ -8173,7 +14904,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", *(UTF8_VALUE_TEMP_N(isolate, hi)));
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("localDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -8196,7 +14927,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", nodem_hi.to_byte());
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("localDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -8217,7 +14948,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", *(UTF8_VALUE_TEMP_N(isolate, hi)));
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("localDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -8240,7 +14971,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
             debug_log(">>   hi: ", nodem_hi.to_byte());
         }
 
-        if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+        if (nodem_state->tp_level == 0) lock_mutex("localDirectory");
 
         if (nodem_state->debug > LOW) {
             if (dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
@@ -8273,7 +15004,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
         gtm_char_t msg_buf[ERR_LEN];
         gtm_zstatus(msg_buf, ERR_LEN);
 
-        if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        if (nodem_state->tp_level == 0) unlock_mutex();
 
         info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
         return;
@@ -8289,7 +15020,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
         json_string = NodemValue::from_byte(ret_buf);
     }
 
-    if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+    if (nodem_state->tp_level == 0) unlock_mutex();
     if (nodem_state->debug > OFF) debug_log(">  Nodem::local_directory JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
 #if NODE_MAJOR_VERSION >= 1
@@ -8306,6 +15037,7 @@ void Nodem::local_directory(const FunctionCallbackInfo<Value>& info)
     } else {
         info.GetReturnValue().Set(Local<Array>::Cast(json));
     }
+#endif
 
     if (nodem_state->debug > OFF) debug_log(">  Nodem::local_directory exit\n");
 
@@ -8332,6 +15064,16 @@ void Nodem::retrieve(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
+#if NODEM_SIMPLE_API == 1
+    if (callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
 
     gtm_status_t status;
@@ -8346,11 +15088,11 @@ void Nodem::retrieve(const FunctionCallbackInfo<Value>& info)
     access.rtn_name.length = strlen(retrieve);
     access.handle = NULL;
 
-    if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+    if (nodem_state->tp_level == 0) lock_mutex("retrieve");
 
     status = gtm_cip(&access, ret_buf);
 #else
-    if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+    if (nodem_state->tp_level == 0) lock_mutex("retrieve");
 
     status = gtm_ci(retrieve, ret_buf);
 #endif
@@ -8361,7 +15103,7 @@ void Nodem::retrieve(const FunctionCallbackInfo<Value>& info)
         gtm_char_t msg_buf[ERR_LEN];
         gtm_zstatus(msg_buf, ERR_LEN);
 
-        if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        if (nodem_state->tp_level == 0) unlock_mutex();
 
         info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
         return;
@@ -8377,7 +15119,7 @@ void Nodem::retrieve(const FunctionCallbackInfo<Value>& info)
         json_string = NodemValue::from_byte(ret_buf);
     }
 
-    if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+    if (nodem_state->tp_level == 0) unlock_mutex();
     if (nodem_state->debug > OFF) debug_log(">  Nodem::retrieve JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
 #if NODE_MAJOR_VERSION >= 1
@@ -8421,6 +15163,16 @@ void Nodem::update(const FunctionCallbackInfo<Value>& info)
         return;
     }
 
+#if NODEM_SIMPLE_API == 1
+    if (callin_init(nodem_state) != EXIT_SUCCESS) {
+        gtm_char_t msg_buf[ERR_LEN];
+        gtm_zstatus(msg_buf, ERR_LEN);
+
+        info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
+        return;
+    }
+#endif
+
     if (nodem_state->debug > OFF) debug_log(">  call into " NODEM_DB);
 
     gtm_status_t status;
@@ -8435,11 +15187,11 @@ void Nodem::update(const FunctionCallbackInfo<Value>& info)
     access.rtn_name.length = strlen(update);
     access.handle = NULL;
 
-    if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+    if (nodem_state->tp_level == 0) lock_mutex("update");
 
     status = gtm_cip(&access, ret_buf);
 #else
-    if (nodem_state->tp_level == 0) uv_mutex_lock(&mutex_g);
+    if (nodem_state->tp_level == 0) lock_mutex("update");
 
     status = gtm_ci(update, ret_buf);
 #endif
@@ -8450,7 +15202,7 @@ void Nodem::update(const FunctionCallbackInfo<Value>& info)
         gtm_char_t msg_buf[ERR_LEN];
         gtm_zstatus(msg_buf, ERR_LEN);
 
-        if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+        if (nodem_state->tp_level == 0) unlock_mutex();
 
         info.GetReturnValue().Set(error_status(msg_buf, false, false, nodem_state));
         return;
@@ -8466,7 +15218,7 @@ void Nodem::update(const FunctionCallbackInfo<Value>& info)
         json_string = NodemValue::from_byte(ret_buf);
     }
 
-    if (nodem_state->tp_level == 0) uv_mutex_unlock(&mutex_g);
+    if (nodem_state->tp_level == 0) unlock_mutex();
     if (nodem_state->debug > OFF) debug_log(">  Nodem::update JSON string: ", *(UTF8_VALUE_TEMP_N(isolate, json_string)));
 
 #if NODE_MAJOR_VERSION >= 1
@@ -8581,6 +15333,8 @@ void Nodem::Init(Local<Object> exports)
 
     NodemState* nodem_state = new NodemState(isolate, exports);
 
+    trace_init();
+
 #if NODE_MAJOR_VERSION >= 11 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 7)
     AddEnvironmentCleanupHook(isolate, cleanup_nodem_state, static_cast<void*>(nodem_state));
 #endif
@@ -8624,23 +15378,46 @@ void Nodem::Init(Local<Object> exports)
     set_prototype_method_n(isolate, fn_template, "get", get, external_data);
     set_prototype_method_n(isolate, fn_template, "set", set, external_data);
     set_prototype_method_n(isolate, fn_template, "kill", kill, external_data);
+#if NODEM_SIMPLE_API == 1
+    set_prototype_method_n(isolate, fn_template, "killTree", kill_tree, external_data);
+#endif
     set_prototype_method_n(isolate, fn_template, "merge", merge, external_data);
     set_prototype_method_n(isolate, fn_template, "order", order, external_data);
     set_prototype_method_n(isolate, fn_template, "next", order, external_data);
     set_prototype_method_n(isolate, fn_template, "previous", previous, external_data);
+#if NODEM_SIMPLE_API == 1
+    set_prototype_method_n(isolate, fn_template, "scan", scan, external_data);
+    set_prototype_method_n(isolate, fn_template, "toJSON", to_json, external_data);
+    set_prototype_method_n(isolate, fn_template, "fromJSON", from_json, external_data);
+    set_prototype_method_n(isolate, fn_template, "countDistinct", count_distinct, external_data);
+    set_prototype_method_n(isolate, fn_template, "sample", sample, external_data);
+    set_prototype_method_n(isolate, fn_template, "sorterWrite", sorter_write, external_data);
+    set_prototype_method_n(isolate, fn_template, "sorterRead", sorter_read, external_data);
+    set_prototype_method_n(isolate, fn_template, "bloom", bloom, external_data);
+    set_prototype_method_n(isolate, fn_template, "defineAggregate", define_aggregate, external_data);
+    set_prototype_method_n(isolate, fn_template, "prune", prune, external_data);
+    set_prototype_method_n(isolate, fn_template, "move", move, external_data);
+#endif
     set_prototype_method_n(isolate, fn_template, "nextNode", next_node, external_data);
     set_prototype_method_n(isolate, fn_template, "next_node", next_node_deprecated, external_data);
     set_prototype_method_n(isolate, fn_template, "previousNode", previous_node, external_data);
     set_prototype_method_n(isolate, fn_template, "previous_node", previous_node_deprecated, external_data);
     set_prototype_method_n(isolate, fn_template, "increment", increment, external_data);
+#if NODEM_SIMPLE_API == 1
+    set_prototype_method_n(isolate, fn_template, "stripedCounter", striped_counter, external_data);
+#endif
     set_prototype_method_n(isolate, fn_template, "lock", lock, external_data);
     set_prototype_method_n(isolate, fn_template, "unlock", unlock, external_data);
+    set_prototype_method_n(isolate, fn_template, "lockStats", lock_stats, external_data);
 #if NODEM_SIMPLE_API == 1
     set_prototype_method_n(isolate, fn_template, "transaction", transaction, external_data);
+    set_prototype_method_n(isolate, fn_template, "readConsistent", read_consistent, external_data);
+    set_prototype_method_n(isolate, fn_template, "shardedGlobal", sharded_global, external_data);
 #endif
     set_prototype_method_n(isolate, fn_template, "function", function, external_data);
     set_prototype_method_n(isolate, fn_template, "procedure", procedure, external_data);
     set_prototype_method_n(isolate, fn_template, "routine", procedure, external_data);
+    set_prototype_method_n(isolate, fn_template, "batch", batch, external_data);
     set_prototype_method_n(isolate, fn_template, "globalDirectory", global_directory, external_data);
     set_prototype_method_n(isolate, fn_template, "global_directory", global_directory_deprecated, external_data);
     set_prototype_method_n(isolate, fn_template, "localDirectory", local_directory, external_data);
@@ -29,6 +29,19 @@
 #include <node_object_wrap.h>
 #include <node_buffer.h>
 #include <uv.h>
+#include "trace.hh"
+#include "lockstats.hh"
+#include "shard.hh"
+#include "adaptive.hh"
+#include "token.hh"
+#include "packed.hh"
+#include "json.hh"
+#include "filter.hh"
+#include "distinct.hh"
+#include "readahead.hh"
+#include "bloom.hh"
+#include "aggregate.hh"
+#include "movewatch.hh"
 
 extern "C" {
 #include <gtmxc_types.h>
@@ -70,6 +83,20 @@ extern "C" {
 
 #define ERR_LEN 2048
 #define RES_LEN 1048576
+#define KILL_CHUNK 1000
+#define SCAN_LIMIT 100
+#define SCAN_VISITS 10
+#define SAMPLE_SIZE 10
+#define SAMPLE_FANOUT 64
+#define SAMPLE_ATTEMPTS 4
+#define COUNTER_STRIPES 16
+#define COUNTER_MAX_STRIPES 1024
+#define BATON_POOL 16
+#define BATON_RESULTS 4
+#define GROUP_WINDOW 1
+#define GROUP_MAX 64
+#define GROUP_MAX_WINDOW 1000
+#define GROUP_MAX_OPS 65536
 
 namespace nodem {
 
@@ -91,6 +118,11 @@ typedef enum {
     OPEN
 } nodem_state_t;
 
+typedef enum {
+    RESERVOIR,
+    DESCENT
+} sample_t;
+
 extern uv_mutex_t    mutex_g;
 extern mode_t        mode_g;
 extern debug_t       debug_g;
@@ -114,17 +146,34 @@ extern int           save_stdout_g;
  * @method {class} {private} get
  * @method {class} {private} set
  * @method {class} {private} kill
+ * @method {class} {private} kill_tree
  * @method {class} {private} merge
  * @method {class} {private} order
  * @method {class} {private} previous
+ * @method {class} {private} scan
+ * @method {class} {private} to_json
+ * @method {class} {private} from_json
+ * @method {class} {private} count_distinct
+ * @method {class} {private} sample
+ * @method {class} {private} sorter_write
+ * @method {class} {private} sorter_read
+ * @method {class} {private} bloom
+ * @method {class} {private} define_aggregate
+ * @method {class} {private} prune
+ * @method {class} {private} move
  * @method {class} {private} next_node
  * @method {class} {private} previous_node
  * @method {class} {private} increment
+ * @method {class} {private} striped_counter
  * @method {class} {private} lock
  * @method {class} {private} unlock
+ * @method {class} {private} lock_stats
  * @method {class} {private} transaction
+ * @method {class} {private} read_consistent
+ * @method {class} {private} sharded_global
  * @method {class} {private} function
  * @method {class} {private} procedure
+ * @method {class} {private} batch
  * @method {class} {private} global_directory
  * @method {class} {private} local_directory
  * @method {class} {private} retrieve
@@ -162,21 +211,44 @@ private:
     static void get(const v8::FunctionCallbackInfo<v8::Value>&);
     static void set(const v8::FunctionCallbackInfo<v8::Value>&);
     static void kill(const v8::FunctionCallbackInfo<v8::Value>&);
+#if NODEM_SIMPLE_API == 1
+    static void kill_tree(const v8::FunctionCallbackInfo<v8::Value>&);
+#endif
     static void merge(const v8::FunctionCallbackInfo<v8::Value>&);
     static void order(const v8::FunctionCallbackInfo<v8::Value>&);
     static void previous(const v8::FunctionCallbackInfo<v8::Value>&);
+#if NODEM_SIMPLE_API == 1
+    static void scan(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void to_json(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void from_json(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void count_distinct(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void sample(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void sorter_write(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void sorter_read(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void bloom(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void define_aggregate(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void prune(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void move(const v8::FunctionCallbackInfo<v8::Value>&);
+#endif
     static void next_node(const v8::FunctionCallbackInfo<v8::Value>&);
     static void next_node_deprecated(const v8::FunctionCallbackInfo<v8::Value>&);
     static void previous_node(const v8::FunctionCallbackInfo<v8::Value>&);
     static void previous_node_deprecated(const v8::FunctionCallbackInfo<v8::Value>&);
     static void increment(const v8::FunctionCallbackInfo<v8::Value>&);
+#if NODEM_SIMPLE_API == 1
+    static void striped_counter(const v8::FunctionCallbackInfo<v8::Value>&);
+#endif
     static void lock(const v8::FunctionCallbackInfo<v8::Value>&);
     static void unlock(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void lock_stats(const v8::FunctionCallbackInfo<v8::Value>&);
 #if NODEM_SIMPLE_API == 1
     static void transaction(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void read_consistent(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void sharded_global(const v8::FunctionCallbackInfo<v8::Value>&);
 #endif
     static void function(const v8::FunctionCallbackInfo<v8::Value>&);
     static void procedure(const v8::FunctionCallbackInfo<v8::Value>&);
+    static void batch(const v8::FunctionCallbackInfo<v8::Value>&);
     static void global_directory(const v8::FunctionCallbackInfo<v8::Value>&);
     static void global_directory_deprecated(const v8::FunctionCallbackInfo<v8::Value>&);
     static void local_directory(const v8::FunctionCallbackInfo<v8::Value>&);
@@ -257,6 +329,9 @@ private:
     uint8_t* buffer;
 }; // @end nodem::NodemValue class
 
+struct GroupCommit;
+struct NodemBaton;
+
 /*
  * @class nodem::NodemState
  * @summary Holds global state data in a form that can be accessed by multiple threads safely
@@ -264,6 +339,17 @@ private:
  * @destructor ~NodemState
  * @member {bool} utf8
  * @member {bool} auto_relink
+ * @member {bool} adaptive
+ * @member {uint64_t} adaptive_threshold
+ * @member {bool} group_commit
+ * @member {uint64_t} group_window
+ * @member {unsigned int} group_max
+ * @member {GroupCommit*} group_batch
+ * @member {unsigned int} read_ahead
+ * @member {bool} read_ahead_values
+ * @member {uint64_t} read_ahead_clock
+ * @member {ReadAheadWindow[]} read_ahead_windows
+ * @member {vector<NodemBaton*>} baton_pool
  * @member {pid_t} pid
  * @member {pid_t} tid
  * @member {gtm_char_t[]} error
@@ -283,6 +369,15 @@ public:
 #endif
         utf8 {utf8_g},
         auto_relink {auto_relink_g},
+        adaptive {false},
+        adaptive_threshold {ADAPTIVE_THRESHOLD},
+        group_commit {false},
+        group_window {GROUP_WINDOW},
+        group_max {GROUP_MAX},
+        group_batch {nullptr},
+        read_ahead {0},
+        read_ahead_values {false},
+        read_ahead_clock {0},
         tp_level {0},
         tp_restart {0},
         mode {mode_g},
@@ -300,21 +395,24 @@ public:
         return;
     }
 
-    ~NodemState()
-    {
-        if (!exports_p.IsEmpty()) {
-            exports_p.ClearWeak();
-            exports_p.Reset();
-        }
-
-        return;
-    }
+    ~NodemState();
 
 #if YDB_RELEASE >= 126
     bool                         reset_handler;
 #endif
     bool                         utf8;
     bool                         auto_relink;
+    bool                         adaptive;
+    uint64_t                     adaptive_threshold;
+    bool                         group_commit;
+    uint64_t                     group_window;
+    unsigned int                 group_max;
+    GroupCommit*                 group_batch;
+    unsigned int                 read_ahead;
+    bool                         read_ahead_values;
+    uint64_t                     read_ahead_clock;
+    ReadAheadWindow              read_ahead_windows[READ_AHEAD_LEVELS];
+    std::vector<NodemBaton*>     baton_pool;
     pid_t                        pid;
     pid_t                        tid;
     short                        tp_level;
@@ -360,18 +458,33 @@ private:
  * @member {Persistent/Global<Function>} object_p
  * @member {Persistent/Global<Function>} arguments_p
  * @member {Persistent/Global<Function>} data_p
+ * @member {Global<Promise::Resolver>} resolver_p
+ * @member {Local<Function>} callback
+ * @member {Local<Object>} object
+ * @member {Local<Value>} arguments
+ * @member {Local<Value>} data
  * @member {string} name
  * @member {string} to_name
  * @member {string} args
  * @member {string} to_args
  * @member {string} value
  * @member {vector<string>} subs_array
+ * @member {vector<string>} to_subs_array
+ * @member {vector<string>} values_array
+ * @member {vector<unsigned int>} data_array
+ * @member {vector<vector<string>>} nodes_array
  * @member {mode_t} mode
  * @member {bool} async
  * @member {bool} local
  * @member {bool} position
  * @member {bool} routine
  * @member {bool} node_only
+ * @member {bool} adaptive
+ * @member {bool} reverse
+ * @member {bool} packed
+ * @member {bool} atomic
+ * @member {bool} sketch
+ * @member {filter_ptr_t} filter
  * @member {uint32_t} relink
  * @member {gtm_double_t} option
  * @member {gtm_status_t} status
@@ -395,18 +508,35 @@ struct NodemBaton {
     v8::Persistent<v8::Value>    arguments_p;
     v8::Persistent<v8::Value>    data_p;
 #endif
+#if NODE_MAJOR_VERSION >= 8
+    v8::Global<v8::Promise::Resolver> resolver_p;
+#endif
+    v8::Local<v8::Function>      callback;
+    v8::Local<v8::Object>        object;
+    v8::Local<v8::Value>         arguments;
+    v8::Local<v8::Value>         data;
     std::string                  name;
     std::string                  to_name;
     std::string                  args;
     std::string                  to_args;
     std::string                  value;
     std::vector<std::string>     subs_array;
+    std::vector<std::string>     to_subs_array;
+    std::vector<std::string>     values_array;
+    std::vector<unsigned int>    data_array;
+    std::vector<std::vector<std::string>> nodes_array;
     mode_t                       mode;
     bool                         async;
     bool                         local;
     bool                         position;
     bool                         routine;
     bool                         node_only;
+    bool                         adaptive;
+    bool                         reverse;
+    bool                         packed;
+    bool                         atomic;
+    bool                         sketch;
+    filter_ptr_t                 filter;
     uint32_t                     relink;
     gtm_double_t                 option;
     gtm_status_t                 status;
@@ -0,0 +1,155 @@
+/*
+ * Package:    NodeM
+ * File:       packed.cc
+ * Summary:    Packed, prefix-compressed binary results, decoded on demand by lib/packed.js
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "packed.hh"
+#include "utility.hh"
+
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+/*
+ * Layout, with all integers little-endian:
+ *   header - "NP", version, kind, flags (bit 0 is UTF-8), 3 reserved bytes, and a 32-bit result count
+ *   result - $DATA byte; varint parts kept from the previous key; varint bytes kept from the previous key's next part;
+ *            varint count of new parts, each a varint length and its bytes (the first one only the bytes after those kept);
+ *            and the value, as a varint length and its bytes
+ * Each length is shifted left one bit, with bit 0 set when the part or value is a canonical number
+ */
+
+/*
+ * @class nodem::PackWriter
+ * @constructor PackWriter
+ * @summary Start a packed buffer, with its header
+ * @param {pack_kind_t} kind - Which API the results are from, which tells the decoder how to shape them
+ * @param {bool} utf8 - Whether the keys and values are UTF-8, or bytes
+ * @param {bool} canonical - Whether to mark canonical numbers, so the decoder returns them as numbers
+ */
+PackWriter::PackWriter(const pack_kind_t kind, const bool utf8, const bool canonical) :
+    count {0},
+    canonical {canonical}
+{
+    buffer.reserve(4096);
+    buffer.append("NP");
+    buffer.push_back(static_cast<char>(PACK_VERSION));
+    buffer.push_back(static_cast<char>(kind));
+    buffer.push_back(static_cast<char>(utf8 ? 1 : 0));
+    buffer.append(PACK_HEADER - 5, '\0');
+
+    return;
+}
+
+/*
+ * @class nodem::PackWriter
+ * @method {instance} {private} put_varint
+ * @summary Append an unsigned integer, seven bits per byte, with the high bit set on every byte but the last
+ * @param {uint64_t} value - The integer
+ * @returns {void}
+ */
+void PackWriter::put_varint(uint64_t value)
+{
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    buffer.push_back(static_cast<char>(value));
+    return;
+} // @end PackWriter::put_varint method
+
+/*
+ * @class nodem::PackWriter
+ * @method {instance} {private} put_part
+ * @summary Append a key part or value, as its length, marked when it is a canonical number, and its bytes
+ * @param {char*} data - The bytes to append
+ * @param {size_t} length - Number of bytes to append
+ * @param {bool} number - Whether the whole part or value is a canonical number
+ * @returns {void}
+ */
+void PackWriter::put_part(const char* data, const size_t length, const bool number)
+{
+    put_varint((static_cast<uint64_t>(length) << 1) | (number ? 1 : 0));
+    buffer.append(data, length);
+
+    return;
+} // @end PackWriter::put_part method
+
+/*
+ * @class nodem::PackWriter
+ * @method {instance} add
+ * @summary Append one result, keeping whatever its key shares with the previous result's key
+ * @param {string*} key - The parts of the key, e.g. a subscript, or a name followed by its subscripts
+ * @param {size_t} parts - Number of parts in the key
+ * @param {unsigned int} data - $DATA of the node, or whether it has a value
+ * @param {string} value - Value of the node, which is empty when it has none
+ * @returns {void}
+ */
+void PackWriter::add(const string* key, const size_t parts, const unsigned int data, const string& value)
+{
+    size_t keep_parts = 0;
+
+    while (keep_parts < parts && keep_parts < previous.size() && key[keep_parts] == previous[keep_parts]) keep_parts++;
+
+    size_t keep_bytes = 0;
+
+    if (keep_parts < parts && keep_parts < previous.size()) {
+        const string& next = key[keep_parts];
+        const string& last = previous[keep_parts];
+
+        while (keep_bytes < next.length() && keep_bytes < last.length() && next[keep_bytes] == last[keep_bytes]) keep_bytes++;
+    }
+
+    buffer.push_back(static_cast<char>(data));
+    put_varint(keep_parts);
+    put_varint(keep_bytes);
+    put_varint(parts - keep_parts);
+
+    for (size_t i = keep_parts; i < parts; i++) {
+        size_t skip = (i == keep_parts) ? keep_bytes : 0;
+
+        put_part(key[i].data() + skip, key[i].length() - skip, canonical && is_number(key[i]));
+    }
+
+    put_part(value.data(), value.length(), canonical && data % 10 == 1 && is_number(value));
+
+    previous.assign(key, key + parts);
+    count++;
+
+    return;
+} // @end PackWriter::add method
+
+/*
+ * @class nodem::PackWriter
+ * @method {instance} finish
+ * @summary Fill in the result count, and return the packed buffer
+ * @returns {string} - The packed buffer
+ */
+const string& PackWriter::finish(void)
+{
+    for (unsigned int i = 0; i < 4; i++) buffer[PACK_HEADER - 4 + i] = static_cast<char>((count >> (8 * i)) & 0xFF);
+
+    return buffer;
+} // @end PackWriter::finish method
+
+} // @end namespace nodem
@@ -0,0 +1,71 @@
+/*
+ * Package:    NodeM
+ * File:       packed.hh
+ * Summary:    Packed, prefix-compressed binary results, decoded on demand by lib/packed.js
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef PACKED_HH
+#   define PACKED_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define PACK_VERSION 1
+#define PACK_HEADER  12
+
+namespace nodem {
+
+enum pack_kind_t {
+    PACK_SCAN       = 1,
+    PACK_CONSISTENT = 2
+};
+
+/*
+ * @class nodem::PackWriter
+ * @summary Build the packed layout of a list of results, each one a key, its $DATA, and its value, in one buffer
+ * @constructor PackWriter
+ * @method {instance} add
+ * @method {instance} finish
+ * @member {string} {private} buffer
+ * @member {vector<string>} {private} previous
+ * @member {uint32_t} {private} count
+ * @member {bool} {private} canonical
+ */
+class PackWriter {
+public:
+    PackWriter(const pack_kind_t, const bool, const bool);
+
+    void add(const std::string*, const size_t, const unsigned int, const std::string&);
+    const std::string& finish(void);
+
+private:
+    void put_varint(uint64_t);
+    void put_part(const char*, const size_t, const bool);
+
+    std::string                 buffer;
+    std::vector<std::string>    previous;
+    uint32_t                    count;
+    bool                        canonical;
+}; // @end nodem::PackWriter class
+
+} // @end namespace nodem
+
+#endif // @end PACKED_HH
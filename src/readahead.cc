@@ -0,0 +1,92 @@
+/*
+ * Package:    NodeM
+ * File:       readahead.cc
+ * Summary:    Write generations, per global or local name, that invalidate read-ahead windows
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "readahead.hh"
+#include "utility.hh"
+#include <atomic>
+
+using std::string;
+
+namespace nodem {
+
+static std::atomic<uint64_t> read_ahead_epoch_g {0};
+static std::atomic<uint64_t> read_ahead_slots_g[READ_AHEAD_SLOTS];
+
+/*
+ * @function {private} nodem::read_ahead_slot
+ * @summary Hash a global or local name to its generation slot; an extended reference shares the slot of the plain global name
+ * @param {string} name - Global or local name, which can be an extended reference
+ * @returns {unsigned int} - The slot
+ */
+static unsigned int read_ahead_slot(const string& name)
+{
+    const string plain = plain_name(name);
+
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (const char& c : plain) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+
+    return static_cast<unsigned int>(hash % READ_AHEAD_SLOTS);
+} // @end nodem::read_ahead_slot function
+
+/*
+ * @function nodem::read_ahead_generation
+ * @summary Return the write generation of a name; it changes whenever the name, or every name, is written through Nodem
+ * @param {string} name - Global or local name
+ * @returns {uint64_t} - The generation, to compare with the one a read-ahead window was filled at
+ */
+uint64_t read_ahead_generation(const string& name)
+{
+    return read_ahead_epoch_g.load(std::memory_order_acquire) +
+      read_ahead_slots_g[read_ahead_slot(name)].load(std::memory_order_acquire);
+} // @end nodem::read_ahead_generation function
+
+/*
+ * @function nodem::read_ahead_invalidate
+ * @summary Invalidate the read-ahead windows on a name, after a write to it through Nodem
+ * @param {string} name - Global or local name; an empty name, from a kill of every local variable, invalidates every window
+ * @returns {void}
+ */
+void read_ahead_invalidate(const string& name)
+{
+    if (name.empty()) {
+        read_ahead_invalidate_all();
+        return;
+    }
+
+    read_ahead_slots_g[read_ahead_slot(name)].fetch_add(1, std::memory_order_acq_rel);
+    return;
+} // @end nodem::read_ahead_invalidate function
+
+/*
+ * @function nodem::read_ahead_invalidate_all
+ * @summary Invalidate every read-ahead window, after a call that can write to any name, e.g. M code run by function or procedure
+ * @returns {void}
+ */
+void read_ahead_invalidate_all(void)
+{
+    read_ahead_epoch_g.fetch_add(1, std::memory_order_acq_rel);
+    return;
+} // @end nodem::read_ahead_invalidate_all function
+
+} // @end namespace nodem
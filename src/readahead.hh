@@ -0,0 +1,74 @@
+/*
+ * Package:    NodeM
+ * File:       readahead.hh
+ * Summary:    Read-ahead windows for sequential order and previous calls, and the write generations that invalidate them
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef READAHEAD_HH
+#   define READAHEAD_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define READ_AHEAD_SIZE    64
+#define READ_AHEAD_LEVELS  4
+#define READ_AHEAD_SLOTS   256
+
+namespace nodem {
+
+/*
+ * @struct nodem::ReadAheadWindow
+ * @summary The subscripts prefetched after the last one returned by order or previous at one level, and optionally their values
+ * @member {string} name
+ * @member {vector<string>} parent
+ * @member {vector<string>} keys
+ * @member {vector<string>} values
+ * @member {vector<bool>} defined
+ * @member {string} last
+ * @member {uint64_t} generation
+ * @member {uint64_t} used
+ * @member {unsigned int} position
+ * @member {bool} reverse
+ * @member {bool} end
+ * @member {bool} armed
+ */
+struct ReadAheadWindow {
+    std::string                 name;
+    std::vector<std::string>    parent;
+    std::vector<std::string>    keys;
+    std::vector<std::string>    values;
+    std::vector<bool>           defined;
+    std::string                 last;
+    uint64_t                    generation = 0;
+    uint64_t                    used = 0;
+    unsigned int                position = 0;
+    bool                        reverse = false;
+    bool                        end = false;
+    bool                        armed = false;
+}; // @end nodem::ReadAheadWindow struct
+
+uint64_t read_ahead_generation(const std::string&);
+void read_ahead_invalidate(const std::string&);
+void read_ahead_invalidate_all(void);
+
+} // @end namespace nodem
+
+#endif // @end READAHEAD_HH
@@ -0,0 +1,90 @@
+/*
+ * Package:    NodeM
+ * File:       registry.hh
+ * Summary:    Definitions shared by every thread in the process, behind a reader-writer lock
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef REGISTRY_HH
+#   define REGISTRY_HH
+
+#include <uv.h>
+#include <atomic>
+
+namespace nodem {
+
+/*
+ * @template nodem::Registry
+ * @summary Definitions shared by every thread, behind a reader-writer lock, and counted so that calls can skip the lock when there are none
+ * @param {C} C - The container type; read returns it for lookups, and write for changes, until read_done or write_done
+ * @member {C} {private} entries
+ * @member {uv_rwlock_t} {private} lock
+ * @member {atomic<size_t>} {private} count
+ */
+template<class C>
+class Registry {
+public:
+    Registry() : count {0}
+    {
+        uv_rwlock_init(&lock);
+        return;
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    bool empty(void) const
+    {
+        return count == 0;
+    }
+
+    const C& read(void)
+    {
+        uv_rwlock_rdlock(&lock);
+        return entries;
+    }
+
+    void read_done(void)
+    {
+        uv_rwlock_rdunlock(&lock);
+        return;
+    }
+
+    C& write(void)
+    {
+        uv_rwlock_wrlock(&lock);
+        return entries;
+    }
+
+    void write_done(void)
+    {
+        count = entries.size();
+        uv_rwlock_wrunlock(&lock);
+        return;
+    }
+
+private:
+    C                   entries;
+    uv_rwlock_t         lock;
+    std::atomic<size_t> count;
+}; // @end nodem::Registry class template
+
+} // @end namespace nodem
+
+#endif // @end REGISTRY_HH
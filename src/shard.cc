@@ -0,0 +1,175 @@
+/*
+ * Package:    NodeM
+ * File:       shard.cc
+ * Summary:    Client-side sharding of a logical global across multiple global directories
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "shard.hh"
+#include "registry.hh"
+#include "utility.hh"
+#include <cstdlib>
+#include <map>
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+static Registry<map<string, shard_ptr_t>> shards_g;
+
+/*
+ * @function nodem::shard_define
+ * @summary Add a sharded global definition, or replace the existing definition of the same global
+ * @param {ShardedGlobal} shard - The definition, with the global name including its leading ^
+ * @returns {void}
+ */
+void shard_define(const ShardedGlobal& shard)
+{
+    shards_g.write()[shard.name] = std::make_shared<const ShardedGlobal>(shard);
+    shards_g.write_done();
+    return;
+} // @end nodem::shard_define function
+
+/*
+ * @function nodem::shard_remove
+ * @summary Remove a sharded global definition; calls already routed by it keep their own reference to it
+ * @param {string} name - Global name, including its leading ^
+ * @returns {bool} - Whether there was a definition to remove
+ */
+bool shard_remove(const string& name)
+{
+    bool removed = shards_g.write().erase(name) > 0;
+    shards_g.write_done();
+    return removed;
+} // @end nodem::shard_remove function
+
+/*
+ * @function nodem::shard_find
+ * @summary Look up the sharded global definition for a global, without taking a lock when there are none
+ * @param {string} name - Global name, including its leading ^
+ * @returns {shard_ptr_t} - The definition, or an empty pointer if the global is not sharded
+ */
+shard_ptr_t shard_find(const string& name)
+{
+    if (shards_g.empty() || name[0] != '^') return shard_ptr_t {};
+
+    const map<string, shard_ptr_t>& shards = shards_g.read();
+
+    map<string, shard_ptr_t>::const_iterator shard = shards.find(name);
+    shard_ptr_t found = (shard == shards.end()) ? shard_ptr_t {} : shard->second;
+
+    shards_g.read_done();
+    return found;
+} // @end nodem::shard_find function
+
+/*
+ * @function nodem::shard_index
+ * @summary Choose the shard that holds every node under a key subscript
+ * @param {ShardedGlobal} shard - The sharded global definition
+ * @param {string} key - The subscript at the definition's key level
+ * @returns {unsigned int} - Index of the shard, in the definition's glds
+ */
+unsigned int shard_index(const ShardedGlobal& shard, const string& key)
+{
+    unsigned int count = shard.glds.size();
+
+    if (shard.hash == MODULO && is_canonical(key) && key.find('.') == string::npos) {
+        long long number = strtoll(key.c_str(), NULL, 10);
+
+        return static_cast<unsigned int>((number < 0 ? -(number + 1) : number) % count);
+    }
+
+    // 32-bit FNV-1a, which spreads short and sequential keys evenly
+    uint32_t hash = 2166136261U;
+
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 16777619U;
+    }
+
+    return hash % count;
+} // @end nodem::shard_index function
+
+/*
+ * @function nodem::shard_collate
+ * @summary Compare two subscripts in M collation order; the empty string, then canonical numbers, then strings
+ * @param {string} first - Subscript to compare
+ * @param {string} second - Subscript to compare
+ * @returns {int} - Negative, zero, or positive, as first collates before, with, or after second
+ */
+int shard_collate(const string& first, const string& second)
+{
+    if (first.empty() || second.empty()) return static_cast<int>(second.empty()) - static_cast<int>(first.empty());
+
+    bool first_number = is_canonical(first);
+    bool second_number = is_canonical(second);
+
+    if (first_number != second_number) return first_number ? -1 : 1;
+    if (!first_number) return first.compare(second);
+
+    bool first_negative = first[0] == '-';
+    bool second_negative = second[0] == '-';
+
+    if (first_negative != second_negative) return first_negative ? -1 : 1;
+
+    string first_digits = first.substr(first_negative ? 1 : 0);
+    string second_digits = second.substr(second_negative ? 1 : 0);
+
+    if (first_digits == "0") first_digits.clear();
+    if (second_digits == "0") second_digits.clear();
+
+    size_t first_point = first_digits.find('.');
+    size_t second_point = second_digits.find('.');
+
+    if (first_point == string::npos) first_point = first_digits.length();
+    if (second_point == string::npos) second_point = second_digits.length();
+
+    // Canonical numbers have no leading zeros, so a longer integer part is a larger magnitude
+    int magnitude;
+
+    if (first_point != second_point) {
+        magnitude = (first_point < second_point) ? -1 : 1;
+    } else {
+        magnitude = first_digits.compare(second_digits);
+    }
+
+    return first_negative ? -magnitude : magnitude;
+} // @end nodem::shard_collate function
+
+/*
+ * @function nodem::shard_collate
+ * @summary Compare two nodes in M collation order, where a node collates before its descendants
+ * @param {vector<string>} first - Subscripts of the node to compare
+ * @param {vector<string>} second - Subscripts of the node to compare
+ * @returns {int} - Negative, zero, or positive, as first collates before, with, or after second
+ */
+int shard_collate(const vector<string>& first, const vector<string>& second)
+{
+    for (unsigned int i = 0; i < first.size() && i < second.size(); i++) {
+        int order = shard_collate(first[i], second[i]);
+
+        if (order != 0) return order;
+    }
+
+    return (first.size() < second.size()) ? -1 : (first.size() > second.size()) ? 1 : 0;
+} // @end nodem::shard_collate function
+
+} // @end namespace nodem
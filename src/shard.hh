@@ -0,0 +1,69 @@
+/*
+ * Package:    NodeM
+ * File:       shard.hh
+ * Summary:    Client-side sharding of a logical global across multiple global directories
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef SHARD_HH
+#   define SHARD_HH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SHARD_MAX 64
+
+namespace nodem {
+
+enum shard_hash_t {
+    FNV1A  = 0,
+    MODULO = 1
+};
+
+/*
+ * @struct nodem::ShardedGlobal
+ * @summary A global whose nodes are spread across several global directories, by the subscript at key_level
+ * @member {string} name
+ * @member {vector<string>} glds
+ * @member {vector<string>} regions
+ * @member {unsigned int} key_level
+ * @member {shard_hash_t} hash
+ */
+struct ShardedGlobal {
+    std::string                 name;
+    std::vector<std::string>    glds;
+    std::vector<std::string>    regions;
+    unsigned int                key_level;
+    shard_hash_t                hash;
+}; // @end nodem::ShardedGlobal struct
+
+typedef std::shared_ptr<const ShardedGlobal> shard_ptr_t;
+
+void shard_define(const ShardedGlobal&);
+bool shard_remove(const std::string&);
+shard_ptr_t shard_find(const std::string&);
+unsigned int shard_index(const ShardedGlobal&, const std::string&);
+int shard_collate(const std::string&, const std::string&);
+int shard_collate(const std::vector<std::string>&, const std::vector<std::string>&);
+
+} // @end namespace nodem
+
+#endif // @end SHARD_HH
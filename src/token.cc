@@ -0,0 +1,194 @@
+/*
+ * Package:    NodeM
+ * File:       token.cc
+ * Summary:    Opaque continuation tokens, to resume paged scans without a server-side cursor
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "token.hh"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+using std::string;
+using std::vector;
+
+namespace nodem {
+
+static const char token_alphabet_g[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/*
+ * @function {private} nodem::token_scope
+ * @summary Hash the global or local name, parent subscripts, and direction that a token is valid for
+ * @param {string} name - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node whose children are being scanned
+ * @param {bool} reverse - Whether the scan is in reverse collation order
+ * @returns {uint32_t} - 32-bit FNV-1a hash
+ */
+static uint32_t token_scope(const string& name, const vector<string>& subs, const bool reverse)
+{
+    uint32_t hash = 2166136261U;
+
+    auto add = [&hash](const string& data) {
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 16777619U;
+        }
+
+        // Separate the parts, so that ("ab", "c") and ("a", "bc") hash differently
+        hash ^= 0xFF;
+        hash *= 16777619U;
+    };
+
+    add(name);
+    for (const string& sub : subs) add(sub);
+    add(reverse ? "R" : "F");
+
+    return hash;
+} // @end nodem::token_scope function
+
+/*
+ * @function nodem::token_encode
+ * @summary Build a continuation token, in URL-safe base64, holding only the last key returned and a check of what it belongs to
+ * @param {string} name - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node whose children are being scanned
+ * @param {bool} reverse - Whether the scan is in reverse collation order
+ * @param {string} key - The last subscript returned, to resume after
+ * @returns {string} - The continuation token
+ */
+string token_encode(const string& name, const vector<string>& subs, const bool reverse, const string& key)
+{
+    uint32_t scope = token_scope(name, subs, reverse);
+    string raw;
+
+    raw += static_cast<char>(TOKEN_VERSION);
+    for (int shift = 24; shift >= 0; shift -= 8) raw += static_cast<char>((scope >> shift) & 0xFF);
+    raw += key;
+
+    string token;
+    unsigned int bits = 0;
+    uint32_t buffer = 0;
+
+    for (unsigned char c : raw) {
+        buffer = (buffer << 8) | c;
+        bits += 8;
+
+        while (bits >= 6) {
+            bits -= 6;
+            token += token_alphabet_g[(buffer >> bits) & 0x3F];
+        }
+    }
+
+    if (bits > 0) token += token_alphabet_g[(buffer << (6 - bits)) & 0x3F];
+
+    return token;
+} // @end nodem::token_encode function
+
+/*
+ * @function nodem::token_decode
+ * @summary Check that a continuation token belongs to a scan, and recover the key to resume after
+ * @param {string} token - The continuation token, from token_encode
+ * @param {string} name - Global or local name
+ * @param {vector<string>} subs - Subscripts of the node whose children are being scanned
+ * @param {bool} reverse - Whether the scan is in reverse collation order
+ * @param {string} key - The subscript to resume after, on output
+ * @returns {bool} - Whether the token is well formed, and was made by the same scan
+ */
+bool token_decode(const string& token, const string& name, const vector<string>& subs, const bool reverse, string& key)
+{
+    string raw;
+    unsigned int bits = 0;
+    uint32_t buffer = 0;
+
+    for (char c : token) {
+        const char* position = c == '\0' ? nullptr : strchr(token_alphabet_g, c);
+
+        if (position == nullptr) return false;
+
+        buffer = (buffer << 6) | static_cast<uint32_t>(position - token_alphabet_g);
+        bits += 6;
+
+        if (bits >= 8) {
+            bits -= 8;
+            raw += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+    }
+
+    if (raw.length() < 5 || raw[0] != static_cast<char>(TOKEN_VERSION)) return false;
+
+    uint32_t scope = 0;
+
+    for (int i = 1; i <= 4; i++) scope = (scope << 8) | static_cast<unsigned char>(raw[i]);
+
+    if (scope != token_scope(name, subs, reverse)) return false;
+
+    key = raw.substr(5);
+
+    return true;
+} // @end nodem::token_decode function
+
+/*
+ * @function nodem::token_join
+ * @summary Join a path of subscripts in to one key, each as its length and a colon followed by its data, to carry in a token
+ * @param {vector<string>} path - Subscripts of the path
+ * @returns {string} - The joined key
+ */
+string token_join(const vector<string>& path)
+{
+    string key;
+
+    for (const string& sub : path) key += std::to_string(sub.length()) + ":" + sub;
+
+    return key;
+} // @end nodem::token_join function
+
+/*
+ * @function nodem::token_split
+ * @summary Split a key made by token_join back in to its path of subscripts
+ * @param {string} key - The joined key
+ * @param {vector<string>} path - Subscripts of the path, on output
+ * @returns {bool} - Whether the key is well formed
+ */
+bool token_split(const string& key, vector<string>& path)
+{
+    size_t position = 0;
+
+    path.clear();
+
+    while (position < key.length()) {
+        size_t colon = key.find(':', position);
+
+        if (colon == string::npos || colon == position || colon - position > 10) return false;
+
+        for (size_t i = position; i < colon; i++) {
+            if (key[i] < '0' || key[i] > '9') return false;
+        }
+
+        size_t length = strtoul(key.c_str() + position, NULL, 10);
+
+        if (length > key.length() - colon - 1) return false;
+
+        path.push_back(key.substr(colon + 1, length));
+        position = colon + 1 + length;
+    }
+
+    return true;
+} // @end nodem::token_split function
+
+} // @end namespace nodem
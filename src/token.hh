@@ -0,0 +1,41 @@
+/*
+ * Package:    NodeM
+ * File:       token.hh
+ * Summary:    Opaque continuation tokens, to resume paged scans without a server-side cursor
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef TOKEN_HH
+#   define TOKEN_HH
+
+#include <string>
+#include <vector>
+
+#define TOKEN_VERSION 1
+
+namespace nodem {
+
+std::string token_encode(const std::string&, const std::vector<std::string>&, const bool, const std::string&);
+bool token_decode(const std::string&, const std::string&, const std::vector<std::string>&, const bool, std::string&);
+std::string token_join(const std::vector<std::string>&);
+bool token_split(const std::string&, std::vector<std::string>&);
+
+} // @end namespace nodem
+
+#endif // @end TOKEN_HH
@@ -0,0 +1,186 @@
+/*
+ * Package:    NodeM
+ * File:       trace.hh
+ * Summary:    Emit Node.js trace events for the phases of each Nodem API call
+ * Maintainer: David Wicksell <dlw@linux.com>
+ *
+ * Written by David Wicksell <dlw@linux.com>
+ * Copyright © 2024 Fourth Watch Software LC
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License (AGPL) as published
+ * by the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef TRACE_HH
+#   define TRACE_HH
+
+#include <node.h>
+#include <uv.h>
+#include <cstdint>
+#include <string>
+
+//  node::GetTracingController was made public in Node.js 12; older versions compile the tracing calls away
+#if NODE_MAJOR_VERSION >= 12 && !defined(V8_USE_PERFETTO)
+#   define NODEM_TRACE 1
+#else
+#   define NODEM_TRACE 0
+#endif
+
+//  Values from V8's trace_event_common.h, which is not shipped with the Node.js headers
+#define NODEM_TRACE_FLAG_NONE        0
+#define NODEM_TRACE_FLAG_HAS_ID      (1 << 1)
+#define NODEM_TRACE_TYPE_COPY_STRING 7
+
+namespace nodem {
+
+extern uv_mutex_t                mutex_g;
+extern const uint8_t*            trace_category_g;
+extern thread_local unsigned int mutex_depth_g;
+
+/*
+ * @function {private} nodem::trace_init
+ * @summary Look up the enabled flag for the "nodem" trace category, which Node.js keeps current as tracing is turned on and off
+ * @returns {void}
+ */
+inline static void trace_init(void)
+{
+#if NODEM_TRACE == 1
+    if (trace_category_g == nullptr) trace_category_g = node::GetTracingController()->GetCategoryGroupEnabled("nodem");
+#endif
+
+    return;
+} // @end nodem::trace_init function
+
+/*
+ * @function {private} nodem::trace_enabled
+ * @summary Check whether the "nodem" trace category is currently being recorded
+ * @returns {bool} - Whether to emit trace events
+ */
+inline static bool trace_enabled(void)
+{
+#if NODEM_TRACE == 1
+    return trace_category_g != nullptr && *trace_category_g != 0;
+#else
+    return false;
+#endif
+} // @end nodem::trace_enabled function
+
+/*
+ * @function {private} nodem::trace_event
+ * @summary Add one event to the "nodem" trace category, with the global or local name as its argument
+ * @param {char} phase - Trace event phase: 'B'/'E' for a span on one thread, 'b'/'e' for a span that crosses threads
+ * @param {char*} event - Name of the traced phase (queue, mutex-wait, db, or marshal)
+ * @param {string} name - Global or local name (or routine name) the API call is operating on
+ * @param {void*} id - Identifier that pairs cross-thread begin and end events; defaults to none
+ * @returns {void}
+ */
+inline static void trace_event(const char phase, const char* event, const std::string& name, const void* id = nullptr)
+{
+#if NODEM_TRACE == 1
+    const char* arg_names[1] = {"global"};
+    const uint8_t arg_types[1] = {NODEM_TRACE_TYPE_COPY_STRING};
+    const uint64_t arg_values[1] = {static_cast<uint64_t>(reinterpret_cast<uintptr_t>(name.c_str()))};
+
+    node::GetTracingController()->AddTraceEvent(phase, trace_category_g, event, nullptr,
+      static_cast<uint64_t>(reinterpret_cast<uintptr_t>(id)), 0, 1, arg_names, arg_types, arg_values, nullptr,
+      id == nullptr ? NODEM_TRACE_FLAG_NONE : NODEM_TRACE_FLAG_HAS_ID);
+#endif
+
+    return;
+} // @end nodem::trace_event function
+
+/*
+ * @class nodem::TraceSpan
+ * @summary Emit a begin event on construction and an end event on destruction, when the "nodem" trace category is enabled
+ * @constructor TraceSpan
+ * @destructor ~TraceSpan
+ * @member {char*} {private} event
+ * @member {string} {private} name
+ * @member {bool} {private} enabled
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* evt, const std::string& nam) :
+        event {evt},
+        name {nam},
+        enabled {trace_enabled()}
+    {
+        if (enabled) trace_event('B', event, name);
+        return;
+    }
+
+    ~TraceSpan()
+    {
+        if (enabled) trace_event('E', event, name);
+        return;
+    }
+
+private:
+    const char*        event;
+    const std::string& name;
+    bool               enabled;
+}; // @end nodem::TraceSpan class
+
+/*
+ * @function {private} nodem::lock_mutex
+ * @summary Lock the global database mutex, tracing the time spent waiting for it if another thread holds it
+ * @param {string} name - Global or local name the caller is about to operate on
+ * @returns {void}
+ */
+inline static void lock_mutex(const std::string& name)
+{
+    // Nested calls from the same thread, e.g. a sharded global call to the API it routes, only count the depth
+    if (mutex_depth_g++ > 0) return;
+
+    if (!trace_enabled()) {
+        uv_mutex_lock(&mutex_g);
+        return;
+    }
+
+    if (uv_mutex_trylock(&mutex_g) == 0) return;
+
+    TraceSpan trace_span("mutex-wait", name);
+    uv_mutex_lock(&mutex_g);
+
+    return;
+} // @end nodem::lock_mutex function
+
+/*
+ * @function {private} nodem::try_lock_mutex
+ * @summary Lock the global database mutex only if no thread holds it, including this one, which would be in the middle of a call
+ * @returns {bool} - Whether the mutex was locked, to be released with unlock_mutex
+ */
+inline static bool try_lock_mutex(void)
+{
+    if (mutex_depth_g > 0 || uv_mutex_trylock(&mutex_g) != 0) return false;
+
+    mutex_depth_g = 1;
+    return true;
+} // @end nodem::try_lock_mutex function
+
+/*
+ * @function {private} nodem::unlock_mutex
+ * @summary Unlock the global database mutex, once the outermost lock_mutex call on this thread is done with it
+ * @returns {void}
+ */
+inline static void unlock_mutex(void)
+{
+    if (--mutex_depth_g > 0) return;
+
+    uv_mutex_unlock(&mutex_g);
+    return;
+} // @end nodem::unlock_mutex function
+
+} // @end namespace nodem
+
+#endif // @end TRACE_HH
@@ -25,8 +25,11 @@
 #   define UTILITY_HH
 
 #include <unistd.h>
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <sstream>
+#include <string>
 
 namespace nodem {
 
@@ -83,6 +86,87 @@ static void debug_log(A... args)
     return;
 } // @end nodem::debug_log variadic template function
 
+/*
+ * @function {private} nodem::is_canonical
+ * @summary Check whether a subscript is a canonical number, which M collates before strings and displays without quotes
+ * @param {string} subscript - The subscript to check
+ * @returns {bool} - Whether the subscript is a canonical number
+ */
+inline static bool is_canonical(const std::string& subscript)
+{
+    size_t digit = (!subscript.empty() && subscript[0] == '-') ? 1 : 0;
+
+    if (subscript.length() == digit || subscript == "-0") return false;
+    if (subscript.find_first_not_of("0123456789.", digit) != std::string::npos) return false;
+
+    size_t point = subscript.find('.');
+
+    if (point == std::string::npos) return subscript[digit] != '0' || subscript.length() == 1;
+    if (subscript.find('.', point + 1) != std::string::npos) return false;
+    if (point > digit && subscript[digit] == '0') return false;
+
+    return subscript.length() > point + 1 && subscript[subscript.length() - 1] != '0';
+} // @end nodem::is_canonical function
+
+/*
+ * @function {private} nodem::plain_name
+ * @summary Strip the global directory from an extended reference, ^|"file.gld"|name or ^["file.gld"]name, leaving the plain global name
+ * @param {string} name - Global or local name, which can be an extended reference
+ * @param {string*} gld - Set to the global directory named in the reference, if there is one; defaults to none
+ * @returns {string} - The plain name, which is the name itself if it is not an extended reference
+ */
+inline static std::string plain_name(const std::string& name, std::string* gld = nullptr)
+{
+    if (name.compare(0, 2, "^[") != 0 && name.compare(0, 2, "^|") != 0) return name;
+
+    bool quoted = name.length() > 2 && name[2] == '"';
+    size_t open = quoted ? 3 : 2;
+    size_t close = quoted ? name.find(name[1] == '[' ? "\"]" : "\"|", open) : name.find(name[1] == '[' ? ']' : '|', open);
+
+    if (close == std::string::npos) return name;
+    if (gld != nullptr) *gld = name.substr(open, close - open);
+
+    return "^" + name.substr(close + (quoted ? 2 : 1));
+} // @end nodem::plain_name function
+
+/*
+ * @function {private} nodem::is_number
+ * @summary Check if a value returned from YottaDB's SimpleAPI is a canonical number
+ * @param {string} data - The data value to be tested
+ * @returns {boolean} - Whether the data value is a canonical number or not
+ */
+inline static bool is_number(const std::string& data)
+{
+    /*
+     * YottaDB/GT.M approximate (using number of digits, rather than number value) number limits:
+     *   - 47 digits before overflow (resulting in an overflow error)
+     *   - 18 digits of precision
+     * Node.js/JavaScript approximate (using number of digits, rather than number value) number limits:
+     *   - 309 digits before overflow (represented as the Infinity primitive)
+     *   - 21 digits before conversion to exponent notation
+     *   - 16 digits of precision
+     * This is why anything over 16 characters needs to be treated as a string
+     */
+
+    bool flag = false;
+    size_t neg_cnt = std::count(data.begin(), data.end(), '-');
+    size_t decp_cnt = std::count(data.begin(), data.end(), '.');
+
+    if ((decp_cnt == 0 || decp_cnt == 1) && (neg_cnt == 0 || (neg_cnt == 1 && data[0] == '-'))) flag = true;
+    if ((decp_cnt == 1 || neg_cnt == 1) && data.length() <= 1) flag = false;
+    if (data.length() > 16 || data[data.length() - 1] == '.') flag = false;
+
+    if (flag && !data.empty() && std::all_of(data.begin(), data.end(), [](char c) {return (std::isdigit(c) || c == '-' || c == '.');})) {
+        if ((data[0] == '0' && data.length() > 1) || (decp_cnt == 1 && data[data.length() - 1] == '0')) {
+            return false;
+        }
+
+        return true;
+    } else {
+        return false;
+    }
+} // @end nodem::is_number function
+
 } // @end namespace nodem
 
 #endif // @end UTILITY_HH
@@ -534,6 +534,173 @@ previous(v4wGlvn,v4wSubs,v4wMode)
  quit "{""result"":"_v4wResult_"}"
  ;; @end previous function
  ;
+ ;; @function {private} getFixed
+ ;; @summary Return the result of a fixed-arity get entry point
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {number} v4wDefined - $data value of the node
+ ;; @param {string} v4wData - The value of the node, or an empty string if it is not defined
+ ;; @returns {string} {JSON} - The value of the data node, and whether it was defined or not
+getFixed:(v4wMode,v4wDefined,v4wData)
+ set v4wDefined=$select(v4wDefined#10=1:"true",1:"false")
+ set v4wData=$$process(v4wData,"output",v4wMode,1,0)
+ ;
+ if $get(v4wDebug,0)>1 do debugLog(">>   getFixed exit:") zwrite v4wDefined,v4wData use $principal
+ quit "{""defined"":"_v4wDefined_",""data"":"_v4wData_"}"
+ ;; @end getFixed function
+ ;
+ ;; @function {private} orderFixed
+ ;; @summary Return the result of a fixed-arity order or previous entry point
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wResult - The next or previous subscript
+ ;; @returns {string} {JSON} - The next or previous data node
+orderFixed:(v4wMode,v4wResult)
+ set v4wResult=$$process(v4wResult,"output",v4wMode,1,0)
+ ;
+ if $get(v4wDebug,0)>1 do debugLog(">>   orderFixed exit:") zwrite v4wResult use $principal
+ quit "{""result"":"_v4wResult_"}"
+ ;; @end orderFixed function
+ ;
+ ;; The fixed-arity entry points below are chosen by gtm.cc when a call has no more than eight subscripts. Each
+ ;; subscript arrives as its own argument, already unquoted and converted, so no parsing or reference building is
+ ;; needed; the node is reached with name-level indirection alone. Nodem's mode comes first, so that every depth of
+ ;; an API shares the leading parameters in nodem.ci.
+ ;
+ ;; @function dataN
+ ;; @summary Same as data, with 0 to 8 subscripts passed as separate arguments
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wGlvn - Global or local variable
+ ;; @param {string} v4wSub1...v4wSub8 - Subscripts
+ ;; @returns {string} {JSON} - $data value; 0 for no data nor children, 1 for data, 10 for children, 11 for data and children
+data0(v4wMode,v4wGlvn)
+ quit "{""defined"":"_$data(@v4wGlvn)_"}"
+data1(v4wMode,v4wGlvn,v4wSub1)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1))_"}"
+data2(v4wMode,v4wGlvn,v4wSub1,v4wSub2)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2))_"}"
+data3(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3))_"}"
+data4(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4))_"}"
+data5(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5))_"}"
+data6(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6))_"}"
+data7(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7))_"}"
+data8(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)
+ quit "{""defined"":"_$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8))_"}"
+ ;; @end dataN functions
+ ;
+ ;; @function getN
+ ;; @summary Same as get, with 0 to 8 subscripts passed as separate arguments; not used for intrinsic special variables
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wGlvn - Global or local variable
+ ;; @param {string} v4wSub1...v4wSub8 - Subscripts
+ ;; @returns {string} {JSON} - The value of the data node, and whether it was defined or not
+get0(v4wMode,v4wGlvn)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn),$get(@v4wGlvn))
+get1(v4wMode,v4wGlvn,v4wSub1)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1)),$get(@v4wGlvn@(v4wSub1)))
+get2(v4wMode,v4wGlvn,v4wSub1,v4wSub2)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2)),$get(@v4wGlvn@(v4wSub1,v4wSub2)))
+get3(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3)))
+get4(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4)))
+get5(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)))
+get6(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)))
+get7(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)))
+get8(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)
+ quit $$getFixed(v4wMode,$data(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)),$get(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)))
+ ;; @end getN functions
+ ;
+ ;; @label setN
+ ;; @summary Same as set, with 0 to 8 subscripts passed as separate arguments; not used for intrinsic special variables
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wGlvn - Global or local variable
+ ;; @param {string} v4wData - Data to store in the database node or local variable node, already unquoted
+ ;; @param {string} v4wSub1...v4wSub8 - Subscripts
+ ;; @returns {void}
+set0(v4wMode,v4wGlvn,v4wData)
+ set @v4wGlvn=v4wData
+ quit
+set1(v4wMode,v4wGlvn,v4wData,v4wSub1)
+ set @v4wGlvn@(v4wSub1)=v4wData
+ quit
+set2(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2)
+ set @v4wGlvn@(v4wSub1,v4wSub2)=v4wData
+ quit
+set3(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3)=v4wData
+ quit
+set4(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3,v4wSub4)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4)=v4wData
+ quit
+set5(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)=v4wData
+ quit
+set6(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)=v4wData
+ quit
+set7(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)=v4wData
+ quit
+set8(v4wMode,v4wGlvn,v4wData,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)
+ set @v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)=v4wData
+ quit
+ ;; @end setN labels
+ ;
+ ;; @function orderN
+ ;; @summary Same as order, with 1 to 8 subscripts passed as separate arguments
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wGlvn - Global or local variable
+ ;; @param {string} v4wSub1...v4wSub8 - Subscripts
+ ;; @returns {string} {JSON} - The next data node
+order1(v4wMode,v4wGlvn,v4wSub1)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1)))
+order2(v4wMode,v4wGlvn,v4wSub1,v4wSub2)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2)))
+order3(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3)))
+order4(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4)))
+order5(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)))
+order6(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)))
+order7(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)))
+order8(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)))
+ ;; @end orderN functions
+ ;
+ ;; @function previousN
+ ;; @summary Same as previous, with 1 to 8 subscripts passed as separate arguments
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @param {string} v4wGlvn - Global or local variable
+ ;; @param {string} v4wSub1...v4wSub8 - Subscripts
+ ;; @returns {string} {JSON} - The previous data node
+previous1(v4wMode,v4wGlvn,v4wSub1)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1),-1))
+previous2(v4wMode,v4wGlvn,v4wSub1,v4wSub2)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2),-1))
+previous3(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3),-1))
+previous4(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4),-1))
+previous5(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5),-1))
+previous6(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6),-1))
+previous7(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7),-1))
+previous8(v4wMode,v4wGlvn,v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8)
+ quit $$orderFixed(v4wMode,$order(@v4wGlvn@(v4wSub1,v4wSub2,v4wSub3,v4wSub4,v4wSub5,v4wSub6,v4wSub7,v4wSub8),-1))
+ ;; @end previousN functions
+ ;
  ;; @function nextNode
  ;; @summary Return the next global or local node, depth first
  ;; @param {string} v4wGlvn - Global or local variable
@@ -727,6 +894,37 @@ increment(v4wGlvn,v4wSubs,v4wIncr,v4wMode)
  quit "{""data"":"_v4wData_"}"
  ;; @end increment function
  ;
+ ;; @function batch
+ ;; @summary Run several data, get, set, kill, order, previous, or increment operations in one call
+ ;; @param {string} v4wOps - Four fields per operation (operation, global or local variable, encoded subscripts, and data or
+ ;;   increment), each encoded with its length
+ ;; @param {number} v4wMode (0|1) - Data mode; 0 is string mode, 1 is canonical mode
+ ;; @returns {string} - The JSON result of each operation, in order, each encoded with its length
+batch(v4wOps,v4wMode)
+ set v4wMode=$get(v4wMode,1)
+ if $get(v4wDebug,0)>1 do debugLog(">>   batch enter:") zwrite v4wOps,v4wMode use $principal
+ ;
+ new v4wFields
+ do parse(v4wOps,.v4wFields,1)
+ ;
+ new v4wNum,v4wOp,v4wJson,v4wReturn
+ set v4wReturn=""
+ ;
+ for v4wNum=1:4 quit:'$data(v4wFields(v4wNum+3))  do
+ . set v4wOp=v4wFields(v4wNum)
+ . if v4wOp="get" set v4wJson=$$get(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wMode)
+ . else  if v4wOp="set" do set(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wFields(v4wNum+3),v4wMode) set v4wJson="{}"
+ . else  if v4wOp="data" set v4wJson=$$data(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wMode)
+ . else  if v4wOp="kill" do kill(v4wFields(v4wNum+1),v4wFields(v4wNum+2),0,v4wMode) set v4wJson="{}"
+ . else  if v4wOp="order" set v4wJson=$$order(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wMode)
+ . else  if v4wOp="previous" set v4wJson=$$previous(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wMode)
+ . else  set v4wJson=$$increment(v4wFields(v4wNum+1),v4wFields(v4wNum+2),v4wFields(v4wNum+3),v4wMode)
+ . set v4wReturn=v4wReturn_$zlength(v4wJson)_":"_v4wJson_","
+ ;
+ if $get(v4wDebug,0)>1 do debugLog(">>   batch exit:") zwrite v4wReturn use $principal
+ quit v4wReturn
+ ;; @end batch function
+ ;
  ;; @function lock
  ;; @summary Lock a global or local node, incrementally
  ;; @param {string} v4wGlvn - Global or local variable
@@ -23,10 +23,16 @@
 
 #if NODEM_SIMPLE_API == 1
 #   include "ydb.hh"
+#   include <sched.h>
+#   include <algorithm>
+#   include <limits>
+#   include <map>
+#   include <random>
 
 using std::boolalpha;
 using std::cerr;
 using std::string;
+using std::vector;
 
 namespace ydb {
 
@@ -146,32 +152,3645 @@ static ydb_status_t extended_ref(nodem::NodemBaton* nodem_baton, string save_res
     return YDB_OK;
 } // @end ydb::extended_ref
 
+/*
+ * @function {private} ydb::to_buffers
+ * @summary Point an array of SimpleAPI buffers at a vector of subscripts, without copying them
+ * @param {vector<string>} subs - Subscripts
+ * @param {ydb_buffer_t*} subs_array - Array of at least YDB_MAX_SUBS buffers to fill in
+ * @returns {void}
+ */
+inline static void to_buffers(const vector<string>& subs, ydb_buffer_t* subs_array)
+{
+    for (unsigned int i = 0; i < subs.size(); i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = subs[i].length();
+        subs_array[i].buf_addr = (char*) subs[i].c_str();
+    }
+
+    return;
+} // @end ydb::to_buffers function
+
+/*
+ * @function {private} ydb::node_next
+ * @summary Move to the next node in collation order, growing the subscript buffers as needed, with the caller holding the mutex
+ * @param {ydb_buffer_t*} glvn - Global or local variable name
+ * @param {vector<string>} subs - Subscripts of the current node on input, and of the next node on output
+ * @returns {ydb_status_t} - Return code; YDB_OK, YDB_NODE_END when there are no more nodes, or any other error code
+ */
+static ydb_status_t node_next(ydb_buffer_t* glvn, vector<string>& subs)
+{
+    thread_local vector<string> next_data(YDB_MAX_SUBS, string(256, '\0'));
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    ydb_buffer_t ret_array[YDB_MAX_SUBS];
+
+    to_buffers(subs, subs_array);
+
+    for (int i = 0; i < YDB_MAX_SUBS; i++) {
+        ret_array[i].len_alloc = next_data[i].length();
+        ret_array[i].len_used = 0;
+        ret_array[i].buf_addr = &next_data[i][0];
+    }
+
+    int subs_used = YDB_MAX_SUBS;
+    ydb_status_t status = ydb_node_next_s(glvn, subs.size(), subs_array, &subs_used, ret_array);
+
+    while (status == YDB_ERR_INVSTRLEN && subs_used >= 0 && subs_used < YDB_MAX_SUBS) {
+        next_data[subs_used].resize(ret_array[subs_used].len_used);
+
+        ret_array[subs_used].len_alloc = next_data[subs_used].length();
+        ret_array[subs_used].buf_addr = &next_data[subs_used][0];
+
+        subs_used = YDB_MAX_SUBS;
+        status = ydb_node_next_s(glvn, subs.size(), subs_array, &subs_used, ret_array);
+    }
+
+    if (status != YDB_OK) return status;
+    if (subs_used == YDB_NODE_END) return YDB_NODE_END;
+
+    subs.clear();
+
+    for (int i = 0; i < subs_used; i++) subs.push_back(string(ret_array[i].buf_addr, ret_array[i].len_used));
+
+    return YDB_OK;
+} // @end ydb::node_next function
+
+/*
+ * @function {private} ydb::get_value
+ * @summary Retrieve the value of a node, growing the value buffer as needed, with the caller holding the mutex
+ * @param {ydb_buffer_t*} glvn - Global or local variable name
+ * @param {vector<string>} subs - Subscripts
+ * @param {string} value - The value of the node, on output
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t get_value(ydb_buffer_t* glvn, const vector<string>& subs, string& value)
+{
+    thread_local string get_data(4096, '\0');
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    to_buffers(subs, subs_array);
+
+    ydb_buffer_t ret_value;
+    ret_value.len_alloc = get_data.length();
+    ret_value.len_used = 0;
+    ret_value.buf_addr = &get_data[0];
+
+    ydb_status_t status = ydb_get_s(glvn, subs.size(), subs_array, &ret_value);
+
+    if (status == YDB_ERR_INVSTRLEN) {
+        get_data.resize(ret_value.len_used);
+
+        ret_value.len_alloc = get_data.length();
+        ret_value.len_used = 0;
+        ret_value.buf_addr = &get_data[0];
+
+        status = ydb_get_s(glvn, subs.size(), subs_array, &ret_value);
+    }
+
+    if (status == YDB_OK) value.assign(ret_value.buf_addr, ret_value.len_used);
+
+    return status;
+} // @end ydb::get_value function
+
+/*
+ * @function {private} ydb::subscript_next
+ * @summary Find the next (or previous) subscript at the last level, growing the subscript buffer as needed, with the caller holding the mutex
+ * @param {ydb_buffer_t*} glvn - Global or local variable name
+ * @param {vector<string>} subs - Subscripts, ending with the subscript to start from; an empty string starts at the first one
+ * @param {bool} reverse - Whether to find the previous subscript, rather than the next one
+ * @param {string} key - The subscript found, on output
+ * @returns {ydb_status_t} - Return code; YDB_OK, YDB_ERR_NODEEND when there are no more subscripts, or any other error code
+ */
+static ydb_status_t subscript_next(ydb_buffer_t* glvn, const vector<string>& subs, const bool reverse, string& key)
+{
+    thread_local string next_data(256, '\0');
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    to_buffers(subs, subs_array);
+
+    ydb_buffer_t ret_value;
+    ret_value.len_alloc = next_data.length();
+    ret_value.len_used = 0;
+    ret_value.buf_addr = &next_data[0];
+
+    ydb_status_t status = reverse ? ydb_subscript_previous_s(glvn, subs.size(), subs_array, &ret_value) :
+      ydb_subscript_next_s(glvn, subs.size(), subs_array, &ret_value);
+
+    if (status == YDB_ERR_INVSTRLEN) {
+        next_data.resize(ret_value.len_used);
+
+        ret_value.len_alloc = next_data.length();
+        ret_value.len_used = 0;
+        ret_value.buf_addr = &next_data[0];
+
+        status = reverse ? ydb_subscript_previous_s(glvn, subs.size(), subs_array, &ret_value) :
+          ydb_subscript_next_s(glvn, subs.size(), subs_array, &ret_value);
+    }
+
+    if (status == YDB_OK) key.assign(ret_value.buf_addr, ret_value.len_used);
+
+    return status;
+} // @end ydb::subscript_next function
+
+/*
+ * @function {private} ydb::sample_child
+ * @summary Choose a random subscript under a node, from all of them when there are few, or with one random probe when there are many
+ * @param {ydb_buffer_t*} glvn - Global or local variable name
+ * @param {vector<string>} subs - Subscripts of the parent node
+ * @param {map<vector<string>, vector<string>>} levels - Subscripts already listed under each parent, so each is listed once per call
+ * @param {mt19937_64} generator - Random number generator
+ * @param {string} key - The subscript chosen, on output
+ * @returns {ydb_status_t} - Return code; YDB_OK, YDB_ERR_NODEEND when the node has no subscripts, or any other error code
+ */
+static ydb_status_t sample_child(ydb_buffer_t* glvn, vector<string>& subs, std::map<vector<string>, vector<string>>& levels,
+  std::mt19937_64& generator, string& key)
+{
+    ydb_status_t status = YDB_OK;
+    std::map<vector<string>, vector<string>>::iterator level = levels.find(subs);
+
+    if (level == levels.end()) {
+        vector<string> children;
+        string next;
+
+        subs.push_back("");
+
+        while (children.size() <= SAMPLE_FANOUT) {
+            status = subscript_next(glvn, subs, false, next);
+
+            if (status != YDB_OK) break;
+
+            subs.back() = next;
+            children.push_back(next);
+        }
+
+        subs.pop_back();
+
+        if (status != YDB_OK && status != YDB_ERR_NODEEND) return status;
+        if (children.empty()) return YDB_ERR_NODEEND;
+
+        level = levels.insert(std::make_pair(subs, children)).first;
+    }
+
+    const vector<string>& children = level->second;
+
+    if (children.size() <= SAMPLE_FANOUT) {
+        key = children[std::uniform_int_distribution<size_t> {0, children.size() - 1}(generator)];
+        return YDB_OK;
+    }
+
+    // Too many to list, so seek from a random point between the first and last subscripts, which favors those after gaps
+    string last;
+
+    subs.push_back("");
+    status = subscript_next(glvn, subs, true, last);
+
+    const string& first = children.front();
+    bool integers = nodem::is_canonical(first) && nodem::is_canonical(last) && first.length() < 16 && last.length() < 16 &&
+      first.find('.') == string::npos && last.find('.') == string::npos;
+
+    if (status == YDB_OK && integers) {
+        long long low = strtoll(first.c_str(), NULL, 10);
+        long long high = strtoll(last.c_str(), NULL, 10);
+
+        subs.back() = std::to_string(std::uniform_int_distribution<long long> {low, high}(generator) - 1);
+    } else if (status == YDB_OK) {
+        size_t common = 0;
+
+        while (common < first.length() && common < last.length() && first[common] == last[common]) common++;
+
+        // Probes stay in printable ASCII, so they are valid in UTF-8 mode too
+        int low = (common < first.length()) ? static_cast<unsigned char>(first[common]) : ' ';
+        int high = (common < last.length()) ? static_cast<unsigned char>(last[common]) : '~';
+
+        if (low < ' ') low = ' ';
+        if (high > '~') high = '~';
+
+        subs.back() = last.substr(0, common);
+
+        if (low <= high) {
+            subs.back() += static_cast<char>(std::uniform_int_distribution<int> {low, high}(generator));
+
+            for (unsigned int i = 0; i < 4; i++) {
+                subs.back() += static_cast<char>(std::uniform_int_distribution<int> {' ', '~'}(generator));
+            }
+        }
+    }
+
+    if (status == YDB_OK) status = subscript_next(glvn, subs, false, key);
+
+    if (status == YDB_ERR_NODEEND) {
+        key = last;
+        status = YDB_OK;
+    }
+
+    subs.pop_back();
+
+    return status;
+} // @end ydb::sample_child function
+
+/*
+ * @function {private} ydb::directory
+ * @summary List global or local variable names in collation order, as globalDirectory^v4wNode and localDirectory^v4wNode do
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - First name to list, if it exists
+ * @member {string} to_name - Last name to list; an empty string means no limit
+ * @member {gtm_double_t} option - Maximum number of names to list; 0 means no limit
+ * @member {bool} local - Whether to list local variables, or globals
+ * @member {vector<string>} subs_array - The names listed, without a leading ^, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t directory(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    ydb::directory enter");
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    to_name: ", nodem_baton->to_name);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+    }
+
+    unsigned int max = static_cast<unsigned int>(nodem_baton->option);
+    string var_name = nodem_baton->name;
+    char next_data[YDB_MAX_IDENT + 2];
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = var_name.length();
+    glvn.buf_addr = (char*) var_name.c_str();
+
+    ydb_buffer_t next_name;
+    next_name.len_alloc = sizeof(next_data);
+    next_name.len_used = 0;
+    next_name.buf_addr = next_data;
+
+    nodem_baton->subs_array.clear();
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    unsigned int data;
+    ydb_status_t status = ydb_data_s(&glvn, 0, NULL, &data);
+
+    if (status == YDB_OK && data != 0) nodem_baton->subs_array.push_back(var_name.substr(nodem_baton->local ? 0 : 1));
+
+    while (status == YDB_OK && (max == 0 || nodem_baton->subs_array.size() < max)) {
+        status = ydb_subscript_next_s(&glvn, 0, NULL, &next_name);
+
+        if (status != YDB_OK) break;
+
+        var_name.assign(next_name.buf_addr, next_name.len_used);
+        if (!nodem_baton->local && var_name[0] != '^') var_name.insert(0, "^");
+
+        glvn.len_alloc = glvn.len_used = var_name.length();
+        glvn.buf_addr = (char*) var_name.c_str();
+
+        if (!nodem_baton->to_name.empty() && var_name > nodem_baton->to_name) break;
+
+        // Do not allow manipulation of internal namespace symbols
+        if (nodem_baton->local && var_name.compare(0, 3, "v4w") == 0) continue;
+
+        nodem_baton->subs_array.push_back(var_name.substr(nodem_baton->local ? 0 : 1));
+    }
+
+    if (status == YDB_NODE_END) status = YDB_OK;
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) nodem::debug_log(">>>    ydb::directory exit");
+
+    return status;
+} // @end ydb::directory function
+
+enum shard_op_t {
+    SHARD_HOME,
+    SHARD_ALL,
+    SHARD_DATA,
+    SHARD_ORDER,
+    SHARD_PREVIOUS,
+    SHARD_NEXT_NODE,
+    SHARD_PREVIOUS_NODE,
+    SHARD_SCAN
+};
+
+static thread_local bool shard_routed_g = false;
+
+/*
+ * @function {private} ydb::switch_gld
+ * @summary Point $zgbldir at a global directory, with the caller holding the mutex; YottaDB keeps each directory it has opened
+ * @param {string} gld - Global directory file
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t switch_gld(const string& gld)
+{
+    char isv_name[] = "$zgbldir";
+
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
+
+    ydb_buffer_t value;
+    value.len_alloc = value.len_used = gld.length();
+    value.buf_addr = (char*) gld.c_str();
+
+    return ydb_set_s(&isv, 0, NULL, &value);
+} // @end ydb::switch_gld function
+
+/*
+ * @function {private} ydb::shard_route
+ * @summary Run an API call on a sharded global, in the shard that holds the node, or in every shard, merging their results
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global name
+ * @member {vector<string>} subs_array - Subscripts on input, and the node found by next_node or previous_node on output
+ * @member {ydb_char_t*} result - Data returned from YottaDB, merged across shards for data, order, previous, and the node APIs
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @param {ShardedGlobal} shard - The sharded global definition
+ * @param {ydb_status_t (*)(NodemBaton*)} function - The API to run in each shard
+ * @param {shard_op_t} op - How to choose the shards, and how to merge their results
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_NODE_END when no shard has a next node, or any other error code
+ */
+static ydb_status_t shard_route(nodem::NodemBaton* nodem_baton, const nodem::ShardedGlobal& shard,
+  ydb_status_t (*function)(nodem::NodemBaton*), const shard_op_t op)
+{
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    ydb::shard_route enter");
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    op: ", op);
+    }
+
+    unsigned int subs_size = nodem_baton->subs_array.size();
+    bool routed = subs_size >= shard.key_level;
+
+    // Siblings of the key subscript, and the next node in collation order, can be in any shard
+    if (op == SHARD_ORDER || op == SHARD_PREVIOUS) routed = subs_size > shard.key_level;
+    if (op == SHARD_NEXT_NODE || op == SHARD_PREVIOUS_NODE) routed = false;
+
+    vector<unsigned int> targets;
+
+    if (routed) {
+        targets.push_back(nodem::shard_index(shard, nodem_baton->subs_array[shard.key_level - 1]));
+    } else if (op == SHARD_HOME) {
+        targets.push_back(0);
+    } else {
+        for (unsigned int i = 0; i < shard.glds.size(); i++) targets.push_back(i);
+    }
+
+    char isv_name[] = "$zgbldir";
+
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
+
+    const vector<string> start = nodem_baton->subs_array;
+    const string start_value = nodem_baton->value;
+    vector<string> found_subs;
+    vector<string> found_values;
+    vector<unsigned int> found_data;
+    string found_result;
+    string stop_key;
+    string default_gld;
+    bool found = false;
+    bool stopped = false;
+    bool has_value = false;
+    bool has_children = false;
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    shard_routed_g = true;
+
+    ydb_status_t status = get_value(&isv, vector<string> {}, default_gld);
+    string active_gld = default_gld;
+
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+
+    for (unsigned int i = 0; i < targets.size() && status == YDB_OK; i++) {
+        const string& gld = shard.glds[targets[i]];
+
+        if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+            nodem::debug_log(">>>    shard: ", targets[i], " gld: ", gld, " region: ", shard.regions[targets[i]]);
+        }
+
+        if (gld != active_gld) {
+            status = switch_gld(gld);
+
+            if (status != YDB_OK) {
+                ydb_zstatus(nodem_baton->error, ERR_LEN);
+                break;
+            }
+
+            active_gld = gld;
+        }
+
+        nodem_baton->subs_array = start;
+        if (op == SHARD_SCAN) nodem_baton->value = start_value;
+
+        status = function(nodem_baton);
+
+        if (op == SHARD_DATA && status == YDB_OK) {
+            unsigned int data = strtoul(nodem_baton->result, NULL, 10);
+
+            if (data % 10 == 1) has_value = true;
+            if (data >= 10) has_children = true;
+        } else if ((op == SHARD_ORDER || op == SHARD_PREVIOUS) && status == YDB_OK && nodem_baton->result[0] != '\0') {
+            string next {nodem_baton->result};
+            int order = found ? nodem::shard_collate(next, found_result) : 0;
+
+            if (!found || (op == SHARD_ORDER && order < 0) || (op == SHARD_PREVIOUS && order > 0)) {
+                found_result = next;
+                found = true;
+            }
+        } else if ((op == SHARD_NEXT_NODE || op == SHARD_PREVIOUS_NODE) && status == YDB_OK) {
+            int order = found ? nodem::shard_collate(nodem_baton->subs_array, found_subs) : 0;
+
+            if (!found || (op == SHARD_NEXT_NODE && order < 0) || (op == SHARD_PREVIOUS_NODE && order > 0)) {
+                found_subs = nodem_baton->subs_array;
+                found_result = nodem_baton->result;
+                found = true;
+            }
+        } else if ((op == SHARD_NEXT_NODE || op == SHARD_PREVIOUS_NODE) && status == YDB_NODE_END) {
+            status = YDB_OK;
+        } else if (op == SHARD_SCAN && status == YDB_OK) {
+            bool reverse = nodem_baton->reverse;
+
+            auto before = [reverse](const string& first, const string& second) {
+                int order = nodem::shard_collate(first, second);
+                return reverse ? order > 0 : order < 0;
+            };
+
+            // The merged page can only go as far as the earliest place a shard stopped, as it may have more before the others
+            if (nodem_baton->info == 1 && (!stopped || before(nodem_baton->value, stop_key))) {
+                stop_key = nodem_baton->value;
+                stopped = true;
+            }
+
+            // Below the key level, the same subscript can have nodes in more than one shard
+            for (unsigned int j = 0; j < nodem_baton->to_subs_array.size(); j++) {
+                const string& key = nodem_baton->to_subs_array[j];
+                unsigned int data = nodem_baton->data_array[j];
+                unsigned int index = std::lower_bound(found_subs.begin(), found_subs.end(), key, before) - found_subs.begin();
+
+                if (index < found_subs.size() && found_subs[index] == key) {
+                    if (data % 10 == 1) found_values[index] = nodem_baton->values_array[j];
+
+                    found_data[index] = ((found_data[index] % 10 == 1 || data % 10 == 1) ? 1 : 0) +
+                      ((found_data[index] >= 10 || data >= 10) ? 10 : 0);
+                } else {
+                    found_subs.insert(found_subs.begin() + index, key);
+                    found_values.insert(found_values.begin() + index, nodem_baton->values_array[j]);
+                    found_data.insert(found_data.begin() + index, data);
+                }
+            }
+        }
+    }
+
+    if (active_gld != default_gld) {
+        ydb_status_t switch_stat = switch_gld(default_gld);
+
+        if (switch_stat != YDB_OK && status == YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+            status = switch_stat;
+        }
+    }
+
+    shard_routed_g = false;
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (status == YDB_OK && !routed) {
+        if (op == SHARD_DATA) {
+            snprintf(nodem_baton->result, RES_LEN, "%u", (has_value ? 1 : 0) + (has_children ? 10 : 0));
+        } else if (op == SHARD_ORDER || op == SHARD_PREVIOUS) {
+            snprintf(nodem_baton->result, RES_LEN, "%s", found_result.c_str());
+        } else if (op == SHARD_NEXT_NODE || op == SHARD_PREVIOUS_NODE) {
+            nodem_baton->subs_array = found_subs;
+            snprintf(nodem_baton->result, RES_LEN, "%s", found_result.c_str());
+
+            if (!found) status = YDB_NODE_END;
+        } else if (op == SHARD_SCAN) {
+            unsigned int limit = static_cast<unsigned int>(nodem_baton->option);
+            bool reverse = nodem_baton->reverse;
+
+            if (stopped) {
+                unsigned int end = std::upper_bound(found_subs.begin(), found_subs.end(), stop_key,
+                  [reverse](const string& first, const string& second) {
+                      int order = nodem::shard_collate(first, second);
+                      return reverse ? order > 0 : order < 0;
+                  }) - found_subs.begin();
+
+                found_subs.resize(end);
+                found_values.resize(end);
+                found_data.resize(end);
+            }
+
+            if (found_subs.size() > limit) {
+                found_subs.resize(limit);
+                found_values.resize(limit);
+                found_data.resize(limit);
+
+                stop_key = found_subs.back();
+                stopped = true;
+            }
+
+            nodem_baton->value = stopped ? stop_key : start_value;
+            nodem_baton->info = stopped ? 1 : 0;
+            nodem_baton->to_subs_array = found_subs;
+            nodem_baton->values_array = found_values;
+            nodem_baton->data_array = found_data;
+        }
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) nodem::debug_log(">>>    ydb::shard_route exit");
+
+    return status;
+} // @end ydb::shard_route function
+
+/*
+ * @function {private} ydb::split_extended
+ * @summary Split an extended global reference, ^|"file.gld"|name or ^["file.gld"]name, in to its global directory and global name
+ * @param {string} var_name - Global or local variable name on input, and without the global directory on output
+ * @param {string} gld - Global directory file named in the reference, on output; left alone if there is none
+ * @returns {bool} - Whether the name was an extended global reference
+ */
+static bool split_extended(string& var_name, string& gld)
+{
+    string plain = nodem::plain_name(var_name, &gld);
+
+    if (plain == var_name) return false;
+
+    var_name = std::move(plain);
+    return true;
+} // @end ydb::split_extended function
+
+/*
+ * @function {private} ydb::aggregate_add
+ * @summary Add a number to one total of an aggregate, with M arithmetic, so that sums of decimal values stay exact
+ * @param {ydb_buffer_t*} glvn - Target global name
+ * @param {vector<string>} subs - Subscripts of the total
+ * @param {string} increment - The number to add, converted as M converts a string to a number
+ * @param {string} total - The new total, on output
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t aggregate_add(ydb_buffer_t* glvn, const vector<string>& subs, const string& increment, string& total)
+{
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    to_buffers(subs, subs_array);
+
+    ydb_buffer_t incr;
+    incr.len_alloc = incr.len_used = increment.length();
+    incr.buf_addr = (char*) increment.data();
+
+    char total_data[AGGREGATE_NUMBER];
+
+    ydb_buffer_t value;
+    value.len_alloc = AGGREGATE_NUMBER;
+    value.len_used = 0;
+    value.buf_addr = total_data;
+
+    ydb_status_t status = ydb_incr_s(glvn, subs.size(), subs_array, &incr, &value);
+
+    if (status == YDB_OK) total.assign(value.buf_addr, value.len_used);
+
+    return status;
+} // @end ydb::aggregate_add function
+
+/*
+ * @function {private} ydb::aggregate_update
+ * @summary Apply the change to one source node to the totals of its group, subtracting its old value and adding its new one
+ * @param {Aggregate} aggregate - The aggregate definition
+ * @param {vector<string>} subs - Subscripts of the source node
+ * @param {string*} old_value - The value of the node before the write, or nullptr if it had none
+ * @param {string*} new_value - The value of the node after the write, or nullptr if it has none
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t aggregate_update(const nodem::Aggregate& aggregate, const vector<string>& subs, const string* old_value,
+  const string* new_value)
+{
+    if (subs.size() != aggregate.value_level) return YDB_OK;
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = aggregate.target.length();
+    glvn.buf_addr = (char*) aggregate.target.c_str();
+
+    vector<string> total_subs(subs.begin(), subs.begin() + aggregate.group_level);
+    int count = (new_value ? 1 : 0) - (old_value ? 1 : 0);
+    string total;
+    ydb_status_t status = YDB_OK;
+
+    nodem::move_written(aggregate.target, total_subs, true);
+
+    total_subs.push_back("");
+
+    if (aggregate.ops & nodem::AGGREGATE_SUM) {
+        total_subs.back() = "sum";
+
+        // M reads any number of leading signs, so a minus sign in front of the old value subtracts it exactly, whatever it holds
+        if (old_value && !old_value->empty() && !(new_value && *new_value == *old_value)) {
+            status = aggregate_add(&glvn, total_subs, "-" + *old_value, total);
+        }
+
+        if (status == YDB_OK && new_value && !new_value->empty() && !(old_value && *old_value == *new_value)) {
+            status = aggregate_add(&glvn, total_subs, *new_value, total);
+        }
+
+        if (status == YDB_OK && nodem::bloom_active()) nodem::bloom_written(aggregate.target, total_subs, false);
+    }
+
+    if (status == YDB_OK && (aggregate.ops & nodem::AGGREGATE_COUNT) && count != 0) {
+        total_subs.back() = "count";
+        status = aggregate_add(&glvn, total_subs, count > 0 ? "1" : "-1", total);
+
+        if (status == YDB_OK && nodem::bloom_active()) nodem::bloom_written(aggregate.target, total_subs, false);
+
+        // A group is killed once its last node is, rather than being left with a count and sum of zero
+        if (status == YDB_OK && total == "0") {
+            ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+            total_subs.pop_back();
+            to_buffers(total_subs, subs_array);
+
+            status = ydb_delete_s(&glvn, total_subs.size(), subs_array, YDB_DEL_TREE);
+        }
+    }
+
+    return status;
+} // @end ydb::aggregate_update function
+
+/*
+ * @function {private} ydb::aggregate_forget
+ * @summary Take a source node that is about to be killed out of the totals of every aggregate kept at its level
+ * @param {ydb_buffer_t*} glvn - Source global name
+ * @param {vector<string>} subs - Subscripts of a node that has a value
+ * @param {vector<aggregate_ptr_t>} aggregates - The aggregates of the source global
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t aggregate_forget(ydb_buffer_t* glvn, const vector<string>& subs, const vector<nodem::aggregate_ptr_t>& aggregates)
+{
+    string value;
+    bool read = false;
+
+    for (const nodem::aggregate_ptr_t& aggregate : aggregates) {
+        if (aggregate->value_level != subs.size()) continue;
+
+        ydb_status_t status = read ? YDB_OK : get_value(glvn, subs, value);
+
+        if (status == YDB_OK) status = aggregate_update(*aggregate, subs, &value, nullptr);
+        if (status != YDB_OK) return status;
+
+        read = true;
+    }
+
+    return YDB_OK;
+} // @end ydb::aggregate_forget function
+
+/*
+ * @function {private} ydb::aggregate_kill
+ * @summary Kill a source node, or its whole subtree, taking every node killed out of the totals of its aggregates first
+ * @param {ydb_buffer_t*} glvn - Source global name
+ * @param {vector<string>} root - Subscripts of the node to kill
+ * @param {bool} node_only - Whether to kill only the node, or the node and its children
+ * @param {vector<aggregate_ptr_t>} aggregates - The aggregates of the source global
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t aggregate_kill(ydb_buffer_t* glvn, const vector<string>& root, const bool node_only,
+  const vector<nodem::aggregate_ptr_t>& aggregates)
+{
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int data;
+
+    to_buffers(root, subs_array);
+
+    ydb_status_t status = ydb_data_s(glvn, root.size(), subs_array, &data);
+
+    if (status == YDB_OK && data % 10 == 1) status = aggregate_forget(glvn, root, aggregates);
+
+    bool deeper = std::any_of(aggregates.begin(), aggregates.end(),
+      [&](const nodem::aggregate_ptr_t& aggregate) { return aggregate->value_level > root.size(); });
+
+    // Only the nodes below the root at a level an aggregate is kept at are read, but finding them walks the whole subtree
+    if (status == YDB_OK && !node_only && deeper && data >= 10) {
+        vector<string> subs = root;
+
+        while ((status = node_next(glvn, subs)) == YDB_OK) {
+            if (subs.size() <= root.size() || !std::equal(root.begin(), root.end(), subs.begin())) break;
+
+            status = aggregate_forget(glvn, subs, aggregates);
+
+            if (status != YDB_OK) break;
+        }
+
+        if (status == YDB_NODE_END) status = YDB_OK;
+    }
+
+    if (status == YDB_OK && data != 0) {
+        to_buffers(root, subs_array);
+        status = ydb_delete_s(glvn, root.size(), subs_array, node_only ? YDB_DEL_NODE : YDB_DEL_TREE);
+    }
+
+    return status;
+} // @end ydb::aggregate_kill function
+
+/*
+ * @function {private} ydb::kill_chunk
+ * @summary Kill the next nodes under a subtree root, up to a chunk of them, in collation order, with the caller holding the mutex
+ * @param {ydb_buffer_t*} glvn - Global or local variable name
+ * @param {vector<string>} root - Subscripts of the subtree root
+ * @param {vector<string>} cursor - Subscripts of the last node killed on input, and of the last node killed in this chunk on output
+ * @param {unsigned int} chunk - Maximum number of nodes to kill
+ * @param {double} killed - Running count of the nodes killed, updated on output
+ * @param {bool} done - Set when there are no more nodes under the subtree root
+ * @param {vector<aggregate_ptr_t>} aggregates - The aggregates of the global, which each node killed is taken out of
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t kill_chunk(ydb_buffer_t* glvn, const vector<string>& root, vector<string>& cursor, const unsigned int chunk,
+  double& killed, bool& done, const vector<nodem::aggregate_ptr_t>& aggregates)
+{
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    for (unsigned int i = 0; i < chunk; i++) {
+        ydb_status_t status = node_next(glvn, cursor);
+
+        if (status == YDB_NODE_END) {
+            done = true;
+            return YDB_OK;
+        } else if (status != YDB_OK) {
+            return status;
+        }
+
+        if (cursor.size() <= root.size() || !std::equal(root.begin(), root.end(), cursor.begin())) {
+            done = true;
+            return YDB_OK;
+        }
+
+        if (!aggregates.empty()) {
+            status = aggregate_forget(glvn, cursor, aggregates);
+
+            if (status != YDB_OK) return status;
+        }
+
+        // Killing only the node keeps each step short, and node_next still finds the nodes after it
+        to_buffers(cursor, subs_array);
+        status = ydb_delete_s(glvn, cursor.size(), subs_array, YDB_DEL_NODE);
+
+        if (status != YDB_OK) return status;
+
+        killed++;
+    }
+
+    return YDB_OK;
+} // @end ydb::kill_chunk function
+
+/*
+ * @struct {private} ydb::KillChunk
+ * @summary One chunk of a killTree call, passed to its transaction callback when the global has aggregates to keep current
+ * @member {ydb_buffer_t*} glvn
+ * @member {vector<string>*} root
+ * @member {vector<string>} cursor
+ * @member {unsigned int} chunk
+ * @member {double} killed
+ * @member {vector<aggregate_ptr_t>} aggregates
+ * @member {vector<string>} next_cursor
+ * @member {double} next_killed
+ * @member {bool} done
+ * @member {ydb_status_t} status
+ */
+struct KillChunk {
+    ydb_buffer_t*                   glvn;
+    const vector<string>*           root;
+    vector<string>                  cursor;
+    unsigned int                    chunk;
+    double                          killed;
+    vector<nodem::aggregate_ptr_t>  aggregates;
+    vector<string>                  next_cursor;
+    double                          next_killed;
+    bool                            done;
+    ydb_status_t                    status;
+}; // @end ydb::KillChunk struct
+
+/*
+ * @function {private} ydb::kill_tree_chunk
+ * @summary Kill the next chunk of a subtree, and its root once there are no more nodes under it, with the caller holding the mutex
+ * @param {KillChunk*} kill - The chunk; the cursor and count it starts from are left as they were, so that a restart can start again
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t kill_tree_chunk(KillChunk* kill)
+{
+    const vector<string>& root = *kill->root;
+
+    kill->next_cursor = kill->cursor;
+    kill->next_killed = kill->killed;
+    kill->done = false;
+
+    ydb_status_t status = kill_chunk(kill->glvn, root, kill->next_cursor, kill->chunk, kill->next_killed, kill->done,
+      kill->aggregates);
+
+    // Kill the root last, along with anything set behind the cursor while the mutex was released
+    if (status == YDB_OK && kill->done) {
+        ydb_buffer_t subs_array[YDB_MAX_SUBS];
+        unsigned int data;
+
+        to_buffers(root, subs_array);
+
+        status = ydb_data_s(kill->glvn, root.size(), subs_array, &data);
+
+        if (status == YDB_OK && data != 0) {
+            if (data % 10 == 1) kill->next_killed++;
+
+            if (kill->aggregates.empty()) {
+                status = ydb_delete_s(kill->glvn, root.size(), subs_array, YDB_DEL_TREE);
+            } else {
+                status = aggregate_kill(kill->glvn, root, false, kill->aggregates);
+            }
+        }
+    }
+
+    return status;
+} // @end ydb::kill_tree_chunk function
+
+/*
+ * @function {private} ydb::kill_tree_tp
+ * @summary Kill the next chunk of a subtree and keep its aggregates current, as the callback of a transaction
+ * @param {void*} data - Cast in to a KillChunk struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int kill_tree_tp(void* data)
+{
+    KillChunk* kill = static_cast<KillChunk*>(data);
+    ydb_status_t status = kill_tree_chunk(kill);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    kill->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::kill_tree_tp function
+
+/*
+ * @struct {private} ydb::PruneChunk
+ * @summary One chunk of a prune call, passed to its transaction callback
+ * @member {NodemBaton*} nodem_baton
+ * @member {ydb_buffer_t*} glvn
+ * @member {vector<string>} cursor
+ * @member {unsigned int} chunk
+ * @member {vector<aggregate_ptr_t>} aggregates
+ * @member {vector<string>} next_cursor
+ * @member {double} scanned
+ * @member {double} pruned
+ * @member {unsigned int} visited
+ * @member {ydb_status_t} status
+ */
+struct PruneChunk {
+    nodem::NodemBaton*              nodem_baton;
+    ydb_buffer_t*                   glvn;
+    vector<string>                  cursor;
+    unsigned int                    chunk;
+    vector<nodem::aggregate_ptr_t>  aggregates;
+    vector<string>                  next_cursor;
+    double                          scanned;
+    double                          pruned;
+    unsigned int                    visited;
+    ydb_status_t                    status;
+}; // @end ydb::PruneChunk struct
+
+/*
+ * @function {private} ydb::prune_chunk
+ * @summary Visit the next chunk of nodes down to the prune level, killing each node at that level that matches the filter
+ * @param {PruneChunk*} prune - The chunk; the cursor it starts from is left as it was, so that a restart can start again
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t prune_chunk(PruneChunk* prune)
+{
+    nodem::NodemBaton* nodem_baton = prune->nodem_baton;
+    const vector<string>& root = nodem_baton->subs_array;
+    const unsigned int level = nodem_baton->info;
+
+    prune->next_cursor = prune->cursor;
+    prune->scanned = 0;
+    prune->pruned = 0;
+    prune->visited = 0;
+
+    // The cursor is the path being walked, whose last subscript is the last node visited at its level
+    vector<string>& subs = prune->next_cursor;
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    string key;
+    string value;
+    unsigned int data;
+    ydb_status_t status = YDB_OK;
+
+    while (prune->visited < prune->chunk && subs.size() > root.size()) {
+        status = subscript_next(prune->glvn, subs, false, key);
+
+        if (status == YDB_ERR_NODEEND) {
+            subs.pop_back();
+            status = YDB_OK;
+
+            continue;
+        } else if (status != YDB_OK) {
+            break;
+        }
+
+        subs.back() = key;
+        prune->visited++;
+
+        to_buffers(subs, subs_array);
+
+        status = ydb_data_s(prune->glvn, subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) break;
+
+        if (subs.size() < level) {
+            if (data >= 10) subs.push_back("");
+            continue;
+        }
+
+        value.clear();
+
+        if (data % 10 == 1) {
+            status = get_value(prune->glvn, subs, value);
+
+            if (status != YDB_OK) break;
+        }
+
+        prune->scanned++;
+
+        if (!nodem_baton->filter->match(key, value, data)) continue;
+
+        // Killing the node leaves the cursor on it, and subscript_next still finds the node after it
+        if (prune->aggregates.empty()) {
+            status = ydb_delete_s(prune->glvn, subs.size(), subs_array, YDB_DEL_TREE);
+        } else {
+            status = aggregate_kill(prune->glvn, subs, false, prune->aggregates);
+        }
+
+        if (status != YDB_OK) break;
+
+        nodem::move_written(nodem_baton->name, subs, true);
+        prune->pruned++;
+    }
+
+    return status;
+} // @end ydb::prune_chunk function
+
+/*
+ * @function {private} ydb::prune_tp
+ * @summary Prune the next chunk of a subtree, as the callback of a transaction
+ * @param {void*} data - Cast in to a PruneChunk struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int prune_tp(void* data)
+{
+    PruneChunk* prune = static_cast<PruneChunk*>(data);
+    ydb_status_t status = prune_chunk(prune);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    prune->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::prune_tp function
+
+/*
+ * @function {private} ydb::merge_overlap
+ * @summary Check whether a merge or move would copy a tree on to itself, or in to one of its own descendants or ancestors
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name to copy from
+ * @member {vector<string>} subs_array - Subscripts to copy from
+ * @member {string} to_name - Global or local variable name to copy to
+ * @member {vector<string>} to_subs_array - Subscripts to copy to
+ * @member {ydb_char_t*} error - Error message, on output, when one tree is a descendant of the other
+ * @param {char*} api - Name of the API, for the error message
+ * @param {bool} same - Whether both trees are the same, which leaves nothing to do, on output
+ * @returns {ydb_status_t} - 0, or YDB_ERR_MERGEDESC when one tree is a descendant of the other
+ */
+static ydb_status_t merge_overlap(nodem::NodemBaton* nodem_baton, const char* api, bool& same)
+{
+    const vector<string>& from_subs = nodem_baton->subs_array;
+    const vector<string>& to_subs = nodem_baton->to_subs_array;
+    unsigned int from_size = from_subs.size();
+
+    same = false;
+
+    // Like the M MERGE command, refuse to copy a tree in to one of its own descendants or ancestors
+    if (nodem_baton->name == nodem_baton->to_name) {
+        unsigned int common = std::min(from_size, static_cast<unsigned int>(to_subs.size()));
+
+        if (from_size == to_subs.size() && std::equal(from_subs.begin(), from_subs.end(), to_subs.begin())) {
+            same = true;
+        } else if (std::equal(from_subs.begin(), from_subs.begin() + common, to_subs.begin())) {
+            string from_ref = nodem::lock_resource(nodem_baton->name, from_subs);
+            string to_ref = nodem::lock_resource(nodem_baton->to_name, to_subs);
+
+            snprintf(nodem_baton->error, ERR_LEN, "%d,%s,%%YDB-E-MERGEDESC, Merge operation not possible.  %s is descendent of %s.",
+              -YDB_ERR_MERGEDESC, api, (to_subs.size() > from_size ? to_ref : from_ref).c_str(),
+              (to_subs.size() > from_size ? from_ref : to_ref).c_str());
+
+            return YDB_ERR_MERGEDESC;
+        }
+    }
+
+    return YDB_OK;
+} // @end ydb::merge_overlap function
+
+/*
+ * @struct {private} ydb::MoveChunk
+ * @summary One chunk of a move call, or its cutover, passed to their transaction callbacks
+ * @member {NodemBaton*} nodem_baton
+ * @member {ydb_buffer_t*} from_glvn
+ * @member {ydb_buffer_t*} to_glvn
+ * @member {vector<string>} cursor
+ * @member {unsigned int} chunk
+ * @member {bool} first
+ * @member {vector<string>} next_cursor
+ * @member {MoveWatch*} written
+ * @member {double} copied
+ * @member {bool} exists
+ * @member {bool} done
+ * @member {ydb_status_t} status
+ */
+struct MoveChunk {
+    nodem::NodemBaton*      nodem_baton;
+    ydb_buffer_t*           from_glvn;
+    ydb_buffer_t*           to_glvn;
+    vector<string>          cursor;
+    unsigned int            chunk;
+    bool                    first;
+    vector<string>          next_cursor;
+    const nodem::MoveWatch* written;
+    double                  copied;
+    bool                    exists;
+    bool                    done;
+    ydb_status_t            status;
+}; // @end ydb::MoveChunk struct
+
+/*
+ * @function {private} ydb::move_target
+ * @summary Set the node in the target tree that matches a node in the source tree
+ * @param {MoveChunk*} move - The move, whose baton has the source and target roots
+ * @param {vector<string>} source - Subscripts of the source node
+ * @param {string} value - The value to set
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t move_target(MoveChunk* move, const vector<string>& source, const string& value)
+{
+    vector<string> target = move->nodem_baton->to_subs_array;
+
+    target.insert(target.end(), source.begin() + move->nodem_baton->subs_array.size(), source.end());
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    to_buffers(target, subs_array);
+
+    ydb_buffer_t set_value;
+    set_value.len_alloc = set_value.len_used = value.length();
+    set_value.buf_addr = (char*) value.c_str();
+
+    return ydb_set_s(move->to_glvn, target.size(), subs_array, &set_value);
+} // @end ydb::move_target function
+
+/*
+ * @function {private} ydb::move_chunk
+ * @summary Copy the next chunk of a source tree to the target; a tree that fits in the first chunk is killed with it, which moves it in one step
+ * @param {MoveChunk*} move - The chunk; the cursor it starts from is left as it was, so that a restart can start again
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t move_chunk(MoveChunk* move)
+{
+    const vector<string>& from_subs = move->nodem_baton->subs_array;
+    const vector<string>& to_subs = move->nodem_baton->to_subs_array;
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    vector<string>& current = move->next_cursor;
+    string value;
+    unsigned int data;
+    ydb_status_t status;
+
+    move->next_cursor = move->cursor;
+    move->copied = 0;
+    move->exists = false;
+    move->done = false;
+
+    if (move->first) {
+        to_buffers(to_subs, subs_array);
+        status = ydb_data_s(move->to_glvn, to_subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) return status;
+
+        // Nothing has been written yet, so the caller can report the error once the empty transaction commits
+        if (data != 0) {
+            move->exists = true;
+            return YDB_OK;
+        }
+
+        to_buffers(from_subs, subs_array);
+        status = ydb_data_s(move->from_glvn, from_subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) return status;
+
+        if (data % 10 == 1) {
+            status = get_value(move->from_glvn, from_subs, value);
+            if (status == YDB_OK) status = move_target(move, from_subs, value);
+
+            if (status != YDB_OK) return status;
+
+            move->copied++;
+        }
+
+        if (data < 10) move->done = true;
+    }
+
+    while (!move->done && move->copied < move->chunk) {
+        status = node_next(move->from_glvn, current);
+
+        if (status == YDB_NODE_END) {
+            move->done = true;
+            break;
+        } else if (status != YDB_OK) {
+            return status;
+        }
+
+        if (current.size() <= from_subs.size() || !std::equal(from_subs.begin(), from_subs.end(), current.begin())) {
+            move->done = true;
+            break;
+        }
+
+        status = get_value(move->from_glvn, current, value);
+        if (status == YDB_OK) status = move_target(move, current, value);
+
+        if (status != YDB_OK) return status;
+
+        move->copied++;
+    }
+
+    // A tree that fits in the first chunk is killed in the same transaction it is copied in, and needs no cutover
+    if (move->first && move->done) {
+        to_buffers(from_subs, subs_array);
+        status = ydb_delete_s(move->from_glvn, from_subs.size(), subs_array, YDB_DEL_TREE);
+
+        if (status != YDB_OK) return status;
+    }
+
+    return YDB_OK;
+} // @end ydb::move_chunk function
+
+/*
+ * @function {private} ydb::move_chunk_tp
+ * @summary Copy the next chunk of a source tree to the target, as the callback of a transaction
+ * @param {void*} data - Cast in to a MoveChunk struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int move_chunk_tp(void* data)
+{
+    MoveChunk* move = static_cast<MoveChunk*>(data);
+    ydb_status_t status = move_chunk(move);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    move->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::move_chunk_tp function
+
+/*
+ * @function {private} ydb::move_reconcile
+ * @summary Bring the whole copied target up to date with the source, when the writes made to it between chunks are not known
+ * @param {MoveChunk*} move - The move; copied is the number of nodes with values in the target, on output
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t move_reconcile(MoveChunk* move)
+{
+    const vector<string>& from_subs = move->nodem_baton->subs_array;
+    const vector<string>& to_subs = move->nodem_baton->to_subs_array;
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    vector<string> current = from_subs;
+    vector<string> other;
+    string value;
+    string old_value;
+    unsigned int data;
+    unsigned int old_data;
+    ydb_status_t status;
+
+    move->copied = 0;
+
+    // Only the nodes that changed since they were copied are written, so this is mostly reads
+    for (bool root = true; ; root = false) {
+        if (root) {
+            to_buffers(current, subs_array);
+            status = ydb_data_s(move->from_glvn, current.size(), subs_array, &data);
+
+            if (status != YDB_OK) return status;
+            if (data % 10 != 1) continue;
+        } else {
+            status = node_next(move->from_glvn, current);
+
+            if (status == YDB_NODE_END) break;
+            if (status != YDB_OK) return status;
+            if (current.size() <= from_subs.size() || !std::equal(from_subs.begin(), from_subs.end(), current.begin())) break;
+        }
+
+        status = get_value(move->from_glvn, current, value);
+
+        if (status != YDB_OK) return status;
+
+        other = to_subs;
+        other.insert(other.end(), current.begin() + from_subs.size(), current.end());
+        to_buffers(other, subs_array);
+
+        status = ydb_data_s(move->to_glvn, other.size(), subs_array, &old_data);
+
+        if (status == YDB_OK && old_data % 10 == 1) status = get_value(move->to_glvn, other, old_value);
+        if (status == YDB_OK && (old_data % 10 != 1 || old_value != value)) status = move_target(move, current, value);
+
+        if (status != YDB_OK) return status;
+
+        move->copied++;
+    }
+
+    // Then kill the nodes in the target whose source nodes were killed between chunks
+    current = to_subs;
+
+    for (bool root = true; ; root = false) {
+        if (root) {
+            to_buffers(current, subs_array);
+            status = ydb_data_s(move->to_glvn, current.size(), subs_array, &data);
+
+            if (status != YDB_OK) return status;
+            if (data % 10 != 1) continue;
+        } else {
+            status = node_next(move->to_glvn, current);
+
+            if (status == YDB_NODE_END) break;
+            if (status != YDB_OK) return status;
+            if (current.size() <= to_subs.size() || !std::equal(to_subs.begin(), to_subs.end(), current.begin())) break;
+        }
+
+        other = from_subs;
+        other.insert(other.end(), current.begin() + to_subs.size(), current.end());
+        to_buffers(other, subs_array);
+
+        status = ydb_data_s(move->from_glvn, other.size(), subs_array, &data);
+
+        if (status != YDB_OK) return status;
+        if (data % 10 == 1) continue;
+
+        // Killing only the node keeps node_next finding the nodes after it
+        to_buffers(current, subs_array);
+        status = ydb_delete_s(move->to_glvn, current.size(), subs_array, YDB_DEL_NODE);
+
+        if (status != YDB_OK) return status;
+    }
+
+    return YDB_OK;
+} // @end ydb::move_reconcile function
+
+/*
+ * @function {private} ydb::move_replay
+ * @summary Copy a source node written between chunks to the target again, or kill it there, along with the nodes below it for a subtree write
+ * @param {MoveChunk*} move - The move; copied is changed by the number of nodes with values added to the target, on output
+ * @param {vector<string>} source - Subscripts of the source node written
+ * @param {bool} subtree - Whether the write could have changed the nodes below the node too
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t move_replay(MoveChunk* move, const vector<string>& source, const bool subtree)
+{
+    vector<string> target = move->nodem_baton->to_subs_array;
+
+    target.insert(target.end(), source.begin() + move->nodem_baton->subs_array.size(), source.end());
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    vector<string> current = target;
+    string value;
+    unsigned int data;
+
+    to_buffers(target, subs_array);
+    ydb_status_t status = ydb_data_s(move->to_glvn, target.size(), subs_array, &data);
+
+    if (status != YDB_OK) return status;
+
+    // The values being replaced are taken out of the count first, and the ones copied again are added back
+    if (data % 10 == 1) move->copied--;
+
+    if (subtree && data >= 10) {
+        while ((status = node_next(move->to_glvn, current)) == YDB_OK) {
+            if (current.size() <= target.size() || !std::equal(target.begin(), target.end(), current.begin())) break;
+
+            move->copied--;
+        }
+
+        if (status != YDB_OK && status != YDB_NODE_END) return status;
+    }
+
+    to_buffers(target, subs_array);
+    status = ydb_delete_s(move->to_glvn, target.size(), subs_array, subtree ? YDB_DEL_TREE : YDB_DEL_NODE);
+
+    if (status != YDB_OK) return status;
+
+    to_buffers(source, subs_array);
+    status = ydb_data_s(move->from_glvn, source.size(), subs_array, &data);
+
+    if (status != YDB_OK) return status;
+
+    if (data % 10 == 1) {
+        status = get_value(move->from_glvn, source, value);
+        if (status == YDB_OK) status = move_target(move, source, value);
+
+        if (status != YDB_OK) return status;
+
+        move->copied++;
+    }
+
+    if (!subtree || data < 10) return YDB_OK;
+
+    current = source;
+
+    while ((status = node_next(move->from_glvn, current)) == YDB_OK) {
+        if (current.size() <= source.size() || !std::equal(source.begin(), source.end(), current.begin())) break;
+
+        status = get_value(move->from_glvn, current, value);
+        if (status == YDB_OK) status = move_target(move, current, value);
+
+        if (status != YDB_OK) return status;
+
+        move->copied++;
+    }
+
+    return (status == YDB_NODE_END) ? YDB_OK : status;
+} // @end ydb::move_replay function
+
+/*
+ * @function {private} ydb::move_cutover
+ * @summary Bring the copied target up to date with the source, which may have been written between chunks, and kill the source
+ * @param {MoveChunk*} move - The move; copied is the number of nodes with values in the target, or only its change after a replay, on output
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t move_cutover(MoveChunk* move)
+{
+    const vector<string>& from_subs = move->nodem_baton->subs_array;
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    ydb_status_t status = YDB_OK;
+
+    move->copied = 0;
+
+    // Only the nodes written through Nodem since the copy started are replayed, so the cutover is as short as the writes were few
+    if (move->written->whole) {
+        status = move_reconcile(move);
+    } else {
+        for (const std::pair<const vector<string>, bool>& node : move->written->written) {
+            status = move_replay(move, node.first, node.second);
+
+            if (status != YDB_OK) break;
+        }
+    }
+
+    if (status != YDB_OK) return status;
+
+    to_buffers(from_subs, subs_array);
+
+    return ydb_delete_s(move->from_glvn, from_subs.size(), subs_array, YDB_DEL_TREE);
+} // @end ydb::move_cutover function
+
+/*
+ * @function {private} ydb::move_cutover_tp
+ * @summary Bring the copied target up to date and kill the source, as the callback of a transaction
+ * @param {void*} data - Cast in to a MoveChunk struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int move_cutover_tp(void* data)
+{
+    MoveChunk* move = static_cast<MoveChunk*>(data);
+    ydb_status_t status = move_cutover(move);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    move->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::move_cutover_tp function
+
+/*
+ * @struct {private} ydb::ConsistentRead
+ * @summary The nodes read by readConsistent, and the global directory each one is read from, passed to its transaction callback
+ * @member {NodemBaton*} nodem_baton
+ * @member {vector<string>} glds
+ * @member {string} default_gld
+ */
+struct ConsistentRead {
+    nodem::NodemBaton*  nodem_baton;
+    vector<string>      glds;
+    string              default_gld;
+}; // @end ydb::ConsistentRead struct
+
+/*
+ * @function {private} ydb::read_consistent_tp
+ * @summary Read every node in a consistent view, as the callback of a read-only transaction; YottaDB calls it again on a restart
+ * @param {void*} data - Cast in to a ConsistentRead struct, whose baton contains the following members
+ * @member {vector<vector<string>>} nodes_array - Each node, as its name followed by its subscripts
+ * @member {vector<string>} values_array - The value of each node, on output
+ * @member {vector<unsigned int>} data_array - Whether each node has a value, on output
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or any other error code
+ */
+static int read_consistent_tp(void* data)
+{
+    ConsistentRead* read = static_cast<ConsistentRead*>(data);
+    nodem::NodemBaton* nodem_baton = read->nodem_baton;
+
+    // A restart reads every node again, so nothing from an earlier try is kept
+    nodem_baton->values_array.clear();
+    nodem_baton->data_array.clear();
+
+    string active_gld = read->default_gld;
+    string value;
+    ydb_status_t status = YDB_OK;
+
+    for (unsigned int i = 0; i < nodem_baton->nodes_array.size(); i++) {
+        const vector<string>& node = nodem_baton->nodes_array[i];
+        const string& gld = read->glds[i].empty() ? read->default_gld : read->glds[i];
+
+        if (gld != active_gld) {
+            status = switch_gld(gld);
+
+            if (status != YDB_OK) break;
+
+            active_gld = gld;
+        }
+
+        ydb_buffer_t glvn;
+        glvn.len_alloc = glvn.len_used = node[0].length();
+        glvn.buf_addr = (char*) node[0].c_str();
+
+        status = get_value(&glvn, vector<string> (node.begin() + 1, node.end()), value);
+
+        if (status == YDB_ERR_GVUNDEF || status == YDB_ERR_LVUNDEF) {
+            status = YDB_OK;
+            value.clear();
+
+            nodem_baton->data_array.push_back(0);
+        } else if (status == YDB_OK) {
+            nodem_baton->data_array.push_back(1);
+        } else {
+            break;
+        }
+
+        nodem_baton->values_array.push_back(value);
+    }
+
+    if (active_gld != read->default_gld) {
+        ydb_status_t switch_stat = switch_gld(read->default_gld);
+
+        if (status == YDB_OK) status = switch_stat;
+    }
+
+    return status;
+} // @end ydb::read_consistent_tp function
+
+/*
+ * @struct {private} ydb::JsonLoad
+ * @summary The parse of a fromJSON call, and where its nodes are set, passed to its transaction callback
+ * @member {NodemBaton*} nodem_baton
+ * @member {JsonReader*} json_reader
+ * @member {shard_ptr_t} shard
+ * @member {string} var_name
+ * @member {string} gld
+ * @member {string} default_gld
+ * @member {double} count
+ * @member {ydb_status_t} status
+ */
+struct JsonLoad {
+    nodem::NodemBaton*  nodem_baton;
+    nodem::JsonReader*  json_reader;
+    nodem::shard_ptr_t  shard;
+    string              var_name;
+    string              gld;
+    string              default_gld;
+    double              count;
+    ydb_status_t        status;
+}; // @end ydb::JsonLoad struct
+
+/*
+ * @function {private} ydb::json_load
+ * @summary Parse the JSON text, setting each node as it is parsed, with the caller holding the mutex
+ * @param {JsonLoad*} load - The parse, whose baton contains the following members
+ * @member {vector<string>} subs_array - Subscripts of the root of the subtree
+ * @member {ydb_char_t*} error - Error message, for a JSON syntax error or an error returned from YottaDB
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t json_load(JsonLoad* load)
+{
+    nodem::NodemBaton* nodem_baton = load->nodem_baton;
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = load->var_name.length();
+    glvn.buf_addr = (char*) load->var_name.c_str();
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    bool switching = load->shard || !load->gld.empty();
+    string active_gld = load->default_gld;
+    ydb_status_t status = YDB_OK;
+
+    load->count = 0;
+
+    nodem::json_result_t result = load->json_reader->parse(nodem_baton->subs_array,
+      [&](const vector<string>& subs, const string& value) -> bool {
+        if (switching) {
+            const nodem::ShardedGlobal* shard = load->shard.get();
+            const string& gld = shard ?
+              shard->glds[subs.size() >= shard->key_level ? nodem::shard_index(*shard, subs[shard->key_level - 1]) : 0] : load->gld;
+
+            if (gld != active_gld) {
+                status = switch_gld(gld);
+
+                if (status != YDB_OK) return false;
+
+                active_gld = gld;
+            }
+        }
+
+        to_buffers(subs, subs_array);
+
+        ydb_buffer_t data_value;
+        data_value.len_alloc = data_value.len_used = value.length();
+        data_value.buf_addr = (char*) value.data();
+
+        status = ydb_set_s(&glvn, subs.size(), subs_array, &data_value);
+
+        if (status != YDB_OK) return false;
+
+        load->count++;
+        return true;
+    });
+
+    if (result == nodem::JSON_STOPPED && status != YDB_TP_RESTART) {
+        ydb_zstatus(nodem_baton->error, ERR_LEN);
+    } else if (result == nodem::JSON_SYNTAX) {
+        snprintf(nodem_baton->error, ERR_LEN, "%d,ydb::from_json,%%YDB-E-PARAMINVALID, %s", -YDB_ERR_PARAMINVALID,
+          load->json_reader->error().c_str());
+
+        status = YDB_ERR_PARAMINVALID;
+    } else if (result == nodem::JSON_DEPTH) {
+        snprintf(nodem_baton->error, ERR_LEN, "%d,ydb::from_json,%%YDB-E-MAXNRSUBSCRIPTS, Maximum number of subscripts exceeded",
+          -YDB_ERR_MAXNRSUBSCRIPTS);
+
+        status = YDB_ERR_MAXNRSUBSCRIPTS;
+    }
+
+    if (active_gld != load->default_gld) {
+        ydb_status_t switch_stat = switch_gld(load->default_gld);
+
+        if (switch_stat != YDB_OK && status == YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+            status = switch_stat;
+        }
+    }
+
+    return status;
+} // @end ydb::json_load function
+
+/*
+ * @function {private} ydb::json_load_tp
+ * @summary Parse the JSON text and set its nodes, as the callback of a transaction; YottaDB calls it again on a restart
+ * @param {void*} data - Cast in to a JsonLoad struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int json_load_tp(void* data)
+{
+    JsonLoad* load = static_cast<JsonLoad*>(data);
+    ydb_status_t status = json_load(load);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    // The error is kept for the caller, since a rollback makes ydb_tp_s return YDB_TP_ROLLBACK instead
+    load->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::json_load_tp function
+
+enum aggregate_write_t {
+    AGGREGATE_SET,
+    AGGREGATE_INCREMENT,
+    AGGREGATE_KILL
+};
+
+/*
+ * @struct {private} ydb::AggregateWrite
+ * @summary A set, increment, or kill of a global with aggregates, passed to the transaction callback that keeps them current
+ * @member {NodemBaton*} nodem_baton
+ * @member {vector<aggregate_ptr_t>} aggregates
+ * @member {aggregate_write_t} write
+ * @member {string} increment
+ * @member {string} value
+ * @member {ydb_status_t} status
+ */
+struct AggregateWrite {
+    nodem::NodemBaton*              nodem_baton;
+    vector<nodem::aggregate_ptr_t>  aggregates;
+    aggregate_write_t               write;
+    string                          increment;
+    string                          value;
+    ydb_status_t                    status;
+}; // @end ydb::AggregateWrite struct
+
+/*
+ * @function {private} ydb::aggregate_write
+ * @summary Make the write, and apply the difference it made to each source node to the totals of its aggregates
+ * @param {AggregateWrite*} write - The write, whose baton contains the following members
+ * @member {string} name - Global name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {string} value - Value to set
+ * @member {bool} node_only - Whether a kill is of only the node, or the node and its children
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t aggregate_write(AggregateWrite* write)
+{
+    nodem::NodemBaton* nodem_baton = write->nodem_baton;
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    const vector<string>& subs = nodem_baton->subs_array;
+    ydb_status_t status;
+
+    if (write->write == AGGREGATE_KILL) {
+        status = aggregate_kill(&glvn, subs, nodem_baton->node_only, write->aggregates);
+    } else {
+        string old_value;
+        status = get_value(&glvn, subs, old_value);
+        bool defined = status == YDB_OK;
+
+        if (status == YDB_ERR_GVUNDEF) status = YDB_OK;
+
+        ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+        to_buffers(subs, subs_array);
+
+        if (status == YDB_OK && write->write == AGGREGATE_SET) {
+            ydb_buffer_t data_node;
+            data_node.len_alloc = data_node.len_used = nodem_baton->value.length();
+            data_node.buf_addr = (char*) nodem_baton->value.data();
+
+            status = ydb_set_s(&glvn, subs.size(), subs_array, &data_node);
+            write->value = nodem_baton->value;
+        } else if (status == YDB_OK) {
+            ydb_buffer_t incr;
+            incr.len_alloc = incr.len_used = write->increment.length();
+            incr.buf_addr = (char*) write->increment.data();
+
+            char increment_data[AGGREGATE_NUMBER];
+
+            ydb_buffer_t value;
+            value.len_alloc = AGGREGATE_NUMBER;
+            value.len_used = 0;
+            value.buf_addr = increment_data;
+
+            status = ydb_incr_s(&glvn, subs.size(), subs_array, &incr, &value);
+            if (status == YDB_OK) write->value.assign(value.buf_addr, value.len_used);
+        }
+
+        for (unsigned int i = 0; i < write->aggregates.size() && status == YDB_OK; i++) {
+            status = aggregate_update(*write->aggregates[i], subs, defined ? &old_value : nullptr, &write->value);
+        }
+    }
+
+    if (status != YDB_OK && status != YDB_TP_RESTART) ydb_zstatus(nodem_baton->error, ERR_LEN);
+
+    return status;
+} // @end ydb::aggregate_write function
+
+/*
+ * @function {private} ydb::aggregate_write_tp
+ * @summary Make a write and keep its aggregates current, as the callback of a transaction; YottaDB calls it again on a restart
+ * @param {void*} data - Cast in to an AggregateWrite struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int aggregate_write_tp(void* data)
+{
+    AggregateWrite* write = static_cast<AggregateWrite*>(data);
+    ydb_status_t status = aggregate_write(write);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    write->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::aggregate_write_tp function
+
+/*
+ * @function {private} ydb::aggregate_call
+ * @summary Make a write to a global with aggregates in one transaction with the updates to their totals, with the caller holding the mutex
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {short} tp_level - Level of nested transactions; a write inside one is made as part of it
+ * @param {vector<aggregate_ptr_t>} aggregates - The aggregates the write can change
+ * @param {aggregate_write_t} kind - Whether the write is a set, an increment, or a kill
+ * @param {string} increment - The amount to increment by, for an increment
+ * @param {string} value - The new value of the node, on output, for an increment
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t aggregate_call(nodem::NodemBaton* nodem_baton, const vector<nodem::aggregate_ptr_t>& aggregates,
+  const aggregate_write_t kind, const string& increment, string& value)
+{
+    AggregateWrite write;
+
+    write.nodem_baton = nodem_baton;
+    write.aggregates = aggregates;
+    write.write = kind;
+    write.increment = increment;
+    write.status = YDB_OK;
+
+    ydb_status_t status;
+
+    if (nodem_baton->nodem_state->tp_level == 0) {
+        status = ydb_tp_s(&aggregate_write_tp, &write, "", 0, NULL);
+
+        if (status == YDB_TP_ROLLBACK) {
+            status = write.status;
+        } else if (status != YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        }
+    } else {
+        // Inside a transaction, the totals are updated as part of it, and a restart is passed up to it
+        status = aggregate_write(&write);
+    }
+
+    if (status == YDB_OK) {
+        value = write.value;
+
+        for (const nodem::aggregate_ptr_t& aggregate : aggregates) nodem::read_ahead_invalidate(aggregate->target);
+    }
+
+    return status;
+} // @end ydb::aggregate_call function
+
+/*
+ * @struct {private} ydb::AggregateBuild
+ * @summary The aggregate whose totals are being computed from its source global, passed to the transaction callback
+ * @member {Aggregate*} aggregate
+ * @member {NodemBaton*} nodem_baton
+ * @member {double} count
+ * @member {ydb_status_t} status
+ */
+struct AggregateBuild {
+    const nodem::Aggregate* aggregate;
+    nodem::NodemBaton*      nodem_baton;
+    double                  count;
+    ydb_status_t            status;
+}; // @end ydb::AggregateBuild struct
+
+/*
+ * @function {private} ydb::aggregate_build
+ * @summary Kill the target global, and add every source node at the value level to the totals of its group, with the caller holding the mutex
+ * @param {AggregateBuild*} build - The aggregate, whose baton contains the following members
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @returns {ydb_status_t} - Return code; 0 is success, YDB_TP_RESTART inside a transaction that must restart, or an error code
+ */
+static ydb_status_t aggregate_build(AggregateBuild* build)
+{
+    const nodem::Aggregate& aggregate = *build->aggregate;
+
+    ydb_buffer_t target;
+    target.len_alloc = target.len_used = aggregate.target.length();
+    target.buf_addr = (char*) aggregate.target.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = aggregate.source.length();
+    glvn.buf_addr = (char*) aggregate.source.c_str();
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    vector<string> subs {""};
+    string key;
+    string value;
+    unsigned int data;
+
+    build->count = 0;
+
+    ydb_status_t status = ydb_delete_s(&target, 0, NULL, YDB_DEL_TREE);
+
+    // Only the levels down to the value level are walked, so the nodes below it are never visited
+    while (status == YDB_OK && !subs.empty()) {
+        status = subscript_next(&glvn, subs, false, key);
+
+        if (status == YDB_ERR_NODEEND) {
+            subs.pop_back();
+            status = YDB_OK;
+
+            continue;
+        } else if (status != YDB_OK) {
+            break;
+        }
+
+        subs.back() = key;
+        to_buffers(subs, subs_array);
+
+        status = ydb_data_s(&glvn, subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) break;
+
+        if (subs.size() < aggregate.value_level) {
+            if (data >= 10) subs.push_back("");
+        } else if (data % 10 == 1) {
+            status = get_value(&glvn, subs, value);
+
+            if (status == YDB_OK) status = aggregate_update(aggregate, subs, nullptr, &value);
+
+            build->count++;
+        }
+    }
+
+    if (status != YDB_OK && status != YDB_TP_RESTART) ydb_zstatus(build->nodem_baton->error, ERR_LEN);
+
+    return status;
+} // @end ydb::aggregate_build function
+
+/*
+ * @function {private} ydb::aggregate_build_tp
+ * @summary Compute the totals of an aggregate, as the callback of a transaction; YottaDB calls it again on a restart
+ * @param {void*} data - Cast in to an AggregateBuild struct
+ * @returns {int} - YDB_OK to commit, YDB_TP_RESTART to have YottaDB restart the transaction, or YDB_TP_ROLLBACK on an error
+ */
+static int aggregate_build_tp(void* data)
+{
+    AggregateBuild* build = static_cast<AggregateBuild*>(data);
+    ydb_status_t status = aggregate_build(build);
+
+    if (status == YDB_OK || status == YDB_TP_RESTART) return status;
+
+    build->status = status;
+    return YDB_TP_ROLLBACK;
+} // @end ydb::aggregate_build_tp function
+
 // ***Begin Public APIs***
 
 /*
- * @function ydb::data
- * @summary Check if global or local node has data and/or children or not
+ * @function {private} ydb::read_ahead_window
+ * @summary Find the read-ahead window a sequential order, previous, or get call would use, or the one to reuse for a new level
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts, ending with the subscript the call starts from
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {unsigned int} read_ahead - Number of subscripts to prefetch; 0 turns read-ahead off
+ * @nested-member {ReadAheadWindow[]} read_ahead_windows - One window for each level being walked
+ * @param {bool} reverse - Whether the call walks the level in reverse collation order
+ * @param {bool} reuse - Whether to return a window to reuse, rather than nullptr, when no window is on this level
+ * @returns {ReadAheadWindow*} - The window, or nullptr when read-ahead does not apply to the call
+ */
+static nodem::ReadAheadWindow* read_ahead_window(nodem::NodemBaton* nodem_baton, const bool reverse, const bool reuse)
+{
+    nodem::NodemState* nodem_state = nodem_baton->nodem_state;
+    const string& name = nodem_baton->name;
+    const vector<string>& subs = nodem_baton->subs_array;
+
+    // Only synchronous calls outside a transaction use it, so the windows are only touched by the thread that owns them
+    if (nodem_state->read_ahead == 0 || nodem_baton->async || nodem_state->tp_level != 0 || subs.empty()) return nullptr;
+    if (shard_routed_g || name.compare(0, 2, "^[") == 0 || name.compare(0, 2, "^|") == 0) return nullptr;
+
+    nodem::ReadAheadWindow* window = nullptr;
+
+    for (nodem::ReadAheadWindow& level : nodem_state->read_ahead_windows) {
+        if (level.name == name && level.reverse == reverse && level.parent.size() + 1 == subs.size() &&
+          std::equal(level.parent.begin(), level.parent.end(), subs.begin())) {
+            window = &level;
+            break;
+        }
+    }
+
+    if (window == nullptr) {
+        if (!reuse) return nullptr;
+
+        // A new level replaces the window for the same name and depth, e.g. the next pass of an inner loop, or else the oldest
+        window = &nodem_state->read_ahead_windows[0];
+
+        for (nodem::ReadAheadWindow& level : nodem_state->read_ahead_windows) {
+            if (level.name == name && level.parent.size() + 1 == subs.size()) {
+                window = &level;
+                break;
+            }
+
+            if (level.used < window->used) window = &level;
+        }
+
+        window->name = name;
+        window->parent.assign(subs.begin(), subs.end() - 1);
+        window->keys.clear();
+        window->values.clear();
+        window->defined.clear();
+        window->last.clear();
+        window->position = 0;
+        window->reverse = reverse;
+        window->end = false;
+        window->armed = false;
+    }
+
+    window->used = ++nodem_state->read_ahead_clock;
+
+    return window;
+} // @end ydb::read_ahead_window function
+
+/*
+ * @function {private} ydb::read_ahead_fill
+ * @summary Prefetch the subscripts after a given one at a window's level, and optionally their values, while holding the mutex once
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {unsigned int} read_ahead - Number of subscripts to prefetch
+ * @nested-member {bool} read_ahead_values - Whether to prefetch the value of each subscript as well
+ * @param {ReadAheadWindow} window - The window to fill
+ * @param {string} from - The subscript to start after
+ * @returns {ydb_status_t} - Return code; 0 is success, any other number is an error code
+ */
+static ydb_status_t read_ahead_fill(nodem::NodemBaton* nodem_baton, nodem::ReadAheadWindow& window, const string& from)
+{
+    nodem::NodemState* nodem_state = nodem_baton->nodem_state;
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = window.name.length();
+    glvn.buf_addr = (char*) window.name.c_str();
+
+    vector<string> subs = window.parent;
+    subs.push_back(from);
+
+    window.keys.clear();
+    window.values.clear();
+    window.defined.clear();
+    window.position = 0;
+    window.end = false;
+
+    // Taken before reading, so a write that lands while the window is filled leaves it stale, not valid
+    window.generation = nodem::read_ahead_generation(window.name);
+
+    ydb_status_t status = YDB_OK;
+    string key;
+    string value;
+
+    nodem::lock_mutex(window.name);
+
+    while (window.keys.size() < nodem_state->read_ahead) {
+        status = subscript_next(&glvn, subs, window.reverse, key);
+
+        if (status == YDB_ERR_NODEEND) {
+            window.end = true;
+            status = YDB_OK;
+
+            break;
+        } else if (status != YDB_OK) {
+            break;
+        }
+
+        subs.back() = key;
+
+        if (nodem_state->read_ahead_values) {
+            status = get_value(&glvn, subs, value);
+
+            if (status == YDB_ERR_GVUNDEF || status == YDB_ERR_LVUNDEF) {
+                value.clear();
+                window.defined.push_back(false);
+            } else if (status == YDB_OK) {
+                window.defined.push_back(true);
+            } else {
+                break;
+            }
+
+            window.values.push_back(value);
+            status = YDB_OK;
+        }
+
+        window.keys.push_back(key);
+    }
+
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+
+    nodem::unlock_mutex();
+
+    if (nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   read-ahead: ", window.keys.size(), " subscripts", window.end ? ", to the end of the level" : "");
+    }
+
+    // A partial window, cut short by an error, is kept; the error is returned when it runs out
+    if (!window.keys.empty()) return YDB_OK;
+
+    return status;
+} // @end ydb::read_ahead_fill function
+
+/*
+ * @function {private} ydb::read_ahead_order
+ * @summary Answer an order or previous call from its level's read-ahead window, when the call picks up where the last one left off
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {vector<string>} subs_array - Subscripts, ending with the subscript to start from
+ * @member {ydb_char_t*} result - The next subscript, on output
+ * @param {bool} reverse - Whether the call is previous, rather than order
+ * @param {ReadAheadWindow*} window - Set to the window for the call, or nullptr when read-ahead does not apply
+ * @param {ydb_status_t} status - Set to the return code of the call, when it is answered
+ * @returns {bool} - Whether the call was answered; if not, the caller makes it and passes the result to read_ahead_record
+ */
+static bool read_ahead_order(nodem::NodemBaton* nodem_baton, const bool reverse, nodem::ReadAheadWindow*& window, ydb_status_t& status)
+{
+    window = read_ahead_window(nodem_baton, reverse, true);
+
+    if (window == nullptr) return false;
+
+    const string& from = nodem_baton->subs_array.back();
+
+    // Only a call that starts from the subscript the last call on this level returned is sequential
+    if (!window->armed || from != window->last) {
+        window->keys.clear();
+        window->values.clear();
+        window->defined.clear();
+        window->position = 0;
+        window->end = false;
+        window->armed = true;
+
+        return false;
+    }
+
+    bool valid = window->generation == nodem::read_ahead_generation(window->name);
+
+    if (!valid || window->position >= window->keys.size()) {
+        if (valid && window->end) {
+            window->keys.clear();
+            window->values.clear();
+            window->defined.clear();
+            window->position = 0;
+            window->end = false;
+
+            status = YDB_NODE_END;
+        } else {
+            status = read_ahead_fill(nodem_baton, *window, from);
+        }
+
+        if (status != YDB_OK || window->keys.empty()) {
+            nodem_baton->result[0] = '\0';
+            window->last.clear();
+
+            if (status == YDB_OK) status = YDB_NODE_END;
+            if (status != YDB_NODE_END) window->armed = false;
+
+            return true;
+        }
+    }
+
+    window->last = window->keys[window->position++];
+
+    strncpy(nodem_baton->result, window->last.c_str(), window->last.length());
+    nodem_baton->result[window->last.length()] = '\0';
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   read-ahead: hit");
+
+    status = YDB_OK;
+
+    return true;
+} // @end ydb::read_ahead_order function
+
+/*
+ * @function {private} ydb::read_ahead_record
+ * @summary Remember the subscript an order or previous call returned, so that a call starting from it is recognized as sequential
+ * @param {ReadAheadWindow*} window - The window for the call, from read_ahead_order
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {ydb_char_t*} result - The subscript returned
+ * @param {ydb_status_t} status - Return code of the call
+ * @returns {void}
+ */
+static void read_ahead_record(nodem::ReadAheadWindow* window, const nodem::NodemBaton* nodem_baton, const ydb_status_t status)
+{
+    if (window == nullptr) return;
+
+    if (status == YDB_OK || status == YDB_NODE_END) {
+        window->last = nodem_baton->result;
+    } else {
+        window->armed = false;
+    }
+
+    return;
+} // @end ydb::read_ahead_record function
+
+/*
+ * @function {private} ydb::read_ahead_get
+ * @summary Answer a get call from a read-ahead window with values, when it is for the subscript the last order or previous returned
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {ydb_char_t*} result - The value, on output
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {bool} read_ahead_values - Whether windows hold values
+ * @param {ydb_status_t} status - Set to the return code of the call, when it is answered
+ * @returns {bool} - Whether the call was answered
+ */
+static bool read_ahead_get(nodem::NodemBaton* nodem_baton, ydb_status_t& status)
+{
+    if (!nodem_baton->nodem_state->read_ahead_values) return false;
+
+    nodem::ReadAheadWindow* window = read_ahead_window(nodem_baton, false, false);
+
+    if (window == nullptr) window = read_ahead_window(nodem_baton, true, false);
+    if (window == nullptr || window->position == 0 || window->values.size() < window->position) return false;
+
+    unsigned int index = window->position - 1;
+
+    if (window->keys[index] != nodem_baton->subs_array.back()) return false;
+    if (window->generation != nodem::read_ahead_generation(window->name)) return false;
+
+    const string& value = window->values[index];
+
+    strncpy(nodem_baton->result, value.c_str(), value.length());
+    nodem_baton->result[value.length()] = '\0';
+
+    if (window->defined[index]) {
+        status = YDB_OK;
+    } else {
+        status = (nodem_baton->name[0] == '^') ? YDB_ERR_GVUNDEF : YDB_ERR_LVUNDEF;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   read-ahead: hit");
+
+    return true;
+} // @end ydb::read_ahead_get function
+
+/*
+ * @function ydb::data
+ * @summary Check if global or local node has data and/or children or not
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t data(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::data enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &data, SHARD_DATA);
+
+    if (nodem_baton->nodem_state->tp_level == 0 && nodem::bloom_absent(nodem_baton->name, nodem_baton->subs_array)) {
+        strcpy(nodem_baton->result, "0");
+
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::data exit");
+
+        return YDB_OK;
+    }
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    char* var_name = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = strlen(var_name);
+    glvn.buf_addr = var_name;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int subs_size = nodem_baton->subs_array.size();
+
+    for (unsigned int i = 0; i < subs_size; i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    }
+
+    unsigned int  temp_value = 0;
+    unsigned int* ret_value = &temp_value;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = ydb_data_s(&glvn, subs_size, subs_array, ret_value);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (int len = snprintf(nodem_baton->result, sizeof(int), "%u", *ret_value) < 0) {
+        char error[BUFSIZ];
+
+        cerr << strerror_r(errno, error, BUFSIZ);
+
+        status = len;
+    }
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::data exit");
+
+    return status;
+} // @end ydb::data function
+
+/*
+ * @function ydb::get
+ * @summary Get data from a global or local node, or an intrinsic special variable
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global, local, or intrinsic special variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t get(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &get, SHARD_HOME);
+
+    ydb_status_t status;
+
+    if (nodem_baton->nodem_state->tp_level == 0 && nodem::bloom_absent(nodem_baton->name, nodem_baton->subs_array)) {
+        nodem_baton->result[0] = '\0';
+
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get exit");
+
+        return (nodem_baton->name[0] == '^') ? YDB_ERR_GVUNDEF : YDB_ERR_LVUNDEF;
+    }
+
+    if (read_ahead_get(nodem_baton, status)) {
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get exit");
+
+        return status;
+    }
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    char* var_name = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = strlen(var_name);
+    glvn.buf_addr = var_name;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int subs_size = nodem_baton->subs_array.size();
+
+    for (unsigned int i = 0; i < subs_size; i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    }
+
+    char get_data[YDB_MAX_STR];
+
+    ydb_buffer_t value;
+    value.len_alloc = YDB_MAX_STR;
+    value.len_used = 0;
+    value.buf_addr = (char*) &get_data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    status = ydb_get_s(&glvn, subs_size, subs_array, &value);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
+    nodem_baton->result[value.len_used] = '\0';
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get exit");
+
+    return status;
+} // @end ydb::get function
+
+/*
+ * @function ydb::read_consistent
+ * @summary Read several global or local nodes in one read-only transaction, so that they are all from the same point in time
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {vector<vector<string>>} nodes_array - Each node, as its name followed by its subscripts; names can be extended references
+ * @member {vector<string>} values_array - The value of each node, on output
+ * @member {vector<unsigned int>} data_array - Whether each node has a value, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t read_consistent(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::read_consistent enter");
+
+    ConsistentRead read;
+    bool switching = false;
+
+    read.nodem_baton = nodem_baton;
+
+    for (vector<string>& node : nodem_baton->nodes_array) {
+        string gld;
+
+        if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+            nodem::debug_log(">>>    name: ", node[0]);
+
+            for (unsigned int i = 1; i < node.size(); i++) nodem::debug_log(">>>    subscripts[", i - 1, "]: ", node[i]);
+        }
+
+        if (!split_extended(node[0], gld)) {
+            nodem::shard_ptr_t shard = nodem::shard_find(node[0]);
+
+            if (shard) gld = shard->glds[node.size() > shard->key_level ? nodem::shard_index(*shard, node[shard->key_level]) : 0];
+        }
+
+        if (!gld.empty()) switching = true;
+
+        read.glds.push_back(gld);
+    }
+
+    char isv_name[] = "$zgbldir";
+
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = switching ? get_value(&isv, vector<string> {}, read.default_gld) : YDB_OK;
+
+    // YottaDB restarts the callback itself when another process changes a node it read, until it gets a consistent view
+    if (status == YDB_OK) status = ydb_tp_s(&read_consistent_tp, &read, "BATCH", 0, NULL);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::read_consistent exit");
+
+    return status;
+} // @end ydb::read_consistent function
+
+/*
+ * @function ydb::set
+ * @summary Set a global or local node, or an intrinsic special variable
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global, local, or intrinsic special variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {string} value - Value to set
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t set(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::set enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    value: ", nodem_baton->value);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &set, SHARD_HOME);
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    char* var_name = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = strlen(var_name);
+    glvn.buf_addr = var_name;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int subs_size = nodem_baton->subs_array.size();
+
+    for (unsigned int i = 0; i < subs_size; i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    }
+
+    char* value = (char*) nodem_baton->value.c_str();
+
+    ydb_buffer_t data_node;
+    data_node.len_alloc = data_node.len_used = strlen(value);
+    data_node.buf_addr = value;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    // Aggregates are looked for under the mutex, so that a write cannot miss one defined while it waited for it
+    vector<nodem::aggregate_ptr_t> aggregates = (shard_routed_g || change_isv) ? vector<nodem::aggregate_ptr_t> {} :
+      nodem::aggregate_sources(nodem_baton->name, subs_size, false);
+
+    // A write through an extended reference can reach another database than the totals are kept in, so they are marked stale
+    if (change_isv) nodem::aggregate_stale(nodem_baton->name);
+
+    // So are the moves the write reaches, so that a move cannot miss a write made between its chunks
+    nodem::move_written(nodem_baton->name, nodem_baton->subs_array, false);
+
+    ydb_status_t status;
+
+    if (aggregates.empty()) {
+        status = ydb_set_s(&glvn, subs_size, subs_array, &data_node);
+        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    } else {
+        string value;
+        status = aggregate_call(nodem_baton, aggregates, AGGREGATE_SET, "", value);
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::set exit");
+
+    return status;
+} // @end ydb::set
+
+/*
+ * @function ydb::kill
+ * @summary Kill a global or global node, or a local or local node, or the entire local symbol table
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {bool} node_only (<false>|true) - Whether to kill only the node, or the node and child subscripts
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t kill(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::kill enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    node_only: ", boolalpha, nodem_baton->node_only);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &kill, SHARD_ALL);
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_status_t status;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+
+    if (nodem_baton->name == "") {
+        ydb_buffer_t subs_array[1] = {8, 8, (char*) "v4wDebug"};
+
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+        nodem::move_written("", vector<string> {}, true);
+
+        status = ydb_delete_excl_s(1, subs_array);
+        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    } else {
+        char* var_name = (char*) nodem_baton->name.c_str();
+
+        ydb_buffer_t glvn;
+        glvn.len_alloc = glvn.len_used = strlen(var_name);
+        glvn.buf_addr = var_name;
+
+        ydb_buffer_t subs_array[YDB_MAX_SUBS];
+        unsigned int subs_size = nodem_baton->subs_array.size();
+
+        for (unsigned int i = 0; i < subs_size; i++) {
+            subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+            subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+        }
+
+        int delete_type = (nodem_baton->node_only) ? YDB_DEL_NODE : YDB_DEL_TREE;
+
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+        vector<nodem::aggregate_ptr_t> aggregates = (shard_routed_g || change_isv) ? vector<nodem::aggregate_ptr_t> {} :
+          nodem::aggregate_sources(nodem_baton->name, subs_size, !nodem_baton->node_only);
+
+        if (change_isv) nodem::aggregate_stale(nodem_baton->name);
+
+        nodem::move_written(nodem_baton->name, nodem_baton->subs_array, !nodem_baton->node_only);
+
+        if (aggregates.empty()) {
+            status = ydb_delete_s(&glvn, subs_size, subs_array, delete_type);
+            if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+        } else {
+            string value;
+            status = aggregate_call(nodem_baton, aggregates, AGGREGATE_KILL, "", value);
+        }
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::kill exit");
+
+    return status;
+} // @end ydb::kill function
+
+/*
+ * @function ydb::kill_tree
+ * @summary Kill a global or local tree in chunks, releasing the mutex between them, so that other calls can run during a large kill
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name, which can be an extended global reference
+ * @member {vector<string>} subs_array - Subscripts of the subtree root
+ * @member {gtm_double_t} option - Maximum number of nodes to kill while holding the mutex
+ * @member {ydb_char_t*} result - The number of nodes killed, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t kill_tree(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::kill_tree enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+    }
+
+    string var_name = nodem_baton->name;
+    vector<string> glds;
+
+    string extended_gld;
+
+    // The global directory is switched inside each chunk, since other calls can run, in the default one, between chunks
+    if (split_extended(var_name, extended_gld)) glds.push_back(extended_gld);
+
+    nodem::shard_ptr_t shard = nodem::shard_find(var_name);
+    const vector<string>& root = nodem_baton->subs_array;
+
+    if (shard && root.size() >= shard->key_level) {
+        glds.push_back(shard->glds[nodem::shard_index(*shard, root[shard->key_level - 1])]);
+    } else if (shard) {
+        glds = shard->glds;
+    } else if (glds.empty()) {
+        glds.push_back("");
+    }
+
+    char isv_name[] = "$zgbldir";
+
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = var_name.length();
+    glvn.buf_addr = (char*) var_name.c_str();
+
+    unsigned int chunk = static_cast<unsigned int>(nodem_baton->option);
+    bool locking = nodem_baton->nodem_state->tp_level == 0;
+    bool plain = glds.size() == 1 && glds[0].empty();
+    double killed = 0;
+    ydb_status_t status = YDB_OK;
+
+    KillChunk kill;
+
+    kill.glvn = &glvn;
+    kill.root = &root;
+    kill.chunk = chunk;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+
+    for (unsigned int i = 0; i < glds.size() && status == YDB_OK; i++) {
+        vector<string> cursor = root;
+        bool done = false;
+
+        while (status == YDB_OK) {
+            string default_gld;
+
+            if (locking) nodem::lock_mutex(nodem_baton->name);
+
+            if (!glds[i].empty()) {
+                status = get_value(&isv, vector<string> {}, default_gld);
+                if (status == YDB_OK && glds[i] != default_gld) status = switch_gld(glds[i]);
+            }
+
+            if (status == YDB_OK) {
+                kill.cursor = cursor;
+                kill.killed = killed;
+                kill.status = YDB_OK;
+
+                // Aggregates are kept of plain global names, so they are looked for under the mutex, once per chunk, and marked
+                // stale by a kill through an extended reference or a shard, which can reach another database
+                if (plain) {
+                    kill.aggregates = nodem::aggregate_sources(var_name, root.size(), true);
+                } else {
+                    nodem::aggregate_stale(var_name);
+                }
+
+                nodem::move_written(var_name, root, true);
+
+                if (kill.aggregates.empty() || !locking) {
+                    status = kill_tree_chunk(&kill);
+                } else {
+                    status = ydb_tp_s(&kill_tree_tp, &kill, "", 0, NULL);
+                    if (status == YDB_TP_ROLLBACK) status = kill.status;
+                }
+
+                if (status == YDB_OK) {
+                    cursor = kill.next_cursor;
+                    killed = kill.next_killed;
+                    done = kill.done;
+
+                    for (const nodem::aggregate_ptr_t& aggregate : kill.aggregates) {
+                        nodem::read_ahead_invalidate(aggregate->target);
+                    }
+                }
+            }
+
+            if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+
+            if (!default_gld.empty() && glds[i] != default_gld) {
+                ydb_status_t switch_stat = switch_gld(default_gld);
+
+                if (switch_stat != YDB_OK && status == YDB_OK) {
+                    ydb_zstatus(nodem_baton->error, ERR_LEN);
+                    status = switch_stat;
+                }
+            }
+
+            if (locking) nodem::unlock_mutex();
+
+            if (done) break;
+
+            // Give threads waiting on the mutex a chance to take it, before the next chunk
+            if (locking) sched_yield();
+        }
+    }
+
+    if (status == YDB_OK) snprintf(nodem_baton->result, RES_LEN, "%.0f", killed);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   killed: ", killed);
+        nodem::debug_log(">>   ydb::kill_tree exit");
+    }
+
+    return status;
+} // @end ydb::kill_tree function
+
+/*
+ * @function ydb::order
+ * @summary Return the next global or local node at the same level
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t order(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::order enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &order, SHARD_ORDER);
+
+    ydb_status_t status;
+    nodem::ReadAheadWindow* window = nullptr;
+
+    if (read_ahead_order(nodem_baton, false, window, status)) {
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::order exit");
+
+        return status;
+    }
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    char* var_name = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = strlen(var_name);
+    glvn.buf_addr = var_name;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int subs_size = nodem_baton->subs_array.size();
+
+    for (unsigned int i = 0; i < subs_size; i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    }
+
+    char order_data[YDB_MAX_STR];
+
+    ydb_buffer_t value;
+    value.len_alloc = YDB_MAX_STR;
+    value.len_used = 0;
+    value.buf_addr = (char*) &order_data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    status = ydb_subscript_next_s(&glvn, subs_size, subs_array, &value);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    while (strncmp(value.buf_addr, "v4w", 3) == 0 && subs_size == 0) {
+        glvn.len_alloc = glvn.len_used = strlen(value.buf_addr);
+        glvn.buf_addr = value.buf_addr;
+        value.len_used = 0;
+
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+        status = ydb_subscript_next_s(&glvn, subs_size, subs_array, &value);
+
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+        if (value.len_used == 0 || status != YDB_OK) break;
+    }
+
+    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
+    nodem_baton->result[value.len_used] = '\0';
+
+    read_ahead_record(window, nodem_baton, status);
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::order exit");
+
+    return status;
+} // @end ydb::order function
+
+/*
+ * @function ydb::previous
+ * @summary Return the previous global or local node at the same level
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts
+ * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t previous(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        if (nodem_baton->subs_array.size()) {
+            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+            }
+        }
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &previous, SHARD_PREVIOUS);
+
+    ydb_status_t status;
+    nodem::ReadAheadWindow* window = nullptr;
+
+    if (read_ahead_order(nodem_baton, true, window, status)) {
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous exit");
+
+        return status;
+    }
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    char* var_name = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = strlen(var_name);
+    glvn.buf_addr = var_name;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int subs_size = nodem_baton->subs_array.size();
+
+    for (unsigned int i = 0; i < subs_size; i++) {
+        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
+        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    }
+
+    char previous_data[YDB_MAX_STR];
+
+    ydb_buffer_t value;
+    value.len_alloc = YDB_MAX_STR;
+    value.len_used = 0;
+    value.buf_addr = (char*) &previous_data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    status = ydb_subscript_previous_s(&glvn, subs_size, subs_array, &value);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    while (strncmp(value.buf_addr, "v4w", 3) == 0 && subs_size == 0) {
+        glvn.len_alloc = glvn.len_used = strlen(value.buf_addr);
+        glvn.buf_addr = value.buf_addr;
+        value.len_used = 0;
+
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+        status = ydb_subscript_previous_s(&glvn, subs_size, subs_array, &value);
+
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+        if (value.len_used == 0 || status != YDB_OK) break;
+    }
+
+    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
+    nodem_baton->result[value.len_used] = '\0';
+
+    read_ahead_record(window, nodem_baton, status);
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous exit");
+
+    return status;
+} // @end ydb::previous function
+
+/*
+ * @function ydb::scan
+ * @summary Return a page of the subscripts under a global or local node, with their data and values, resuming after a given subscript
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the node whose children are scanned
+ * @member {string} value - The subscript to resume after; an empty string starts at the first one
+ * @member {gtm_double_t} option - Maximum number of subscripts to return
+ * @member {bool} reverse - Whether to scan in reverse collation order
+ * @member {vector<string>} to_subs_array - The subscripts found, on output
+ * @member {vector<string>} values_array - The value of each subscript found that has data, on output
+ * @member {vector<unsigned int>} data_array - The $DATA of each subscript found, on output
+ * @member {string} value - The last subscript visited, to resume after, on output when info is 1
+ * @member {gtm_uint_t} info - 1 if the scan stopped before the end of the subscripts, on output, else 0
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t scan(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::scan enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    value: ", nodem_baton->value);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+        nodem::debug_log(">>>    reverse: ", boolalpha, nodem_baton->reverse);
+        nodem::debug_log(">>>    filter: ", boolalpha, static_cast<bool>(nodem_baton->filter));
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &scan, SHARD_SCAN);
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    unsigned int limit = static_cast<unsigned int>(nodem_baton->option);
+    uint64_t max_visits = static_cast<uint64_t>(limit) * SCAN_VISITS;
+    uint64_t visits = 0;
+    vector<string> subs = nodem_baton->subs_array;
+    string key;
+    string value;
+    unsigned int data;
+
+    subs.push_back(nodem_baton->value);
+
+    nodem_baton->to_subs_array.clear();
+    nodem_baton->values_array.clear();
+    nodem_baton->data_array.clear();
+    nodem_baton->info = 0;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = YDB_OK;
+
+    // Resuming is a single seek from the last subscript returned, however far in to the global the scan has gone
+    while (true) {
+        // A selective filter stops at a bounded number of nodes, so one page never holds the mutex for a whole global
+        if (nodem_baton->to_subs_array.size() >= limit || visits >= max_visits) {
+            nodem_baton->info = 1;
+            break;
+        }
+
+        status = subscript_next(&glvn, subs, nodem_baton->reverse, key);
+
+        if (status != YDB_OK) break;
+
+        subs.back() = key;
+        visits++;
+        to_buffers(subs, subs_array);
+
+        status = ydb_data_s(&glvn, subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) break;
+
+        value.clear();
+
+        if (data % 10 == 1) {
+            status = get_value(&glvn, subs, value);
+
+            if (status != YDB_OK) break;
+        }
+
+        // A filtered scan keeps going past the nodes that do not match, until it fills the page or reaches its visit limit
+        if (nodem_baton->filter && !nodem_baton->filter->match(key, value, data)) continue;
+
+        nodem_baton->to_subs_array.push_back(key);
+        nodem_baton->values_array.push_back(value);
+        nodem_baton->data_array.push_back(data);
+    }
+
+    if (status == YDB_ERR_NODEEND) status = YDB_OK;
+    if (nodem_baton->info == 1) nodem_baton->value = subs.back();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::scan exit");
+
+    return status;
+} // @end ydb::scan function
+
+/*
+ * @function ydb::to_json
+ * @summary Serialize a global or local subtree as JSON text, walking it depth first with the mutex held
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the root of the subtree
+ * @member {gtm_uint_t} info - Shape of the JSON text: JSON_NESTED or JSON_FLAT
+ * @member {mode_t} mode - Data mode; canonical mode writes canonical numbers as JSON numbers
+ * @member {string} value - The JSON text, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {bool} utf8 - Whether the data is UTF-8, or bytes
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t to_json(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::to_json enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+    }
+
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &to_json, SHARD_HOME);
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    const vector<string>& root = nodem_baton->subs_array;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    to_buffers(root, subs_array);
+
+    nodem::JsonWriter json_writer {static_cast<nodem::json_shape_t>(nodem_baton->info), nodem_baton->nodem_state->utf8,
+      nodem_baton->mode == nodem::CANONICAL, root};
+
+    vector<string> subs = root;
+    string value;
+    unsigned int data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = ydb_data_s(&glvn, root.size(), subs_array, &data);
+
+    if (status == YDB_OK && data % 10 == 1) {
+        status = get_value(&glvn, root, value);
+
+        if (status == YDB_OK) json_writer.add(root, value);
+    }
+
+    // The nodes of the subtree follow its root in collation order, so the walk ends at the first node outside it
+    while (status == YDB_OK && data >= 10) {
+        status = node_next(&glvn, subs);
+
+        if (status != YDB_OK) break;
+        if (subs.size() <= root.size() || !std::equal(root.begin(), root.end(), subs.begin())) break;
+
+        status = get_value(&glvn, subs, value);
+
+        if (status != YDB_OK) break;
+
+        json_writer.add(subs, value);
+    }
+
+    if (status == YDB_NODE_END) status = YDB_OK;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    // Restoring $zgbldir uses the value member, so the JSON text is only moved in to it afterwards
+    if (status == YDB_OK) nodem_baton->value = json_writer.finish();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   length: ", nodem_baton->value.length());
+        nodem::debug_log(">>   ydb::to_json exit");
+    }
+
+    return status;
+} // @end ydb::to_json function
+
+/*
+ * @function ydb::count_distinct
+ * @summary Estimate the number of distinct values, or subscripts at one level, in a global or local subtree, with a HyperLogLog sketch
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name; it can be an extended reference, or a sharded global
+ * @member {vector<string>} subs_array - Subscripts of the root of the subtree
+ * @member {gtm_uint_t} info - Subscript level to count the distinct subscripts of, or 0 to count the distinct values
+ * @member {string} value - A serialized sketch to merge in to the count, or empty, on input; the serialized sketch, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t count_distinct(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::count_distinct enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+    }
+
+    // Each shard merges its nodes in to the sketch left in the value member by the shards before it
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &count_distinct, SHARD_ALL);
+
+    nodem::DistinctSketch sketch;
+
+    if (!nodem_baton->value.empty()) sketch.merge(nodem_baton->value.data(), nodem_baton->value.length());
+
+    nodem_baton->value.clear();
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    const vector<string>& root = nodem_baton->subs_array;
+    const unsigned int level = nodem_baton->info;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    vector<string> subs = root;
+    string key;
+    string value;
+    unsigned int data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = YDB_OK;
+
+    if (level == 0) {
+        to_buffers(root, subs_array);
+
+        status = ydb_data_s(&glvn, root.size(), subs_array, &data);
+
+        if (status == YDB_OK && data % 10 == 1) {
+            status = get_value(&glvn, root, value);
+
+            if (status == YDB_OK) sketch.add(value.data(), value.length());
+        }
+
+        while (status == YDB_OK && data >= 10) {
+            status = node_next(&glvn, subs);
+
+            if (status != YDB_OK) break;
+            if (subs.size() <= root.size() || !std::equal(root.begin(), root.end(), subs.begin())) break;
+
+            status = get_value(&glvn, subs, value);
+
+            if (status != YDB_OK) break;
+
+            sketch.add(value.data(), value.length());
+        }
+
+        if (status == YDB_NODE_END) status = YDB_OK;
+    } else {
+        // Only the levels down to the one counted are walked, so the nodes below it are never visited
+        subs.push_back("");
+
+        while (subs.size() > root.size()) {
+            status = subscript_next(&glvn, subs, false, key);
+
+            if (status == YDB_ERR_NODEEND) {
+                subs.pop_back();
+                status = YDB_OK;
+
+                continue;
+            } else if (status != YDB_OK) {
+                break;
+            }
+
+            subs.back() = key;
+
+            if (subs.size() == level) {
+                sketch.add(key.data(), key.length());
+                continue;
+            }
+
+            to_buffers(subs, subs_array);
+
+            status = ydb_data_s(&glvn, subs.size(), subs_array, &data);
+
+            if (status != YDB_OK) break;
+            if (data >= 10) subs.push_back("");
+        }
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (status == YDB_OK) nodem_baton->value = sketch.serialized();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::count_distinct exit");
+
+    return status;
+} // @end ydb::count_distinct function
+
+/*
+ * @function ydb::sample
+ * @summary Choose random nodes with values from a subtree, by reservoir sampling all of them, or by random descents through its levels
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name; it can be an extended reference, or a sharded global
+ * @member {vector<string>} subs_array - Subscripts of the root of the subtree
+ * @member {gtm_double_t} option - Number of nodes to choose
+ * @member {gtm_uint_t} info - Sampling method: RESERVOIR or DESCENT
+ * @member {string} value - Number of nodes with values a reservoir sample has seen, on input and output
+ * @member {vector<vector<string>>} nodes_array - The subscripts of each node chosen, added to on output
+ * @member {vector<string>} values_array - The value of each node chosen, added to on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t sample(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::sample enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+    }
+
+    // Each shard adds its nodes to the sample left in the baton by the shards before it
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &sample, SHARD_ALL);
+
+    uint64_t seen = strtoull(nodem_baton->value.c_str(), NULL, 10);
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    static thread_local std::mt19937_64 generator {std::random_device {}()};
+
+    const vector<string>& root = nodem_baton->subs_array;
+    const size_t size = static_cast<size_t>(nodem_baton->option);
+    vector<vector<string>>& nodes = nodem_baton->nodes_array;
+    vector<string>& values = nodem_baton->values_array;
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+
+    to_buffers(root, subs_array);
+
+    vector<string> subs = root;
+    string value;
+    unsigned int data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = ydb_data_s(&glvn, root.size(), subs_array, &data);
+
+    if (nodem_baton->info == nodem::RESERVOIR) {
+        // The nth node seen replaces a random one in the sample with a chance of size/n, and only then is its value read
+        auto keep = [&](const vector<string>& node) -> ydb_status_t {
+            size_t slot = nodes.size() < size ? nodes.size() : std::uniform_int_distribution<uint64_t> {0, seen}(generator);
+
+            seen++;
+
+            if (slot >= size) return YDB_OK;
+
+            ydb_status_t get_stat = get_value(&glvn, node, value);
+
+            if (get_stat != YDB_OK) return get_stat;
+
+            if (slot == nodes.size()) {
+                nodes.push_back(node);
+                values.push_back(value);
+            } else {
+                nodes[slot] = node;
+                values[slot] = value;
+            }
+
+            return YDB_OK;
+        };
+
+        if (status == YDB_OK && data % 10 == 1) status = keep(root);
+
+        while (status == YDB_OK && data >= 10) {
+            status = node_next(&glvn, subs);
+
+            if (status != YDB_OK) break;
+            if (subs.size() <= root.size() || !std::equal(root.begin(), root.end(), subs.begin())) break;
+
+            status = keep(subs);
+        }
+
+        if (status == YDB_NODE_END) status = YDB_OK;
+    } else if (status == YDB_OK && data != 0) {
+        // Each descent chooses a random subscript at every level, stopping at a node with a value, at random if it has children too
+        std::map<vector<string>, vector<string>> levels;
+        size_t wanted = nodes.size() + size;
+        size_t first = nodes.size();
+        string key;
+
+        for (size_t attempt = 0; status == YDB_OK && nodes.size() < wanted && attempt < size * SAMPLE_ATTEMPTS; attempt++) {
+            unsigned int node_data = data;
+
+            subs = root;
+
+            while (node_data >= 10 && (node_data % 10 == 0 || std::bernoulli_distribution {0.5}(generator))) {
+                status = sample_child(&glvn, subs, levels, generator, key);
+
+                if (status != YDB_OK) break;
+
+                subs.push_back(key);
+                to_buffers(subs, subs_array);
+
+                status = ydb_data_s(&glvn, subs.size(), subs_array, &node_data);
+
+                if (status != YDB_OK) break;
+            }
+
+            // A node killed since its level was listed ends that descent
+            if (status == YDB_ERR_NODEEND) {
+                status = YDB_OK;
+                continue;
+            }
+
+            if (status != YDB_OK || node_data % 10 != 1) continue;
+            if (std::find(nodes.begin() + first, nodes.end(), subs) != nodes.end()) continue;
+
+            status = get_value(&glvn, subs, value);
+
+            if (status != YDB_OK) break;
+
+            nodes.push_back(subs);
+            values.push_back(value);
+        }
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (status == YDB_OK) nodem_baton->value = std::to_string(seen);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   count: ", nodes.size());
+        nodem::debug_log(">>   ydb::sample exit");
+    }
+
+    return status;
+} // @end ydb::sample function
+
+/*
+ * @function ydb::sorter_write
+ * @summary Set a batch of sort records, each under its sort key and a sequence number, so equal keys keep the order they were added in
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name; it can be an extended reference
+ * @member {vector<string>} subs_array - Subscripts of the sorter's root node
+ * @member {vector<string>} to_subs_array - The sort keys
+ * @member {vector<string>} values_array - The records, one for each sort key
+ * @member {gtm_double_t} option - Sequence number of the first record in the batch
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t sorter_write(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::sorter_write enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+        nodem::debug_log(">>>    count: ", nodem_baton->to_subs_array.size());
+    }
+
+    string save_result;
+    bool change_isv = false;
+
+    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    ydb_buffer_t record;
+
+    vector<string> subs = nodem_baton->subs_array;
+    const size_t level = subs.size();
+    const uint64_t sequence = static_cast<uint64_t>(nodem_baton->option);
+
+    subs.resize(level + 2);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    nodem::move_written(nodem_baton->name, nodem_baton->subs_array, true);
+
+    ydb_status_t status = YDB_OK;
+
+    for (size_t i = 0; i < nodem_baton->to_subs_array.size(); i++) {
+        subs[level] = nodem_baton->to_subs_array[i];
+        subs[level + 1] = std::to_string(sequence + i);
+
+        to_buffers(subs, subs_array);
+
+        record.len_alloc = record.len_used = nodem_baton->values_array[i].length();
+        record.buf_addr = (char*) nodem_baton->values_array[i].c_str();
+
+        status = ydb_set_s(&glvn, subs.size(), subs_array, &record);
+
+        if (status != YDB_OK) break;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (change_isv) {
+        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+
+        if (set_stat != YDB_OK) return set_stat;
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::sorter_write exit");
+
+    return status;
+} // @end ydb::sorter_write function
+
+/*
+ * @function ydb::sorter_read
+ * @summary Read the next page of sort records, in key order, walking the key and sequence levels with ydb_subscript_next_s
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {string} name - Global or local variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {string} name - Global or local variable name; it can be an extended reference
+ * @member {vector<string>} subs_array - Subscripts of the sorter's root node
+ * @member {vector<string>} to_subs_array - Key and sequence number of the last record read, or empty to start, on input;
+ *   the key of each record read, on output
+ * @member {vector<string>} values_array - Each record read, on output
+ * @member {gtm_double_t} option - Maximum number of records to read
+ * @member {string} value - Sequence number of the last record read, on output
  * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t data(nodem::NodemBaton* nodem_baton)
+ydb_status_t sorter_read(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::data enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::sorter_read enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        for (unsigned int i = 0; i < nodem_baton->to_subs_array.size(); i++) {
+            nodem::debug_log(">>>    next[", i, "]: ", nodem_baton->to_subs_array[i]);
         }
+
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
     }
 
     string save_result;
@@ -183,482 +3802,685 @@ ydb_status_t data(nodem::NodemBaton* nodem_baton)
         if (set_stat != YDB_OK) return set_stat;
     }
 
-    char* var_name = (char*) nodem_baton->name.c_str();
-
     ydb_buffer_t glvn;
-    glvn.len_alloc = glvn.len_used = strlen(var_name);
-    glvn.buf_addr = var_name;
-
-    ydb_buffer_t subs_array[YDB_MAX_SUBS];
-    unsigned int subs_size = nodem_baton->subs_array.size();
-
-    for (unsigned int i = 0; i < subs_size; i++) {
-        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    vector<string> subs = nodem_baton->subs_array;
+    const size_t level = subs.size();
+    const unsigned int limit = static_cast<unsigned int>(nodem_baton->option);
+    vector<string>& keys = nodem_baton->to_subs_array;
+    string next;
+    string value;
+    string sequence;
+
+    // A page resumes at the sequence level of the last key read, and a new sort starts at the key level
+    if (keys.size() == 2) {
+        subs.push_back(keys[0]);
+        subs.push_back(keys[1]);
+    } else {
+        subs.push_back("");
     }
 
-    unsigned int  temp_value = 0;
-    unsigned int* ret_value = &temp_value;
+    keys.clear();
+    nodem_baton->values_array.clear();
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
-    ydb_status_t status = ydb_data_s(&glvn, subs_size, subs_array, ret_value);
+    ydb_status_t status = YDB_OK;
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    while (keys.size() < limit) {
+        status = subscript_next(&glvn, subs, false, next);
 
-    if (int len = snprintf(nodem_baton->result, sizeof(int), "%u", *ret_value) < 0) {
-        char error[BUFSIZ];
+        if (status == YDB_ERR_NODEEND && subs.size() == level + 2) {
+            subs.pop_back();
+            continue;
+        } else if (status != YDB_OK) {
+            break;
+        }
 
-        cerr << strerror_r(errno, error, BUFSIZ);
+        subs.back() = next;
 
-        status = len;
+        if (subs.size() == level + 1) {
+            subs.push_back("");
+            continue;
+        }
+
+        status = get_value(&glvn, subs, value);
+
+        if (status != YDB_OK) break;
+
+        keys.push_back(subs[level]);
+        nodem_baton->values_array.push_back(value);
+        sequence = next;
     }
 
+    if (status == YDB_ERR_NODEEND) status = YDB_OK;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
     if (change_isv) {
         ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
 
         if (set_stat != YDB_OK) return set_stat;
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::data exit");
+    if (status == YDB_OK) nodem_baton->value = sequence;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   count: ", keys.size());
+        nodem::debug_log(">>   ydb::sorter_read exit");
+    }
 
     return status;
-} // @end ydb::data function
+} // @end ydb::sorter_read function
 
 /*
- * @function ydb::get
- * @summary Get data from a global or local node, or an intrinsic special variable
+ * @function ydb::bloom
+ * @summary Build a Bloom filter over the keys at one level under a node, by scanning them; or remove the filter
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {string} name - Global, local, or intrinsic special variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {string} name - Global or local variable name
+ * @member {vector<string>} subs_array - Subscripts of the node whose descendants are keyed
+ * @member {gtm_uint_t} info - Subscript level of the last subscript in each key
+ * @member {gtm_double_t} option - Bits to allocate for each key
+ * @member {bool} node_only - Whether to remove the filter, rather than build it
+ * @member {ydb_char_t*} result - Whether a filter was removed, on output
  * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t get(nodem::NodemBaton* nodem_baton)
+ydb_status_t bloom(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::bloom enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
         }
+
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
+        nodem::debug_log(">>>    node_only: ", boolalpha, nodem_baton->node_only);
     }
 
-    string save_result;
-    bool change_isv = false;
+    const vector<string>& root = nodem_baton->subs_array;
+    const unsigned int level = nodem_baton->info;
 
-    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+    if (nodem_baton->node_only) {
+        strcpy(nodem_baton->result, nodem::bloom_remove(nodem_baton->name, root, level) ? "1" : "0");
 
-        if (set_stat != YDB_OK) return set_stat;
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::bloom exit");
+
+        return YDB_OK;
     }
 
-    char* var_name = (char*) nodem_baton->name.c_str();
+    // Registered before the scan, so keys written while it runs are queued for the filter, not missed
+    nodem::bloom_ptr_t filter = nodem::bloom_begin(nodem_baton->name, root, level);
 
     ydb_buffer_t glvn;
-    glvn.len_alloc = glvn.len_used = strlen(var_name);
-    glvn.buf_addr = var_name;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
 
     ydb_buffer_t subs_array[YDB_MAX_SUBS];
-    unsigned int subs_size = nodem_baton->subs_array.size();
 
-    for (unsigned int i = 0; i < subs_size; i++) {
-        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
-    }
+    vector<uint64_t> hashes;
+    vector<string> subs = root;
+    string key;
+    unsigned int data;
+    unsigned int chunk = 0;
 
-    char get_data[YDB_MAX_STR];
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
-    ydb_buffer_t value;
-    value.len_alloc = YDB_MAX_STR;
-    value.len_used = 0;
-    value.buf_addr = (char*) &get_data;
+    ydb_status_t status = YDB_OK;
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    // Only the levels down to the keyed one are walked, so the nodes below it are never visited
+    subs.push_back("");
 
-    ydb_status_t status = ydb_get_s(&glvn, subs_size, subs_array, &value);
+    while (subs.size() > root.size()) {
+        status = subscript_next(&glvn, subs, false, key);
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+        if (status == YDB_ERR_NODEEND) {
+            subs.pop_back();
+            status = YDB_OK;
 
-    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
-    nodem_baton->result[value.len_used] = '\0';
+            continue;
+        } else if (status != YDB_OK) {
+            break;
+        }
 
-    if (change_isv) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+        subs.back() = key;
 
-        if (set_stat != YDB_OK) return set_stat;
+        if (subs.size() == level) {
+            hashes.push_back(nodem::BloomFilter::hash(subs, root.size(), level));
+
+            // The mutex is given up between chunks, so other threads are not held up for the whole scan
+            if (++chunk == BLOOM_CHUNK && nodem_baton->nodem_state->tp_level == 0) {
+                chunk = 0;
+
+                nodem::unlock_mutex();
+                sched_yield();
+                nodem::lock_mutex(nodem_baton->name);
+            }
+
+            continue;
+        }
+
+        to_buffers(subs, subs_array);
+
+        status = ydb_data_s(&glvn, subs.size(), subs_array, &data);
+
+        if (status != YDB_OK) break;
+        if (data >= 10) subs.push_back("");
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::get exit");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (status == YDB_OK) {
+        filter->finish(hashes, static_cast<unsigned int>(nodem_baton->option));
+    } else {
+        nodem::bloom_abandon(filter);
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::bloom exit");
 
     return status;
-} // @end ydb::get function
+} // @end ydb::bloom function
 
 /*
- * @function ydb::set
- * @summary Set a global or local node, or an intrinsic special variable
+ * @function ydb::define_aggregate
+ * @summary Define an aggregate of a global, and compute its totals in one transaction, or drop its definition
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {string} name - Global, local, or intrinsic special variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {string} value - Value to set
+ * @member {string} name - Source global name; an empty string only shows the definition kept in the target
+ * @member {string} to_name - Target global name, where the totals are kept
+ * @member {gtm_uint_t} info - Number of leading subscripts that group the source nodes
+ * @member {gtm_double_t} option - Subscript level of the source nodes whose values are totaled
+ * @member {vector<string>} values_array - The totals to keep: count, sum, or both
+ * @member {bool} node_only - Whether to drop the definition, leaving the target global as it is
+ * @member {ydb_char_t*} result - The number of source nodes totaled, or whether a definition was dropped, on output
  * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t set(nodem::NodemBaton* nodem_baton)
+ydb_status_t define_aggregate(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::set enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::define_aggregate enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
-        nodem::debug_log(">>>    value: ", nodem_baton->value);
+        nodem::debug_log(">>>    to_name: ", nodem_baton->to_name);
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->values_array.size(); i++) {
+            nodem::debug_log(">>>    ops[", i, "]: ", nodem_baton->values_array[i]);
         }
+
+        nodem::debug_log(">>>    node_only: ", boolalpha, nodem_baton->node_only);
     }
 
-    string save_result;
-    bool change_isv = false;
+    if (nodem_baton->node_only) {
+        strcpy(nodem_baton->result, nodem::aggregate_remove(nodem_baton->to_name) ? "1" : "0");
 
-    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::define_aggregate exit");
 
-        if (set_stat != YDB_OK) return set_stat;
-    }
+        return YDB_OK;
+    } else if (nodem_baton->name.empty()) {
+        // Only showing the definition, which the return function looks up
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::define_aggregate exit");
 
-    char* var_name = (char*) nodem_baton->name.c_str();
+        return YDB_OK;
+    }
 
-    ydb_buffer_t glvn;
-    glvn.len_alloc = glvn.len_used = strlen(var_name);
-    glvn.buf_addr = var_name;
+    std::shared_ptr<nodem::Aggregate> aggregate = std::make_shared<nodem::Aggregate>();
 
-    ydb_buffer_t subs_array[YDB_MAX_SUBS];
-    unsigned int subs_size = nodem_baton->subs_array.size();
+    aggregate->source = nodem_baton->name;
+    aggregate->target = nodem_baton->to_name;
+    aggregate->group_level = nodem_baton->info;
+    aggregate->value_level = static_cast<unsigned int>(nodem_baton->option);
+    aggregate->ops = 0;
 
-    for (unsigned int i = 0; i < subs_size; i++) {
-        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+    for (const string& op : nodem_baton->values_array) {
+        aggregate->ops |= (op == "count") ? nodem::AGGREGATE_COUNT : nodem::AGGREGATE_SUM;
     }
 
-    char* value = (char*) nodem_baton->value.c_str();
+    AggregateBuild build;
 
-    ydb_buffer_t data_node;
-    data_node.len_alloc = data_node.len_used = strlen(value);
-    data_node.buf_addr = value;
+    build.aggregate = aggregate.get();
+    build.nodem_baton = nodem_baton;
+    build.count = 0;
+    build.status = YDB_OK;
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
-    ydb_status_t status = ydb_set_s(&glvn, subs_size, subs_array, &data_node);
+    // Defined under the mutex, before the totals are computed, so every write through Nodem after them updates them
+    nodem::aggregate_define(aggregate);
+    nodem::move_written(aggregate->target, vector<string> {}, true);
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    ydb_status_t status;
 
-    if (change_isv) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+    if (nodem_baton->nodem_state->tp_level == 0) {
+        status = ydb_tp_s(&aggregate_build_tp, &build, "", 0, NULL);
 
-        if (set_stat != YDB_OK) return set_stat;
+        if (status == YDB_TP_ROLLBACK) {
+            status = build.status;
+        } else if (status != YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        }
+    } else {
+        status = aggregate_build(&build);
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::set exit");
+    // Totals that could not be computed stay defined, but marked stale, until defineAggregate is called again
+    if (status != YDB_OK) aggregate->stale = true;
+
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (status == YDB_OK) snprintf(nodem_baton->result, RES_LEN, "%.0f", build.count);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   count: ", build.count);
+        nodem::debug_log(">>   ydb::define_aggregate exit");
+    }
 
     return status;
-} // @end ydb::set
+} // @end ydb::define_aggregate function
 
 /*
- * @function ydb::kill
- * @summary Kill a global or global node, or a local or local node, or the entire local symbol table
+ * @function ydb::prune
+ * @summary Kill the nodes at one level of a subtree that match a filter, in chunks that each commit in their own transaction
  * @param {NodemBaton*} nodem_baton - struct containing the following members
  * @member {string} name - Global or local variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {bool} node_only (<false>|true) - Whether to kill only the node, or the node and child subscripts
+ * @member {vector<string>} subs_array - Subscripts of the subtree root
+ * @member {gtm_uint_t} info - Subscript level of the nodes the filter is run against
+ * @member {gtm_double_t} option - Maximum number of nodes to visit in each transaction
+ * @member {filter_ptr_t} filter - The compiled where expression
+ * @member {vector<unsigned int>} data_array - The most nodes to visit in this call, or 0 for no limit
+ * @member {vector<string>} to_subs_array - The path to resume after, below the root; on output, empty once the walk is done
+ * @member {ydb_char_t*} result - The number of nodes run against the filter, pruned, and the chunks committed, on output
  * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t kill(nodem::NodemBaton* nodem_baton)
+ydb_status_t prune(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::kill enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::prune enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
-        nodem::debug_log(">>>    node_only: ", boolalpha, nodem_baton->node_only);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
         }
-    }
 
-    string save_result;
-    bool change_isv = false;
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
 
-    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+        for (unsigned int i = 0; i < nodem_baton->to_subs_array.size(); i++) {
+            nodem::debug_log(">>>    start[", i, "]: ", nodem_baton->to_subs_array[i]);
+        }
+    }
 
-        if (set_stat != YDB_OK) return set_stat;
+    ydb_buffer_t glvn;
+    glvn.len_alloc = glvn.len_used = nodem_baton->name.length();
+    glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    const vector<string>& root = nodem_baton->subs_array;
+    unsigned int limit = nodem_baton->data_array.empty() ? 0 : nodem_baton->data_array[0];
+    unsigned int chunk = static_cast<unsigned int>(nodem_baton->option);
+    bool locking = nodem_baton->nodem_state->tp_level == 0;
+    vector<string> cursor = root;
+    double scanned = 0;
+    double pruned = 0;
+    double visited = 0;
+    unsigned int chunks = 0;
+    ydb_status_t status = YDB_OK;
+
+    if (nodem_baton->to_subs_array.empty()) {
+        cursor.push_back("");
+    } else {
+        cursor.insert(cursor.end(), nodem_baton->to_subs_array.begin(), nodem_baton->to_subs_array.end());
     }
 
-    ydb_status_t status;
+    PruneChunk prune;
+
+    prune.nodem_baton = nodem_baton;
+    prune.glvn = &glvn;
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
 
-    if (nodem_baton->name == "") {
-        ydb_buffer_t subs_array[1] = {8, 8, (char*) "v4wDebug"};
+    while (cursor.size() > root.size() && (limit == 0 || visited < limit)) {
+        prune.cursor = cursor;
+        prune.chunk = (limit == 0 || limit - visited > chunk) ? chunk : static_cast<unsigned int>(limit - visited);
+        prune.status = YDB_OK;
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+        if (locking) nodem::lock_mutex(nodem_baton->name);
 
-        status = ydb_delete_excl_s(1, subs_array);
-    } else {
-        char* var_name = (char*) nodem_baton->name.c_str();
+        // Aggregates are looked for under the mutex, once per chunk, since they can be defined while the mutex is released
+        prune.aggregates = nodem::aggregate_sources(nodem_baton->name, nodem_baton->info, true);
 
-        ydb_buffer_t glvn;
-        glvn.len_alloc = glvn.len_used = strlen(var_name);
-        glvn.buf_addr = var_name;
+        if (locking) {
+            status = ydb_tp_s(&prune_tp, &prune, "", 0, NULL);
+            if (status == YDB_TP_ROLLBACK) status = prune.status;
+        } else {
+            status = prune_chunk(&prune);
+        }
 
-        ydb_buffer_t subs_array[YDB_MAX_SUBS];
-        unsigned int subs_size = nodem_baton->subs_array.size();
+        if (status == YDB_OK) {
+            cursor = prune.next_cursor;
+            scanned += prune.scanned;
+            pruned += prune.pruned;
+            visited += prune.visited;
+            chunks++;
 
-        for (unsigned int i = 0; i < subs_size; i++) {
-            subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-            subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
+            for (const nodem::aggregate_ptr_t& aggregate : prune.aggregates) {
+                nodem::read_ahead_invalidate(aggregate->target);
+            }
+        } else {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
         }
 
-        int delete_type = (nodem_baton->node_only) ? YDB_DEL_NODE : YDB_DEL_TREE;
+        if (locking) nodem::unlock_mutex();
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+        if (status != YDB_OK) break;
 
-        status = ydb_delete_s(&glvn, subs_size, subs_array, delete_type);
+        if (locking) sched_yield();
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
-
-    if (change_isv) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
-
-        if (set_stat != YDB_OK) return set_stat;
+    if (status == YDB_OK) {
+        nodem_baton->to_subs_array.assign(cursor.begin() + root.size(), cursor.end());
+        snprintf(nodem_baton->result, RES_LEN, "%.0f %.0f %u", scanned, pruned, chunks);
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::kill exit");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   scanned: ", scanned);
+        nodem::debug_log(">>   pruned: ", pruned);
+        nodem::debug_log(">>   chunks: ", chunks);
+        nodem::debug_log(">>   ydb::prune exit");
+    }
 
     return status;
-} // @end ydb::kill function
+} // @end ydb::prune function
 
 /*
- * @function ydb::order
- * @summary Return the next global or local node at the same level
+ * @function ydb::move
+ * @summary Move a global or local tree to another one, in one transaction, or in chunks followed by a transaction that cuts over
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {string} name - Global or local variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
+ * @member {string} name - Global or local variable name to move from
+ * @member {vector<string>} subs_array - Subscripts to move from
+ * @member {string} to_name - Global or local variable name to move to
+ * @member {vector<string>} to_subs_array - Subscripts to move to, which must not have any data
+ * @member {gtm_double_t} option - Maximum number of nodes to copy in each transaction
+ * @member {bool} atomic - Whether to move the whole tree in one transaction, rather than in chunks
+ * @member {ydb_char_t*} result - The number of nodes moved, and the transactions committed, on output
  * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t order(nodem::NodemBaton* nodem_baton)
+ydb_status_t move(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::order enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::move enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
         }
+
+        nodem::debug_log(">>>    to_name: ", nodem_baton->to_name);
+
+        for (unsigned int i = 0; i < nodem_baton->to_subs_array.size(); i++) {
+            nodem::debug_log(">>>    to_subscripts[", i, "]: ", nodem_baton->to_subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    option: ", nodem_baton->option);
     }
 
-    string save_result;
-    bool change_isv = false;
+    bool same;
+    ydb_status_t status = merge_overlap(nodem_baton, "ydb::move", same);
 
-    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+    if (status != YDB_OK || same) {
+        if (status == YDB_OK) strcpy(nodem_baton->result, "0 0");
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::move exit");
 
-        if (set_stat != YDB_OK) return set_stat;
+        return status;
     }
 
-    char* var_name = (char*) nodem_baton->name.c_str();
+    ydb_buffer_t from_glvn;
+    from_glvn.len_alloc = from_glvn.len_used = nodem_baton->name.length();
+    from_glvn.buf_addr = (char*) nodem_baton->name.c_str();
 
-    ydb_buffer_t glvn;
-    glvn.len_alloc = glvn.len_used = strlen(var_name);
-    glvn.buf_addr = var_name;
+    ydb_buffer_t to_glvn;
+    to_glvn.len_alloc = to_glvn.len_used = nodem_baton->to_name.length();
+    to_glvn.buf_addr = (char*) nodem_baton->to_name.c_str();
 
-    ydb_buffer_t subs_array[YDB_MAX_SUBS];
-    unsigned int subs_size = nodem_baton->subs_array.size();
+    // YottaDB only restores the local variables it is passed when it restarts a transaction, so a restart cannot lose them
+    ydb_buffer_t locals[2];
+    int local_count = 0;
 
-    for (unsigned int i = 0; i < subs_size; i++) {
-        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
-    }
+    if (nodem_baton->name[0] != '^') locals[local_count++] = from_glvn;
+    if (nodem_baton->to_name[0] != '^' && nodem_baton->to_name != nodem_baton->name) locals[local_count++] = to_glvn;
+
+    bool locking = nodem_baton->nodem_state->tp_level == 0;
+    double moved = 0;
+    unsigned int chunks = 0;
+
+    nodem::move_watch_ptr_t watch;
+    nodem::MoveWatch written;
+
+    MoveChunk move;
+
+    move.nodem_baton = nodem_baton;
+    move.from_glvn = &from_glvn;
+    move.to_glvn = &to_glvn;
+    move.cursor = nodem_baton->subs_array;
+    move.first = true;
+    move.written = &written;
+
+    // Unless chunks were asked for, or inside a transaction, which commits nothing until it does, the tree is one chunk
+    move.chunk = (locking && !nodem_baton->atomic) ? static_cast<unsigned int>(nodem_baton->option) :
+      std::numeric_limits<unsigned int>::max();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+
+    while (status == YDB_OK) {
+        move.status = YDB_OK;
+
+        if (locking) nodem::lock_mutex(nodem_baton->name);
+
+        // Another move of either tree has to see these writes; only the first chunk can kill the source
+        if (move.first) nodem::move_written(nodem_baton->name, nodem_baton->subs_array, true);
+        nodem::move_written(nodem_baton->to_name, nodem_baton->to_subs_array, true);
+
+        if (locking) {
+            status = ydb_tp_s(&move_chunk_tp, &move, "", local_count, locals);
+            if (status == YDB_TP_ROLLBACK) status = move.status;
+        } else {
+            status = move_chunk(&move);
+        }
+
+        if (status != YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        } else if (move.exists) {
+            string to_ref = nodem::lock_resource(nodem_baton->to_name, nodem_baton->to_subs_array);
+
+            snprintf(nodem_baton->error, ERR_LEN, "%d,ydb::move,%%YDB-E-PARAMINVALID, %s already has data, and cannot be moved to",
+              -YDB_ERR_PARAMINVALID, to_ref.c_str());
+
+            status = YDB_ERR_PARAMINVALID;
+        } else {
+            move.cursor = move.next_cursor;
+            moved += move.copied;
+            chunks++;
+
+            // Started under the same hold of the mutex as the first chunk, so no write to the source can come between them
+            if (move.first && !move.done) watch = nodem::move_watch(nodem_baton->name, nodem_baton->subs_array, move.chunk);
+        }
 
-    char order_data[YDB_MAX_STR];
+        if (locking) nodem::unlock_mutex();
 
-    ydb_buffer_t value;
-    value.len_alloc = YDB_MAX_STR;
-    value.len_used = 0;
-    value.buf_addr = (char*) &order_data;
+        if (status != YDB_OK || move.done) break;
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+        move.first = false;
 
-    ydb_status_t status;
+        sched_yield();
+    }
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    // A tree copied in more than one chunk may have been written in between, so the cutover makes the target match it
+    if (status == YDB_OK && !move.first) {
+        move.status = YDB_OK;
 
-    status = ydb_subscript_next_s(&glvn, subs_size, subs_array, &value);
+        if (locking) nodem::lock_mutex(nodem_baton->name);
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+        if (watch) {
+            written = nodem::move_written_nodes(watch);
 
-    while (strncmp(value.buf_addr, "v4w", 3) == 0 && subs_size == 0) {
-        glvn.len_alloc = glvn.len_used = strlen(value.buf_addr);
-        glvn.buf_addr = value.buf_addr;
-        value.len_used = 0;
+            nodem::move_unwatch(watch);
+            watch.reset();
+        } else {
+            written.whole = true;
+        }
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+        nodem::move_written(nodem_baton->name, nodem_baton->subs_array, true);
+        nodem::move_written(nodem_baton->to_name, nodem_baton->to_subs_array, true);
 
-        status = ydb_subscript_next_s(&glvn, subs_size, subs_array, &value);
+        status = ydb_tp_s(&move_cutover_tp, &move, "", local_count, locals);
 
-        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
-        if (value.len_used == 0 || status != YDB_OK) break;
+        if (status == YDB_TP_ROLLBACK) status = move.status;
+
+        if (status == YDB_OK) {
+            moved = written.whole ? move.copied : moved + move.copied;
+            chunks++;
+        } else {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        }
+
+        if (locking) nodem::unlock_mutex();
     }
 
-    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
-    nodem_baton->result[value.len_used] = '\0';
+    if (watch) nodem::move_unwatch(watch);
 
-    if (change_isv) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+    if (status == YDB_OK) snprintf(nodem_baton->result, RES_LEN, "%.0f %u", moved, chunks);
 
-        if (set_stat != YDB_OK) return set_stat;
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   moved: ", moved);
+        nodem::debug_log(">>   chunks: ", chunks);
+        nodem::debug_log(">>   ydb::move exit");
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::order exit");
-
     return status;
-} // @end ydb::order function
+} // @end ydb::move function
 
 /*
- * @function ydb::previous
- * @summary Return the previous global or local node at the same level
+ * @function ydb::from_json
+ * @summary Parse JSON text, setting a global or local node for each value in it, optionally all in one transaction
  * @param {NodemBaton*} nodem_baton - struct containing the following members
- * @member {string} name - Global or local variable name
- * @member {vector<string>} subs_array - Subscripts
- * @member {ydb_char_t*} result - Data returned from YottaDB, via the SimpleAPI interface
- * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {string} name - Global or local variable name; it can be an extended reference, or a sharded global
+ * @member {vector<string>} subs_array - Subscripts of the root of the subtree
+ * @member {string} value - The JSON text
+ * @member {gtm_uint_t} info - Shape of the JSON text: JSON_NESTED or JSON_FLAT
+ * @member {bool} atomic - Whether to set every node in one transaction, so that either all of them or none of them are set
+ * @member {mode_t} mode - Data mode; canonical mode converts JSON numbers to canonical numbers
+ * @member {ydb_char_t*} result - Number of nodes set, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface, or describing invalid JSON
  * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {bool} utf8 - Whether to store strings as UTF-8, or as bytes
  * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
  * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
  */
-ydb_status_t previous(nodem::NodemBaton* nodem_baton)
+ydb_status_t from_json(nodem::NodemBaton* nodem_baton)
 {
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous enter");
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::from_json enter");
 
     if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
         nodem::debug_log(">>>    name: ", nodem_baton->name);
 
-        if (nodem_baton->subs_array.size()) {
-            for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
-                nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
-            }
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
         }
-    }
-
-    string save_result;
-    bool change_isv = false;
 
-    if (nodem_baton->name.compare(0, 2, "^[") == 0 || nodem_baton->name.compare(0, 2, "^|") == 0) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
-
-        if (set_stat != YDB_OK) return set_stat;
+        nodem::debug_log(">>>    length: ", nodem_baton->value.length());
+        nodem::debug_log(">>>    info: ", nodem_baton->info);
+        nodem::debug_log(">>>    atomic: ", boolalpha, nodem_baton->atomic);
     }
 
-    char* var_name = (char*) nodem_baton->name.c_str();
-
-    ydb_buffer_t glvn;
-    glvn.len_alloc = glvn.len_used = strlen(var_name);
-    glvn.buf_addr = var_name;
-
-    ydb_buffer_t subs_array[YDB_MAX_SUBS];
-    unsigned int subs_size = nodem_baton->subs_array.size();
-
-    for (unsigned int i = 0; i < subs_size; i++) {
-        subs_array[i].len_alloc = subs_array[i].len_used = nodem_baton->subs_array[i].length();
-        subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
-    }
+    nodem::JsonReader json_reader {nodem_baton->value.data(), nodem_baton->value.length(),
+      static_cast<nodem::json_shape_t>(nodem_baton->info), nodem_baton->nodem_state->utf8, nodem_baton->mode == nodem::CANONICAL,
+      YDB_MAX_SUBS};
 
-    char previous_data[YDB_MAX_STR];
+    JsonLoad load;
 
-    ydb_buffer_t value;
-    value.len_alloc = YDB_MAX_STR;
-    value.len_used = 0;
-    value.buf_addr = (char*) &previous_data;
+    load.nodem_baton = nodem_baton;
+    load.json_reader = &json_reader;
+    load.var_name = nodem_baton->name;
+    load.count = 0;
+    load.status = YDB_OK;
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (!split_extended(load.var_name, load.gld)) load.shard = nodem::shard_find(load.var_name);
 
-    ydb_status_t status;
+    char isv_name[] = "$zgbldir";
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
 
-    status = ydb_subscript_previous_s(&glvn, subs_size, subs_array, &value);
+    bool atomic = nodem_baton->atomic && nodem_baton->nodem_state->tp_level == 0;
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
-    while (strncmp(value.buf_addr, "v4w", 3) == 0 && subs_size == 0) {
-        glvn.len_alloc = glvn.len_used = strlen(value.buf_addr);
-        glvn.buf_addr = value.buf_addr;
-        value.len_used = 0;
+    nodem::move_written(nodem_baton->name, nodem_baton->subs_array, true);
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    ydb_status_t status = (load.shard || !load.gld.empty()) ? get_value(&isv, vector<string> {}, load.default_gld) : YDB_OK;
 
-        status = ydb_subscript_previous_s(&glvn, subs_size, subs_array, &value);
+    if (status != YDB_OK) {
+        ydb_zstatus(nodem_baton->error, ERR_LEN);
+    } else if (atomic) {
+        status = ydb_tp_s(&json_load_tp, &load, "", 0, NULL);
 
-        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
-        if (value.len_used == 0 || status != YDB_OK) break;
+        if (status == YDB_TP_ROLLBACK) {
+            status = load.status;
+        } else if (status != YDB_OK) {
+            ydb_zstatus(nodem_baton->error, ERR_LEN);
+        }
+    } else {
+        // Inside a transaction, the nodes are set as part of it, and a restart is passed up to it
+        status = json_load(&load);
     }
 
-    strncpy(nodem_baton->result, value.buf_addr, value.len_used);
-    nodem_baton->result[value.len_used] = '\0';
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
 
-    if (change_isv) {
-        ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
+    if (status == YDB_OK) snprintf(nodem_baton->result, RES_LEN, "%.0f", load.count);
 
-        if (set_stat != YDB_OK) return set_stat;
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   count: ", load.count);
+        nodem::debug_log(">>   ydb::from_json exit");
     }
 
-    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous exit");
-
     return status;
-} // @end ydb::previous function
+} // @end ydb::from_json function
 
 /*
  * @function ydb::next_node
@@ -686,6 +4508,10 @@ ydb_status_t next_node(nodem::NodemBaton* nodem_baton)
         }
     }
 
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &next_node, SHARD_NEXT_NODE);
+
     string save_result;
     bool change_isv = false;
 
@@ -716,7 +4542,7 @@ ydb_status_t next_node(nodem::NodemBaton* nodem_baton)
     static ydb_buffer_t ret_array[YDB_MAX_SUBS];
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
     for (int i = 0; i < YDB_MAX_SUBS; i++) {
         ret_array[i].len_alloc = YDB_MAX_STR;
@@ -733,7 +4559,7 @@ ydb_status_t next_node(nodem::NodemBaton* nodem_baton)
     if (status != YDB_OK) {
         ydb_zstatus(nodem_baton->error, ERR_LEN);
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
         if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::next_node exit");
 
         if (change_isv) {
@@ -751,7 +4577,7 @@ ydb_status_t next_node(nodem::NodemBaton* nodem_baton)
             nodem_baton->subs_array.push_back(ret_array[i].buf_addr);
         }
     } else {
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
         if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::next_node exit");
 
         if (change_isv) {
@@ -775,7 +4601,7 @@ ydb_status_t next_node(nodem::NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
 
     strncpy(nodem_baton->result, value.buf_addr, value.len_used);
     nodem_baton->result[value.len_used] = '\0';
@@ -817,6 +4643,10 @@ ydb_status_t previous_node(nodem::NodemBaton* nodem_baton)
         }
     }
 
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &previous_node, SHARD_PREVIOUS_NODE);
+
     string save_result;
     bool change_isv = false;
 
@@ -847,7 +4677,7 @@ ydb_status_t previous_node(nodem::NodemBaton* nodem_baton)
     static ydb_buffer_t ret_array[YDB_MAX_SUBS];
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
     for (int i = 0; i < YDB_MAX_SUBS; i++) {
         ret_array[i].len_alloc = YDB_MAX_STR;
@@ -864,7 +4694,7 @@ ydb_status_t previous_node(nodem::NodemBaton* nodem_baton)
     if (status != YDB_OK) {
         ydb_zstatus(nodem_baton->error, ERR_LEN);
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
         if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::previous_node exit");
 
         if (change_isv) {
@@ -896,7 +4726,7 @@ ydb_status_t previous_node(nodem::NodemBaton* nodem_baton)
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
 
     if (subs_size == 0 || status == YDB_ERR_GVUNDEF || status == YDB_ERR_LVUNDEF) {
         if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::next_node exit");
@@ -953,6 +4783,10 @@ ydb_status_t increment(nodem::NodemBaton* nodem_baton)
         }
     }
 
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &increment, SHARD_HOME);
+
     string save_result;
     bool change_isv = false;
 
@@ -996,13 +4830,28 @@ ydb_status_t increment(nodem::NodemBaton* nodem_baton)
     value.buf_addr = (char*) &increment_data;
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    vector<nodem::aggregate_ptr_t> aggregates = (shard_routed_g || change_isv) ? vector<nodem::aggregate_ptr_t> {} :
+      nodem::aggregate_sources(nodem_baton->name, subs_size, false);
+
+    if (change_isv) nodem::aggregate_stale(nodem_baton->name);
 
-    ydb_status_t status = ydb_incr_s(&glvn, subs_size, subs_array, &incr, &value);
+    nodem::move_written(nodem_baton->name, nodem_baton->subs_array, false);
+
+    ydb_status_t status;
+
+    if (aggregates.empty()) {
+        status = ydb_incr_s(&glvn, subs_size, subs_array, &incr, &value);
+        if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    } else {
+        string total;
+        status = aggregate_call(nodem_baton, aggregates, AGGREGATE_INCREMENT, incr_val, total);
+        value.len_used = total.copy(value.buf_addr, value.len_alloc);
+    }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
-    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
 
     strncpy(nodem_baton->result, value.buf_addr, value.len_used);
     nodem_baton->result[value.len_used] = '\0';
@@ -1018,6 +4867,80 @@ ydb_status_t increment(nodem::NodemBaton* nodem_baton)
     return status;
 } // @end ydb::increment function
 
+/*
+ * @function ydb::striped_counter
+ * @summary Increment this thread's stripe of a striped counter, or read the counter by summing every stripe
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global variable name
+ * @member {vector<string>} subs_array - Subscripts of the counter; each stripe is a child of it
+ * @member {ydb_double_t} option - The amount to increment by, or 0 to read the counter
+ * @member {ydb_uint_t} info - Number of stripes
+ * @member {ydb_char_t*} result - The new value of the stripe, or the sum of the stripes, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @nested-member {pid_t} tid - Thread ID, which picks the stripe to increment
+ * @nested-member {short} tp_level - Level of nested transactions; the mutex is already held when non-zero
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t striped_counter(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::striped_counter enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+        nodem::debug_log(">>>    increment: ", nodem_baton->option);
+        nodem::debug_log(">>>    stripes: ", nodem_baton->info);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+    }
+
+    unsigned int stripes = nodem_baton->info;
+    ydb_status_t status = YDB_OK;
+
+    // Thread IDs are unique across processes, so each thread, in every process, increments a stripe of its own (modulo stripes)
+    if (nodem_baton->option != 0) {
+        nodem_baton->subs_array.push_back(std::to_string(nodem_baton->nodem_state->tid % stripes));
+
+        status = increment(nodem_baton);
+
+        nodem_baton->subs_array.pop_back();
+    } else {
+        bool locking = nodem_baton->nodem_state->tp_level == 0;
+        double total = 0;
+
+        if (locking) nodem::lock_mutex(nodem_baton->name);
+
+        for (unsigned int i = 0; i < stripes && status == YDB_OK; i++) {
+            nodem_baton->subs_array.push_back(std::to_string(i));
+
+            status = get(nodem_baton);
+
+            nodem_baton->subs_array.pop_back();
+
+            if (status == YDB_OK) {
+                total += strtod(nodem_baton->result, NULL);
+            } else if (status == YDB_ERR_GVUNDEF) {
+                status = YDB_OK;
+            }
+        }
+
+        if (locking) nodem::unlock_mutex();
+
+        if (status == YDB_OK) snprintf(nodem_baton->result, RES_LEN, "%.16g", total);
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) {
+        nodem::debug_log(">>   status: ", status);
+        nodem::debug_log(">>   result: ", nodem_baton->result);
+        nodem::debug_log(">>   ydb::striped_counter exit");
+    }
+
+    return status;
+} // @end ydb::striped_counter function
+
 /*
  * @function ydb::lock
  * @summary Lock a global or local node, incrementally
@@ -1046,6 +4969,11 @@ ydb_status_t lock(nodem::NodemBaton* nodem_baton)
         }
     }
 
+    string resource = nodem::lock_resource(nodem_baton->name, nodem_baton->subs_array);
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &lock, SHARD_HOME);
+
     string save_result;
     bool change_isv = false;
 
@@ -1078,17 +5006,21 @@ ydb_status_t lock(nodem::NodemBaton* nodem_baton)
     }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
+    uint64_t start = uv_hrtime();
     ydb_status_t status = ydb_lock_incr_s(timeout, &glvn, subs_size, subs_array);
+    uint64_t wait = uv_hrtime() - start;
 
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
 
     if (status == YDB_OK) {
         strncpy(nodem_baton->result, "1\0", 2);
+        nodem::lock_stats_acquire(resource, nodem_baton->nodem_state->tid, wait, true);
     } else if (status == YDB_LOCK_TIMEOUT) {
         strncpy(nodem_baton->result, "0\0", 2);
+        nodem::lock_stats_acquire(resource, nodem_baton->nodem_state->tid, wait, false);
 
         status = YDB_OK;
     } else {
@@ -1131,6 +5063,11 @@ ydb_status_t unlock(nodem::NodemBaton* nodem_baton)
         }
     }
 
+    string resource = nodem::lock_resource(nodem_baton->name, nodem_baton->subs_array);
+    nodem::shard_ptr_t shard = shard_routed_g ? nodem::shard_ptr_t {} : nodem::shard_find(nodem_baton->name);
+
+    if (shard) return shard_route(nodem_baton, *shard, &unlock, SHARD_HOME);
+
     string save_result;
     bool change_isv = false;
 
@@ -1145,7 +5082,7 @@ ydb_status_t unlock(nodem::NodemBaton* nodem_baton)
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
 
     if (nodem_baton->name == "") {
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
         status = ydb_lock_s(0, 0);
     } else {
@@ -1163,14 +5100,15 @@ ydb_status_t unlock(nodem::NodemBaton* nodem_baton)
             subs_array[i].buf_addr = (char*) nodem_baton->subs_array[i].c_str();
         }
 
-        if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_lock(&nodem::mutex_g);
+        if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
 
         status = ydb_lock_decr_s(&glvn, subs_size, subs_array);
     }
 
     if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
     if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
-    if (nodem_baton->nodem_state->tp_level == 0) uv_mutex_unlock(&nodem::mutex_g);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+    if (status == YDB_OK) nodem::lock_stats_release(resource, nodem_baton->nodem_state->tid);
 
     if (change_isv) {
         ydb_status_t set_stat = extended_ref(nodem_baton, save_result, change_isv);
@@ -1183,6 +5121,220 @@ ydb_status_t unlock(nodem::NodemBaton* nodem_baton)
     return status;
 } // @end ydb::unlock function
 
+/*
+ * @function ydb::version
+ * @summary Return the YottaDB version, from $zyrelease, without calling in to v4wNode.m
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Nodem version string
+ * @member {ydb_char_t*} result - The YottaDB version, formatted as version^v4wNode formats it, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t version(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::version enter");
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) nodem::debug_log(">>>    version: ", nodem_baton->name);
+
+    if (nodem::nodem_state_g < nodem::OPEN) return YDB_OK;
+
+    char isv_name[] = "$zyrelease";
+
+    ydb_buffer_t isv;
+    isv.len_alloc = isv.len_used = strlen(isv_name);
+    isv.buf_addr = isv_name;
+
+    string release;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    ydb_status_t status = get_value(&isv, vector<string> {}, release);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (status == YDB_OK) {
+        // $zyrelease is e.g. "YottaDB r1.34 Linux x86_64", and the version is the second piece, without the leading 'r'
+        size_t start = release.find(' ');
+        string number = (start == string::npos) ? "" : release.substr(start + 2, release.find(' ', start + 1) - start - 2);
+
+        snprintf(nodem_baton->result, RES_LEN, "YottaDB Version: %s", number.c_str());
+    }
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::version exit");
+
+    return status;
+} // @end ydb::version function
+
+/*
+ * @function ydb::merge
+ * @summary Merge a global or local array tree to another global or local array tree, without calling in to v4wNode.m
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - Global or local variable name to merge from
+ * @member {vector<string>} subs_array - Subscripts to merge from
+ * @member {string} to_name - Global or local variable name to merge to
+ * @member {vector<string>} to_subs_array - Subscripts to merge to
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t merge(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::merge enter");
+
+    if (nodem_baton->nodem_state->debug > nodem::MEDIUM) {
+        nodem::debug_log(">>>    name: ", nodem_baton->name);
+
+        for (unsigned int i = 0; i < nodem_baton->subs_array.size(); i++) {
+            nodem::debug_log(">>>    subscripts[", i, "]: ", nodem_baton->subs_array[i]);
+        }
+
+        nodem::debug_log(">>>    to_name: ", nodem_baton->to_name);
+
+        for (unsigned int i = 0; i < nodem_baton->to_subs_array.size(); i++) {
+            nodem::debug_log(">>>    to_subscripts[", i, "]: ", nodem_baton->to_subs_array[i]);
+        }
+    }
+
+    const vector<string>& from_subs = nodem_baton->subs_array;
+    const vector<string>& to_subs = nodem_baton->to_subs_array;
+    unsigned int from_size = from_subs.size();
+    bool same;
+
+    ydb_status_t overlap = merge_overlap(nodem_baton, "ydb::merge", same);
+
+    if (overlap != YDB_OK) return overlap;
+
+    if (same) {
+        if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::merge exit");
+
+        return YDB_OK;
+    }
+
+    ydb_buffer_t from_glvn;
+    from_glvn.len_alloc = from_glvn.len_used = nodem_baton->name.length();
+    from_glvn.buf_addr = (char*) nodem_baton->name.c_str();
+
+    ydb_buffer_t to_glvn;
+    to_glvn.len_alloc = to_glvn.len_used = nodem_baton->to_name.length();
+    to_glvn.buf_addr = (char*) nodem_baton->to_name.c_str();
+
+    ydb_buffer_t subs_array[YDB_MAX_SUBS];
+    ydb_buffer_t target_array[YDB_MAX_SUBS];
+
+    to_buffers(from_subs, subs_array);
+
+    vector<string> current = from_subs;
+    vector<string> target = to_subs;
+    string value;
+    unsigned int data;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   call using SimpleAPI");
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::lock_mutex(nodem_baton->name);
+
+    nodem::move_written(nodem_baton->to_name, to_subs, true);
+
+    ydb_status_t status = ydb_data_s(&from_glvn, from_size, subs_array, &data);
+
+    if (status == YDB_OK && (data == 1 || data == 11)) {
+        status = get_value(&from_glvn, current, value);
+
+        if (status == YDB_OK) {
+            ydb_buffer_t set_value;
+            set_value.len_alloc = set_value.len_used = value.length();
+            set_value.buf_addr = (char*) value.c_str();
+
+            to_buffers(target, target_array);
+            status = ydb_set_s(&to_glvn, target.size(), target_array, &set_value);
+        }
+    }
+
+    while (status == YDB_OK && data >= 10) {
+        status = node_next(&from_glvn, current);
+
+        if (status != YDB_OK) break;
+        if (current.size() <= from_size || !std::equal(from_subs.begin(), from_subs.end(), current.begin())) break;
+
+        status = get_value(&from_glvn, current, value);
+
+        if (status != YDB_OK) break;
+
+        target.resize(to_subs.size());
+        target.insert(target.end(), current.begin() + from_size, current.end());
+
+        ydb_buffer_t set_value;
+        set_value.len_alloc = set_value.len_used = value.length();
+        set_value.buf_addr = (char*) value.c_str();
+
+        to_buffers(target, target_array);
+        status = ydb_set_s(&to_glvn, target.size(), target_array, &set_value);
+    }
+
+    if (status == YDB_NODE_END) status = YDB_OK;
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   status: ", status);
+    if (status != YDB_OK) ydb_zstatus(nodem_baton->error, ERR_LEN);
+    if (nodem_baton->nodem_state->tp_level == 0) nodem::unlock_mutex();
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::merge exit");
+
+    return status;
+} // @end ydb::merge function
+
+/*
+ * @function ydb::global_directory
+ * @summary List the globals in a database, with optional filters, without calling in to v4wNode.m
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - First global to list, if it exists, including the leading ^
+ * @member {string} to_name - Last global to list, including the leading ^; an empty string means no limit
+ * @member {gtm_double_t} option - Maximum number of globals to list; 0 means no limit
+ * @member {vector<string>} subs_array - The globals listed, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t global_directory(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::global_directory enter");
+
+    nodem_baton->local = false;
+    ydb_status_t status = directory(nodem_baton);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::global_directory exit");
+
+    return status;
+} // @end ydb::global_directory function
+
+/*
+ * @function ydb::local_directory
+ * @summary List the local variables in the symbol table, with optional filters, without calling in to v4wNode.m
+ * @param {NodemBaton*} nodem_baton - struct containing the following members
+ * @member {string} name - First local variable to list, if it exists
+ * @member {string} to_name - Last local variable to list; an empty string means no limit
+ * @member {gtm_double_t} option - Maximum number of local variables to list; 0 means no limit
+ * @member {vector<string>} subs_array - The local variables listed, on output
+ * @member {ydb_char_t*} error - Error message returned from YottaDB, via the SimpleAPI interface
+ * @member {NodemState*} nodem_state - Per-thread state class containing the following members
+ * @nested-member {debug_t} debug - Debug mode: OFF, LOW, MEDIUM, or HIGH; defaults to OFF
+ * @returns {ydb_status_t} status - Return code; 0 is success, any other number is an error code
+ */
+ydb_status_t local_directory(nodem::NodemBaton* nodem_baton)
+{
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::local_directory enter");
+
+    nodem_baton->local = true;
+    ydb_status_t status = directory(nodem_baton);
+
+    if (nodem_baton->nodem_state->debug > nodem::LOW) nodem::debug_log(">>   ydb::local_directory exit");
+
+    return status;
+} // @end ydb::local_directory function
+
 // ***End Public APIs***
 
 } // @end ydb namespace
@@ -31,15 +31,33 @@ namespace ydb {
 
 ydb_status_t data(nodem::NodemBaton*);
 ydb_status_t get(nodem::NodemBaton*);
+ydb_status_t read_consistent(nodem::NodemBaton*);
 ydb_status_t set(nodem::NodemBaton*);
 ydb_status_t kill(nodem::NodemBaton*);
+ydb_status_t kill_tree(nodem::NodemBaton*);
 ydb_status_t order(nodem::NodemBaton*);
 ydb_status_t previous(nodem::NodemBaton*);
+ydb_status_t scan(nodem::NodemBaton*);
+ydb_status_t to_json(nodem::NodemBaton*);
+ydb_status_t from_json(nodem::NodemBaton*);
+ydb_status_t count_distinct(nodem::NodemBaton*);
+ydb_status_t sample(nodem::NodemBaton*);
+ydb_status_t sorter_write(nodem::NodemBaton*);
+ydb_status_t sorter_read(nodem::NodemBaton*);
+ydb_status_t bloom(nodem::NodemBaton*);
+ydb_status_t define_aggregate(nodem::NodemBaton*);
+ydb_status_t prune(nodem::NodemBaton*);
+ydb_status_t move(nodem::NodemBaton*);
 ydb_status_t next_node(nodem::NodemBaton*);
 ydb_status_t previous_node(nodem::NodemBaton*);
 ydb_status_t increment(nodem::NodemBaton*);
+ydb_status_t striped_counter(nodem::NodemBaton*);
 ydb_status_t lock(nodem::NodemBaton*);
 ydb_status_t unlock(nodem::NodemBaton*);
+ydb_status_t version(nodem::NodemBaton*);
+ydb_status_t merge(nodem::NodemBaton*);
+ydb_status_t global_directory(nodem::NodemBaton*);
+ydb_status_t local_directory(nodem::NodemBaton*);
 
 } // @end ydb namespace
 